@@ -0,0 +1,85 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#ifndef CCB_BAM_AVAILABILITY_HISTORY_HH
+#define CCB_BAM_AVAILABILITY_HISTORY_HH
+
+#include <ctime>
+#include <functional>
+#include <vector>
+
+#include "com/centreon/broker/bam/availability_builder.hh"
+#include "com/centreon/broker/bam/timeperiod_map.hh"
+#include "com/centreon/broker/namespace.hh"
+
+CCB_BEGIN()
+
+namespace bam {
+/**
+ *  @class availability_history availability_history.hh
+ * "com/centreon/broker/bam/availability_history.hh"
+ *  @brief Events of a BA, used to rebuild its availabilities.
+ *
+ *  All the events of a BA are loaded at once and the availabilities of
+ *  every day are built from memory, with the same rules as the daily
+ *  build of the availability thread.
+ */
+class availability_history {
+ public:
+  typedef std::function<void(time_t day_start,
+                             uint32_t timeperiod_id,
+                             availability_builder const& builder)>
+      callback;
+
+  availability_history(uint32_t ba_id = 0);
+  ~availability_history();
+  availability_history(availability_history const& other) = default;
+  availability_history& operator=(availability_history const& other) = default;
+
+  uint32_t get_ba_id() const;
+  void add_closed_event(short status,
+                        time_t start,
+                        time_t end,
+                        bool in_downtime,
+                        uint32_t timeperiod_id,
+                        bool timeperiod_is_default);
+  void add_opened_event(short status, time_t start, bool in_downtime);
+  void build(time_t first_day,
+             time_t last_day,
+             timeperiod_map const& tps,
+             callback const& write) const;
+
+ private:
+  struct event {
+    time_t start;
+    time_t end;
+    uint32_t timeperiod_id;
+    short status;
+    bool in_downtime;
+    bool timeperiod_is_default;
+  };
+
+  uint32_t _ba_id;
+  std::vector<event> _closed;
+  std::vector<event> _opened;
+};
+}  // namespace bam
+
+CCB_END()
+
+#endif  // !CCB_BAM_AVAILABILITY_HISTORY_HH
@@ -19,13 +19,18 @@
 #ifndef CCB_BAM_AVAILABILITY_THREAD_HH
 #define CCB_BAM_AVAILABILITY_THREAD_HH
 
+#include <atomic>
 #include <condition_variable>
+#include <exception>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
+#include <unordered_map>
+#include <vector>
 
 #include "com/centreon/broker/bam/availability_builder.hh"
+#include "com/centreon/broker/bam/availability_history.hh"
 #include "com/centreon/broker/bam/timeperiod_map.hh"
 #include "com/centreon/broker/database_config.hh"
 #include "com/centreon/broker/io/data.hh"
@@ -44,6 +49,11 @@ namespace bam {
  * "com/centreon/broker/bam/availability_thread.hh"
  *  @brief Availability thread
  *
+ *  Availabilities are built each night for the previous day. When BAs
+ *  are rebuilt, their events are loaded once and their availabilities
+ *  are built by a pool of workers, one BA at a time per worker. The BAs
+ *  remaining to rebuild are saved in the cache directory so that an
+ *  interrupted rebuild is resumed at the next start.
  */
 class availability_thread {
  public:
@@ -63,10 +73,17 @@ class availability_thread {
 
   void rebuild_availabilities(std::string const& bas_to_rebuild);
   void wait();
+  std::string get_progress() const;
 
  private:
-  void _delete_all_availabilities();
+  static size_t const _bulk_size = 1000;
+
   void _build_availabilities(time_t midnight);
+  void _rebuild_availabilities(time_t midnight);
+  void _rebuild_worker(std::vector<uint32_t> const& ba_ids,
+                       time_t first_day,
+                       time_t last_day,
+                       int thread_id);
   void _build_daily_availabilities(int thread_id,
                                    time_t day_start,
                                    time_t day_end);
@@ -82,6 +99,11 @@ class availability_thread {
   void _open_database();
   void _close_database();
 
+  std::string _rebuild_state_file() const;
+  void _load_rebuild_state();
+  void _save_rebuild_state(std::string const& bas_to_rebuild) const;
+  void _set_progress(std::string const& progress);
+
   std::thread _thread;
 
   // Checked from master
@@ -96,6 +118,19 @@ class availability_thread {
   bool _should_rebuild_all;
   std::string _bas_to_rebuild;
   std::condition_variable _wait;
+
+  // Rebuild shared with workers.
+  std::mutex _rebuild_m;
+  std::condition_variable _rebuild_cv;
+  std::unordered_map<uint32_t, availability_history> _histories;
+  size_t _rebuild_next;
+  std::vector<uint32_t> _rebuilt;
+  int _running_workers;
+  std::exception_ptr _rebuild_error;
+  std::atomic_bool _rebuild_interrupted;
+
+  mutable std::mutex _progress_m;
+  std::string _progress;
 };
 }  // namespace bam
 
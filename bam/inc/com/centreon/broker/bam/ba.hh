@@ -57,12 +57,14 @@ class ba : public computable, public service_listener {
     impact_values hard_impact;
     impact_values soft_impact;
     bool in_downtime;
+    bool ok_state;
   };
 
  private:
   static int const _recompute_limit = 100;
 
   void _apply_impact(kpi* kpi_ptr, impact_info& impact);
+  void _count_impact(impact_info const& impact, int sign);
   void _open_new_event(io::stream* visitor, short service_hard_state);
   void _recompute();
   void _unapply_impact(kpi* kpi_ptr, impact_info& impact);
@@ -82,6 +84,8 @@ class ba : public computable, public service_listener {
   uint32_t _host_id;
   uint32_t _id;
   std::unordered_map<kpi*, impact_info> _impacts;
+  uint32_t _num_kpi_in_dt;
+  uint32_t _num_kpi_not_ok_out_of_dt;
   bool _in_downtime;
   timestamp _last_kpi_update;
   double _level_critical;
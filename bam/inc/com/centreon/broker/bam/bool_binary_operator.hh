@@ -48,6 +48,8 @@ class bool_binary_operator : public bool_value {
   bool child_has_update(computable* child, io::stream* visitor = NULL);
   void set_left(std::shared_ptr<bool_value> const& left);
   void set_right(std::shared_ptr<bool_value> const& right);
+  std::shared_ptr<bool_value> const& get_left() const;
+  std::shared_ptr<bool_value> const& get_right() const;
   bool state_known() const;
   bool in_downtime() const;
 
@@ -48,6 +48,7 @@ class bool_call : public bool_value {
   double value_soft();
   bool state_known() const;
   std::string const& get_name() const;
+  std::shared_ptr<bool_value> const& get_expression() const;
   void set_expression(std::shared_ptr<bool_value> expression);
   bool child_has_update(computable* child, io::stream* visitor = NULL);
 
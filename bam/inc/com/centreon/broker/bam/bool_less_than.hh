@@ -41,6 +41,7 @@ class bool_less_than : public bool_binary_operator {
   bool_less_than& operator=(bool_less_than const& right);
   double value_hard();
   double value_soft();
+  bool is_strict() const;
 
  private:
   bool _strict;
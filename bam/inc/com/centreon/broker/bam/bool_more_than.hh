@@ -40,6 +40,7 @@ class bool_more_than : public bool_binary_operator {
   bool_more_than& operator=(bool_more_than const& right);
   double value_hard();
   double value_soft();
+  bool is_strict() const;
 
  private:
   bool _strict;
@@ -46,6 +46,7 @@ class bool_not : public bool_value {
   bool_not& operator=(bool_not const& right);
   bool child_has_update(computable* child, io::stream* visitor = NULL);
   void set_value(std::shared_ptr<bool_value>& value);
+  bool_value::ptr const& get_value() const;
   double value_hard();
   double value_soft();
   bool state_known() const;
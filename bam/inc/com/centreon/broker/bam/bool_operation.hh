@@ -37,6 +37,14 @@ namespace bam {
  */
 class bool_operation : public bool_binary_operator {
  public:
+  enum operation_type {
+    addition,
+    substraction,
+    multiplication,
+    division,
+    modulo
+  };
+
   bool_operation(std::string const& op);
   bool_operation(bool_operation const& right);
   ~bool_operation();
@@ -44,15 +52,9 @@ class bool_operation : public bool_binary_operator {
   double value_hard();
   double value_soft();
   bool state_known() const;
+  operation_type get_type() const;
 
  private:
-  enum operation_type {
-    addition,
-    substraction,
-    multiplication,
-    division,
-    modulo
-  };
   operation_type _type;
 };
 }  // namespace bam
@@ -0,0 +1,128 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#ifndef CCB_BAM_BOOL_PROGRAM_HH
+#define CCB_BAM_BOOL_PROGRAM_HH
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "com/centreon/broker/bam/bool_value.hh"
+#include "com/centreon/broker/namespace.hh"
+
+CCB_BEGIN()
+
+namespace bam {
+/**
+ *  @class bool_program bool_program.hh "com/centreon/broker/bam/bool_program.hh"
+ *  @brief Boolean expression compiled into a flat program.
+ *
+ *  The operators of a bool_value tree are compiled into a list of
+ *  instructions working on registers. Leaves of the tree (services, calls,
+ *  ...) become inputs whose values are stored in registers, constant
+ *  subexpressions are folded and AND/OR are short-circuited. Inputs are
+ *  direct children of the program, so an input update costs one
+ *  evaluation of the program and no walk through the operator nodes.
+ *  Calls are resolved after compilation, so they are read again on each
+ *  evaluation.
+ */
+class bool_program : public bool_value {
+ public:
+  typedef std::shared_ptr<bool_program> ptr;
+
+  enum opcode {
+    op_not = 0,
+    op_and,
+    op_or,
+    op_xor,
+    op_equal,
+    op_not_equal,
+    op_more,
+    op_more_equal,
+    op_less,
+    op_less_equal,
+    op_add,
+    op_sub,
+    op_mul,
+    op_div,
+    op_mod,
+    op_jump_if_false,
+    op_jump_if_true
+  };
+
+  /**
+   *  Operands are register indexes. Jumps store their result in dst and
+   *  their target in b.
+   */
+  struct instruction {
+    opcode op;
+    uint32_t dst;
+    uint32_t a;
+    uint32_t b;
+  };
+
+ private:
+  struct input {
+    bool_value* value;
+    uint32_t reg;
+    bool known;
+    bool in_downtime;
+    bool call;
+  };
+
+  std::vector<bool_value::ptr> _owned_inputs;
+  std::vector<input> _inputs;
+  std::vector<instruction> _code;
+  std::vector<double> _hard;
+  std::vector<double> _soft;
+  uint32_t _result;
+  uint32_t _unknown_inputs;
+  uint32_t _inputs_in_downtime;
+  double _value_hard;
+  double _value_soft;
+  bool _state_known;
+
+  struct operand;
+  operand _compile(bool_value::ptr const& node, bool_value::ptr const& parent);
+  uint32_t _add_input(bool_value::ptr const& node,
+                      bool_value::ptr const& parent);
+  uint32_t _add_register(double value = 0.0);
+  void _read_input(input& in);
+  void _evaluate();
+  bool _run(std::vector<double>& regs) const;
+
+ public:
+  bool_program(bool_value::ptr const& tree);
+  bool_program(bool_program const& other) = delete;
+  ~bool_program();
+  bool_program& operator=(bool_program const& other) = delete;
+  static bool_value::ptr compile(bool_value::ptr const& tree);
+  bool child_has_update(computable* child, io::stream* visitor = NULL);
+  double value_hard();
+  double value_soft();
+  bool state_known() const;
+  bool in_downtime() const;
+  std::vector<instruction> const& get_code() const;
+  size_t get_inputs_count() const;
+};
+}  // namespace bam
+
+CCB_END()
+
+#endif  // !CCB_BAM_BOOL_PROGRAM_HH
@@ -19,8 +19,8 @@
 #ifndef CCB_BAM_COMPUTABLE_HH
 #define CCB_BAM_COMPUTABLE_HH
 
-#include <list>
 #include <memory>
+#include <vector>
 
 #include "com/centreon/broker/io/stream.hh"
 #include "com/centreon/broker/namespace.hh"
@@ -35,9 +35,46 @@ namespace bam {
  *
  *  The computation of such objects is triggered by the BAM engine. It
  *  provides an effective way to compute whole part of the BA/KPI tree.
+ *
+ *  Each node knows its level in the graph (0 for leaves, parents are
+ *  always above their children). Updates are propagated through a batch:
+ *  updated nodes mark their parents dirty and the batch recomputes dirty
+ *  nodes level by level, so that a node shared by many paths is only
+ *  propagated once.
  */
 class computable {
  public:
+  /**
+   *  @class batch computable.hh "com/centreon/broker/bam/computable.hh"
+   *  @brief Group the propagation of several updates.
+   *
+   *  While a batch is alive in the current thread, propagate_update()
+   *  only marks parents as dirty. Dirty nodes are recomputed in
+   *  topological order by run(), which the owner of the batch calls to
+   *  get propagation errors, or else when the batch is destroyed.
+   */
+  class batch {
+    static thread_local batch* _current;
+
+    batch* _previous;
+    io::stream* _visitor;
+    std::vector<std::vector<std::shared_ptr<computable>>> _levels;
+    size_t _position;
+    bool _running;
+
+    void _add(computable* child);
+    void _reset(std::vector<std::shared_ptr<computable>>& nodes);
+
+   public:
+    batch(io::stream* visitor = nullptr);
+    batch(batch const&) = delete;
+    batch& operator=(batch const&) = delete;
+    ~batch();
+    void run();
+
+    friend class computable;
+  };
+
   computable();
   computable(computable const& right);
   virtual ~computable();
@@ -45,6 +82,7 @@ class computable {
   void add_parent(std::shared_ptr<computable> const& parent);
   void propagate_update(io::stream* visitor = NULL);
   void remove_parent(std::shared_ptr<computable> const& parent);
+  uint32_t get_level() const noexcept;
 
   /**
    *  @brief Notify node of the change of a child node.
@@ -63,8 +101,11 @@ class computable {
 
  private:
   void _internal_copy(computable const& right);
+  void _raise_level(uint32_t level);
 
-  std::list<std::weak_ptr<computable>> _parents;
+  std::vector<std::weak_ptr<computable>> _parents;
+  uint32_t _level;
+  std::vector<computable*> _updated_children;
 };
 }  // namespace bam
 
@@ -21,7 +21,10 @@
 
 #include <mutex>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 
+#include "com/centreon/broker/bam/ba_status.hh"
 #include "com/centreon/broker/bam/configuration/applier/state.hh"
 #include "com/centreon/broker/database/mysql_stmt.hh"
 #include "com/centreon/broker/database_config.hh"
@@ -39,8 +42,15 @@ namespace bam {
  *
  *  Handle perfdata and insert proper informations in index_data and
  *  metrics table of a centbam DB.
+ *
+ *  BA statuses are kept per BA until the next flush, only the latest one
+ *  is written and all of them are updated with one query. External
+ *  commands are buffered and written to the command file at once.
  */
 class monitoring_stream : public io::stream {
+  static constexpr size_t _max_pending_ba_status = 1000;
+  static constexpr time_t _flush_window = 1;
+
   configuration::applier::state _applier;
   std::string _status;
   std::string _ext_cmd_file;
@@ -48,12 +58,15 @@ class monitoring_stream : public io::stream {
   ba_svc_mapping _meta_mapping;
   mutable std::mutex _statusm;
   mysql _mysql;
-  database::mysql_stmt _ba_update;
   database::mysql_stmt _kpi_update;
   database::mysql_stmt _meta_service_update;
   int32_t _pending_events;
   database_config _storage_db_cfg;
   std::shared_ptr<persistent_cache> _cache;
+  std::unordered_map<uint32_t, std::shared_ptr<ba_status>> _ba_statuses;
+  std::unordered_set<uint32_t> _ba_checks;
+  std::string _ext_cmd_buffer;
+  time_t _last_flush;
 
  public:
   monitoring_stream(std::string const& ext_cmd_file,
@@ -72,10 +85,12 @@ class monitoring_stream : public io::stream {
   monitoring_stream(monitoring_stream const& other);
   monitoring_stream& operator=(monitoring_stream const& other);
   void _check_replication();
+  void _flush_pending();
   void _prepare();
   void _rebuild();
   void _update_status(std::string const& status);
-  void _write_external_command(std::string cmd);
+  void _write_ba_statuses();
+  void _write_external_commands();
 
   void _read_cache();
   void _write_cache();
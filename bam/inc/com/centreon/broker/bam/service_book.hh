@@ -19,10 +19,12 @@
 #ifndef CCB_BAM_SERVICE_BOOK_HH
 #define CCB_BAM_SERVICE_BOOK_HH
 
-#include <map>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 #include "com/centreon/broker/io/stream.hh"
+#include "com/centreon/broker/misc/pair.hh"
 #include "com/centreon/broker/namespace.hh"
 
 CCB_BEGIN()
@@ -43,7 +45,9 @@ class service_listener;
  * "com/centreon/broker/bam/service_book.hh"
  *  @brief Propagate service updates.
  *
- *  Propagate updates of services to service listeners.
+ *  Propagate updates of services to service listeners. Listeners are
+ *  indexed by service, so that each status, acknowledgement or downtime
+ *  only costs a hash lookup.
  */
 class service_book {
  public:
@@ -63,10 +67,17 @@ class service_book {
               io::stream* visitor = NULL);
 
  private:
-  typedef std::multimap<std::pair<uint32_t, uint32_t>, service_listener*>
-      multimap;
+  typedef std::unordered_map<std::pair<uint64_t, uint64_t>,
+                             std::vector<service_listener*> >
+      listeners;
 
-  multimap _book;
+  template <typename T>
+  void _update(uint32_t host_id,
+               uint32_t service_id,
+               std::shared_ptr<T> const& t,
+               io::stream* visitor);
+
+  listeners _book;
 };
 }  // namespace bam
 
@@ -41,6 +41,7 @@ class timeperiod_map {
   timeperiod_map(timeperiod_map const&);
   timeperiod_map& operator=(timeperiod_map const&);
   bool operator==(timeperiod_map const& other) const;
+  timeperiod_map clone() const;
 
   time::timeperiod::ptr get_timeperiod(uint32_t id) const;
   void add_timeperiod(uint32_t id, time::timeperiod::ptr ptr);
@@ -0,0 +1,185 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#include "com/centreon/broker/bam/availability_history.hh"
+
+#include <algorithm>
+#include <map>
+
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::bam;
+
+/**
+ *  Constructor.
+ *
+ *  @param[in] ba_id  The id of the BA.
+ */
+availability_history::availability_history(uint32_t ba_id) : _ba_id(ba_id) {}
+
+/**
+ *  Destructor.
+ */
+availability_history::~availability_history() {}
+
+/**
+ *  Get the id of the BA.
+ *
+ *  @return  The id of the BA.
+ */
+uint32_t availability_history::get_ba_id() const {
+  return _ba_id;
+}
+
+/**
+ *  Add a closed event, with its duration in a timeperiod.
+ *
+ *  @param[in] status                 Status of the BA.
+ *  @param[in] start                  Start of the duration.
+ *  @param[in] end                    End of the duration.
+ *  @param[in] in_downtime            True if the BA was in downtime.
+ *  @param[in] timeperiod_id          The id of the timeperiod.
+ *  @param[in] timeperiod_is_default  True if it is the default timeperiod.
+ */
+void availability_history::add_closed_event(short status,
+                                            time_t start,
+                                            time_t end,
+                                            bool in_downtime,
+                                            uint32_t timeperiod_id,
+                                            bool timeperiod_is_default) {
+  event e;
+  e.start = start;
+  e.end = end;
+  e.timeperiod_id = timeperiod_id;
+  e.status = status;
+  e.in_downtime = in_downtime;
+  e.timeperiod_is_default = timeperiod_is_default;
+  _closed.push_back(e);
+}
+
+/**
+ *  Add an event not finished yet.
+ *
+ *  @param[in] status       Status of the BA.
+ *  @param[in] start        Start of the event.
+ *  @param[in] in_downtime  True if the BA is in downtime.
+ */
+void availability_history::add_opened_event(short status,
+                                            time_t start,
+                                            bool in_downtime) {
+  event e;
+  e.start = start;
+  e.end = 0;
+  e.timeperiod_id = 0;
+  e.status = status;
+  e.in_downtime = in_downtime;
+  e.timeperiod_is_default = false;
+  _opened.push_back(e);
+}
+
+/**
+ *  Build the availabilities of each day.
+ *
+ *  Events are walked once: each day only looks at the events started
+ *  before its end and not finished before its start.
+ *
+ *  @param[in] first_day  Midnight of the first day to build.
+ *  @param[in] last_day   Midnight of the day following the last day.
+ *  @param[in] tps        Timeperiods.
+ *  @param[in] write      Called for each availability built.
+ */
+void availability_history::build(time_t first_day,
+                                 time_t last_day,
+                                 timeperiod_map const& tps,
+                                 callback const& write) const {
+  auto by_start = [](event const* a, event const* b) {
+    return a->start < b->start;
+  };
+  std::vector<event const*> closed;
+  closed.reserve(_closed.size());
+  for (event const& e : _closed)
+    closed.push_back(&e);
+  std::stable_sort(closed.begin(), closed.end(), by_start);
+  std::vector<event const*> opened;
+  opened.reserve(_opened.size());
+  for (event const& e : _opened)
+    opened.push_back(&e);
+  std::stable_sort(opened.begin(), opened.end(), by_start);
+
+  // Opened events are counted in all the timeperiods of the BA.
+  std::vector<std::pair<time::timeperiod::ptr, bool> > ba_tps;
+  if (!opened.empty())
+    ba_tps = tps.get_timeperiods_by_ba_id(_ba_id);
+
+  std::vector<event const*> active;
+  size_t next_closed = 0;
+  size_t opened_count = 0;
+  while (first_day < last_day) {
+    time_t day_end =
+        time::timeperiod::add_round_days_to_midnight(first_day, 3600 * 24);
+    std::map<uint32_t, availability_builder> builders;
+
+    // Closed events.
+    while (next_closed < closed.size() && closed[next_closed]->start < day_end)
+      active.push_back(closed[next_closed++]);
+    size_t kept = 0;
+    for (event const* e : active) {
+      // Finished before this day, so before the next ones.
+      if (e->end < first_day)
+        continue;
+      active[kept++] = e;
+
+      time::timeperiod::ptr tp = tps.get_timeperiod(e->timeperiod_id);
+      if (!tp)
+        continue;
+      auto found = builders.find(e->timeperiod_id);
+      if (found == builders.end())
+        found = builders
+                    .insert(std::make_pair(
+                        e->timeperiod_id,
+                        availability_builder(day_end, first_day)))
+                    .first;
+      found->second.add_event(e->status, e->start, e->end, e->in_downtime, tp);
+      found->second.set_timeperiod_is_default(e->timeperiod_is_default);
+    }
+    active.resize(kept);
+
+    // Events not finished.
+    while (opened_count < opened.size() &&
+           opened[opened_count]->start < day_end)
+      ++opened_count;
+    for (size_t i = 0; i < opened_count; ++i) {
+      event const* e = opened[i];
+      for (auto it = ba_tps.begin(), end = ba_tps.end(); it != end; ++it) {
+        uint32_t tp_id = it->first->get_id();
+        auto found = builders.find(tp_id);
+        if (found == builders.end())
+          found = builders
+                      .insert(std::make_pair(
+                          tp_id, availability_builder(day_end, first_day)))
+                      .first;
+        found->second.add_event(e->status, e->start, e->end, e->in_downtime,
+                                it->first);
+        found->second.set_timeperiod_is_default(it->second);
+      }
+    }
+
+    for (auto it = builders.begin(), end = builders.end(); it != end; ++it)
+      write(first_day, it->first, it->second);
+    first_day = day_end;
+  }
+}
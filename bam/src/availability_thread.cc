@@ -18,14 +18,20 @@
 
 #include "com/centreon/broker/bam/availability_thread.hh"
 
+#include <algorithm>
+#include <cstdio>
 #include <ctime>
+#include <fstream>
+#include <set>
 #include <sstream>
 
 #include "com/centreon/broker/database/mysql_error.hh"
 #include "com/centreon/broker/exceptions/msg.hh"
 #include "com/centreon/broker/log_v2.hh"
 #include "com/centreon/broker/logging/logging.hh"
+#include "com/centreon/broker/config/applier/state.hh"
 #include "com/centreon/broker/misc/global_lock.hh"
+#include "com/centreon/broker/misc/string.hh"
 
 using namespace com::centreon::broker;
 using namespace com::centreon::broker::bam;
@@ -43,7 +49,10 @@ availability_thread::availability_thread(database_config const& db_cfg,
       _shared_tps(shared_map),
       _mutex{},
       _should_exit(false),
-      _should_rebuild_all(false) {}
+      _should_rebuild_all(false),
+      _rebuild_next(0),
+      _running_workers(0),
+      _rebuild_interrupted(false) {}
 
 /**
  *  Destructor.
@@ -63,15 +72,23 @@ void availability_thread::run() {
   if (_should_exit)
     return;
 
+  // An interrupted rebuild is resumed without waiting.
+  _load_rebuild_state();
+  bool resume(_should_rebuild_all);
+
   for (;;) {
     try {
-      // Calculate the duration until next midnight.
-      time_t midnight = _compute_next_midnight();
-      unsigned long wait_for = std::difftime(midnight, ::time(nullptr));
-      log_v2::bam()->debug(
-          "BAM-BI: availability thread sleeping for {} seconds.", wait_for);
-      _wait.wait_for(lock, std::chrono::seconds(wait_for));
-      log_v2::bam()->debug("BAM-BI: availability thread waking up ");
+      if (resume)
+        resume = false;
+      else {
+        // Calculate the duration until next midnight.
+        time_t midnight = _compute_next_midnight();
+        unsigned long wait_for = std::difftime(midnight, ::time(nullptr));
+        log_v2::bam()->debug(
+            "BAM-BI: availability thread sleeping for {} seconds.", wait_for);
+        _wait.wait_for(lock, std::chrono::seconds(wait_for));
+        log_v2::bam()->debug("BAM-BI: availability thread waking up ");
+      }
 
       // Termination asked.
       if (_should_exit)
@@ -81,8 +98,13 @@ void availability_thread::run() {
       // Open the database.
       _open_database();
 
-      log_v2::bam()->debug("BAM-BI: build availabilities");
-      _build_availabilities(_compute_start_of_day(::time(nullptr)));
+      if (_should_rebuild_all) {
+        log_v2::bam()->debug("BAM-BI: rebuild availabilities");
+        _rebuild_availabilities(_compute_start_of_day(::time(nullptr)));
+      } else {
+        log_v2::bam()->debug("BAM-BI: build availabilities");
+        _build_availabilities(_compute_start_of_day(::time(nullptr)));
+      }
       _should_rebuild_all = false;
       _bas_to_rebuild.clear();
 
@@ -102,6 +124,8 @@ void availability_thread::run() {
  *  Ask for the thread termination.
  */
 void availability_thread::terminate() {
+  // A running rebuild stops after the BAs in progress.
+  _rebuild_interrupted = true;
   std::lock_guard<std::mutex> lock(_mutex);
   _should_exit = true;
   _wait.notify_one();
@@ -148,21 +172,18 @@ void availability_thread::rebuild_availabilities(
     return;
   _should_rebuild_all = true;
   _bas_to_rebuild = bas_to_rebuild;
+  _save_rebuild_state(_bas_to_rebuild);
   _wait.notify_one();
 }
 
 /**
- *  Delete all the availabilities.
+ *  Get the progress of the rebuild.
+ *
+ *  @return  A description of the rebuild in progress, empty if none.
  */
-void availability_thread::_delete_all_availabilities() {
-  log_v2::bam()->debug("BAM-BI: availability thread deleting availabilities");
-
-  // Prepare the query.
-  std::string query_str(fmt::format(
-      "DELETE FROM mod_bam_reporting_ba_availabilities WHERE ba_id IN ({})",
-      _bas_to_rebuild));
-
-  _mysql->run_query(query_str, database::mysql_error::delete_availabilities);
+std::string availability_thread::get_progress() const {
+  std::lock_guard<std::mutex> lock(_progress_m);
+  return _progress;
 }
 
 /**
@@ -178,63 +199,29 @@ void availability_thread::_build_availabilities(time_t midnight) {
   std::string query_str;
   int thread_id;
 
-  // Get the first day of rebuilding. If a complete rebuilding was asked,
-  // it's the day of the chronogically first event to rebuild.
-  // If not, it's the day following the chronogically last availability.
-  if (_should_rebuild_all) {
-    query_str = fmt::format(
-        "SELECT MIN(start_time), MAX(end_time), MIN(IFNULL(end_time, '0'))"
-        "  FROM mod_bam_reporting_ba_events"
-        "  WHERE ba_id IN ({})",
-        _bas_to_rebuild);
-    try {
-      std::promise<database::mysql_result> promise;
-      thread_id = _mysql->run_query_and_get_result(query_str, &promise);
-      database::mysql_result res(promise.get_future().get());
-      if (!_mysql->fetch_row(res))
-        throw exceptions::msg() << "no events matching BAs to rebuild";
-      first_day = res.value_as_i32(0);
-      first_day = _compute_start_of_day(first_day);
-      // If there is opened events, rebuild until midnight of this day.
-      // If not, rebuild until the last closed events.
-      if (res.value_as_i32(2) != 0)
-        last_day = _compute_start_of_day(res.value_as_f64(1));
-
-      _delete_all_availabilities();
-    } catch (const std::exception& e) {
-      log_v2::bam()->error(
-          "BAM-BI: availability thread could not select the BA durations from "
-          "the reporting database: {}",
-          e.what());
-      throw exceptions::msg()
-          << "BAM-BI: availability thread could not select the BA durations "
-             "from the reporting database: "
-          << e.what();
-    }
-
-  } else {
-    query_str = "SELECT MAX(time_id) FROM mod_bam_reporting_ba_availabilities";
-    try {
-      std::promise<database::mysql_result> promise;
-      thread_id = _mysql->run_query_and_get_result(query_str, &promise);
-      database::mysql_result res(promise.get_future().get());
-      if (!_mysql->fetch_row(res)) {
-        log_v2::bam()->error("no availability in table");
-        throw exceptions::msg() << "no availability in table";
-      }
-      first_day = res.value_as_i32(0);
-      first_day =
-          time::timeperiod::add_round_days_to_midnight(first_day, 3600 * 24);
-    } catch (const std::exception& e) {
-      log_v2::bam()->error(
-          "BAM-BI: availability thread could not select the BA availabilities "
-          "from the reporting database: {}",
-          e.what());
-      throw exceptions::msg() << "BAM-BI: availability thread "
-                                 "could not select the BA availabilities "
-                                 "from the reporting database: "
-                              << e.what();
+  // Get the first day of building, the day following the chronogically
+  // last availability.
+  query_str = "SELECT MAX(time_id) FROM mod_bam_reporting_ba_availabilities";
+  try {
+    std::promise<database::mysql_result> promise;
+    thread_id = _mysql->run_query_and_get_result(query_str, &promise);
+    database::mysql_result res(promise.get_future().get());
+    if (!_mysql->fetch_row(res)) {
+      log_v2::bam()->error("no availability in table");
+      throw exceptions::msg() << "no availability in table";
     }
+    first_day = res.value_as_i32(0);
+    first_day =
+        time::timeperiod::add_round_days_to_midnight(first_day, 3600 * 24);
+  } catch (const std::exception& e) {
+    log_v2::bam()->error(
+        "BAM-BI: availability thread could not select the BA availabilities "
+        "from the reporting database: {}",
+        e.what());
+    throw exceptions::msg() << "BAM-BI: availability thread "
+                               "could not select the BA availabilities "
+                               "from the reporting database: "
+                            << e.what();
   }
 
   log_v2::bam()->debug(
@@ -250,6 +237,274 @@ void availability_thread::_build_availabilities(time_t midnight) {
   }
 }
 
+/**
+ *  @brief  Rebuild the availabilities of the BAs to rebuild.
+ *
+ *  Events of the BAs are read once, then workers build and write the
+ *  availabilities BA by BA. What was written is regularly committed and
+ *  the BAs remaining to rebuild are saved, so that the rebuild can be
+ *  resumed if it is interrupted.
+ *
+ *  This is called from the context of the availability thread.
+ *
+ *  @param[in] mignight   Midnight of today.
+ */
+void availability_thread::_rebuild_availabilities(time_t midnight) {
+  // BAs to rebuild.
+  std::vector<uint32_t> ba_ids;
+  std::list<std::string> ids(misc::string::split(_bas_to_rebuild, ','));
+  for (std::string& id : ids) {
+    try {
+      ba_ids.push_back(std::stoul(misc::string::trim(id)));
+    } catch (std::exception const& e) {
+      log_v2::bam()->error("BAM-BI: invalid BA id '{}' to rebuild", id);
+    }
+  }
+  if (ba_ids.empty()) {
+    _save_rebuild_state("");
+    return;
+  }
+
+  _set_progress("rebuilding availabilities: loading BA events");
+
+  // Get the days to rebuild: from the day of the chronogically first event
+  // to today if some events are opened, to the day of the last event
+  // otherwise.
+  time_t first_day = 0;
+  time_t last_day = midnight;
+  try {
+    std::string query_str(fmt::format(
+        "SELECT MIN(start_time), MAX(end_time), MIN(IFNULL(end_time, '0'))"
+        "  FROM mod_bam_reporting_ba_events"
+        "  WHERE ba_id IN ({})",
+        _bas_to_rebuild));
+    std::promise<database::mysql_result> promise;
+    _mysql->run_query_and_get_result(query_str, &promise);
+    database::mysql_result res(promise.get_future().get());
+    if (!_mysql->fetch_row(res))
+      throw exceptions::msg() << "no events matching BAs to rebuild";
+    first_day = _compute_start_of_day(res.value_as_i32(0));
+    if (res.value_as_i32(2) != 0)
+      last_day = _compute_start_of_day(res.value_as_f64(1));
+  } catch (const std::exception& e) {
+    log_v2::bam()->error(
+        "BAM-BI: availability thread could not select the BA durations from "
+        "the reporting database: {}",
+        e.what());
+    throw exceptions::msg()
+        << "BAM-BI: availability thread could not select the BA durations "
+           "from the reporting database: "
+        << e.what();
+  }
+
+  // Read the events of all the BAs at once.
+  _histories.clear();
+  for (uint32_t ba_id : ba_ids)
+    _histories.emplace(ba_id, availability_history(ba_id));
+  try {
+    std::string query(fmt::format(
+        "SELECT b.ba_id, a.start_time, a.end_time, a.timeperiod_id, "
+        "a.timeperiod_is_default, b.status, b.in_downtime FROM "
+        "mod_bam_reporting_ba_events_durations AS a INNER JOIN "
+        "mod_bam_reporting_ba_events AS b ON a.ba_event_id=b.ba_event_id AND "
+        "b.end_time IS NOT NULL WHERE a.end_time>={} AND b.ba_id IN ({})",
+        first_day, _bas_to_rebuild));
+    std::promise<database::mysql_result> promise;
+    _mysql->run_query_and_get_result(query, &promise);
+    database::mysql_result res(promise.get_future().get());
+    while (_mysql->fetch_row(res)) {
+      auto found = _histories.find(res.value_as_u32(0));
+      if (found != _histories.end())
+        found->second.add_closed_event(res.value_as_i32(5),    // Status
+                                       res.value_as_i32(1),    // Start time
+                                       res.value_as_i32(2),    // End time
+                                       res.value_as_bool(6),   // In downtime
+                                       res.value_as_u32(3),    // Timeperiod
+                                       res.value_as_bool(4));  // Is default
+    }
+
+    query = fmt::format(
+        "SELECT ba_id, start_time, status, in_downtime FROM "
+        "mod_bam_reporting_ba_events WHERE end_time IS NULL AND "
+        "ba_id IN ({})",
+        _bas_to_rebuild);
+    std::promise<database::mysql_result> promise_opened;
+    _mysql->run_query_and_get_result(query, &promise_opened);
+    database::mysql_result res_opened(promise_opened.get_future().get());
+    while (_mysql->fetch_row(res_opened)) {
+      auto found = _histories.find(res_opened.value_as_u32(0));
+      if (found != _histories.end())
+        found->second.add_opened_event(
+            res_opened.value_as_i32(2),    // Status
+            res_opened.value_as_i32(1),    // Start time
+            res_opened.value_as_bool(3));  // In downtime
+    }
+  } catch (const std::exception& e) {
+    _histories.clear();
+    throw exceptions::msg()
+        << "BAM-BI: availability thread could not read the BA events: "
+        << e.what();
+  }
+
+  size_t workers(std::max(1u, std::thread::hardware_concurrency()));
+  if (workers > ba_ids.size())
+    workers = ba_ids.size();
+  log_v2::bam()->info(
+      "BAM-BI: availability thread rebuilding availabilities of {} BAs from "
+      "{} to {} with {} workers",
+      ba_ids.size(), first_day, last_day, workers);
+
+  _rebuild_next = 0;
+  _rebuilt.clear();
+  _running_workers = workers;
+  _rebuild_error = std::exception_ptr();
+  _rebuild_interrupted = false;
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < workers; ++i)
+    threads.emplace_back(&availability_thread::_rebuild_worker, this,
+                         std::cref(ba_ids), first_day, last_day,
+                         static_cast<int>(i % _mysql->connections_count()));
+
+  // Commit what the workers wrote and save what remains to do.
+  std::set<uint32_t> remaining(ba_ids.begin(), ba_ids.end());
+  {
+    std::unique_lock<std::mutex> lock(_rebuild_m);
+    for (;;) {
+      bool finished(_rebuild_cv.wait_for(lock, std::chrono::seconds(1),
+                                         [this] {
+                                           return _running_workers == 0;
+                                         }));
+      std::vector<uint32_t> rebuilt;
+      rebuilt.swap(_rebuilt);
+      lock.unlock();
+      if (!rebuilt.empty()) {
+        try {
+          _mysql->commit();
+          for (uint32_t ba_id : rebuilt)
+            remaining.erase(ba_id);
+          _save_rebuild_state(fmt::format("{}", fmt::join(remaining, ",")));
+        } catch (std::exception const& e) {
+          log_v2::bam()->error(
+              "BAM-BI: availability thread could not commit availabilities: "
+              "{}",
+              e.what());
+          std::lock_guard<std::mutex> lck(_rebuild_m);
+          if (!_rebuild_error)
+            _rebuild_error = std::current_exception();
+        }
+        std::string progress(
+            fmt::format("rebuilding availabilities: {}/{} BAs",
+                        ba_ids.size() - remaining.size(), ba_ids.size()));
+        log_v2::bam()->info("BAM-BI: {}", progress);
+        _set_progress(progress);
+      }
+      lock.lock();
+      if (finished)
+        break;
+    }
+  }
+  for (std::thread& t : threads)
+    t.join();
+  _histories.clear();
+  _set_progress("");
+
+  if (_rebuild_error)
+    std::rethrow_exception(_rebuild_error);
+  if (!remaining.empty())
+    throw exceptions::msg() << "BAM-BI: availabilities rebuild interrupted, "
+                            << remaining.size() << " BAs remaining";
+  log_v2::bam()->info("BAM-BI: availabilities rebuild finished");
+}
+
+/**
+ *  Rebuild availabilities, BA after BA, until there is nothing left to do.
+ *  This is called from the context of a worker of the rebuild.
+ *
+ *  @param[in] ba_ids     The BAs to rebuild.
+ *  @param[in] first_day  Midnight of the first day to build.
+ *  @param[in] last_day   Midnight of the day following the last day.
+ *  @param[in] thread_id  The database connection of the worker.
+ */
+void availability_thread::_rebuild_worker(std::vector<uint32_t> const& ba_ids,
+                                          time_t first_day,
+                                          time_t last_day,
+                                          int thread_id) {
+  try {
+    // Caches of the timeperiods are not shared with other workers.
+    timeperiod_map tps(_shared_tps.clone());
+    std::string query;
+    size_t rows = 0;
+    auto flush = [&]() {
+      if (rows) {
+        _mysql->run_query(query, database::mysql_error::insert_availability,
+                          true, thread_id);
+        query.clear();
+        rows = 0;
+      }
+    };
+
+    for (;;) {
+      uint32_t ba_id;
+      {
+        std::lock_guard<std::mutex> lock(_rebuild_m);
+        if (_rebuild_error || _rebuild_interrupted ||
+            _rebuild_next >= ba_ids.size())
+          break;
+        ba_id = ba_ids[_rebuild_next++];
+      }
+
+      _mysql->run_query(
+          fmt::format("DELETE FROM mod_bam_reporting_ba_availabilities WHERE "
+                      "ba_id={}",
+                      ba_id),
+          database::mysql_error::delete_availabilities, true, thread_id);
+
+      auto found = _histories.find(ba_id);
+      if (found != _histories.end())
+        found->second.build(
+            first_day, last_day, tps,
+            [&](time_t day_start, uint32_t timeperiod_id,
+                availability_builder const& builder) {
+              if (!rows)
+                query =
+                    "INSERT INTO mod_bam_reporting_ba_availabilities "
+                    "(ba_id, time_id, timeperiod_id, timeperiod_is_default,"
+                    " available, unavailable, degraded,"
+                    " unknown, downtime, alert_unavailable_opened,"
+                    " alert_degraded_opened, alert_unknown_opened,"
+                    " nb_downtime) VALUES ";
+              else
+                query.push_back(',');
+              query.append(fmt::format(
+                  "({},{},{},{},{},{},{},{},{},{},{},{},{})", ba_id, day_start,
+                  timeperiod_id, builder.get_timeperiod_is_default(),
+                  builder.get_available(), builder.get_unavailable(),
+                  builder.get_degraded(), builder.get_unknown(),
+                  builder.get_downtime(), builder.get_unavailable_opened(),
+                  builder.get_degraded_opened(), builder.get_unknown_opened(),
+                  builder.get_downtime_opened()));
+              if (++rows >= _bulk_size)
+                flush();
+            });
+      flush();
+
+      std::lock_guard<std::mutex> lock(_rebuild_m);
+      _rebuilt.push_back(ba_id);
+    }
+  } catch (std::exception const& e) {
+    log_v2::bam()->error(
+        "BAM-BI: availability thread could not rebuild availabilities: {}",
+        e.what());
+    std::lock_guard<std::mutex> lock(_rebuild_m);
+    if (!_rebuild_error)
+      _rebuild_error = std::current_exception();
+  }
+
+  std::lock_guard<std::mutex> lock(_rebuild_m);
+  --_running_workers;
+  _rebuild_cv.notify_all();
+}
+
 /**
  *  @brief  Build all the availabilities of a day.
  *
@@ -272,11 +527,8 @@ void availability_thread::_build_daily_availabilities(int thread_id,
       "a.sla_duration, a.timeperiod_id, a.timeperiod_is_default, b.status, "
       "b.in_downtime FROM mod_bam_reporting_ba_events_durations AS a INNER "
       "JOIN mod_bam_reporting_ba_events AS b ON a.ba_event_id=b.ba_event_id "
-      "AND b.end_time IS NOT NULL WHERE a.start_time<{} AND a.end_time>={} "
-      "{}",
-      day_end, day_start,
-      _should_rebuild_all ? fmt::format("AND b.ba_id IN({})", _bas_to_rebuild)
-                          : ""));
+      "AND b.end_time IS NOT NULL WHERE a.start_time<{} AND a.end_time>={}",
+      day_end, day_start));
 
   std::promise<database::mysql_result> promise;
   _mysql->run_query_and_get_result(query, &promise, thread_id);
@@ -330,10 +582,8 @@ void availability_thread::_build_daily_availabilities(int thread_id,
   query = fmt::format(
       "SELECT ba_event_id,ba_id,start_time,end_time,status,"
       "in_downtime FROM mod_bam_reporting_ba_events WHERE start_time<{} AND "
-      "end_time IS NULL {}",
-      day_end,
-      _should_rebuild_all ? fmt::format("AND ba_id IN ({})", _bas_to_rebuild)
-                          : "");
+      "end_time IS NULL",
+      day_end);
 
   promise = std::promise<database::mysql_result>();
   _mysql->run_query_and_get_result(query, &promise, thread_id);
@@ -472,3 +722,70 @@ void availability_thread::_close_database() {
     _mysql.reset();
   }
 }
+
+/**
+ *  Get the path of the file containing the BAs remaining to rebuild.
+ *
+ *  @return  The path of the file.
+ */
+std::string availability_thread::_rebuild_state_file() const {
+  return fmt::format("{}.bam.availabilities_rebuild",
+                     config::applier::state::instance().cache_dir());
+}
+
+/**
+ *  Load the BAs of an interrupted rebuild.
+ */
+void availability_thread::_load_rebuild_state() {
+  std::ifstream ifs(_rebuild_state_file());
+  std::string bas_to_rebuild;
+  if (ifs.is_open() && std::getline(ifs, bas_to_rebuild) &&
+      !misc::string::trim(bas_to_rebuild).empty()) {
+    log_v2::bam()->info(
+        "BAM-BI: availability thread resuming the rebuild of BAs {}",
+        bas_to_rebuild);
+    _should_rebuild_all = true;
+    _bas_to_rebuild = bas_to_rebuild;
+  }
+}
+
+/**
+ *  Save the BAs remaining to rebuild.
+ *
+ *  @param[in] bas_to_rebuild  The BAs to rebuild, nothing left if empty.
+ */
+void availability_thread::_save_rebuild_state(
+    std::string const& bas_to_rebuild) const {
+  std::string path(_rebuild_state_file());
+  if (bas_to_rebuild.empty()) {
+    ::remove(path.c_str());
+    return;
+  }
+
+  // Replace the file at once to never leave a truncated list.
+  std::string tmp(path + ".tmp");
+  {
+    std::ofstream ofs(tmp, std::ios::trunc);
+    ofs << bas_to_rebuild << "\n";
+    if (!ofs.good()) {
+      log_v2::bam()->error(
+          "BAM-BI: availability thread could not write rebuild state to '{}'",
+          tmp);
+      return;
+    }
+  }
+  if (::rename(tmp.c_str(), path.c_str()))
+    log_v2::bam()->error(
+        "BAM-BI: availability thread could not write rebuild state to '{}'",
+        path);
+}
+
+/**
+ *  Set the progress of the rebuild.
+ *
+ *  @param[in] progress  A description of the rebuild in progress.
+ */
+void availability_thread::_set_progress(std::string const& progress) {
+  std::lock_guard<std::mutex> lock(_progress_m);
+  _progress = progress;
+}
@@ -38,37 +38,6 @@ auto normalize = [](double d) -> double {
   return (d);
 };
 
-auto _num_kpi_in_dt =
-    [](std::unordered_map<kpi*, bam::ba::impact_info>& imp) -> bool {
-  std::size_t num{0};
-
-  for (std::unordered_map<kpi*, ba::impact_info>::const_iterator
-           it = imp.begin(),
-           end = imp.end();
-       it != end; ++it) {
-    if (!it->first->ok_state() && !it->first->in_downtime()) {
-      num++;
-    }
-  }
-
-  return num;
-};
-
-auto _every_kpi_in_dt = [](std::unordered_map<kpi*, bam::ba::impact_info>& imp,
-                           bool look_for_state = true) -> bool {
-  if (imp.empty())
-    return false;
-
-  for (auto it = imp.begin(), end = imp.end(); it != end; ++it) {
-    if ((look_for_state && it->first->ok_state()) ||
-        !it->first->in_downtime()) {
-      return false;
-    }
-  }
-
-  return true;
-};
-
 /**
  *  Constructor.
  *
@@ -89,6 +58,8 @@ ba::ba(bool generate_virtual_status)
       _generate_virtual_status(generate_virtual_status),
       _host_id(0),
       _id(0),
+      _num_kpi_in_dt(0),
+      _num_kpi_not_ok_out_of_dt(0),
       _in_downtime(false),
       _last_kpi_update(0),
       _level_critical(0.0),
@@ -113,6 +84,8 @@ void ba::add_impact(std::shared_ptr<kpi> const& impact) {
     impact->impact_hard(ii.hard_impact);
     impact->impact_soft(ii.soft_impact);
     ii.in_downtime = impact->in_downtime();
+    ii.ok_state = impact->ok_state();
+    _count_impact(ii, 1);
     _apply_impact(impact.get(), ii);
     timestamp last_state_change(impact->get_last_state_change());
     if (last_state_change.get_time_t() != (time_t)-1)
@@ -139,9 +112,10 @@ bool ba::child_has_update(computable* child, io::stream* visitor) {
     it->second.kpi_ptr->impact_hard(new_hard_impact);
     it->second.kpi_ptr->impact_soft(new_soft_impact);
     bool kpi_in_downtime(it->second.kpi_ptr->in_downtime());
+    bool kpi_ok_state(it->second.kpi_ptr->ok_state());
 
     // Logging.
-    logging::debug(logging::low)
+    LOGGING_DEBUG(logging::low)
         << "BAM: BA " << _id << " is getting notified of child update (KPI "
         << it->second.kpi_ptr->get_id() << ", impact "
         << new_hard_impact.get_nominal() << ", last state change "
@@ -150,7 +124,8 @@ bool ba::child_has_update(computable* child, io::stream* visitor) {
     // If the new impact is the same as the old, don't update.
     if (it->second.hard_impact == new_hard_impact &&
         it->second.soft_impact == new_soft_impact &&
-        it->second.in_downtime == kpi_in_downtime)
+        it->second.in_downtime == kpi_in_downtime &&
+        it->second.ok_state == kpi_ok_state)
       return (false);
     timestamp last_state_change(it->second.kpi_ptr->get_last_state_change());
     if (last_state_change.get_time_t() != (time_t)-1)
@@ -158,12 +133,15 @@ bool ba::child_has_update(computable* child, io::stream* visitor) {
                                   last_state_change.get_time_t());
 
     // Discard old data.
+    _count_impact(it->second, -1);
     _unapply_impact(it->first, it->second);
 
     // Apply new data.
     it->second.hard_impact = new_hard_impact;
     it->second.soft_impact = new_soft_impact;
     it->second.in_downtime = kpi_in_downtime;
+    it->second.ok_state = kpi_ok_state;
+    _count_impact(it->second, 1);
     _apply_impact(it->first, it->second);
 
     // Check for inherited downtimes.
@@ -332,7 +310,7 @@ ba::state ba::get_state_hard() {
   else if (_state_source == configuration::ba::state_source_best ||
            _state_source == configuration::ba::state_source_worst) {
     if (_dt_behaviour == configuration::ba::dt_ignore_kpi &&
-        _every_kpi_in_dt(_impacts, false))
+        !_impacts.empty() && _num_kpi_in_dt == _impacts.size())
       state = impact_values::state_ok;
     else
       state = _computed_hard_state;
@@ -407,6 +385,7 @@ void ba::remove_impact(std::shared_ptr<kpi> const& impact) {
   std::unordered_map<kpi*, impact_info>::iterator it(
       _impacts.find(impact.get()));
   if (it != _impacts.end()) {
+    _count_impact(it->second, -1);
     _unapply_impact(it->first, it->second);
     _impacts.erase(it);
   }
@@ -554,7 +533,7 @@ void ba::visit(io::stream* visitor) {
       status->level_nominal = normalize(_level_hard);
       status->state = hard_state;
       status->state_changed = state_changed;
-      logging::debug(logging::low)
+      LOGGING_DEBUG(logging::low)
           << "BAM: generating status of BA " << status->ba_id << " (state "
           << status->state << ", in downtime " << status->in_downtime
           << ", level " << status->level_nominal << ")";
@@ -629,7 +608,7 @@ void ba::service_update(std::shared_ptr<neb::downtime> const& dt,
   (void)visitor;
   if ((dt->host_id == _host_id) && (dt->service_id == _service_id)) {
     // Log message.
-    logging::debug(logging::low)
+    LOGGING_DEBUG(logging::low)
         << "BAM: BA " << _id
         << " is getting notified of a downtime on its service (" << _host_id
         << ", " << _service_id << ")";
@@ -746,6 +725,20 @@ void ba::_apply_impact(kpi* kpi_ptr __attribute__((unused)),
   }
 }
 
+/**
+ *  Count a KPI in the downtime counters, so that inherited downtimes are
+ *  decided without going through every KPI.
+ *
+ *  @param[in] impact  Impact information.
+ *  @param[in] sign    1 to count the KPI, -1 to discount it.
+ */
+void ba::_count_impact(ba::impact_info const& impact, int sign) {
+  if (impact.in_downtime)
+    _num_kpi_in_dt += sign;
+  else if (!impact.ok_state)
+    _num_kpi_not_ok_out_of_dt += sign;
+}
+
 /**
  *  Open a new event for this BA.
  *
@@ -856,16 +849,8 @@ void ba::_compute_inherited_downtime(io::stream* visitor) {
     return;
 
   // Check if every impacting child KPIs are in downtime.
-  bool every_kpi_in_downtime(!_impacts.empty());
-  for (std::unordered_map<kpi*, impact_info>::const_iterator
-           it = _impacts.begin(),
-           end = _impacts.end();
-       it != end; ++it) {
-    if (!it->first->ok_state() && !it->first->in_downtime()) {
-      every_kpi_in_downtime = false;
-      break;
-    }
-  }
+  bool every_kpi_in_downtime(!_impacts.empty() &&
+                             !_num_kpi_not_ok_out_of_dt);
 
   // Case 1: state not ok, every child in downtime, no actual downtime.
   //         Put the BA in downtime.
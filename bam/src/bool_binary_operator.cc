@@ -141,6 +141,24 @@ void bool_binary_operator::set_right(std::shared_ptr<bool_value> const& right) {
   return;
 }
 
+/**
+ *  Get left member.
+ *
+ *  @return Left member of the boolean operator.
+ */
+std::shared_ptr<bool_value> const& bool_binary_operator::get_left() const {
+  return _left;
+}
+
+/**
+ *  Get right member.
+ *
+ *  @return Right member of the boolean operator.
+ */
+std::shared_ptr<bool_value> const& bool_binary_operator::get_right() const {
+  return _right;
+}
+
 /**
  *  Copy internal data members.
  *
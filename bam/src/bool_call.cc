@@ -103,6 +103,15 @@ std::string const& bool_call::get_name() const {
   return (_name);
 }
 
+/**
+ *  Get expression.
+ *
+ *  @return  The called expression, null if not resolved.
+ */
+std::shared_ptr<bool_value> const& bool_call::get_expression() const {
+  return _expression;
+}
+
 /**
  *  Set expression.
  *
@@ -51,8 +51,8 @@ bool bool_expression::child_has_update(computable* child, io::stream* visitor) {
   // class, as the bool_* classes already cache most of them.
   if (child == _expression.get()) {
     // Logging.
-    logging::debug(logging::low) << "BAM: boolean expression " << _id
-                                 << " is getting notified of child update";
+    LOGGING_DEBUG(logging::low) << "BAM: boolean expression " << _id
+                                << " is getting notified of child update";
   }
   return (true);
 }
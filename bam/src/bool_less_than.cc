@@ -74,3 +74,12 @@ double bool_less_than::value_hard() {
 double bool_less_than::value_soft() {
   return (_strict ? _left_soft < _right_soft : _left_soft <= _right_soft);
 }
+
+/**
+ *  Check if the comparison is strict.
+ *
+ *  @return True if equal values do not match.
+ */
+bool bool_less_than::is_strict() const {
+  return _strict;
+}
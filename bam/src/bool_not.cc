@@ -83,6 +83,15 @@ void bool_not::set_value(std::shared_ptr<bool_value>& value) {
   return;
 }
 
+/**
+ *  Get the negated value.
+ *
+ *  @return The negated value.
+ */
+bool_value::ptr const& bool_not::get_value() const {
+  return _value;
+}
+
 /**
  *  Get the hard value.
  *
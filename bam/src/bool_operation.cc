@@ -142,3 +142,12 @@ bool bool_operation::state_known() const {
   else
     return (known);
 }
+
+/**
+ *  Get the operation type.
+ *
+ *  @return The operation type.
+ */
+bool_operation::operation_type bool_operation::get_type() const {
+  return _type;
+}
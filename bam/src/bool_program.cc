@@ -0,0 +1,481 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#include "com/centreon/broker/bam/bool_program.hh"
+
+#include <cmath>
+
+#include "com/centreon/broker/bam/bool_and.hh"
+#include "com/centreon/broker/bam/bool_call.hh"
+#include "com/centreon/broker/bam/bool_constant.hh"
+#include "com/centreon/broker/bam/bool_equal.hh"
+#include "com/centreon/broker/bam/bool_less_than.hh"
+#include "com/centreon/broker/bam/bool_more_than.hh"
+#include "com/centreon/broker/bam/bool_not.hh"
+#include "com/centreon/broker/bam/bool_not_equal.hh"
+#include "com/centreon/broker/bam/bool_operation.hh"
+#include "com/centreon/broker/bam/bool_or.hh"
+#include "com/centreon/broker/bam/bool_xor.hh"
+
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::bam;
+
+/**
+ *  Compiled operand: the register holding its value and what is known of
+ *  it at compile time.
+ */
+struct bool_program::operand {
+  uint32_t reg;
+  bool constant;
+};
+
+/**
+ *  Check if a subtree contains a division or a modulo, these are the only
+ *  operators whose state can be unknown when their inputs are known.
+ *  Such subtrees must never be skipped.
+ *
+ *  @param[in] node  Subtree root.
+ *
+ *  @return True if the subtree can be unknown.
+ */
+static bool may_be_unknown(bool_value* node) {
+  if (bool_not* n = dynamic_cast<bool_not*>(node))
+    return may_be_unknown(n->get_value().get());
+  if (bool_operation* o = dynamic_cast<bool_operation*>(node))
+    if (o->get_type() == bool_operation::division ||
+        o->get_type() == bool_operation::modulo)
+      return true;
+  if (bool_binary_operator* b = dynamic_cast<bool_binary_operator*>(node))
+    return may_be_unknown(b->get_left().get()) ||
+           may_be_unknown(b->get_right().get());
+  return false;
+}
+
+/**
+ *  Get the opcode of a binary operator.
+ *
+ *  @param[in]  node  Operator.
+ *  @param[out] op    Its opcode.
+ *
+ *  @return False if the operator is not known of the compiler.
+ */
+static bool binary_opcode(bool_binary_operator* node,
+                          bool_program::opcode& op) {
+  if (dynamic_cast<bool_and*>(node))
+    op = bool_program::op_and;
+  else if (dynamic_cast<bool_or*>(node))
+    op = bool_program::op_or;
+  else if (dynamic_cast<bool_xor*>(node))
+    op = bool_program::op_xor;
+  else if (dynamic_cast<bool_equal*>(node))
+    op = bool_program::op_equal;
+  else if (dynamic_cast<bool_not_equal*>(node))
+    op = bool_program::op_not_equal;
+  else if (bool_more_than* m = dynamic_cast<bool_more_than*>(node))
+    op = m->is_strict() ? bool_program::op_more : bool_program::op_more_equal;
+  else if (bool_less_than* l = dynamic_cast<bool_less_than*>(node))
+    op = l->is_strict() ? bool_program::op_less : bool_program::op_less_equal;
+  else if (bool_operation* o = dynamic_cast<bool_operation*>(node)) {
+    switch (o->get_type()) {
+      case bool_operation::addition:
+        op = bool_program::op_add;
+        break;
+      case bool_operation::substraction:
+        op = bool_program::op_sub;
+        break;
+      case bool_operation::multiplication:
+        op = bool_program::op_mul;
+        break;
+      case bool_operation::division:
+        op = bool_program::op_div;
+        break;
+      case bool_operation::modulo:
+        op = bool_program::op_mod;
+        break;
+      default:
+        return false;
+    }
+  } else
+    return false;
+  return true;
+}
+
+/**
+ *  Apply an operator, the same way the bool_* classes do.
+ *
+ *  @param[in]  op       Operator.
+ *  @param[in]  l        Left value.
+ *  @param[in]  r        Right value.
+ *  @param[out] unknown  Set to true if the result is unknown.
+ *
+ *  @return The result.
+ */
+static double apply(bool_program::opcode op,
+                    double l,
+                    double r,
+                    bool& unknown) {
+  switch (op) {
+    case bool_program::op_not:
+      return !l;
+    case bool_program::op_and:
+      return l && r;
+    case bool_program::op_or:
+      return l || r;
+    case bool_program::op_xor:
+      return (!l && r) || (l && !r);
+    case bool_program::op_equal:
+      return (std::fabs(l - r) < COMPARE_EPSILON) ? 1.0 : 0.0;
+    case bool_program::op_not_equal:
+      return (std::fabs(l - r) >= COMPARE_EPSILON) ? 1.0 : 0.0;
+    case bool_program::op_more:
+      return l > r;
+    case bool_program::op_more_equal:
+      return l >= r;
+    case bool_program::op_less:
+      return l < r;
+    case bool_program::op_less_equal:
+      return l <= r;
+    case bool_program::op_add:
+      return l + r;
+    case bool_program::op_sub:
+      return l - r;
+    case bool_program::op_mul:
+      return l * r;
+    case bool_program::op_div:
+      if (std::fabs(r) < COMPARE_EPSILON) {
+        unknown = true;
+        return NAN;
+      }
+      return l / r;
+    case bool_program::op_mod: {
+      if (std::fabs(r) < COMPARE_EPSILON)
+        unknown = true;
+      long long left_val(static_cast<long long>(l));
+      long long right_val(static_cast<long long>(r));
+      if (right_val == 0)
+        return NAN;
+      return left_val % right_val;
+    }
+    default:
+      return NAN;
+  }
+}
+
+/**
+ *  Constructor. Use compile() to get a program correctly plugged in the
+ *  BAM graph.
+ *
+ *  @param[in] tree  Expression to compile.
+ */
+bool_program::bool_program(bool_value::ptr const& tree)
+    : _result(0),
+      _unknown_inputs(0),
+      _inputs_in_downtime(0),
+      _value_hard(0.0),
+      _value_soft(0.0),
+      _state_known(false) {
+  _result = _compile(tree, bool_value::ptr()).reg;
+  _evaluate();
+}
+
+/**
+ *  Destructor.
+ */
+bool_program::~bool_program() {}
+
+/**
+ *  Compile an expression. Inputs of the expression are unplugged from
+ *  the operator nodes and plugged to the program.
+ *
+ *  @param[in] tree  Expression to compile.
+ *
+ *  @return The compiled expression, or the tree itself if there is no
+ *          operator to compile.
+ */
+bool_value::ptr bool_program::compile(bool_value::ptr const& tree) {
+  if (!dynamic_cast<bool_not*>(tree.get()) &&
+      !dynamic_cast<bool_binary_operator*>(tree.get()))
+    return tree;
+  bool_program::ptr retval(new bool_program(tree));
+  for (bool_value::ptr const& in : retval->_owned_inputs)
+    in->add_parent(retval);
+  return retval;
+}
+
+/**
+ *  Get notified of an input update.
+ *
+ *  @param[in] child    Updated input.
+ *  @param[in] visitor  Unused.
+ *
+ *  @return True if the value of the expression changed.
+ */
+bool bool_program::child_has_update(computable* child, io::stream* visitor) {
+  (void)visitor;
+  for (input& in : _inputs)
+    if (in.value == child && !in.call)
+      _read_input(in);
+
+  double old_hard(_value_hard);
+  double old_soft(_value_soft);
+  bool old_known(_state_known);
+  _evaluate();
+  // NaN values are never equal, they are reported as changes.
+  return _value_hard != old_hard || _value_soft != old_soft ||
+         _state_known != old_known;
+}
+
+/**
+ *  Get the hard value.
+ *
+ *  @return Evaluation of the expression with hard values.
+ */
+double bool_program::value_hard() {
+  return _value_hard;
+}
+
+/**
+ *  Get the soft value.
+ *
+ *  @return Evaluation of the expression with soft values.
+ */
+double bool_program::value_soft() {
+  return _value_soft;
+}
+
+/**
+ *  Get if the state is known, i.e has been computed at least once.
+ *
+ *  @return  True if the state is known.
+ */
+bool bool_program::state_known() const {
+  return _state_known;
+}
+
+/**
+ *  Is this expression in downtime?
+ *
+ *  @return  True if one of the inputs is in downtime.
+ */
+bool bool_program::in_downtime() const {
+  return _inputs_in_downtime > 0;
+}
+
+/**
+ *  Get the compiled code.
+ *
+ *  @return The instructions of the program.
+ */
+std::vector<bool_program::instruction> const& bool_program::get_code() const {
+  return _code;
+}
+
+/**
+ *  Get the number of inputs.
+ *
+ *  @return The number of inputs of the program.
+ */
+size_t bool_program::get_inputs_count() const {
+  return _inputs.size();
+}
+
+/**
+ *  Compile a node.
+ *
+ *  @param[in] node    Node to compile.
+ *  @param[in] parent  Parent of the node in the tree.
+ *
+ *  @return The operand holding the node value.
+ */
+bool_program::operand bool_program::_compile(bool_value::ptr const& node,
+                                             bool_value::ptr const& parent) {
+  operand retval;
+  retval.constant = false;
+
+  if (bool_constant* c = dynamic_cast<bool_constant*>(node.get())) {
+    retval.reg = _add_register(c->value_hard());
+    retval.constant = true;
+  } else if (bool_not* n = dynamic_cast<bool_not*>(node.get())) {
+    operand arg(_compile(n->get_value(), node));
+    if (arg.constant) {
+      bool unknown(false);
+      retval.reg = _add_register(apply(op_not, _hard[arg.reg], 0.0, unknown));
+      retval.constant = true;
+    } else {
+      retval.reg = _add_register();
+      _code.push_back({op_not, retval.reg, arg.reg, 0});
+    }
+  } else if (bool_binary_operator* b =
+                 dynamic_cast<bool_binary_operator*>(node.get())) {
+    opcode op;
+    if (!binary_opcode(b, op)) {
+      retval.reg = _add_input(node, parent);
+      return retval;
+    }
+    operand left(_compile(b->get_left(), node));
+
+    // AND/OR: the right member is skipped when the left one decides.
+    if ((op == op_and || op == op_or) &&
+        !may_be_unknown(b->get_right().get())) {
+      bool decisive(op == op_or);
+      if (left.constant && (_hard[left.reg] != 0.0) == decisive) {
+        // The right member is still compiled for its inputs.
+        size_t code_size(_code.size());
+        _compile(b->get_right(), node);
+        _code.resize(code_size);
+        retval.reg = _add_register(decisive ? 1.0 : 0.0);
+        retval.constant = true;
+        return retval;
+      }
+      retval.reg = _add_register();
+      size_t jump(_code.size());
+      if (!left.constant)
+        _code.push_back({op == op_and ? op_jump_if_false : op_jump_if_true,
+                         retval.reg, left.reg, 0});
+      operand right(_compile(b->get_right(), node));
+      _code.push_back({op, retval.reg, left.reg, right.reg});
+      if (!left.constant)
+        _code[jump].b = _code.size();
+      return retval;
+    }
+
+    operand right(_compile(b->get_right(), node));
+    bool unknown(false);
+    double folded(0.0);
+    if (left.constant && right.constant)
+      folded = apply(op, _hard[left.reg], _hard[right.reg], unknown);
+    if (left.constant && right.constant && !unknown) {
+      retval.reg = _add_register(folded);
+      retval.constant = true;
+    } else {
+      retval.reg = _add_register();
+      _code.push_back({op, retval.reg, left.reg, right.reg});
+    }
+  } else
+    retval.reg = _add_input(node, parent);
+  return retval;
+}
+
+/**
+ *  Add an input to the program.
+ *
+ *  @param[in] node    Input.
+ *  @param[in] parent  Parent of the input in the tree, it will not be
+ *                     notified anymore.
+ *
+ *  @return The register of the input.
+ */
+uint32_t bool_program::_add_input(bool_value::ptr const& node,
+                                  bool_value::ptr const& parent) {
+  if (parent)
+    node->remove_parent(parent);
+  for (input const& in : _inputs)
+    if (in.value == node.get())
+      return in.reg;
+
+  input in;
+  in.value = node.get();
+  in.reg = _add_register();
+  in.known = true;
+  in.in_downtime = false;
+  in.call = dynamic_cast<bool_call*>(node.get()) != nullptr;
+  _read_input(in);
+  _inputs.push_back(in);
+  _owned_inputs.push_back(node);
+  return in.reg;
+}
+
+/**
+ *  Add a register.
+ *
+ *  @param[in] value  Initial value of the register.
+ *
+ *  @return The register index.
+ */
+uint32_t bool_program::_add_register(double value) {
+  _hard.push_back(value);
+  _soft.push_back(value);
+  return _hard.size() - 1;
+}
+
+/**
+ *  Read the values of an input into its register and update the input
+ *  counters.
+ *
+ *  @param[in,out] in  Input.
+ */
+void bool_program::_read_input(input& in) {
+  _hard[in.reg] = in.value->value_hard();
+  _soft[in.reg] = in.value->value_soft();
+  bool known(in.value->state_known());
+  if (known != in.known) {
+    in.known = known;
+    known ? --_unknown_inputs : ++_unknown_inputs;
+  }
+  bool in_dt(in.value->in_downtime());
+  if (in_dt != in.in_downtime) {
+    in.in_downtime = in_dt;
+    in_dt ? ++_inputs_in_downtime : --_inputs_in_downtime;
+  }
+}
+
+/**
+ *  Evaluate the program with hard and soft values.
+ */
+void bool_program::_evaluate() {
+  for (input& in : _inputs)
+    if (in.call)
+      _read_input(in);
+  bool unknown_hard(_run(_hard));
+  bool unknown_soft(_run(_soft));
+  _value_hard = _hard[_result];
+  _value_soft = _soft[_result];
+  _state_known = !_unknown_inputs && !unknown_hard && !unknown_soft;
+}
+
+/**
+ *  Run the program on a set of registers.
+ *
+ *  @param[in,out] regs  Registers.
+ *
+ *  @return True if an operation had an unknown result.
+ */
+bool bool_program::_run(std::vector<double>& regs) const {
+  bool unknown(false);
+  size_t pc(0);
+  size_t size(_code.size());
+  while (pc < size) {
+    instruction const& i(_code[pc]);
+    if (i.op == op_jump_if_false) {
+      if (!regs[i.a]) {
+        regs[i.dst] = 0.0;
+        pc = i.b;
+        continue;
+      }
+    } else if (i.op == op_jump_if_true) {
+      if (regs[i.a]) {
+        regs[i.dst] = 1.0;
+        pc = i.b;
+        continue;
+      }
+    } else
+      regs[i.dst] = apply(i.op, regs[i.a], regs[i.b], unknown);
+    ++pc;
+  }
+  return unknown;
+}
@@ -18,14 +18,127 @@
 
 #include "com/centreon/broker/bam/computable.hh"
 
-#include <vector>
+#include <algorithm>
 
+#include "com/centreon/broker/logging/logging.hh"
+
+using namespace com::centreon::broker;
 using namespace com::centreon::broker::bam;
 
+// Deepest level accepted, this protects against cycles in the graph.
+static constexpr uint32_t max_level = 4096;
+
+thread_local computable::batch* computable::batch::_current = nullptr;
+
+/**
+ *  Constructor. The batch becomes the current batch of the thread.
+ *
+ *  @param[out] visitor  Object that will receive events.
+ */
+computable::batch::batch(io::stream* visitor)
+    : _previous(_current), _visitor(visitor), _position(0), _running(false) {
+  _current = this;
+}
+
+/**
+ *  Destructor. Dirty nodes left by an owner that did not call run(), for
+ *  example because of an exception, are recomputed as a last resort.
+ */
+computable::batch::~batch() {
+  try {
+    run();
+  } catch (std::exception const& e) {
+    logging::error(logging::high)
+        << "BAM: could not propagate updates: " << e.what();
+  }
+  _current = _previous;
+}
+
+/**
+ *  Mark the parents of an updated node as dirty.
+ *
+ *  @param[in] child  Updated node.
+ */
+void computable::batch::_add(computable* child) {
+  for (std::weak_ptr<computable> const& p : child->_parents) {
+    std::shared_ptr<computable> parent(p.lock());
+    if (!parent)
+      continue;
+    std::vector<computable*>& children(parent->_updated_children);
+    if (children.empty()) {
+      if (_levels.size() <= parent->_level)
+        _levels.resize(parent->_level + 1);
+      _levels[parent->_level].push_back(parent);
+      // Updates normally only fill upper levels, but a node updated out of
+      // the graph order must not be forgotten.
+      if (parent->_level < _position)
+        _position = parent->_level;
+    }
+    if (std::find(children.begin(), children.end(), child) == children.end())
+      children.push_back(child);
+  }
+}
+
+/**
+ *  Recompute dirty nodes, lowest levels first. Nodes modified by their
+ *  children mark their own parents dirty in upper levels. If a node fails,
+ *  the remaining dirty nodes are forgotten and the error is thrown.
+ */
+void computable::batch::run() {
+  if (_running)
+    return;
+  _running = true;
+  std::vector<computable*> children;
+  std::vector<std::shared_ptr<computable>> nodes;
+  _position = 0;
+  while (_position < _levels.size()) {
+    if (_levels[_position].empty()) {
+      ++_position;
+      continue;
+    }
+    nodes.swap(_levels[_position]);
+    try {
+      for (std::shared_ptr<computable> const& node : nodes) {
+        children.swap(node->_updated_children);
+        bool updated(false);
+        for (computable* child : children)
+          updated = node->child_has_update(child, _visitor) || updated;
+        children.clear();
+        if (updated)
+          _add(node.get());
+      }
+    } catch (...) {
+      _reset(nodes);
+      throw;
+    }
+    nodes.clear();
+  }
+  _levels.clear();
+  _running = false;
+}
+
+/**
+ *  Forget the dirty nodes after a failed propagation. Their children lists
+ *  are emptied, otherwise _add() would never queue them again.
+ *
+ *  @param[in] nodes  Nodes of the level being recomputed.
+ */
+void computable::batch::_reset(
+    std::vector<std::shared_ptr<computable>>& nodes) {
+  for (std::shared_ptr<computable> const& node : nodes)
+    node->_updated_children.clear();
+  nodes.clear();
+  for (std::vector<std::shared_ptr<computable>>& level : _levels)
+    for (std::shared_ptr<computable> const& node : level)
+      node->_updated_children.clear();
+  _levels.clear();
+  _running = false;
+}
+
 /**
  *  Default constructor.
  */
-computable::computable() {}
+computable::computable() : _level(0) {}
 
 /**
  *  Copy constructor.
@@ -61,40 +174,26 @@ computable& computable::operator=(computable const& right) {
  */
 void computable::add_parent(std::shared_ptr<computable> const& parent) {
   _parents.push_back(std::weak_ptr<computable>(parent));
-  return;
+  parent->_raise_level(_level + 1);
 }
 
 /**
  *  @brief Propagate the update of a child node.
  *
- *  This method will call the child_has_update() method of the parents
- *  of this node.
+ *  The parents of this node are marked dirty in the current batch. If no
+ *  batch is running for this visitor, a batch is created and the whole
+ *  propagation is done before returning.
  *
  *  @param[out] visitor  Object that will receive events.
  */
 void computable::propagate_update(io::stream* visitor) {
-  std::vector<bool> filter;
-  filter.resize(_parents.size());
-  uint32_t i = 0;
-  for (std::list<std::weak_ptr<computable> >::iterator it(_parents.begin()),
-       end(_parents.end());
-       it != end; ++it) {
-    std::shared_ptr<computable> ptr = it->lock();
-    if (ptr)
-      filter[i++] = ptr->child_has_update(this, visitor);
-    else
-      ++i;
+  if (batch::_current && batch::_current->_visitor == visitor)
+    batch::_current->_add(this);
+  else {
+    batch b(visitor);
+    b._add(this);
+    b.run();
   }
-  i = 0;
-  for (std::list<std::weak_ptr<computable> >::iterator it(_parents.begin()),
-       end(_parents.end());
-       it != end; ++it)
-    if (filter[i++] == true) {
-      std::shared_ptr<computable> ptr = it->lock();
-      if (ptr)
-        ptr->propagate_update(visitor);
-    }
-  return;
 }
 
 /**
@@ -103,7 +202,7 @@ void computable::propagate_update(io::stream* visitor) {
  *  @param[in] parent Parent node.
  */
 void computable::remove_parent(std::shared_ptr<computable> const& parent) {
-  for (std::list<std::weak_ptr<computable> >::iterator it(_parents.begin()),
+  for (std::vector<std::weak_ptr<computable> >::iterator it(_parents.begin()),
        end(_parents.end());
        it != end; ++it)
     if (it->lock().get() == parent.get()) {
@@ -113,6 +212,16 @@ void computable::remove_parent(std::shared_ptr<computable> const& parent) {
   return;
 }
 
+/**
+ *  Get the level of this node in the graph.
+ *
+ *  @return 0 for a leaf, a value greater than the level of each child
+ *          otherwise.
+ */
+uint32_t computable::get_level() const noexcept {
+  return _level;
+}
+
 /**
  *  Copy internal data members.
  *
@@ -120,5 +229,27 @@ void computable::remove_parent(std::shared_ptr<computable> const& parent) {
  */
 void computable::_internal_copy(computable const& right) {
   _parents = right._parents;
+  _level = right._level;
   return;
 }
+
+/**
+ *  Make sure this node and its ancestors are above the given level.
+ *
+ *  @param[in] level  Minimum level of this node.
+ */
+void computable::_raise_level(uint32_t level) {
+  if (level <= _level)
+    return;
+  if (level > max_level) {
+    logging::error(logging::high)
+        << "BAM: the BA/KPI graph is too deep, it probably contains a cycle";
+    return;
+  }
+  _level = level;
+  for (std::weak_ptr<computable> const& p : _parents) {
+    std::shared_ptr<computable> parent(p.lock());
+    if (parent)
+      parent->_raise_level(level + 1);
+  }
+}
@@ -18,6 +18,7 @@
 
 #include "com/centreon/broker/bam/bool_expression.hh"
 #include "com/centreon/broker/bam/ba.hh"
+#include "com/centreon/broker/bam/bool_program.hh"
 #include "com/centreon/broker/bam/configuration/applier/ba.hh"
 #include "com/centreon/broker/bam/configuration/applier/bool_expression.hh"
 #include "com/centreon/broker/bam/configuration/bool_expression.hh"
@@ -144,7 +145,8 @@ void applier::bool_expression::apply(
     try {
       bam::exp_parser p(it->second.get_expression());
       bam::exp_builder b(p.get_postfix(), mapping);
-      bam::bool_value::ptr tree(b.get_tree());
+      bam::bool_value::ptr tree(
+          bam::bool_program::compile(b.get_tree()));
       new_bool_exp->set_expression(tree);
       if (tree)
         tree->add_parent(
@@ -239,8 +241,18 @@ void applier::bool_expression::_resolve_expression_calls() {
             << it->second.cfg.get_name() << "'";
         break;
       } else {
-        (*call_it)->set_expression(
+        // The call is notified of the updates of the called expression,
+        // so that the expressions using it are updated too.
+        bam::bool_value::ptr expression(
             _applied[found->second].obj->get_expression());
+        bam::bool_value::ptr old((*call_it)->get_expression());
+        if (old == expression)
+          continue;
+        if (old)
+          old->remove_parent(*call_it);
+        if (expression)
+          expression->add_parent(*call_it);
+        (*call_it)->set_expression(expression);
       }
     }
   }
@@ -166,8 +166,12 @@ exp_builder::exp_builder(exp_parser::notation const& postfix,
         // Arity check.
         _check_arity("CALL()", 1, arity);
 
-        // XXX
-        _pop_string();
+        // Build object, its expression is resolved by the applier.
+        bool_call::ptr obj(new bool_call(_pop_string()));
+
+        // Store it in the operand stack and within the call list.
+        _operands.push(any_operand(obj, ""));
+        _calls.push_back(obj);
       }
       // Unsupported function.
       else
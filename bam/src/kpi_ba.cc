@@ -48,7 +48,7 @@ bool kpi_ba::child_has_update(computable* child, io::stream* visitor) {
   // the ba class already cache most of them.
   if (child == _ba.get()) {
     // Logging.
-    logging::debug(logging::low)
+    LOGGING_DEBUG(logging::low)
         << "BAM: BA KPI " << _id << " is getting notified of child update";
 
     // Generate status event.
@@ -49,8 +49,8 @@ bool kpi_boolexp::child_has_update(computable* child, io::stream* visitor) {
   // this class, as the bool_expression class already cache most of them.
   if (child == _boolexp.get()) {
     // Logging.
-    logging::debug(logging::low) << "BAM: boolean expression KPI " << _id
-                                 << " is getting notified of child update";
+    LOGGING_DEBUG(logging::low) << "BAM: boolean expression KPI " << _id
+                                << " is getting notified of child update";
 
     // Generate status event.
     visit(visitor);
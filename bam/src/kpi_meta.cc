@@ -49,8 +49,8 @@ bool kpi_meta::child_has_update(computable* child, io::stream* visitor) {
   // class, as the meta_service class already cache most of them.
   if (child == _meta.get()) {
     // Logging.
-    logging::debug(logging::low) << "BAM: meta-service KPI " << _id
-                                 << " is getting notified of child update";
+    LOGGING_DEBUG(logging::low) << "BAM: meta-service KPI " << _id
+                                << " is getting notified of child update";
 
     // Generate status event.
     visit(visitor);
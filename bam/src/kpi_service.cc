@@ -186,7 +186,7 @@ void kpi_service::service_update(
   if (status && status->host_id == _host_id &&
       status->service_id == _service_id) {
     // Log message.
-    logging::debug(logging::low)
+    LOGGING_DEBUG(logging::low)
         << "BAM: KPI " << _id << " is getting notified of service (" << _host_id
         << ", " << _service_id << ") update";
 
@@ -222,7 +222,7 @@ void kpi_service::service_update(
     io::stream* visitor) {
   if (ack && ack->host_id == _host_id && ack->service_id == _service_id) {
     // Log message.
-    logging::debug(logging::low)
+    LOGGING_DEBUG(logging::low)
         << "BAM: KPI " << _id
         << " is getting an acknowledgement event for service (" << _host_id
         << ", " << _service_id << ")";
@@ -248,7 +248,7 @@ void kpi_service::service_update(std::shared_ptr<neb::downtime> const& dt,
                                  io::stream* visitor) {
   if (dt && dt->host_id == _host_id && dt->service_id == _service_id) {
     // Log message.
-    logging::debug(logging::low)
+    LOGGING_DEBUG(logging::low)
         << "BAM: KPI " << _id << " is getting a downtime event for service ("
         << _host_id << ", " << _service_id << ")";
 
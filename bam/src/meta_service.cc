@@ -309,7 +309,7 @@ void meta_service::visit(io::stream* visitor, bool& changed_state) {
       status->value = _value;
       status->state_changed = changed_state;
       _last_state = new_state;
-      logging::debug(logging::low)
+      LOGGING_DEBUG(logging::low)
           << "BAM: generating status of meta-service "
           << status->meta_service_id << " (value " << status->value << ")";
       visitor->write(std::static_pointer_cast<io::data>(status));
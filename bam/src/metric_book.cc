@@ -18,6 +18,7 @@
 
 #include "com/centreon/broker/bam/metric_book.hh"
 
+#include "com/centreon/broker/bam/computable.hh"
 #include "com/centreon/broker/bam/metric_listener.hh"
 #include "com/centreon/broker/storage/metric.hh"
 
@@ -91,11 +92,13 @@ void metric_book::unlisten(uint32_t metric_id, metric_listener* listnr) {
  */
 void metric_book::update(std::shared_ptr<storage::metric> const& m,
                          io::stream* visitor) {
+  computable::batch b(visitor);
   std::pair<multimap::iterator, multimap::iterator> range(
       _book.equal_range(m->metric_id));
   while (range.first != range.second) {
     range.first->second->metric_update(m, visitor);
     ++range.first;
   }
+  b.run();
   return;
 }
@@ -18,6 +18,7 @@
 
 #include "com/centreon/broker/bam/monitoring_stream.hh"
 
+#include <cmath>
 #include <cstdlib>
 #include <ctime>
 #include <fstream>
@@ -78,7 +79,8 @@ monitoring_stream::monitoring_stream(std::string const& ext_cmd_file,
       _mysql(db_cfg),
       _pending_events(0),
       _storage_db_cfg(storage_db_cfg),
-      _cache(cache) {
+      _cache(cache),
+      _last_flush(time(nullptr)) {
   // Prepare queries.
   _prepare();
 
@@ -108,7 +110,7 @@ monitoring_stream::~monitoring_stream() {
  *  @return Number of acknowledged events.
  */
 int monitoring_stream::flush() {
-  _mysql.commit();
+  _flush_pending();
   int retval = _pending_events;
   _pending_events = 0;
   return retval;
@@ -231,45 +233,34 @@ int monitoring_stream::write(std::shared_ptr<io::data> const& data) {
     } break;
     case bam::ba_status::static_type(): {
       ba_status* status(static_cast<ba_status*>(data.get()));
-      logging::debug(logging::low)
+      LOGGING_DEBUG(logging::low)
           << "BAM: processing BA status (id " << status->ba_id << ", level "
           << status->level_nominal << ", acknowledgement "
           << status->level_acknowledgement << ", downtime "
           << status->level_downtime << ")";
-      _ba_update.bind_value_as_f64(0, status->level_nominal);
-      _ba_update.bind_value_as_f64(1, status->level_acknowledgement);
-      _ba_update.bind_value_as_f64(2, status->level_downtime);
-      _ba_update.bind_value_as_u32(6, status->ba_id);
-      if (status->last_state_change == (time_t)-1 ||
-          status->last_state_change == 0)
-        _ba_update.bind_value_as_null(3);
-      else
-        _ba_update.bind_value_as_u64(3, status->last_state_change.get_time_t());
-      _ba_update.bind_value_as_bool(4, status->in_downtime);
-      _ba_update.bind_value_as_i32(5, status->state);
-
-      _mysql.run_statement(_ba_update, database::mysql_error::update_ba, true);
-
-      if (status->state_changed) {
+      _ba_statuses[status->ba_id] =
+          std::static_pointer_cast<ba_status>(data);
+      // The check of the virtual service is scheduled once per flush, in
+      // the order of the events, before the downtimes that follow.
+      if (status->state_changed && _ba_checks.insert(status->ba_id).second) {
         std::pair<std::string, std::string> ba_svc_name(
             _ba_mapping.get_service(status->ba_id));
-        if (ba_svc_name.first.empty() || ba_svc_name.second.empty()) {
+        if (ba_svc_name.first.empty() || ba_svc_name.second.empty())
           logging::error(logging::high)
               << "BAM: could not trigger check of virtual service of BA "
               << status->ba_id
               << ": host name and service description were not found";
-        } else {
+        else {
           time_t now = time(nullptr);
-          std::string cmd(fmt::format("[{}] SCHEDULE_FORCED_SVC_CHECK;{};{};{}",
-                                      now, ba_svc_name.first,
-                                      ba_svc_name.second, now));
-          _write_external_command(cmd);
+          _ext_cmd_buffer.append(
+              fmt::format("[{}] SCHEDULE_FORCED_SVC_CHECK;{};{};{}\n", now,
+                          ba_svc_name.first, ba_svc_name.second, now));
         }
       }
     } break;
     case bam::kpi_status::static_type(): {
       kpi_status* status(static_cast<kpi_status*>(data.get()));
-      logging::debug(logging::low)
+      LOGGING_DEBUG(logging::low)
           << "BAM: processing KPI status (id " << status->kpi_id << ", level "
           << status->level_nominal_hard << ", acknowledgement "
           << status->level_acknowledgement_hard << ", downtime "
@@ -314,12 +305,17 @@ int monitoring_stream::write(std::shared_ptr<io::data> const& data) {
             "inheritance",
             now, config::applier::state::instance().poller_id(), dwn.ba_id,
             std::numeric_limits<int32_t>::max());
-      _write_external_command(cmd);
+      _ext_cmd_buffer.append(cmd).append("\n");
     } break;
     default:
       break;
   }
 
+  // Pending statuses and commands are not kept for too long.
+  if (_ba_statuses.size() >= _max_pending_ba_status ||
+      time(nullptr) - _last_flush >= _flush_window)
+    _flush_pending();
+
   // Event acknowledgement.
   return 0;
 }
@@ -334,14 +330,6 @@ int monitoring_stream::write(std::shared_ptr<io::data> const& data) {
  *  Prepare queries.
  */
 void monitoring_stream::_prepare() {
-  // BA status.
-  {
-    std::string query(
-        "UPDATE mod_bam SET current_level=?,acknowledged=?,downtime=?,"
-        "last_state_change=?,in_downtime=?,current_status=? WHERE ba_id=?");
-    _ba_update = _mysql.prepare_query(query);
-  }
-
   // KPI status.
   {
     std::string query(
@@ -402,12 +390,81 @@ void monitoring_stream::_update_status(std::string const& status) {
 }
 
 /**
- *  Write an external command to Engine.
- *
- *  @param[in] cmd  Command to write to the external command pipe.
+ *  Write pending BA statuses and external commands. The database is
+ *  committed before commands are sent, so that checks triggered by them
+ *  see the new BA statuses.
  */
-void monitoring_stream::_write_external_command(std::string cmd) {
-  cmd.append("\n");
+void monitoring_stream::_flush_pending() {
+  _write_ba_statuses();
+  _mysql.commit();
+  _write_external_commands();
+  _last_flush = time(nullptr);
+}
+
+/**
+ *  Write the latest status of each updated BA with one UPDATE query. BAs
+ *  missing from mod_bam are not created. An undefined level is written as
+ *  no impact.
+ */
+void monitoring_stream::_write_ba_statuses() {
+  if (_ba_statuses.empty())
+    return;
+
+  auto level = [](double value, double undefined) -> double {
+    return std::isnan(value) ? undefined : value;
+  };
+  std::string ids;
+  std::string current_level;
+  std::string acknowledged;
+  std::string downtime;
+  std::string last_state_change;
+  std::string in_downtime;
+  std::string current_status;
+  for (auto const& p : _ba_statuses) {
+    ba_status const& status(*p.second);
+    if (!ids.empty())
+      ids.append(",");
+    ids.append(std::to_string(status.ba_id));
+    current_level.append(fmt::format(" WHEN {} THEN {}", status.ba_id,
+                                     level(status.level_nominal, 100.0)));
+    acknowledged.append(fmt::format(" WHEN {} THEN {}", status.ba_id,
+                                    level(status.level_acknowledgement, 0.0)));
+    downtime.append(fmt::format(" WHEN {} THEN {}", status.ba_id,
+                                level(status.level_downtime, 0.0)));
+    if (status.last_state_change == (time_t)-1 ||
+        status.last_state_change == 0)
+      last_state_change.append(
+          fmt::format(" WHEN {} THEN NULL", status.ba_id));
+    else
+      last_state_change.append(
+          fmt::format(" WHEN {} THEN {}", status.ba_id,
+                      status.last_state_change.get_time_t()));
+    in_downtime.append(fmt::format(" WHEN {} THEN {}", status.ba_id,
+                                   status.in_downtime ? 1 : 0));
+    current_status.append(
+        fmt::format(" WHEN {} THEN {}", status.ba_id, status.state));
+  }
+  std::string query(fmt::format(
+      "UPDATE mod_bam SET current_level=CASE ba_id{} END,"
+      "acknowledged=CASE ba_id{} END,downtime=CASE ba_id{} END,"
+      "last_state_change=CASE ba_id{} END,in_downtime=CASE ba_id{} END,"
+      "current_status=CASE ba_id{} END WHERE ba_id IN ({})",
+      current_level, acknowledged, downtime, last_state_change, in_downtime,
+      current_status, ids));
+  log_v2::bam()->debug("BAM: writing {} BA statuses", _ba_statuses.size());
+  _mysql.run_query(query, database::mysql_error::update_ba, true);
+  _ba_statuses.clear();
+}
+
+/**
+ *  Write buffered external commands to Engine with one write. Checks of
+ *  the virtual services may be scheduled again after it.
+ */
+void monitoring_stream::_write_external_commands() {
+  _ba_checks.clear();
+  if (_ext_cmd_buffer.empty())
+    return;
+
   std::ofstream ofs;
   ofs.open(_ext_cmd_file.c_str());
   if (!ofs.good()) {
@@ -415,16 +472,17 @@ void monitoring_stream::_write_external_command(std::string cmd) {
         << "BAM: could not write BA check result to command file '"
         << _ext_cmd_file << "'";
   } else {
-    ofs.write(cmd.c_str(), cmd.size());
+    ofs.write(_ext_cmd_buffer.c_str(), _ext_cmd_buffer.size());
     if (!ofs.good())
       logging::error(logging::medium)
           << "BAM: could not write BA check result to command file '"
           << _ext_cmd_file << "'";
     else
       logging::debug(logging::medium)
-          << "BAM: sent external command '" << cmd << "'";
+          << "BAM: sent external commands '" << _ext_cmd_buffer << "'";
     ofs.close();
   }
+  _ext_cmd_buffer.clear();
 }
 
 /**
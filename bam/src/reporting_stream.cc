@@ -108,6 +108,9 @@ void reporting_stream::statistics(json11::Json::object& tree) const {
   std::lock_guard<std::mutex> lock(_statusm);
   if (!_status.empty())
     tree["status"] = _status;
+  std::string progress(_availabilities->get_progress());
+  if (!progress.empty())
+    tree["availabilities"] = progress;
 }
 
 /**
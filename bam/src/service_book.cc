@@ -18,6 +18,7 @@
 
 #include "com/centreon/broker/bam/service_book.hh"
 
+#include "com/centreon/broker/bam/computable.hh"
 #include "com/centreon/broker/bam/service_listener.hh"
 #include "com/centreon/broker/neb/acknowledgement.hh"
 #include "com/centreon/broker/neb/downtime.hh"
@@ -65,8 +66,7 @@ service_book& service_book::operator=(service_book const& other) {
 void service_book::listen(uint32_t host_id,
                           uint32_t service_id,
                           service_listener* listnr) {
-  _book.insert(std::make_pair(std::make_pair(host_id, service_id), listnr));
-  return;
+  _book[std::make_pair(host_id, service_id)].push_back(listnr);
 }
 
 /**
@@ -79,16 +79,18 @@ void service_book::listen(uint32_t host_id,
 void service_book::unlisten(uint32_t host_id,
                             uint32_t service_id,
                             service_listener* listnr) {
-  std::pair<multimap::iterator, multimap::iterator> range(
-      _book.equal_range(std::make_pair(host_id, service_id)));
-  while (range.first != range.second) {
-    if (range.first->second == listnr) {
-      _book.erase(range.first);
-      break;
-    }
-    ++range.first;
+  listeners::iterator found(_book.find(std::make_pair(host_id, service_id)));
+  if (found != _book.end()) {
+    std::vector<service_listener*>& l(found->second);
+    for (std::vector<service_listener*>::iterator it(l.begin()), end(l.end());
+         it != end; ++it)
+      if (*it == listnr) {
+        l.erase(it);
+        break;
+      }
+    if (l.empty())
+      _book.erase(found);
   }
-  return;
 }
 
 /**
@@ -99,13 +101,7 @@ void service_book::unlisten(uint32_t host_id,
  */
 void service_book::update(std::shared_ptr<neb::service_status> const& ss,
                           io::stream* visitor) {
-  std::pair<multimap::iterator, multimap::iterator> range(
-      _book.equal_range(std::make_pair(ss->host_id, ss->service_id)));
-  while (range.first != range.second) {
-    range.first->second->service_update(ss, visitor);
-    ++range.first;
-  }
-  return;
+  _update(ss->host_id, ss->service_id, ss, visitor);
 }
 
 /**
@@ -117,13 +113,7 @@ void service_book::update(std::shared_ptr<neb::service_status> const& ss,
  */
 void service_book::update(std::shared_ptr<neb::acknowledgement> const& ack,
                           io::stream* visitor) {
-  std::pair<multimap::iterator, multimap::iterator> range(
-      _book.equal_range(std::make_pair(ack->host_id, ack->service_id)));
-  while (range.first != range.second) {
-    range.first->second->service_update(ack, visitor);
-    ++range.first;
-  }
-  return;
+  _update(ack->host_id, ack->service_id, ack, visitor);
 }
 
 /**
@@ -135,11 +125,28 @@ void service_book::update(std::shared_ptr<neb::acknowledgement> const& ack,
  */
 void service_book::update(std::shared_ptr<neb::downtime> const& dt,
                           io::stream* visitor) {
-  std::pair<multimap::iterator, multimap::iterator> range(
-      _book.equal_range(std::make_pair(dt->host_id, dt->service_id)));
-  while (range.first != range.second) {
-    range.first->second->service_update(dt, visitor);
-    ++range.first;
-  }
-  return;
+  _update(dt->host_id, dt->service_id, dt, visitor);
+}
+
+/**
+ *  Forward an update to the listeners of a service.
+ *
+ *  @param[in]  host_id     Host ID.
+ *  @param[in]  service_id  Service ID.
+ *  @param[in]  t           Update.
+ *  @param[out] visitor     Object that will receive events.
+ */
+template <typename T>
+void service_book::_update(uint32_t host_id,
+                           uint32_t service_id,
+                           std::shared_ptr<T> const& t,
+                           io::stream* visitor) {
+  listeners::iterator found(_book.find(std::make_pair(host_id, service_id)));
+  if (found == _book.end())
+    return;
+  computable::batch b(visitor);
+  std::vector<service_listener*>& l(found->second);
+  for (size_t i(0); i < l.size(); ++i)
+    l[i]->service_update(t, visitor);
+  b.run();
 }
@@ -52,6 +52,7 @@ timeperiod_map::timeperiod_map(timeperiod_map const& other) {
 timeperiod_map& timeperiod_map::operator=(timeperiod_map const& other) {
   if (this != &other) {
     _map = other._map;
+    _timeperiod_relations = other._timeperiod_relations;
   }
   return (*this);
 }
@@ -67,6 +68,23 @@ bool timeperiod_map::operator==(timeperiod_map const& other) const {
   return (_map == other._map);
 }
 
+/**
+ *  Deep copy of the map, timeperiods included. Threads working on their
+ *  own clone do not share the caches of the timeperiods.
+ *
+ *  @return  A copy of this map.
+ */
+timeperiod_map timeperiod_map::clone() const {
+  timeperiod_map retval;
+  for (std::map<uint32_t, time::timeperiod::ptr>::const_iterator
+           it(_map.begin()),
+       end(_map.end());
+       it != end; ++it)
+    retval._map[it->first] = std::make_shared<time::timeperiod>(*it->second);
+  retval._timeperiod_relations = _timeperiod_relations;
+  return (retval);
+}
+
 /**
  *  Get the timeperiod associated with an id.
  *
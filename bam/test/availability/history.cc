@@ -0,0 +1,192 @@
+/*
+ * Copyright 2020 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+#include "com/centreon/broker/bam/availability_history.hh"
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <map>
+#include <tuple>
+
+using namespace com::centreon::broker;
+
+namespace {
+struct closed_event {
+  short status;
+  time_t start;
+  time_t end;
+  bool in_downtime;
+  uint32_t tp_id;
+  bool is_default;
+};
+
+struct opened_event {
+  short status;
+  time_t start;
+  bool in_downtime;
+};
+
+typedef std::tuple<int, int, int, int, int, int, int, int, int, bool>
+    availability;
+
+availability to_tuple(bam::availability_builder const& b) {
+  return availability(b.get_available(), b.get_unavailable(),
+                      b.get_degraded(), b.get_unknown(), b.get_downtime(),
+                      b.get_unavailable_opened(), b.get_degraded_opened(),
+                      b.get_unknown_opened(), b.get_downtime_opened(),
+                      b.get_timeperiod_is_default());
+}
+
+/**
+ *  Availabilities built as the daily build does, with one selection of
+ *  the events per day.
+ */
+std::map<std::pair<time_t, uint32_t>, availability> daily_build(
+    uint32_t ba_id,
+    std::vector<closed_event> const& closed,
+    std::vector<opened_event> const& opened,
+    time_t first_day,
+    time_t last_day,
+    bam::timeperiod_map const& tps) {
+  std::map<std::pair<time_t, uint32_t>, availability> retval;
+  while (first_day < last_day) {
+    time_t day_end =
+        time::timeperiod::add_round_days_to_midnight(first_day, 3600 * 24);
+    std::map<uint32_t, bam::availability_builder> builders;
+    for (closed_event const& e : closed)
+      if (e.start < day_end && e.end >= first_day) {
+        time::timeperiod::ptr tp(tps.get_timeperiod(e.tp_id));
+        if (!tp)
+          continue;
+        auto found = builders
+                         .insert(std::make_pair(
+                             e.tp_id,
+                             bam::availability_builder(day_end, first_day)))
+                         .first;
+        found->second.add_event(e.status, e.start, e.end, e.in_downtime, tp);
+        found->second.set_timeperiod_is_default(e.is_default);
+      }
+    for (opened_event const& e : opened)
+      if (e.start < day_end)
+        for (auto const& p : tps.get_timeperiods_by_ba_id(ba_id)) {
+          auto found = builders
+                           .insert(std::make_pair(
+                               p.first->get_id(),
+                               bam::availability_builder(day_end, first_day)))
+                           .first;
+          found->second.add_event(e.status, e.start, 0, e.in_downtime,
+                                  p.first);
+          found->second.set_timeperiod_is_default(p.second);
+        }
+    for (auto const& b : builders)
+      retval[std::make_pair(first_day, b.first)] = to_tuple(b.second);
+    first_day = day_end;
+  }
+  return retval;
+}
+}  // namespace
+
+class BamAvailabilityHistory : public ::testing::Test {
+ public:
+  void SetUp() override {
+    time::timeperiod::ptr always(new time::timeperiod(
+        1, "24x7", "", "00:00-24:00", "00:00-24:00", "00:00-24:00",
+        "00:00-24:00", "00:00-24:00", "00:00-24:00", "00:00-24:00"));
+    time::timeperiod::ptr office(new time::timeperiod(
+        2, "office", "", "", "08:00-18:00", "08:00-18:00", "08:00-18:00",
+        "08:00-18:00", "08:00-18:00", ""));
+    _tps.add_timeperiod(1, always);
+    _tps.add_timeperiod(2, office);
+    _tps.add_relation(12, 1, true);
+    _tps.add_relation(12, 2, false);
+
+    struct tm t = tm();
+    t.tm_year = 120;
+    t.tm_mon = 1;
+    t.tm_mday = 1;
+    t.tm_isdst = -1;
+    _first_day = mktime(&t);
+    t.tm_mon = 4;
+    t.tm_isdst = -1;
+    _last_day = mktime(&t);
+  }
+
+ protected:
+  bam::timeperiod_map _tps;
+  time_t _first_day;
+  time_t _last_day;
+};
+
+TEST_F(BamAvailabilityHistory, SameAsDailyBuild) {
+  srand(42);
+  std::vector<closed_event> closed;
+  std::vector<opened_event> opened;
+  bam::availability_history history(12);
+  time_t span(_last_day - _first_day);
+  time_t current(_first_day - 3 * 24 * 3600);
+  while (current < _last_day - span / 10) {
+    time_t duration(rand() % (3 * 24 * 3600));
+    short status(rand() % 4);
+    bool in_downtime(rand() % 5 == 0);
+    for (uint32_t tp_id = 1; tp_id <= 3; ++tp_id) {
+      closed_event e{status,      current, current + duration,
+                     in_downtime, tp_id,   tp_id == 1};
+      closed.push_back(e);
+      history.add_closed_event(e.status, e.start, e.end, e.in_downtime,
+                               e.tp_id, e.is_default);
+    }
+    current += duration;
+  }
+  opened_event o{2, current, false};
+  opened.push_back(o);
+  history.add_opened_event(o.status, o.start, o.in_downtime);
+
+  std::map<std::pair<time_t, uint32_t>, availability> result;
+  history.build(_first_day, _last_day, _tps,
+                [&](time_t day, uint32_t tp_id,
+                    bam::availability_builder const& b) {
+                  ASSERT_TRUE(result
+                                  .insert(std::make_pair(
+                                      std::make_pair(day, tp_id), to_tuple(b)))
+                                  .second);
+                });
+  std::map<std::pair<time_t, uint32_t>, availability> expected(
+      daily_build(12, closed, opened, _first_day, _last_day, _tps));
+  ASSERT_FALSE(expected.empty());
+  ASSERT_EQ(result, expected);
+}
+
+TEST_F(BamAvailabilityHistory, Durations) {
+  bam::availability_history history(12);
+  time_t day2(time::timeperiod::add_round_days_to_midnight(_first_day,
+                                                           3600 * 24));
+  // OK for the first day and until 06:00 the next day, then critical.
+  history.add_closed_event(0, _first_day, day2 + 6 * 3600, false, 1, true);
+  history.add_opened_event(2, day2 + 6 * 3600, false);
+
+  std::map<std::pair<time_t, uint32_t>, availability> result;
+  history.build(_first_day, day2 + 24 * 3600 + 3600, _tps,
+                [&](time_t day, uint32_t tp_id,
+                    bam::availability_builder const& b) {
+                  result[std::make_pair(day, tp_id)] = to_tuple(b);
+                });
+  ASSERT_EQ(std::get<0>(result[std::make_pair(_first_day, 1u)]), 24 * 3600);
+  ASSERT_EQ(std::get<0>(result[std::make_pair(day2, 1u)]), 6 * 3600);
+  ASSERT_EQ(std::get<1>(result[std::make_pair(day2, 1u)]), 18 * 3600);
+  ASSERT_EQ(std::get<5>(result[std::make_pair(day2, 1u)]), 1);
+  ASSERT_TRUE(std::get<9>(result[std::make_pair(day2, 1u)]));
+}
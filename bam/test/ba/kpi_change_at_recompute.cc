@@ -495,6 +495,42 @@ TEST_F(BamBA, DtInheritAllCritical) {
   }
 }
 
+/**
+ *  The downtime counters of a BA stay right after one of its KPIs is
+ *  removed: the critical KPI removed is no longer counted, so the BA
+ *  inherits the downtime of its remaining KPI.
+ */
+TEST_F(BamBA, DtInheritRemovedKpi) {
+  std::shared_ptr<bam::ba> test_ba(new bam::ba);
+  test_ba->set_state_source(bam::configuration::ba::state_source_ratio_percent);
+  test_ba->set_level_critical(100);
+  test_ba->set_level_warning(75);
+  test_ba->set_downtime_behaviour(bam::configuration::ba::dt_inherit);
+
+  std::vector<std::shared_ptr<bam::kpi_service> > kpis;
+  for (size_t i = 0; i < 2; i++) {
+    std::shared_ptr<bam::kpi_service> s{new bam::kpi_service};
+    s->set_host_id(i + 1);
+    s->set_service_id(1);
+    s->set_state_hard(bam::kpi_service::state::state_critical);
+    s->set_state_soft(s->get_state_hard());
+    test_ba->add_impact(s);
+    s->add_parent(test_ba);
+    kpis.push_back(s);
+  }
+
+  test_ba->remove_impact(kpis[1]);
+  kpis[1]->remove_parent(test_ba);
+
+  std::shared_ptr<neb::downtime> dt(new neb::downtime);
+  dt->host_id = 1;
+  dt->service_id = 1;
+  dt->was_started = true;
+  dt->actual_end_time = 0;
+  kpis[0]->service_update(dt);
+  ASSERT_TRUE(test_ba->get_in_downtime());
+}
+
 TEST_F(BamBA, DtInheritOneOK) {
   std::shared_ptr<bam::ba> test_ba(new bam::ba);
   test_ba->set_state_source(bam::configuration::ba::state_source_ratio_percent);
@@ -0,0 +1,158 @@
+/*
+ * Copyright 2020 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+#include "com/centreon/broker/bam/bool_program.hh"
+#include <gtest/gtest.h>
+#include <memory>
+#include "com/centreon/broker/bam/bool_and.hh"
+#include "com/centreon/broker/bam/bool_constant.hh"
+#include "com/centreon/broker/bam/bool_equal.hh"
+#include "com/centreon/broker/bam/bool_not.hh"
+#include "com/centreon/broker/bam/bool_operation.hh"
+#include "com/centreon/broker/bam/bool_or.hh"
+
+using namespace com::centreon::broker;
+
+/**
+ *  Input whose value is set by the test.
+ */
+class test_input : public bam::bool_value {
+ public:
+  double value = 0.0;
+  bool known = true;
+  bool downtime = false;
+
+  void set(double v) {
+    value = v;
+    propagate_update();
+  }
+  bool child_has_update(bam::computable*, io::stream*) override {
+    return true;
+  }
+  double value_hard() override { return value; }
+  double value_soft() override { return value; }
+  bool state_known() const override { return known; }
+  bool in_downtime() const override { return downtime; }
+};
+
+/**
+ *  Build a binary operator the same way exp_builder does.
+ */
+template <typename T>
+static bam::bool_value::ptr binary(std::shared_ptr<T> op,
+                                   bam::bool_value::ptr const& left,
+                                   bam::bool_value::ptr const& right) {
+  left->add_parent(op);
+  right->add_parent(op);
+  op->set_left(left);
+  op->set_right(right);
+  return op;
+}
+
+static bam::bool_value::ptr constant(double value) {
+  return std::make_shared<bam::bool_constant>(value);
+}
+
+TEST(BamBoolProgram, LeafIsNotCompiled) {
+  auto in = std::make_shared<test_input>();
+  ASSERT_EQ(bam::bool_program::compile(in), in);
+}
+
+TEST(BamBoolProgram, ConstantFolding) {
+  // (2 + 3) == 5
+  bam::bool_value::ptr tree(binary(
+      std::make_shared<bam::bool_equal>(),
+      binary(std::make_shared<bam::bool_operation>("+"), constant(2),
+             constant(3)),
+      constant(5)));
+  auto prog = std::dynamic_pointer_cast<bam::bool_program>(
+      bam::bool_program::compile(tree));
+  ASSERT_TRUE(prog);
+  ASSERT_TRUE(prog->get_code().empty());
+  ASSERT_EQ(prog->value_hard(), 1.0);
+  ASSERT_TRUE(prog->state_known());
+}
+
+TEST(BamBoolProgram, ShortCircuit) {
+  auto a = std::make_shared<test_input>();
+  auto b = std::make_shared<test_input>();
+  // a AND NOT(b)
+  auto n = std::make_shared<bam::bool_not>(b);
+  b->add_parent(n);
+  bam::bool_value::ptr tree(
+      binary(std::make_shared<bam::bool_and>(), a, n));
+  auto prog = std::dynamic_pointer_cast<bam::bool_program>(
+      bam::bool_program::compile(tree));
+  ASSERT_TRUE(prog);
+  tree.reset();
+  ASSERT_EQ(prog->get_inputs_count(), 2u);
+  ASSERT_EQ(prog->get_code().front().op, bam::bool_program::op_jump_if_false);
+
+  ASSERT_EQ(prog->value_hard(), 0.0);
+  a->set(1);
+  ASSERT_EQ(prog->value_hard(), 1.0);
+  b->set(2);
+  ASSERT_EQ(prog->value_hard(), 0.0);
+  a->set(0);
+  b->set(0);
+  ASSERT_EQ(prog->value_hard(), 0.0);
+}
+
+TEST(BamBoolProgram, ConstantDecidesOr) {
+  auto a = std::make_shared<test_input>();
+  a->known = false;
+  bam::bool_value::ptr tree(
+      binary(std::make_shared<bam::bool_or>(), constant(1), a));
+  auto prog = std::dynamic_pointer_cast<bam::bool_program>(
+      bam::bool_program::compile(tree));
+  ASSERT_TRUE(prog->get_code().empty());
+  ASSERT_EQ(prog->value_hard(), 1.0);
+  // The skipped input still tells if the state is known.
+  ASSERT_FALSE(prog->state_known());
+  a->known = true;
+  a->set(0);
+  ASSERT_TRUE(prog->state_known());
+}
+
+TEST(BamBoolProgram, DivisionByZeroIsUnknown) {
+  auto a = std::make_shared<test_input>();
+  auto b = std::make_shared<test_input>();
+  a->set(6);
+  b->set(3);
+  bam::bool_value::ptr tree(
+      binary(std::make_shared<bam::bool_operation>("/"), a, b));
+  auto prog = std::dynamic_pointer_cast<bam::bool_program>(
+      bam::bool_program::compile(tree));
+  ASSERT_EQ(prog->value_hard(), 2.0);
+  ASSERT_TRUE(prog->state_known());
+  b->set(0);
+  ASSERT_FALSE(prog->state_known());
+}
+
+TEST(BamBoolProgram, Downtime) {
+  auto a = std::make_shared<test_input>();
+  auto b = std::make_shared<test_input>();
+  bam::bool_value::ptr tree(
+      binary(std::make_shared<bam::bool_or>(), a, b));
+  auto prog = bam::bool_program::compile(tree);
+  ASSERT_FALSE(prog->in_downtime());
+  b->downtime = true;
+  b->set(1);
+  ASSERT_TRUE(prog->in_downtime());
+  ASSERT_EQ(prog->value_hard(), 1.0);
+}
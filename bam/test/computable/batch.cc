@@ -0,0 +1,130 @@
+/*
+ * Copyright 2020 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include "com/centreon/broker/bam/computable.hh"
+
+using namespace com::centreon::broker;
+
+/**
+ *  Node counting its updates.
+ */
+class counting_node : public bam::computable {
+ public:
+  int updates = 0;
+  bool fail = false;
+  bool child_has_update(bam::computable* child,
+                        io::stream* visitor) override {
+    (void)child;
+    (void)visitor;
+    if (fail)
+      throw std::runtime_error("update failed");
+    ++updates;
+    return true;
+  }
+};
+
+/**
+ *  Diamond graph:
+ *
+ *            top
+ *             |
+ *           join
+ *          /    \
+ *       left    right
+ *          \    /
+ *           leaf
+ */
+class BamComputable : public ::testing::Test {
+ public:
+  void SetUp() override {
+    leaf = std::make_shared<counting_node>();
+    left = std::make_shared<counting_node>();
+    right = std::make_shared<counting_node>();
+    join = std::make_shared<counting_node>();
+    top = std::make_shared<counting_node>();
+    join->add_parent(top);
+    left->add_parent(join);
+    right->add_parent(join);
+    leaf->add_parent(left);
+    leaf->add_parent(right);
+  }
+
+ protected:
+  std::shared_ptr<counting_node> leaf, left, right, join, top;
+};
+
+TEST_F(BamComputable, Levels) {
+  ASSERT_EQ(leaf->get_level(), 0u);
+  ASSERT_EQ(left->get_level(), 1u);
+  ASSERT_EQ(right->get_level(), 1u);
+  ASSERT_EQ(join->get_level(), 2u);
+  ASSERT_EQ(top->get_level(), 3u);
+}
+
+TEST_F(BamComputable, DiamondPropagatesOnce) {
+  leaf->propagate_update();
+  ASSERT_EQ(left->updates, 1);
+  ASSERT_EQ(right->updates, 1);
+  // join is notified by each of its children but propagates only once.
+  ASSERT_EQ(join->updates, 2);
+  ASSERT_EQ(top->updates, 1);
+}
+
+TEST_F(BamComputable, BatchCoalescesUpdates) {
+  {
+    bam::computable::batch b;
+    for (int i = 0; i < 10; ++i) {
+      left->propagate_update();
+      right->propagate_update();
+    }
+    ASSERT_EQ(join->updates, 0);
+  }
+  ASSERT_EQ(join->updates, 2);
+  ASSERT_EQ(top->updates, 1);
+}
+
+TEST_F(BamComputable, FailedUpdateDoesNotBlockNextOnes) {
+  left->fail = true;
+  ASSERT_THROW(leaf->propagate_update(), std::runtime_error);
+  ASSERT_EQ(right->updates, 0);
+  ASSERT_EQ(join->updates, 0);
+
+  left->fail = false;
+  leaf->propagate_update();
+  ASSERT_EQ(left->updates, 1);
+  ASSERT_EQ(right->updates, 1);
+  ASSERT_EQ(join->updates, 2);
+  ASSERT_EQ(top->updates, 1);
+}
+
+TEST_F(BamComputable, RunThrowsDestructorDoesNot) {
+  left->fail = true;
+  {
+    bam::computable::batch b;
+    leaf->propagate_update();
+    ASSERT_THROW(b.run(), std::runtime_error);
+  }
+  ASSERT_NO_THROW({
+    bam::computable::batch b;
+    leaf->propagate_update();
+  });
+  ASSERT_EQ(join->updates, 0);
+}
@@ -17,10 +17,16 @@
  */
 
 #include <gtest/gtest.h>
+#include "com/centreon/broker/bam/bool_expression.hh"
+#include "com/centreon/broker/bam/bool_value.hh"
+#include "com/centreon/broker/bam/configuration/applier/bool_expression.hh"
 #include "com/centreon/broker/bam/configuration/applier/state.hh"
 #include "com/centreon/broker/bam/configuration/bool_expression.hh"
 #include "com/centreon/broker/bam/configuration/kpi.hh"
+#include "com/centreon/broker/bam/metric_book.hh"
+#include "com/centreon/broker/bam/service_book.hh"
 #include "com/centreon/broker/config/applier/init.hh"
+#include "com/centreon/broker/neb/service_status.hh"
 
 using namespace com::centreon::broker;
 
@@ -58,3 +64,40 @@ TEST_F(ApplierBoolexp, Simple) {
 
   ASSERT_NO_THROW(_aply_state->apply(*_state));
 }
+
+// Given a boolexp calling another boolexp
+// When the state of the service of the called boolexp changes
+// Then the calling boolexp is updated.
+TEST_F(ApplierBoolexp, CallFollowsCalledExpression) {
+  bam::hst_svc_mapping mapping;
+  mapping.set_service("host_1", "service_1", 1, 1, true);
+  bam::configuration::state::bool_exps exps;
+  exps[1] = bam::configuration::bool_expression(
+      1, "called", "{host_1 service_1} {IS} {OK}");
+  exps[2] = bam::configuration::bool_expression(2, "calling",
+                                                "{NOT} CALL(called)");
+  bam::service_book book;
+  bam::metric_book metric_book;
+  bam::configuration::applier::bool_expression aply;
+  aply.apply(exps, mapping, book, metric_book);
+
+  std::shared_ptr<bam::bool_expression> calling(aply.find_boolexp(2));
+  ASSERT_TRUE(calling);
+  ASSERT_TRUE(calling->get_expression());
+  ASSERT_FALSE(calling->state_known());
+
+  std::shared_ptr<neb::service_status> ss(new neb::service_status);
+  ss->host_id = 1;
+  ss->service_id = 1;
+  ss->current_state = 0;
+  ss->last_hard_state = 0;
+  book.update(ss);
+  ASSERT_TRUE(calling->state_known());
+  ASSERT_EQ(calling->get_expression()->value_hard(), 0);
+
+  ss->current_state = 2;
+  ss->last_hard_state = 2;
+  book.update(ss);
+  ASSERT_TRUE(calling->state_known());
+  ASSERT_EQ(calling->get_expression()->value_hard(), 1);
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright 2020 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+#include <gtest/gtest.h>
+#include <memory>
+#include "com/centreon/broker/bam/service_book.hh"
+#include "com/centreon/broker/bam/service_listener.hh"
+#include "com/centreon/broker/config/applier/init.hh"
+#include "com/centreon/broker/neb/acknowledgement.hh"
+#include "com/centreon/broker/neb/downtime.hh"
+#include "com/centreon/broker/neb/service_status.hh"
+
+using namespace com::centreon::broker;
+
+/**
+ *  Listener counting its updates.
+ */
+class counting_listener : public bam::service_listener {
+ public:
+  int statuses = 0;
+  int acks = 0;
+  int downtimes = 0;
+  void service_update(std::shared_ptr<neb::service_status> const& status,
+                      io::stream* visitor) override {
+    (void)status;
+    (void)visitor;
+    ++statuses;
+  }
+  void service_update(std::shared_ptr<neb::acknowledgement> const& ack,
+                      io::stream* visitor) override {
+    (void)ack;
+    (void)visitor;
+    ++acks;
+  }
+  void service_update(std::shared_ptr<neb::downtime> const& dt,
+                      io::stream* visitor) override {
+    (void)dt;
+    (void)visitor;
+    ++downtimes;
+  }
+};
+
+class BamServiceBook : public ::testing::Test {
+ public:
+  void SetUp() override { config::applier::init(); }
+  void TearDown() override { config::applier::deinit(); }
+};
+
+/**
+ *  Updates only reach the listeners of their service.
+ */
+TEST_F(BamServiceBook, Update) {
+  bam::service_book book;
+  counting_listener l1, l2, l3;
+  book.listen(1, 1, &l1);
+  book.listen(1, 1, &l2);
+  book.listen(1, 2, &l3);
+
+  std::shared_ptr<neb::service_status> ss(new neb::service_status);
+  ss->host_id = 1;
+  ss->service_id = 1;
+  book.update(ss);
+  std::shared_ptr<neb::acknowledgement> ack(new neb::acknowledgement);
+  ack->host_id = 1;
+  ack->service_id = 2;
+  book.update(ack);
+  std::shared_ptr<neb::downtime> dt(new neb::downtime);
+  dt->host_id = 2;
+  dt->service_id = 1;
+  book.update(dt);
+
+  ASSERT_EQ(l1.statuses, 1);
+  ASSERT_EQ(l2.statuses, 1);
+  ASSERT_EQ(l3.statuses, 0);
+  ASSERT_EQ(l1.acks, 0);
+  ASSERT_EQ(l3.acks, 1);
+  ASSERT_EQ(l1.downtimes + l2.downtimes + l3.downtimes, 0);
+}
+
+/**
+ *  An unlistened listener does not get updates anymore, the other
+ *  listeners of the service still do.
+ */
+TEST_F(BamServiceBook, Unlisten) {
+  bam::service_book book;
+  counting_listener l1, l2;
+  book.listen(1, 1, &l1);
+  book.listen(1, 1, &l2);
+  book.unlisten(1, 1, &l1);
+  book.unlisten(1, 2, &l2);
+
+  std::shared_ptr<neb::downtime> dt(new neb::downtime);
+  dt->host_id = 1;
+  dt->service_id = 1;
+  book.update(dt);
+  ASSERT_EQ(l1.downtimes, 0);
+  ASSERT_EQ(l2.downtimes, 1);
+
+  book.unlisten(1, 1, &l2);
+  book.update(dt);
+  ASSERT_EQ(l2.downtimes, 1);
+}
@@ -58,6 +58,19 @@ class broker_impl final : public Broker::Service {
                                 const GenericNameOrIndex* request,
                                 GenericString* response) override;
 
+  grpc::Status GetStageStats(grpc::ServerContext* context,
+                             const ::google::protobuf::Empty* /*request*/,
+                             StageStatsList* response) override;
+
+  grpc::Status GetPrometheusMetrics(
+      grpc::ServerContext* context,
+      const ::google::protobuf::Empty* /*request*/,
+      GenericString* response) override;
+
+  grpc::Status GetStats(grpc::ServerContext* context,
+                        const StatsQuery* request,
+                        GenericString* response) override;
+
  public:
   void set_broker_name(std::string const& s) { _broker_name = s; };
 };
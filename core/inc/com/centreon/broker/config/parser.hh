@@ -45,7 +45,9 @@ class parser {
 
  private:
   void _parse_endpoint(json11::Json const& elem, endpoint& e);
+  void _parse_log(json11::Json const& elem, state& s);
   void _parse_logger(json11::Json const& elem, logger& l);
+  void _parse_publisher(json11::Json const& elem, state& s);
 };
 }  // namespace config
 
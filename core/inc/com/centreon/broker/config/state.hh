@@ -52,12 +52,19 @@ class state {
   logging::timestamp_type _log_timestamp;
   bool _log_human_readable_timestamp;
   std::list<logger> _loggers;
+  bool _log_async;
+  size_t _log_queue_size;
+  std::string _log_overflow_policy;
   std::string _module_dir;
   std::list<std::string> _module_list;
   std::map<std::string, std::string> _params;
   int _poller_id;
   std::string _poller_name;
   size_t _pool_size;
+  bool _publisher_async;
+  size_t _publisher_queue_size;
+  std::string _publisher_overflow_policy;
+  std::string _publisher_spill_file;
 
  public:
   state();
@@ -89,6 +96,12 @@ class state {
   logging::timestamp_type log_timestamp() const noexcept;
   void log_human_readable_timestamp(bool human_log_time) noexcept;
   bool log_human_readable_timestamp() const noexcept;
+  void log_async(bool async) noexcept;
+  bool log_async() const noexcept;
+  void log_queue_size(int size) noexcept;
+  size_t log_queue_size() const noexcept;
+  void log_overflow_policy(std::string const& policy);
+  std::string const& log_overflow_policy() const noexcept;
   std::list<logger>& loggers() noexcept;
   std::list<logger> const& loggers() const noexcept;
   std::string const& module_directory() const noexcept;
@@ -103,6 +116,14 @@ class state {
   int pool_size() const noexcept;
   void poller_name(std::string const& name);
   std::string const& poller_name() const noexcept;
+  void publisher_async(bool async) noexcept;
+  bool publisher_async() const noexcept;
+  void publisher_queue_size(int size) noexcept;
+  size_t publisher_queue_size() const noexcept;
+  void publisher_overflow_policy(std::string const& policy);
+  std::string const& publisher_overflow_policy() const noexcept;
+  void publisher_spill_file(std::string const& file);
+  std::string const& publisher_spill_file() const noexcept;
 };
 }  // namespace config
 
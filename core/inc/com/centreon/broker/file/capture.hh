@@ -0,0 +1,72 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#ifndef CCB_FILE_CAPTURE_HH
+#define CCB_FILE_CAPTURE_HH
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+#include "com/centreon/broker/io/stream.hh"
+#include "com/centreon/broker/namespace.hh"
+
+CCB_BEGIN()
+
+namespace file {
+/**
+ *  @class capture capture.hh "com/centreon/broker/file/capture.hh"
+ *  @brief Record and replay a timestamped stream.
+ *
+ *  Placed between a protocol stream (usually BBDO) and a file stream.
+ *  Each written chunk is stored as a record made of its write time (in
+ *  microseconds since the epoch), its size and its bytes. On read, records
+ *  are given back with the delays between their write times divided by
+ *  the replay speed, a speed of 0 replays them as fast as possible.
+ */
+class capture : public io::stream {
+ public:
+  // Write time (8 bytes) followed by payload size (4 bytes).
+  static uint32_t const header_size = 12;
+
+  capture(double speed = 1.0);
+  ~capture() noexcept;
+  capture(capture const&) = delete;
+  capture& operator=(capture const&) = delete;
+  bool read(std::shared_ptr<io::data>& d, time_t deadline = (time_t)-1);
+  void statistics(json11::Json::object& tree) const override;
+  int write(std::shared_ptr<io::data> const& d);
+
+ private:
+  bool _get_data(size_t size, time_t deadline);
+
+  double _speed;
+  std::vector<char> _rbuffer;
+  size_t _rpos;
+  bool _started;
+  uint64_t _first_time;
+  std::chrono::steady_clock::time_point _replay_start;
+  uint64_t _records;
+  uint64_t _bytes;
+  double _lag;
+  double _max_lag;
+};
+}  // namespace file
+
+CCB_END()
+
+#endif  // !CCB_FILE_CAPTURE_HH
@@ -40,14 +40,19 @@ class opener : public io::endpoint {
   opener& operator=(opener const&) = delete;
   std::shared_ptr<io::stream> open();
   void set_auto_delete(bool auto_delete);
+  void set_capture(bool capture, double replay_speed = 1.0);
   void set_filename(std::string const& filename);
   void set_max_size(unsigned long long max);
 
  private:
   bool _auto_delete;
+  bool _capture;
   std::string _filename;
   unsigned long long _max_size;
+  double _replay_speed;
 };
+
+std::shared_ptr<io::stream> open_bbdo_file(std::string const& path);
 }  // namespace file
 
 CCB_END()
@@ -21,45 +21,120 @@
 #include <spdlog/common.h>
 #include <spdlog/spdlog.h>
 
+#include <array>
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
 
 #include "com/centreon/broker/config/state.hh"
+#include "com/centreon/broker/logging/async_sink.hh"
 #include "com/centreon/broker/namespace.hh"
 
+/**
+ *  Minimal level of the messages compiled in the log_v2 macros. It uses the
+ *  spdlog numbering (0 = trace, 1 = debug, 2 = info...) and is set by the
+ *  build system, release builds strip the trace messages.
+ */
+#ifndef CENTREON_BROKER_LOG_ACTIVE_LEVEL
+#define CENTREON_BROKER_LOG_ACTIVE_LEVEL SPDLOG_LEVEL_TRACE
+#endif
+
+/**
+ *  These macros check the level of the logger before evaluating the
+ *  arguments. Use them instead of log_v2::xxx()->trace(...) when arguments
+ *  are costly to compute, a disabled message then costs a single branch.
+ */
+#define LOG_V2_CALL(lg, lvl, lvl_num, ...)             \
+  do {                                                 \
+    if (CENTREON_BROKER_LOG_ACTIVE_LEVEL <= lvl_num) { \
+      spdlog::logger* log_v2_l = (lg);                 \
+      if (log_v2_l->should_log(lvl))                   \
+        log_v2_l->log(lvl, __VA_ARGS__);               \
+    }                                                  \
+  } while (0)
+#define LOG_V2_TRACE(lg, ...) \
+  LOG_V2_CALL(lg, spdlog::level::trace, SPDLOG_LEVEL_TRACE, __VA_ARGS__)
+#define LOG_V2_DEBUG(lg, ...) \
+  LOG_V2_CALL(lg, spdlog::level::debug, SPDLOG_LEVEL_DEBUG, __VA_ARGS__)
+#define LOG_V2_INFO(lg, ...) \
+  LOG_V2_CALL(lg, spdlog::level::info, SPDLOG_LEVEL_INFO, __VA_ARGS__)
+#define LOG_V2_WARN(lg, ...) \
+  LOG_V2_CALL(lg, spdlog::level::warn, SPDLOG_LEVEL_WARN, __VA_ARGS__)
+#define LOG_V2_ERROR(lg, ...) \
+  LOG_V2_CALL(lg, spdlog::level::err, SPDLOG_LEVEL_ERROR, __VA_ARGS__)
+
 CCB_BEGIN()
 
+/**
+ *  @class log_v2 log_v2.hh "com/centreon/broker/log_v2.hh"
+ *  @brief spdlog based loggers of broker.
+ *
+ *  Accessors return raw pointers so that a log call does not cost an atomic
+ *  increment/decrement of a shared_ptr. Loggers replaced by load() are kept
+ *  in _retired until the following load(), so a pointer got just before a
+ *  reload is still valid.
+ *
+ *  In asynchronous mode, all the loggers share an async_sink whose thread
+ *  writes the messages, so enabled messages do not cost a write on the
+ *  caller thread.
+ */
 class log_v2 {
-  std::shared_ptr<spdlog::logger> _core_log;
-  std::shared_ptr<spdlog::logger> _config_log;
-  std::shared_ptr<spdlog::logger> _tcp_log;
-  std::shared_ptr<spdlog::logger> _bbdo_log;
-  std::shared_ptr<spdlog::logger> _tls_log;
-  std::shared_ptr<spdlog::logger> _sql_log;
-  std::shared_ptr<spdlog::logger> _perfdata_log;
-  std::shared_ptr<spdlog::logger> _lua_log;
-  std::shared_ptr<spdlog::logger> _processing_log;
-  std::shared_ptr<spdlog::logger> _bam_log;
-  std::mutex _load_m;
+ public:
+  enum logger_id {
+    log_core = 0,
+    log_config,
+    log_tls,
+    log_bbdo,
+    log_tcp,
+    log_sql,
+    log_perfdata,
+    log_lua,
+    log_processing,
+    log_bam,
+    log_max
+  };
+
+ private:
+  static std::array<std::string, log_max> const _names;
+  std::array<std::shared_ptr<spdlog::logger>, log_max> _log;
+  std::array<std::atomic<spdlog::logger*>, log_max> _log_ptr;
+  std::vector<std::shared_ptr<spdlog::logger>> _retired;
+  std::shared_ptr<logging::async_sink> _async_sink;
+  bool _async;
+  size_t _async_queue_size;
+  logging::async_sink::overflow_policy _async_policy;
+  mutable std::mutex _load_m;
 
   log_v2();
   ~log_v2();
+  void _set_logger(logger_id id, std::shared_ptr<spdlog::logger> l);
+  void _release_retired();
 
  public:
   static log_v2& instance();
   bool load(std::string const& file,
             std::string const& broker_name,
             std::string& err);
+  void set_async(config::state const& conf);
+  bool is_async() const;
+  size_t queued_messages() const;
+  uint64_t dropped_messages() const;
 
-  static std::shared_ptr<spdlog::logger> core();
-  static std::shared_ptr<spdlog::logger> config();
-  static std::shared_ptr<spdlog::logger> tls();
-  static std::shared_ptr<spdlog::logger> bbdo();
-  static std::shared_ptr<spdlog::logger> tcp();
-  static std::shared_ptr<spdlog::logger> sql();
-  static std::shared_ptr<spdlog::logger> perfdata();
-  static std::shared_ptr<spdlog::logger> lua();
-  static std::shared_ptr<spdlog::logger> processing();
-  static std::shared_ptr<spdlog::logger> bam();
+  static spdlog::logger* get(logger_id id) {
+    return instance()._log_ptr[id].load(std::memory_order_acquire);
+  }
+  static spdlog::logger* core() { return get(log_core); }
+  static spdlog::logger* config() { return get(log_config); }
+  static spdlog::logger* tls() { return get(log_tls); }
+  static spdlog::logger* bbdo() { return get(log_bbdo); }
+  static spdlog::logger* tcp() { return get(log_tcp); }
+  static spdlog::logger* sql() { return get(log_sql); }
+  static spdlog::logger* perfdata() { return get(log_perfdata); }
+  static spdlog::logger* lua() { return get(log_lua); }
+  static spdlog::logger* processing() { return get(log_processing); }
+  static spdlog::logger* bam() { return get(log_bam); }
 };
 
 CCB_END();
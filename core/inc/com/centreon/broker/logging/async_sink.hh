@@ -0,0 +1,91 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#ifndef CCB_LOGGING_ASYNC_SINK_HH
+#define CCB_LOGGING_ASYNC_SINK_HH
+
+#include <spdlog/details/log_msg_buffer.h>
+#include <spdlog/sinks/sink.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "com/centreon/broker/misc/mpmc_queue.hh"
+#include "com/centreon/broker/namespace.hh"
+
+CCB_BEGIN()
+
+namespace logging {
+/**
+ *  @class async_sink async_sink.hh "com/centreon/broker/logging/async_sink.hh"
+ *  @brief spdlog sink used by log_v2 in asynchronous mode.
+ *
+ *  Messages are copied into a bounded lock-free queue and a dedicated thread
+ *  formats and writes them to the real sinks. When the queue is full, the
+ *  overflow policy tells if the caller waits, if the oldest message is
+ *  dropped or if the new message is dropped. Dropped messages are counted.
+ *  flush() does not block, it only asks the writer thread to flush the real
+ *  sinks once the queue is empty.
+ */
+class async_sink : public spdlog::sinks::sink {
+ public:
+  enum overflow_policy { block = 0, drop_oldest, drop };
+
+ private:
+  static std::atomic<uint64_t> _total_dropped;
+
+  std::vector<spdlog::sink_ptr> const _sinks;
+  overflow_policy const _policy;
+  misc::mpmc_queue<spdlog::details::log_msg_buffer> _queue;
+  std::atomic<uint64_t> _dropped;
+  std::atomic_bool _flush_requested;
+  std::atomic_bool _writer_waiting;
+  bool _exit;
+  std::mutex _writer_m;
+  std::condition_variable _writer_cv;
+  std::thread _writer;
+
+  void _count_dropped();
+  void _wake_writer();
+  void _run();
+
+ public:
+  async_sink(std::vector<spdlog::sink_ptr> const& sinks,
+             size_t queue_size,
+             overflow_policy policy);
+  async_sink(async_sink const&) = delete;
+  async_sink& operator=(async_sink const&) = delete;
+  ~async_sink();
+  void log(spdlog::details::log_msg const& msg) override;
+  void flush() override;
+  void set_pattern(std::string const& pattern) override;
+  void set_formatter(std::unique_ptr<spdlog::formatter> f) override;
+  uint64_t dropped() const noexcept;
+  size_t queued() const noexcept;
+  static uint64_t total_dropped() noexcept;
+  static bool parse_policy(std::string const& str, overflow_policy& policy);
+};
+}  // namespace logging
+
+CCB_END()
+
+#endif  // !CCB_LOGGING_ASYNC_SINK_HH
@@ -20,6 +20,7 @@
 #define CCB_LOGGING_LOGGING_HH
 
 #include "com/centreon/broker/logging/logger.hh"
+#include "com/centreon/broker/logging/manager.hh"
 #include "com/centreon/broker/namespace.hh"
 
 CCB_BEGIN()
@@ -31,8 +32,46 @@ extern logger debug;
 extern logger error;
 extern logger info;
 extern logger perf;
+
+/**
+ *  Used by the LOGGING_* macros to give the same type to both branches of
+ *  their conditional operator.
+ */
+struct voidify {
+  void operator&(temp_logger const&) const noexcept {}
+};
 }  // namespace logging
 
 CCB_END()
 
+/**
+ *  Minimal level of the compiled messages, with the log_v2 numbering
+ *  (0 = trace, 1 = debug...). Debug messages of low level are considered as
+ *  trace messages.
+ */
+#ifndef CENTREON_BROKER_LOG_ACTIVE_LEVEL
+#define CENTREON_BROKER_LOG_ACTIVE_LEVEL 0
+#endif
+
+#define LOGGING_DEBUG_COMPILED(l)            \
+  (CENTREON_BROKER_LOG_ACTIVE_LEVEL <= 0 ||  \
+   (CENTREON_BROKER_LOG_ACTIVE_LEVEL <= 1 && \
+    (l) != com::centreon::broker::logging::low))
+
+/**
+ *  Same as logging::xxx(l) << ... but the streamed arguments are only
+ *  evaluated if a backend wants the message.
+ */
+#define LOGGING_CALL(obj, t, l)                                         \
+  !com::centreon::broker::logging::manager::instance().is_enabled(t, l) \
+      ? (void)0                                                         \
+      : com::centreon::broker::logging::voidify() &                     \
+            com::centreon::broker::logging::obj(l)
+#define LOGGING_DEBUG(l)     \
+  !LOGGING_DEBUG_COMPILED(l) \
+      ? (void)0              \
+      : LOGGING_CALL(debug, com::centreon::broker::logging::debug_type, l)
+#define LOGGING_INFO(l) \
+  LOGGING_CALL(info, com::centreon::broker::logging::info_type, l)
+
 #endif  // !CCB_LOGGING_LOGGING_HH
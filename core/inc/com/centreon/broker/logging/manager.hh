@@ -53,6 +53,7 @@ class manager : public backend {
   manager& operator=(manager const& m) = delete;
   ~manager() = default;
   temp_logger get_temp_logger(type t, level l) noexcept;
+  bool is_enabled(type t, level l) const noexcept { return _limits[l] & t; }
   static manager& instance();
   void log_msg(char const* msg, uint32_t len, type t, level l) noexcept;
   void log_on(std::shared_ptr<backend> b,
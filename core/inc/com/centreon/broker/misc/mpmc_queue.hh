@@ -0,0 +1,147 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#ifndef CCB_MISC_MPMC_QUEUE_HH
+#define CCB_MISC_MPMC_QUEUE_HH
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "com/centreon/broker/namespace.hh"
+
+CCB_BEGIN()
+
+namespace misc {
+/**
+ *  @class mpmc_queue mpmc_queue.hh "com/centreon/broker/misc/mpmc_queue.hh"
+ *  @brief Bounded lock-free multi-producer multi-consumer queue.
+ *
+ *  Each cell carries a sequence number telling if it is ready to be written
+ *  or read for the current lap (D. Vyukov's algorithm). The capacity is
+ *  rounded up to a power of two. try_push() and try_pop() never block, it
+ *  is up to the caller to decide what to do when the queue is full or empty.
+ */
+template <typename T>
+class mpmc_queue {
+  struct cell {
+    std::atomic<size_t> seq;
+    T data;
+  };
+
+  static size_t _round_up(size_t size) {
+    size_t retval = 2;
+    while (retval < size)
+      retval <<= 1;
+    return retval;
+  }
+
+  size_t const _mask;
+  std::unique_ptr<cell[]> const _cells;
+  /* Paddings keep producers and consumers on different cache lines. */
+  char _pad0[64];
+  std::atomic<size_t> _enqueue_pos;
+  char _pad1[64];
+  std::atomic<size_t> _dequeue_pos;
+
+ public:
+  explicit mpmc_queue(size_t size)
+      : _mask(_round_up(size) - 1),
+        _cells(new cell[_mask + 1]),
+        _enqueue_pos(0),
+        _dequeue_pos(0) {
+    for (size_t i = 0; i <= _mask; i++)
+      _cells[i].seq.store(i, std::memory_order_relaxed);
+  }
+  mpmc_queue(mpmc_queue const&) = delete;
+  mpmc_queue& operator=(mpmc_queue const&) = delete;
+
+  /**
+   *  Push an element into the queue.
+   *
+   *  @param[in] data The element, moved only on success.
+   *
+   *  @return false if the queue is full.
+   */
+  bool try_push(T& data) {
+    size_t pos = _enqueue_pos.load(std::memory_order_relaxed);
+    cell* c;
+    for (;;) {
+      c = &_cells[pos & _mask];
+      size_t seq = c->seq.load(std::memory_order_acquire);
+      intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+      if (diff == 0) {
+        if (_enqueue_pos.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed))
+          break;
+      } else if (diff < 0)
+        return false;
+      else
+        pos = _enqueue_pos.load(std::memory_order_relaxed);
+    }
+    c->data = std::move(data);
+    c->seq.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   *  Pop an element from the queue.
+   *
+   *  @param[out] data Filled with the element on success.
+   *
+   *  @return false if the queue is empty.
+   */
+  bool try_pop(T& data) {
+    size_t pos = _dequeue_pos.load(std::memory_order_relaxed);
+    cell* c;
+    for (;;) {
+      c = &_cells[pos & _mask];
+      size_t seq = c->seq.load(std::memory_order_acquire);
+      intptr_t diff =
+          static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+      if (diff == 0) {
+        if (_dequeue_pos.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed))
+          break;
+      } else if (diff < 0)
+        return false;
+      else
+        pos = _dequeue_pos.load(std::memory_order_relaxed);
+    }
+    data = std::move(c->data);
+    c->seq.store(pos + _mask + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   *  Approximate number of elements in the queue.
+   */
+  size_t size() const {
+    size_t e = _enqueue_pos.load(std::memory_order_relaxed);
+    size_t d = _dequeue_pos.load(std::memory_order_relaxed);
+    return e > d ? e - d : 0;
+  }
+
+  size_t capacity() const { return _mask + 1; }
+};
+}  // namespace misc
+
+CCB_END()
+
+#endif  // !CCB_MISC_MPMC_QUEUE_HH
@@ -0,0 +1,253 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#ifndef CCB_MISC_OBJECT_POOL_HH
+#define CCB_MISC_OBJECT_POOL_HH
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+
+#include "com/centreon/broker/namespace.hh"
+
+CCB_BEGIN()
+
+namespace misc {
+/**
+ *  @class object_pool object_pool.hh "com/centreon/broker/misc/object_pool.hh"
+ *  @brief Pool of recycled objects handed out as shared pointers.
+ *
+ *  When the last reference to an object drops, the object is reset by a copy
+ *  of a default constructed T and given back to the pool. Since the reset is
+ *  a copy assignment, strings keep their capacity and the next user of the
+ *  object fills them without allocation. The control blocks of the shared
+ *  pointers are recycled the same way.
+ *
+ *  Objects can be released from any thread, free lists are lock-free stacks
+ *  on this side. acquire() is serialized by a mutex, so there is only one
+ *  thread popping the stacks at a time, which makes them ABA-safe. This
+ *  mutex is never contended when objects are always acquired from the same
+ *  thread.
+ *
+ *  Objects may outlive the pool: the free lists are only destroyed once the
+ *  pool and all its objects are gone.
+ */
+template <typename T>
+class object_pool {
+  struct node {
+    T obj;
+    node* next;
+    node() : obj(), next(nullptr) {}
+  };
+
+  struct block {
+    block* next;
+  };
+
+  struct state {
+    std::atomic<node*> free_nodes;
+    std::atomic<block*> free_blocks;
+    std::atomic<size_t> free_count;
+    std::atomic<size_t> allocated;
+    // The pool and each control block in use hold a reference.
+    std::atomic<size_t> refs;
+    size_t block_size;
+    size_t const max_free;
+    std::mutex acquire_m;
+    T const blank;
+
+    explicit state(size_t max)
+        : free_nodes(nullptr),
+          free_blocks(nullptr),
+          free_count(0),
+          allocated(0),
+          refs(1),
+          block_size(0),
+          max_free(max),
+          blank() {}
+
+    ~state() {
+      node* n = free_nodes.load(std::memory_order_acquire);
+      while (n) {
+        node* next = n->next;
+        delete n;
+        n = next;
+      }
+      block* b = free_blocks.load(std::memory_order_acquire);
+      while (b) {
+        block* next = b->next;
+        ::operator delete(b);
+        b = next;
+      }
+    }
+
+    void unref() noexcept {
+      if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        delete this;
+    }
+
+    template <typename U>
+    static void push(std::atomic<U*>& head, U* elem) noexcept {
+      U* h = head.load(std::memory_order_relaxed);
+      do
+        elem->next = h;
+      while (!head.compare_exchange_weak(h, elem, std::memory_order_release,
+                                         std::memory_order_relaxed));
+    }
+
+    // acquire_m must be held.
+    template <typename U>
+    static U* pop(std::atomic<U*>& head) noexcept {
+      U* h = head.load(std::memory_order_acquire);
+      while (h && !head.compare_exchange_weak(h, h->next,
+                                              std::memory_order_acquire,
+                                              std::memory_order_acquire))
+        ;
+      return h;
+    }
+  };
+
+  /**
+   *  Deleter of the shared pointers, it gives the object back to the pool.
+   */
+  struct releaser {
+    state* s;
+    node* n;
+
+    void operator()(T*) noexcept {
+      if (s->free_count.load(std::memory_order_relaxed) < s->max_free) {
+        try {
+          n->obj = s->blank;
+          s->free_count.fetch_add(1, std::memory_order_relaxed);
+          state::push(s->free_nodes, n);
+          return;
+        } catch (...) {
+        }
+      }
+      s->allocated.fetch_sub(1, std::memory_order_relaxed);
+      delete n;
+    }
+  };
+
+ public:
+  /**
+   *  Allocator of the control blocks. Allocations always happen in
+   *  acquire(), with acquire_m held.
+   */
+  template <typename U>
+  class block_allocator {
+    template <typename V>
+    friend class block_allocator;
+    state* _s;
+
+   public:
+    typedef U value_type;
+
+    explicit block_allocator(state* s) noexcept : _s(s) {}
+    template <typename V>
+    block_allocator(block_allocator<V> const& other) noexcept : _s(other._s) {}
+
+    U* allocate(size_t n) {
+      size_t size = std::max(n * sizeof(U), sizeof(block));
+      void* p = nullptr;
+      if (n == 1) {
+        if (!_s->block_size)
+          _s->block_size = size;
+        if (size == _s->block_size)
+          p = state::pop(_s->free_blocks);
+      }
+      if (!p)
+        p = ::operator new(size);
+      _s->refs.fetch_add(1, std::memory_order_relaxed);
+      return static_cast<U*>(p);
+    }
+
+    void deallocate(U* p, size_t n) noexcept {
+      state* s = _s;
+      if (n == 1 && std::max(sizeof(U), sizeof(block)) == s->block_size)
+        state::push(s->free_blocks, reinterpret_cast<block*>(p));
+      else
+        ::operator delete(p);
+      s->unref();
+    }
+
+    template <typename V>
+    bool operator==(block_allocator<V> const& other) const noexcept {
+      return _s == other._s;
+    }
+    template <typename V>
+    bool operator!=(block_allocator<V> const& other) const noexcept {
+      return _s != other._s;
+    }
+  };
+
+  /**
+   *  Constructor.
+   *
+   *  @param[in] max_free Maximum number of free objects kept in the pool,
+   *                      beyond it released objects are destroyed.
+   */
+  explicit object_pool(size_t max_free = 10000) : _s(new state(max_free)) {}
+  object_pool(object_pool const&) = delete;
+  object_pool& operator=(object_pool const&) = delete;
+  ~object_pool() { _s->unref(); }
+
+  /**
+   *  Get an object from the pool, it is equal to a default constructed T.
+   *
+   *  @return A shared pointer to the object.
+   */
+  std::shared_ptr<T> acquire() {
+    std::lock_guard<std::mutex> lock(_s->acquire_m);
+    node* n = state::pop(_s->free_nodes);
+    if (n)
+      _s->free_count.fetch_sub(1, std::memory_order_relaxed);
+    else {
+      n = new node;
+      _s->allocated.fetch_add(1, std::memory_order_relaxed);
+    }
+    // On failure, the constructor gives the object back with the releaser.
+    return std::shared_ptr<T>(&n->obj, releaser{_s, n},
+                              block_allocator<T>(_s));
+  }
+
+  /**
+   *  Number of objects owned by the pool, used or free.
+   */
+  size_t allocated() const {
+    return _s->allocated.load(std::memory_order_relaxed);
+  }
+
+  /**
+   *  Number of free objects in the pool.
+   */
+  size_t available() const {
+    return _s->free_count.load(std::memory_order_relaxed);
+  }
+
+ private:
+  state* _s;
+};
+}  // namespace misc
+
+CCB_END()
+
+#endif  // !CCB_MISC_OBJECT_POOL_HH
@@ -51,7 +51,10 @@ std::list<std::string> split(std::string const& str, char sep);
 std::string& trim(std::string& str) throw();
 std::string base64_encode(std::string const& str);
 bool is_number(const std::string& s);
+bool is_utf8(std::string const& str) noexcept;
 std::string check_string_utf8(const std::string& str) noexcept;
+void append_utf8(std::string& dest, std::string const& str);
+void assign_utf8(std::string& dest, std::string const& str);
 
 /**
  * @brief This function works almost like the resize method but takes care
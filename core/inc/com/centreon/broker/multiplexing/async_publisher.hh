@@ -0,0 +1,107 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#ifndef CCB_MULTIPLEXING_ASYNC_PUBLISHER_HH
+#define CCB_MULTIPLEXING_ASYNC_PUBLISHER_HH
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "com/centreon/broker/misc/mpmc_queue.hh"
+#include "com/centreon/broker/multiplexing/publisher.hh"
+#include "com/centreon/broker/namespace.hh"
+
+CCB_BEGIN()
+
+namespace multiplexing {
+/**
+ *  @class async_publisher async_publisher.hh
+ * "com/centreon/broker/multiplexing/async_publisher.hh"
+ *  @brief Publisher handing events to the multiplexing engine from its own
+ *  thread.
+ *
+ *  Until start() is called, and after stop(), it behaves like a publisher.
+ *  Once started, write() only pushes the event into a bounded lock-free
+ *  queue and a dedicated thread publishes the queued events by batches.
+ *  When the queue is full, the overflow policy tells if the caller waits
+ *  (block), if the event is dropped (drop) or if it is written to a spill
+ *  file (spill). Once spilling has started, all the events go to spill files
+ *  until the thread has published them again, so that their order is kept.
+ *  Spill files left by a previous run are published when the publisher
+ *  starts.
+ */
+class async_publisher : public publisher {
+ public:
+  enum overflow_policy { block = 0, drop, spill };
+
+ private:
+  std::unique_ptr<misc::mpmc_queue<std::shared_ptr<io::data>>> _queue;
+  overflow_policy _policy;
+  std::string _spill_file;
+  std::atomic_bool _started;
+  std::atomic_bool _spilling;
+  std::atomic<uint64_t> _dropped;
+  std::atomic<uint64_t> _spilled;
+  std::atomic_bool _thread_waiting;
+  bool _exit;
+  std::mutex _thread_m;
+  std::condition_variable _thread_cv;
+  std::thread _thread;
+
+  // Spill files not published yet, the last one may be open for writing.
+  std::mutex _spill_m;
+  std::deque<std::string> _spill_files;
+  std::shared_ptr<io::stream> _spill_writer;
+  uint32_t _spill_id;
+
+  std::string _spill_path(uint32_t id) const;
+  void _load_spill_files();
+  void _spill(std::shared_ptr<io::data>& d);
+  bool _replay_spill();
+  void _count_dropped();
+  void _wake_thread();
+  void _run();
+
+ public:
+  async_publisher();
+  async_publisher(async_publisher const&) = delete;
+  async_publisher& operator=(async_publisher const&) = delete;
+  ~async_publisher() noexcept;
+  void start(size_t queue_size,
+             overflow_policy policy,
+             std::string const& spill_file);
+  void stop();
+  bool is_async() const noexcept;
+  int write(std::shared_ptr<io::data> const& d) override;
+  int write(std::list<std::shared_ptr<io::data>> const& to_publish);
+  uint64_t dropped() const noexcept;
+  uint64_t spilled() const noexcept;
+  size_t queued() const noexcept;
+  static bool parse_policy(std::string const& str, overflow_policy& policy);
+};
+}  // namespace multiplexing
+
+CCB_END()
+
+#endif  // !CCB_MULTIPLEXING_ASYNC_PUBLISHER_HH
@@ -23,6 +23,7 @@
 #include <memory>
 #include <mutex>
 #include <queue>
+#include <vector>
 
 #include "com/centreon/broker/multiplexing/hooker.hh"
 #include "com/centreon/broker/namespace.hh"
@@ -41,6 +42,10 @@ class muxer;
  *  Core multiplexing engine. Send events to and receive events from
  *  muxer objects.
  *
+ *  Each event is only given to the muxers whose write filters accept its
+ *  type. The subscribers of each type are computed again when a muxer
+ *  subscribes, unsubscribes or changes its write filters.
+ *
  *  @see muxer
  */
 class engine {
@@ -62,10 +67,17 @@ class engine {
   std::vector<muxer*> _muxers;
   std::mutex _muxers_m;
 
+  // Subscribers by type, indexed by category index and element. Protected
+  // by _muxers_m.
+  std::vector<std::vector<std::vector<muxer*>>> _subscribers;
+  uint32_t _filters_version;
+
   engine();
   std::string _cache_file_path() const;
   void _nop(std::shared_ptr<io::data> const& d);
   void _send_to_subscribers();
+  std::vector<muxer*> const& _subscribers_of(uint32_t type) const;
+  void _update_subscribers();
   void _write(std::shared_ptr<io::data> const& d);
   void _write_to_cache_file(std::shared_ptr<io::data> const& d);
   void _publish(std::shared_ptr<io::data> const& d);
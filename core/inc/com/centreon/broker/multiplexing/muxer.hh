@@ -19,7 +19,10 @@
 #ifndef CCB_MULTIPLEXING_MUXER_HH
 #define CCB_MULTIPLEXING_MUXER_HH
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <deque>
 #include <list>
 #include <memory>
 #include <mutex>
@@ -27,6 +30,7 @@
 #include <string>
 #include <unordered_set>
 
+#include "com/centreon/broker/multiplexing/type_bitmap.hh"
 #include "com/centreon/broker/namespace.hh"
 #include "com/centreon/broker/persistent_file.hh"
 
@@ -42,6 +46,9 @@ namespace multiplexing {
  *  new muxer object. This objects broadcast events sent to it to all
  *  other muxer objects.
  *
+ *  Filters are kept as sets for configuration and statistics, and compiled
+ *  into bitmaps for the checks done on each event.
+ *
  *  @see engine
  */
 class muxer : public io::stream {
@@ -61,6 +68,7 @@ class muxer : public io::stream {
   void set_write_filters(filters const& fltrs);
   filters const& get_read_filters() const;
   filters const& get_write_filters() const;
+  filters get_write_filters_copy() const;
   const std::string& get_read_filters_str() const;
   const std::string& get_write_filters_str() const;
   uint32_t get_event_queue_size() const;
@@ -70,6 +78,7 @@ class muxer : public io::stream {
   void wake();
   int write(std::shared_ptr<io::data> const& d);
 
+  static uint32_t filters_version() noexcept;
   static std::string memory_file(std::string const& name);
   static std::string queue_file(std::string const& name);
 
@@ -78,6 +87,8 @@ class muxer : public io::stream {
   void _get_event_from_file(std::shared_ptr<io::data>& event);
   std::string _memory_file() const;
   void _push_to_queue(std::shared_ptr<io::data> const& event);
+  static void _record_queue_wait(
+      std::chrono::steady_clock::time_point pushed) noexcept;
   std::string _queue_file() const;
 
   std::condition_variable _cv;
@@ -89,8 +100,16 @@ class muxer : public io::stream {
   std::string _name;
   bool _persistent;
   std::list<std::shared_ptr<io::data>>::iterator _pos;
+  // Number of events before _pos.
+  size_t _pos_index;
+  // Push time of each event of _events, to measure the queue wait.
+  std::deque<std::chrono::steady_clock::time_point> _push_times;
   filters _read_filters;
   filters _write_filters;
+  type_bitmap _read_types;
+  type_bitmap _write_types;
+  // Incremented each time write filters change.
+  static std::atomic<uint32_t> _filters_version;
   std::string _read_filters_str;
   std::string _write_filters_str;
 };
@@ -0,0 +1,109 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#ifndef CCB_MULTIPLEXING_TYPE_BITMAP_HH
+#define CCB_MULTIPLEXING_TYPE_BITMAP_HH
+
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+#include "com/centreon/broker/io/events.hh"
+#include "com/centreon/broker/namespace.hh"
+
+CCB_BEGIN()
+
+namespace multiplexing {
+/**
+ *  @class type_bitmap type_bitmap.hh
+ * "com/centreon/broker/multiplexing/type_bitmap.hh"
+ *  @brief Set of event types stored as bitmaps.
+ *
+ *  There is one bitmap per category, indexed by the element of the type, so
+ *  that testing a type is two array accesses. Categories are small numbers,
+ *  except the internal one (65535) that is stored at index 0.
+ */
+class type_bitmap {
+  std::vector<std::vector<uint64_t>> _categories;
+
+ public:
+  /**
+   *  Get the index of a category in the tables indexed by category.
+   *
+   *  @param[in] category  Category of an event type.
+   *
+   *  @return The index, io::events::internal gives 0.
+   */
+  static uint16_t category_index(uint16_t category) noexcept {
+    return static_cast<uint16_t>(category + 1);
+  }
+
+  type_bitmap() = default;
+
+  /**
+   *  Build the bitmap from a set of types.
+   *
+   *  @param[in] types  Event types.
+   */
+  explicit type_bitmap(std::unordered_set<uint32_t> const& types) {
+    for (uint32_t t : types)
+      set(t);
+  }
+
+  /**
+   *  Add a type.
+   *
+   *  @param[in] type  Event type.
+   */
+  void set(uint32_t type) {
+    uint16_t c(category_index(io::events::category_of_type(type)));
+    uint16_t e(io::events::element_of_type(type));
+    if (c >= _categories.size())
+      _categories.resize(c + 1);
+    std::vector<uint64_t>& bits(_categories[c]);
+    if (e / 64u >= bits.size())
+      bits.resize(e / 64u + 1);
+    bits[e / 64u] |= uint64_t(1) << (e % 64u);
+  }
+
+  /**
+   *  Check if a type is in the set.
+   *
+   *  @param[in] type  Event type.
+   *
+   *  @return true if the type was added.
+   */
+  bool test(uint32_t type) const noexcept {
+    uint16_t c(category_index(io::events::category_of_type(type)));
+    if (c >= _categories.size())
+      return false;
+    uint16_t e(io::events::element_of_type(type));
+    std::vector<uint64_t> const& bits(_categories[c]);
+    return e / 64u < bits.size() && (bits[e / 64u] >> (e % 64u)) & 1u;
+  }
+
+  /**
+   *  Remove all the types.
+   */
+  void clear() noexcept { _categories.clear(); }
+};
+}  // namespace multiplexing
+
+CCB_END()
+
+#endif  // !CCB_MULTIPLEXING_TYPE_BITMAP_HH
@@ -45,7 +45,7 @@ class feeder;
  *  @class acceptor acceptor.hh "com/centreon/broker/processing/acceptor.hh"
  *  @brief Accept incoming connections.
  *
- *  Accept incoming connections and launch a feeder thread.
+ *  Accept incoming connections and launch a feeder.
  */
 class acceptor : public endpoint {
   enum state {
@@ -78,6 +78,7 @@ class acceptor : public endpoint {
   std::string const& _get_read_filters() const override;
   std::string const& _get_write_filters() const override;
   virtual void _forward_statistic(json11::Json::object& tree) override;
+  void _forward_details(json11::Json::object& tree) override;
   virtual uint32_t _get_queued_events() const override;
 
  public:
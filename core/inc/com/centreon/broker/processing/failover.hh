@@ -82,6 +82,7 @@ class failover : public endpoint {
   void set_buffering_timeout(time_t secs);
   void set_failover(std::shared_ptr<processing::failover> fo);
   void set_retry_interval(time_t retry_interval);
+  void set_stats_path(std::string const& path) override;
   void update() override;
   //bool wait(unsigned long time = ULONG_MAX);
 
@@ -91,6 +92,7 @@ class failover : public endpoint {
   std::string const& _get_write_filters() const override;
   uint32_t _get_queued_events() const override;
   virtual void _forward_statistic(json11::Json::object& tree) override;
+  void _forward_details(json11::Json::object& tree) override;
 
  private:
   void _launch_failover();
@@ -19,12 +19,12 @@
 #ifndef CCB_PROCESSING_FEEDER_HH
 #define CCB_PROCESSING_FEEDER_HH
 
+#include <asio.hpp>
 #include <atomic>
 #include <climits>
 #include <condition_variable>
 #include <memory>
 #include <string>
-#include <thread>
 
 #include "com/centreon/broker/misc/shared_mutex.hh"
 #include "com/centreon/broker/multiplexing/subscriber.hh"
@@ -44,11 +44,20 @@ namespace processing {
  *  @brief Feed events from a source to a destination.
  *
  *  Take events from a source and send them to a destination.
+ *
+ *  A feeder has no thread of its own, it works by turns executed by the
+ *  thread pool. A turn moves at most max_events_per_turn events, then the
+ *  next turn is posted behind the other tasks of the pool, so that every
+ *  peer gets its share of the threads. When there was nothing to move, the
+ *  next turn is delayed by idle_delay, unless the feeder is destroyed in
+ *  the meantime.
  */
 class feeder : public stat_visitable {
   enum state { stopped, running, finished };
-  // Condition variable used when waiting for the thread to finish
-  std::thread _thread;
+  static uint32_t const max_events_per_turn = 1000;
+  static std::chrono::milliseconds const idle_delay;
+
+  // Condition variable used when waiting for the last turn to finish
   state _state;
   mutable std::mutex _state_m;
   std::condition_variable _state_cv;
@@ -61,7 +70,18 @@ class feeder : public stat_visitable {
   // This mutex is used for the stat thread.
   mutable misc::shared_mutex _client_m;
 
+  // Turns and timer operations are serialized by the strand.
+  asio::io_context::strand _strand;
+  asio::steady_timer _timer;
+  bool _timer_cancelled;
+  time_t _fill_stats_time;
+  bool _stream_can_read;
+  bool _muxer_can_read;
+
+  void _schedule(bool idle);
+  void _cancel_timer() noexcept;
   void _callback() noexcept;
+  void _stop() noexcept;
 
  protected:
   std::string const& _get_read_filters() const override;
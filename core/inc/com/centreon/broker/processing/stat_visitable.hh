@@ -25,7 +25,7 @@
 #include <string>
 #include <unordered_set>
 
-#include "com/centreon/broker/misc/processing_speed_computer.hh"
+#include "com/centreon/broker/stats/registry.hh"
 #include "com/centreon/broker/timestamp.hh"
 
 CCB_BEGIN()
@@ -35,14 +35,22 @@ namespace processing {
  *  @class stat_visitable stat_visitable.hh
  * "com/centreon/broker/processing/stat_visitable.hh"
  *  @brief Represent a processing thread that is visitable.
+ *
+ *  Its statistics are published in the stats registry by its owner with
+ *  set_stats_path(), usually as "endpoint <name>". The counters are
+ *  updated without lock, the statistics of the streams are gathered from
+ *  time to time by the processing thread with _publish_stats().
  */
 class stat_visitable {
-  std::string _last_error;
-  timestamp _last_connection_attempt;
-  timestamp _last_connection_success;
-  misc::processing_speed_computer _event_processing_speed;
-  std::atomic<char const*> _state;
-  std::atomic<uint32_t> _queued_events;
+  stats::group _stats;
+  std::shared_ptr<stats::text> _stats_state;
+  std::shared_ptr<stats::text> _stats_last_error;
+  std::shared_ptr<stats::gauge> _stats_last_connection_attempt;
+  std::shared_ptr<stats::gauge> _stats_last_connection_success;
+  std::shared_ptr<stats::gauge> _stats_last_event_at;
+  std::shared_ptr<stats::meter> _stats_speed;
+  std::shared_ptr<stats::gauge> _stats_queued_events;
+  std::shared_ptr<stats::tree> _stats_details;
 
  protected:
   const std::string _name;
@@ -52,6 +60,8 @@ class stat_visitable {
   virtual std::string const& _get_read_filters() const = 0;
   virtual std::string const& _get_write_filters() const = 0;
   virtual void _forward_statistic(json11::Json::object& tree);
+  virtual void _forward_details(json11::Json::object& tree);
+  void _publish_stats();
 
  public:
   stat_visitable(std::string const& name = std::string());
@@ -60,6 +70,8 @@ class stat_visitable {
   stat_visitable& operator=(stat_visitable const& other) = delete;
 
   std::string const& get_name() const;
+  std::string const& get_stats_path() const noexcept;
+  virtual void set_stats_path(std::string const& path);
   void set_last_error(std::string const& last_error);
   void set_state(char const* state);
   void set_queued_events(uint32_t);
@@ -30,6 +30,8 @@ void get_generic_stats(json11::Json::object& object) noexcept;
 void get_mysql_stats(json11::Json::object& object) noexcept;
 void get_loaded_module_stats(std::vector<json11::Json::object>& object) noexcept;
 bool get_endpoint_stats(std::vector<json11::Json::object>& object);
+void get_stage_stats(json11::Json::object& object) noexcept;
+std::string get_stage_prometheus();
 
 };
 
@@ -0,0 +1,93 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#ifndef CCB_STATS_HISTOGRAM_HH
+#define CCB_STATS_HISTOGRAM_HH
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "com/centreon/broker/namespace.hh"
+
+CCB_BEGIN()
+
+namespace stats {
+/**
+ *  @class histogram histogram.hh "com/centreon/broker/stats/histogram.hh"
+ *  @brief Latency histogram cheap enough to be fed from hot paths.
+ *
+ *  Values (usually nanoseconds) are counted in log-linear buckets: each
+ *  power of two is split in 16 buckets, so a bucket bound is at most 6%
+ *  away from the values it counts. Counters are sharded by thread, a
+ *  record is a few relaxed atomic increments on a cache line that other
+ *  threads seldom touch. Shards are only summed when a snapshot is taken.
+ */
+class histogram {
+ public:
+  static uint32_t const sub_bucket_bits = 4;
+  static uint32_t const sub_buckets = 1 << sub_bucket_bits;
+  // Values above 2^40 (about 18 minutes in nanoseconds) share the last
+  // bucket.
+  static uint32_t const max_power = 40;
+  static uint32_t const bucket_count =
+      (max_power - sub_bucket_bits + 2) * sub_buckets;
+  static uint32_t const shard_count = 8;
+
+  /**
+   *  Merged content of the shards.
+   */
+  struct snapshot {
+    uint64_t count;
+    uint64_t sum;
+    uint64_t max;
+    std::vector<uint64_t> buckets;
+
+    snapshot();
+    double mean() const;
+    uint64_t percentile(double p) const;
+  };
+
+  histogram();
+  histogram(histogram const&) = delete;
+  histogram& operator=(histogram const&) = delete;
+  void record(uint64_t value) noexcept;
+  void reset() noexcept;
+  snapshot get_snapshot() const;
+
+  static uint32_t bucket_of(uint64_t value) noexcept;
+  static uint64_t bucket_upper_bound(uint32_t bucket) noexcept;
+
+ private:
+  struct alignas(64) shard {
+    std::array<std::atomic<uint64_t>, bucket_count> buckets;
+    std::atomic<uint64_t> count;
+    std::atomic<uint64_t> sum;
+    std::atomic<uint64_t> max;
+  };
+
+  static uint32_t _shard_index() noexcept;
+
+  std::array<shard, shard_count> _shards;
+};
+}  // namespace stats
+
+CCB_END()
+
+#endif  // !CCB_STATS_HISTOGRAM_HH
@@ -0,0 +1,206 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#ifndef CCB_STATS_REGISTRY_HH
+#define CCB_STATS_REGISTRY_HH
+
+#include <array>
+#include <atomic>
+#include <ctime>
+#include <json11.hpp>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "com/centreon/broker/namespace.hh"
+
+CCB_BEGIN()
+
+namespace stats {
+/**
+ *  @class metric registry.hh "com/centreon/broker/stats/registry.hh"
+ *  @brief A value published in the statistics registry.
+ *
+ *  Metrics are updated by their owner without any lock, the registry only
+ *  reads them when a snapshot is taken.
+ */
+class metric {
+ public:
+  virtual ~metric() noexcept = default;
+  virtual json11::Json value() const = 0;
+};
+
+/**
+ *  Unsigned integer, usually a number of events.
+ */
+class counter : public metric {
+  std::atomic<uint64_t> _value;
+
+ public:
+  counter() : _value(0) {}
+  void add(uint64_t n = 1) noexcept {
+    _value.fetch_add(n, std::memory_order_relaxed);
+  }
+  void set(uint64_t n) noexcept { _value.store(n, std::memory_order_relaxed); }
+  uint64_t get() const noexcept {
+    return _value.load(std::memory_order_relaxed);
+  }
+  json11::Json value() const override;
+};
+
+/**
+ *  Floating value, also used for times.
+ */
+class gauge : public metric {
+  std::atomic<double> _value;
+
+ public:
+  gauge() : _value(0) {}
+  void set(double v) noexcept { _value.store(v, std::memory_order_relaxed); }
+  double get() const noexcept { return _value.load(std::memory_order_relaxed); }
+  json11::Json value() const override;
+};
+
+/**
+ *  String, replaced as a whole on each update. Meant for values that
+ *  seldom change, such as states.
+ */
+class text : public metric {
+  std::shared_ptr<std::string const> _value;
+
+ public:
+  text();
+  void set(std::string const& v);
+  std::string get() const;
+  json11::Json value() const override;
+};
+
+/**
+ *  Json object, replaced as a whole on each update. Statistics of streams
+ *  are gathered by the thread owning them and published this way, so that
+ *  readers never have to lock the stream.
+ */
+class tree : public metric {
+  std::shared_ptr<json11::Json const> _value;
+
+ public:
+  tree();
+  void set(json11::Json::object const& v);
+  json11::Json value() const override;
+};
+
+/**
+ *  Events per second over the last window_length seconds. Each second
+ *  has its own slot, reset by the first tick of a new second. A tick racing
+ *  with this reset may be lost, which is acceptable for statistics.
+ */
+class meter : public metric {
+ public:
+  static int const window_length = 30;
+
+  meter();
+  void tick(uint32_t events = 1) noexcept;
+  double get_speed() const noexcept;
+  time_t get_last_event_time() const noexcept;
+  json11::Json value() const override;
+
+ private:
+  std::array<std::atomic<uint32_t>, window_length> _events;
+  std::array<std::atomic<time_t>, window_length> _seconds;
+  std::atomic<time_t> _last_tick;
+};
+
+/**
+ *  @class registry registry.hh "com/centreon/broker/stats/registry.hh"
+ *  @brief Table of all the published metrics.
+ *
+ *  Metrics are referenced by a path made of components separated by '/',
+ *  a snapshot gives them back as a json tree built from these paths. The
+ *  table is copied on each registration, snapshots only take a reference
+ *  on the current table and never block the registration nor the owners
+ *  of the metrics.
+ */
+class registry {
+ public:
+  typedef std::vector<std::pair<std::string, std::shared_ptr<metric> > >
+      metric_list;
+
+  static registry& instance();
+  registry(registry const&) = delete;
+  registry& operator=(registry const&) = delete;
+  void add(std::string const& path, metric_list const& metrics);
+  void remove(std::string const& path, metric_list const& metrics);
+  json11::Json::object snapshot(
+      std::vector<std::string> const& subtrees =
+          std::vector<std::string>()) const;
+
+ private:
+  typedef std::map<std::string, std::shared_ptr<metric> > metric_map;
+
+  registry();
+
+  std::mutex _update_m;
+  std::shared_ptr<metric_map const> _metrics;
+};
+
+/**
+ *  @class group registry.hh "com/centreon/broker/stats/registry.hh"
+ *  @brief Metrics of an object, published together under one path.
+ *
+ *  The metrics are withdrawn from the registry when the group is destroyed.
+ */
+class group {
+ public:
+  group() = default;
+  ~group() noexcept;
+  group(group const&) = delete;
+  group& operator=(group const&) = delete;
+
+  /**
+   *  Create a metric in this group.
+   *
+   *  @param[in] name  Name of the metric relative to the group path, empty
+   *                   for a tree metric merged into the group node.
+   *
+   *  @return The metric.
+   */
+  template <typename T>
+  std::shared_ptr<T> add(std::string const& name) {
+    std::shared_ptr<T> retval(std::make_shared<T>());
+    _metrics.emplace_back(name, retval);
+    if (!_path.empty())
+      registry::instance().add(_path, {_metrics.back()});
+    return retval;
+  }
+
+  std::string const& path() const noexcept;
+  void publish(std::string const& path);
+  void unpublish() noexcept;
+
+ private:
+  std::string _path;
+  registry::metric_list _metrics;
+};
+}  // namespace stats
+
+CCB_END()
+
+#endif  // !CCB_STATS_REGISTRY_HH
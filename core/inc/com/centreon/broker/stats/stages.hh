@@ -0,0 +1,70 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#ifndef CCB_STATS_STAGES_HH
+#define CCB_STATS_STAGES_HH
+
+#include <chrono>
+
+#include "com/centreon/broker/namespace.hh"
+#include "com/centreon/broker/stats/histogram.hh"
+
+CCB_BEGIN()
+
+namespace stats {
+/**
+ *  Pipeline stages whose durations are recorded, in nanoseconds.
+ */
+enum stage {
+  stage_bbdo_decode = 0,
+  stage_engine_publish,
+  stage_muxer_queue_wait,
+  stage_stream_write,
+  stage_sql_commit,
+  stage_rrd_update,
+  stage_count
+};
+
+char const* stage_name(stage s) noexcept;
+histogram& stage_histogram(stage s) noexcept;
+
+/**
+ *  @class stage_timer stages.hh "com/centreon/broker/stats/stages.hh"
+ *  @brief Record the lifetime of the object in a stage histogram.
+ */
+class stage_timer {
+  histogram& _histogram;
+  std::chrono::steady_clock::time_point _start;
+
+ public:
+  explicit stage_timer(stage s) noexcept
+      : _histogram(stage_histogram(s)),
+        _start(std::chrono::steady_clock::now()) {}
+  stage_timer(stage_timer const&) = delete;
+  stage_timer& operator=(stage_timer const&) = delete;
+  ~stage_timer() noexcept {
+    _histogram.record(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          std::chrono::steady_clock::now() - _start)
+                          .count());
+  }
+};
+}  // namespace stats
+
+CCB_END()
+
+#endif  // !CCB_STATS_STAGES_HH
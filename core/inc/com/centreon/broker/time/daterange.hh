@@ -86,7 +86,10 @@ class daterange {
   void year_start(uint32_t value);
   uint32_t year_start() const throw();
 
-  bool to_time_t(time_t const preferred_time, time_t& start, time_t& end) const;
+  bool to_time_t(time_t const preferred_time,
+                 time_t& start,
+                 time_t& end,
+                 timezone_rules const& tz = timezone_rules::local()) const;
 
   static bool build_calendar_date(std::string const& line,
                                   std::vector<std::list<daterange> >& list);
@@ -97,7 +100,9 @@ class daterange {
       std::vector<std::list<daterange> >& list);
 
  private:
-  bool _calendar_date_to_time_t(time_t& start, time_t& end) const;
+  bool _calendar_date_to_time_t(time_info const& ti,
+                                time_t& start,
+                                time_t& end) const;
   bool _month_date_to_time_t(time_info const& ti,
                              time_t& start,
                              time_t& end) const;
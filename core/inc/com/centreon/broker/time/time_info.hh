@@ -21,6 +21,7 @@
 
 #include <ctime>
 #include "com/centreon/broker/namespace.hh"
+#include "com/centreon/broker/time/timezone_rules.hh"
 
 CCB_BEGIN()
 
@@ -30,6 +31,7 @@ namespace time {
  *  @brief  Internal struct time information.
  */
 struct time_info {
+  timezone_rules const* tz;
   time_t midnight;
   time_t preferred_time;
   tm preftime;
@@ -21,11 +21,14 @@
 
 #include <list>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 #include "com/centreon/broker/namespace.hh"
 #include "com/centreon/broker/time/daterange.hh"
 #include "com/centreon/broker/time/timerange.hh"
+#include "com/centreon/broker/time/timezone_rules.hh"
 
 CCB_BEGIN()
 
@@ -35,6 +38,10 @@ namespace time {
  *  @brief Timeperiod object.
  *
  *  The object containing a timeperiod.
+ *
+ *  Valid intervals are materialized lazily over a sliding window of
+ *  cache_days days, so that lookups are binary searches. The cache is
+ *  dropped each time the timeperiod is modified.
  */
 class timeperiod {
  public:
@@ -111,9 +118,23 @@ class timeperiod {
 
   uint32_t duration_intersect(time_t start_time, time_t end_time) const;
 
-  static time_t add_round_days_to_midnight(time_t midnight, long long skip);
+  static time_t add_round_days_to_midnight(
+      time_t midnight,
+      long long skip,
+      timezone_rules const& tz = timezone_rules::local());
 
  private:
+  static int const cache_days = 93;
+
+  time_t _get_next_valid(time_t preferred_time) const;
+  time_t _get_next_invalid(time_t preferred_time) const;
+  time_t _midnight(time_t t) const;
+  std::vector<std::pair<time_t, time_t> >::const_iterator _find_interval(
+      time_t t,
+      time_t& limit) const;
+  void _build_cache(time_t midnight) const;
+  void _invalidate_cache();
+
   uint32_t _id;
   std::string _alias;
   std::vector<std::list<daterange> > _exceptions;
@@ -122,6 +143,14 @@ class timeperiod {
   std::string _timeperiod_name;
   std::vector<std::list<timerange> > _timeranges;
   std::string _timezone;
+  std::shared_ptr<timezone_rules const> _tz;
+
+  // Sorted valid [start, end) intervals, exact in [_cache_start,
+  // _cache_end).
+  mutable std::mutex _cache_m;
+  mutable std::vector<std::pair<time_t, time_t> > _cache;
+  mutable time_t _cache_start;
+  mutable time_t _cache_end;
 };
 }  // namespace time
 
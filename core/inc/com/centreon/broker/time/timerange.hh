@@ -23,6 +23,7 @@
 #include <list>
 #include <string>
 #include "com/centreon/broker/namespace.hh"
+#include "com/centreon/broker/time/timezone_rules.hh"
 
 CCB_BEGIN()
 
@@ -53,7 +54,8 @@ class timerange {
 
   bool to_time_t(struct tm const& midnight,
                  time_t& range_start,
-                 time_t& range_end) const;
+                 time_t& range_end,
+                 timezone_rules const& tz = timezone_rules::local()) const;
 
   static bool build_timeranges_from_string(std::string const& line,
                                            std::list<timerange>& timeranges);
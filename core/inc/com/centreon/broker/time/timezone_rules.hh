@@ -0,0 +1,91 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#ifndef CCB_CORE_TIME_TIMEZONE_RULES_HH
+#define CCB_CORE_TIME_TIMEZONE_RULES_HH
+
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <vector>
+#include "com/centreon/broker/namespace.hh"
+
+CCB_BEGIN()
+
+namespace time {
+/**
+ *  @class timezone_rules timezone_rules.hh
+ * "com/centreon/broker/time/timezone_rules.hh"
+ *  @brief Offsets of a timezone.
+ *
+ *  Rules are read from the TZif files of the system timezone database or
+ *  from a POSIX TZ string. Objects are immutable once loaded, so
+ *  conversions between UTC and local time can run concurrently without
+ *  touching the TZ environment variable nor taking any lock. Loaded
+ *  timezones are cached by name.
+ */
+class timezone_rules {
+ public:
+  timezone_rules();
+  timezone_rules(timezone_rules const& other) = delete;
+  timezone_rules& operator=(timezone_rules const& other) = delete;
+  ~timezone_rules();
+  static std::shared_ptr<timezone_rules const> get(std::string const& name);
+  static timezone_rules const& local();
+  static timezone_rules const& utc();
+  std::string const& get_name() const noexcept;
+  int32_t offset(time_t t, bool* is_dst = nullptr) const;
+  void localtime(time_t t, struct tm& result) const;
+  time_t mktime(struct tm& t) const;
+
+ private:
+  struct type {
+    int32_t utoff;
+    bool is_dst;
+  };
+  struct rule {
+    enum { julian, day_of_year, month_week_day } kind;
+    int month;
+    int week;
+    int day;
+    int32_t time;
+  };
+
+  bool _load_file(std::string const& path);
+  bool _parse_posix(std::string const& str);
+  int64_t _rule_time(rule const& r, int year) const;
+  int32_t _posix_offset(time_t t, bool* is_dst) const;
+
+  std::string _name;
+  std::vector<int64_t> _transitions;
+  std::vector<uint8_t> _transition_types;
+  std::vector<type> _types;
+  // POSIX rule used after the last transition.
+  bool _has_posix;
+  bool _has_dst;
+  type _std;
+  type _dst;
+  rule _dst_start;
+  rule _dst_end;
+};
+}  // namespace time
+
+CCB_END()
+
+#endif  // !CCB_CORE_TIME_TIMEZONE_RULES_HH
@@ -34,6 +34,7 @@
 #include "com/centreon/broker/logging/logging.hh"
 #include "com/centreon/broker/misc/misc.hh"
 #include "com/centreon/broker/misc/string.hh"
+#include "com/centreon/broker/stats/stages.hh"
 
 using namespace com::centreon::broker;
 using namespace com::centreon::broker::bbdo;
@@ -863,7 +864,11 @@ bool stream::_read_any(std::shared_ptr<io::data>& d, time_t deadline) {
 
         // Maybe it is bigger now.
         packet_size = content.size();
-        d.reset(unserialize(event_id, source_id, dest_id, pack, packet_size));
+        {
+          stats::stage_timer timer(stats::stage_bbdo_decode);
+          d.reset(
+              unserialize(event_id, source_id, dest_id, pack, packet_size));
+        }
         if (d) {
           log_v2::bbdo()->debug("unserialized {} bytes for event of type {}",
                                 BBDO_HEADER_SIZE + packet_size, event_id);
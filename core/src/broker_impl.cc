@@ -23,6 +23,8 @@
 #include "com/centreon/broker/config/applier/modules.hh"
 #include "com/centreon/broker/log_v2.hh"
 #include "com/centreon/broker/stats/helper.hh"
+#include "com/centreon/broker/stats/registry.hh"
+#include "com/centreon/broker/stats/stages.hh"
 #include "com/centreon/broker/version.hh"
 
 using namespace com::centreon::broker;
@@ -212,3 +214,56 @@ grpc::Status broker_impl::GetSqlStats(grpc::ServerContext* context,
   response->set_str_arg(std::move(val.dump()));
   return grpc::Status::OK;
 }
+
+/**
+ * @brief Return the durations of the pipeline stages.
+ *
+ * @param context gRPC context
+ * @param  unused
+ * @param response The list of stages to fill
+ *
+ * @return Status::OK
+ */
+grpc::Status broker_impl::GetStageStats(
+    grpc::ServerContext* context,
+    const ::google::protobuf::Empty* request,
+    StageStatsList* response) {
+  for (int i = 0; i < stats::stage_count; ++i) {
+    stats::stage s(static_cast<stats::stage>(i));
+    stats::histogram::snapshot snap(stats::stage_histogram(s).get_snapshot());
+    StageStats* st(response->add_stages());
+    st->set_name(stats::stage_name(s));
+    st->set_count(snap.count);
+    st->set_sum(snap.sum);
+    st->set_max(snap.max);
+    st->set_p50(snap.percentile(0.5));
+    st->set_p90(snap.percentile(0.9));
+    st->set_p99(snap.percentile(0.99));
+    st->set_p999(snap.percentile(0.999));
+    for (uint32_t j = 0; j < snap.buckets.size(); ++j)
+      if (snap.buckets[j]) {
+        StageBucket* b(st->add_buckets());
+        b->set_upper_bound(stats::histogram::bucket_upper_bound(j));
+        b->set_count(snap.buckets[j]);
+      }
+  }
+  return grpc::Status::OK;
+}
+
+grpc::Status broker_impl::GetPrometheusMetrics(
+    grpc::ServerContext* context,
+    const ::google::protobuf::Empty* request,
+    GenericString* response) {
+  response->set_str_arg(stats::get_stage_prometheus());
+  return grpc::Status::OK;
+}
+
+grpc::Status broker_impl::GetStats(grpc::ServerContext* context,
+                                   const StatsQuery* request,
+                                   GenericString* response) {
+  std::vector<std::string> subtrees(request->subtrees().begin(),
+                                    request->subtrees().end());
+  json11::Json val(stats::registry::instance().snapshot(subtrees));
+  response->set_str_arg(val.dump());
+  return grpc::Status::OK;
+}
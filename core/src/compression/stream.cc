@@ -138,7 +138,7 @@ bool stream::read(std::shared_ptr<io::data>& data, time_t deadline) {
         _rbuffer.pop(1);
         corrupted = true;
       } else {
-        logging::debug(logging::low)
+        LOGGING_DEBUG(logging::low)
             << "compression: " << this << " uncompressed "
             << size + sizeof(int32_t) << " bytes to " << r->size() << " bytes";
         data = r;
@@ -252,7 +252,7 @@ void stream::_flush() {
     std::shared_ptr<io::raw> compressed(new io::raw);
     std::vector<char>& data(compressed->get_buffer());
     data = std::move(zlib::compress(_wbuffer, _level));
-    logging::debug(logging::low)
+    LOGGING_DEBUG(logging::low)
         << "compression: " << this << " compressed " << _wbuffer.size()
         << " bytes to " << compressed->size() << " bytes (level " << _level
         << ")";
@@ -178,6 +178,7 @@ void endpoint::apply(std::list<config::endpoint> const& endpoints) {
         endp.reset(acceptr.release());
       } else
         endp.reset(_create_failover(ep, s, e, endp_to_create));
+      endp->set_stats_path("endpoint " + ep.name);
       {
         std::lock_guard<std::timed_mutex> lock(_endpointsm);
         _endpoints[ep] = endp.get();
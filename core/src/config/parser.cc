@@ -27,8 +27,10 @@
 #include <streambuf>
 
 #include "com/centreon/broker/exceptions/msg.hh"
+#include "com/centreon/broker/logging/async_sink.hh"
 #include "com/centreon/broker/logging/defines.hh"
 #include "com/centreon/broker/misc/string.hh"
+#include "com/centreon/broker/multiplexing/async_publisher.hh"
 
 using namespace com::centreon::broker;
 using namespace com::centreon::broker::config;
@@ -147,7 +149,20 @@ state parser::parse(std::string const& file) {
                                      &state::log_human_readable_timestamp,
                                      &Json::is_bool, &Json::bool_value))
         ;
-      else if (object.first == "output") {
+      else if (object.first == "log") {
+        if (object.second.is_object())
+          _parse_log(object.second, retval);
+        else
+          throw exceptions::msg() << "config parser: cannot parse key "
+                                  << "'log':  value type must be an object";
+      } else if (object.first == "publisher") {
+        if (object.second.is_object())
+          _parse_publisher(object.second, retval);
+        else
+          throw exceptions::msg()
+              << "config parser: cannot parse key "
+              << "'publisher':  value type must be an object";
+      } else if (object.first == "output") {
         if (object.second.is_array()) {
           for (Json const& node : object.second.array_items()) {
             endpoint out(endpoint::io_type::output);
@@ -278,6 +293,73 @@ void parser::_parse_endpoint(Json const& elem, endpoint& e) {
   }
 }
 
+/**
+ *  Parse the configuration of the log_v2 loggers.
+ *
+ *  @param[in]  elem JSON object of the "log" key.
+ *  @param[out] s    State to fill.
+ */
+void parser::_parse_log(Json const& elem, state& s) {
+  for (std::pair<std::string const, Json> const& object :
+       elem.object_items()) {
+    if (get_conf<bool, state>(object, "async", s, &state::log_async,
+                              &Json::is_bool, &Json::bool_value))
+      ;
+    else if (get_conf<int, state>(object, "queue_size", s,
+                                  &state::log_queue_size, &Json::is_number,
+                                  &Json::int_value)) {
+      if (object.second.int_value() <= 0)
+        throw exceptions::msg() << "config parser: cannot parse key "
+                                << "'queue_size': value must be positive";
+    } else if (get_conf<std::string const&, state>(
+                   object, "overflow_policy", s, &state::log_overflow_policy,
+                   &Json::is_string, &Json::string_value)) {
+      logging::async_sink::overflow_policy p;
+      if (!logging::async_sink::parse_policy(s.log_overflow_policy(), p))
+        throw exceptions::msg()
+            << "config parser: unknown log overflow policy '"
+            << s.log_overflow_policy()
+            << "', expected 'block', 'drop_oldest' or 'drop'";
+    }
+  }
+}
+
+/**
+ *  Parse the configuration of the publisher of the cbmod module.
+ *
+ *  @param[in]  elem JSON object of the "publisher" key.
+ *  @param[out] s    State to fill.
+ */
+void parser::_parse_publisher(Json const& elem, state& s) {
+  for (std::pair<std::string const, Json> const& object :
+       elem.object_items()) {
+    if (get_conf<bool, state>(object, "async", s, &state::publisher_async,
+                              &Json::is_bool, &Json::bool_value))
+      ;
+    else if (get_conf<int, state>(object, "queue_size", s,
+                                  &state::publisher_queue_size,
+                                  &Json::is_number, &Json::int_value)) {
+      if (object.second.int_value() <= 0)
+        throw exceptions::msg() << "config parser: cannot parse key "
+                                << "'queue_size': value must be positive";
+    } else if (get_conf<std::string const&, state>(
+                   object, "overflow_policy", s,
+                   &state::publisher_overflow_policy, &Json::is_string,
+                   &Json::string_value)) {
+      multiplexing::async_publisher::overflow_policy p;
+      if (!multiplexing::async_publisher::parse_policy(
+              s.publisher_overflow_policy(), p))
+        throw exceptions::msg()
+            << "config parser: unknown publisher overflow policy '"
+            << s.publisher_overflow_policy()
+            << "', expected 'block', 'drop' or 'spill'";
+    } else if (get_conf<std::string const&, state>(
+                   object, "spill_file", s, &state::publisher_spill_file,
+                   &Json::is_string, &Json::string_value))
+      ;
+  }
+}
+
 /**
  *  Parse the configuration of a logging object.
  *
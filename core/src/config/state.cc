@@ -53,12 +53,19 @@ state::state(const state& other)
       _log_timestamp(other._log_timestamp),
       _log_human_readable_timestamp(other._log_human_readable_timestamp),
       _loggers(other._loggers),
+      _log_async(other._log_async),
+      _log_queue_size(other._log_queue_size),
+      _log_overflow_policy(other._log_overflow_policy),
       _module_dir(other._module_dir),
       _module_list(other._module_list),
       _params(other._params),
       _poller_id(other._poller_id),
       _poller_name(other._poller_name),
-      _pool_size(other._pool_size) {}
+      _pool_size(other._pool_size),
+      _publisher_async(other._publisher_async),
+      _publisher_queue_size(other._publisher_queue_size),
+      _publisher_overflow_policy(other._publisher_overflow_policy),
+      _publisher_spill_file(other._publisher_spill_file) {}
 
 /**
  *  Destructor.
@@ -86,12 +93,19 @@ state& state::operator=(state const& other) {
     _log_timestamp = other._log_timestamp;
     _log_human_readable_timestamp = other._log_human_readable_timestamp;
     _loggers = other._loggers;
+    _log_async = other._log_async;
+    _log_queue_size = other._log_queue_size;
+    _log_overflow_policy = other._log_overflow_policy;
     _module_dir = other._module_dir;
     _module_list = other._module_list;
     _params = other._params;
     _poller_id = other._poller_id;
     _poller_name = other._poller_name;
     _pool_size = other._pool_size;
+    _publisher_async = other._publisher_async;
+    _publisher_queue_size = other._publisher_queue_size;
+    _publisher_overflow_policy = other._publisher_overflow_policy;
+    _publisher_spill_file = other._publisher_spill_file;
   }
   return *this;
 }
@@ -114,12 +128,19 @@ void state::clear() {
   _log_human_readable_timestamp =
       com::centreon::broker::logging::file::with_human_redable_timestamp();
   _loggers.clear();
+  _log_async = false;
+  _log_queue_size = 8192;
+  _log_overflow_policy = "block";
   _module_dir.clear();
   _module_list.clear();
   _params.clear();
   _poller_id = 0;
   _poller_name.clear();
   _pool_size = 0;
+  _publisher_async = false;
+  _publisher_queue_size = 65536;
+  _publisher_overflow_policy = "block";
+  _publisher_spill_file.clear();
 }
 
 /**
@@ -268,6 +289,62 @@ bool state::flush_logs() const noexcept {
   return _flush_logs;
 }
 
+/**
+ *  Set whether or not log_v2 messages are written by a dedicated thread.
+ *
+ *  @param[in] async true to enable the asynchronous mode.
+ */
+void state::log_async(bool async) noexcept {
+  _log_async = async;
+}
+
+/**
+ *  Get whether or not log_v2 messages are written by a dedicated thread.
+ *
+ *  @return true if the asynchronous mode is enabled.
+ */
+bool state::log_async() const noexcept {
+  return _log_async;
+}
+
+/**
+ *  Set the maximum number of log messages waiting to be written in
+ *  asynchronous mode.
+ *
+ *  @param[in] size The queue size.
+ */
+void state::log_queue_size(int size) noexcept {
+  _log_queue_size = size;
+}
+
+/**
+ *  Get the maximum number of log messages waiting to be written in
+ *  asynchronous mode.
+ *
+ *  @return The queue size.
+ */
+size_t state::log_queue_size() const noexcept {
+  return _log_queue_size;
+}
+
+/**
+ *  Set what to do with a log message when the asynchronous queue is full.
+ *
+ *  @param[in] policy "block", "drop_oldest" or "drop".
+ */
+void state::log_overflow_policy(std::string const& policy) {
+  _log_overflow_policy = policy;
+}
+
+/**
+ *  Get what to do with a log message when the asynchronous queue is full.
+ *
+ *  @return The overflow policy.
+ */
+std::string const& state::log_overflow_policy() const noexcept {
+  return _log_overflow_policy;
+}
+
 /**
  *  Get the logger list.
  *
@@ -459,3 +536,81 @@ void state::rpc_port(uint16_t port) noexcept {
 uint16_t state::rpc_port(void) const noexcept {
   return _rpc_port;
 }
+
+/**
+ *  Set whether or not the events of the cbmod module are published by a
+ *  dedicated thread.
+ *
+ *  @param[in] async true to enable the asynchronous mode.
+ */
+void state::publisher_async(bool async) noexcept {
+  _publisher_async = async;
+}
+
+/**
+ *  Get whether or not the events of the cbmod module are published by a
+ *  dedicated thread.
+ *
+ *  @return true if the asynchronous mode is enabled.
+ */
+bool state::publisher_async() const noexcept {
+  return _publisher_async;
+}
+
+/**
+ *  Set the maximum number of events waiting to be published in asynchronous
+ *  mode.
+ *
+ *  @param[in] size The queue size.
+ */
+void state::publisher_queue_size(int size) noexcept {
+  _publisher_queue_size = size;
+}
+
+/**
+ *  Get the maximum number of events waiting to be published in asynchronous
+ *  mode.
+ *
+ *  @return The queue size.
+ */
+size_t state::publisher_queue_size() const noexcept {
+  return _publisher_queue_size;
+}
+
+/**
+ *  Set what to do with an event when the publisher queue is full.
+ *
+ *  @param[in] policy "block", "drop" or "spill".
+ */
+void state::publisher_overflow_policy(std::string const& policy) {
+  _publisher_overflow_policy = policy;
+}
+
+/**
+ *  Get what to do with an event when the publisher queue is full.
+ *
+ *  @return The overflow policy.
+ */
+std::string const& state::publisher_overflow_policy() const noexcept {
+  return _publisher_overflow_policy;
+}
+
+/**
+ *  Set the base path of the files where events are spilled when the
+ *  publisher queue is full.
+ *
+ *  @param[in] file The base path, empty for the default one.
+ */
+void state::publisher_spill_file(std::string const& file) {
+  _publisher_spill_file = file;
+}
+
+/**
+ *  Get the base path of the files where events are spilled when the
+ *  publisher queue is full.
+ *
+ *  @return The base path, empty for the default one.
+ */
+std::string const& state::publisher_spill_file() const noexcept {
+  return _publisher_spill_file;
+}
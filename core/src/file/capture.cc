@@ -0,0 +1,204 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#include "com/centreon/broker/file/capture.hh"
+
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#include "com/centreon/broker/io/raw.hh"
+
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::file;
+
+/**
+ *  Constructor.
+ *
+ *  @param[in] speed  Replay speed, 1 for the original speed, 0 for the
+ *                    maximum speed.
+ */
+capture::capture(double speed)
+    : io::stream("capture"),
+      _speed(speed),
+      _rpos(0),
+      _started(false),
+      _first_time(0),
+      _records(0),
+      _bytes(0),
+      _lag(0),
+      _max_lag(0) {}
+
+/**
+ *  Destructor.
+ */
+capture::~capture() noexcept {}
+
+/**
+ *  Fill the read buffer from the substream.
+ *
+ *  @param[in] size      Number of bytes wanted in the buffer.
+ *  @param[in] deadline  Timeout.
+ *
+ *  @return False if the substream timed out.
+ */
+bool capture::_get_data(size_t size, time_t deadline) {
+  if (_rpos) {
+    _rbuffer.erase(_rbuffer.begin(), _rbuffer.begin() + _rpos);
+    _rpos = 0;
+  }
+  while (_rbuffer.size() < size) {
+    std::shared_ptr<io::data> d;
+    if (!_substream->read(d, deadline))
+      return false;
+    if (d && d->type() == io::raw::static_type()) {
+      std::vector<char> const& r(
+          std::static_pointer_cast<io::raw>(d)->get_buffer());
+      _rbuffer.insert(_rbuffer.end(), r.begin(), r.end());
+    }
+  }
+  return true;
+}
+
+/**
+ *  Read the next record, waiting for its replay time. If the deadline
+ *  comes first, the record stays pending and is returned by the next call.
+ *
+ *  @param[out] d         Payload of the record.
+ *  @param[in]  deadline  Timeout.
+ *
+ *  @return Respect io::stream::read()'s return value.
+ */
+bool capture::read(std::shared_ptr<io::data>& d, time_t deadline) {
+  d.reset();
+
+  // Record header.
+  if (!_get_data(header_size, deadline))
+    return false;
+  unsigned char const* h(
+      reinterpret_cast<unsigned char const*>(_rbuffer.data()));
+  uint64_t time(0);
+  for (int i = 0; i < 8; ++i)
+    time = (time << 8) | h[i];
+  uint32_t size((h[8] << 24) | (h[9] << 16) | (h[10] << 8) | h[11]);
+
+  // Payload.
+  if (!_get_data(header_size + size, deadline))
+    return false;
+
+  // Wait for the replay time of the record.
+  std::chrono::steady_clock::time_point now(std::chrono::steady_clock::now());
+  if (!_started) {
+    _started = true;
+    _first_time = time;
+    _replay_start = now;
+  } else if (_speed > 0 && time > _first_time) {
+    std::chrono::steady_clock::time_point due(
+        _replay_start +
+        std::chrono::microseconds(
+            static_cast<int64_t>((time - _first_time) / _speed)));
+    if (due > now) {
+      if (deadline != (time_t)-1) {
+        std::chrono::steady_clock::time_point limit(
+            now + (std::chrono::system_clock::from_time_t(deadline) -
+                   std::chrono::system_clock::now()));
+        if (limit < due) {
+          // The record is kept in the read buffer.
+          std::this_thread::sleep_until(limit);
+          return false;
+        }
+      }
+      std::this_thread::sleep_until(due);
+      _lag = 0;
+    } else {
+      _lag = std::chrono::duration<double>(now - due).count();
+      if (_lag > _max_lag)
+        _max_lag = _lag;
+    }
+  }
+
+  std::shared_ptr<io::raw> r(std::make_shared<io::raw>());
+  r->get_buffer().assign(_rbuffer.begin() + header_size,
+                         _rbuffer.begin() + header_size + size);
+  _rpos = header_size + size;
+  ++_records;
+  _bytes += size;
+  d = r;
+  return true;
+}
+
+/**
+ *  Get statistics.
+ *
+ *  @param[out] tree Output tree.
+ */
+void capture::statistics(json11::Json::object& tree) const {
+  tree["capture_records"] = static_cast<double>(_records);
+  tree["capture_bytes"] = static_cast<double>(_bytes);
+  if (_started) {
+    double elapsed(std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - _replay_start)
+                       .count());
+    tree["replay_speed"] = _speed;
+    tree["replay_elapsed"] = elapsed;
+    if (elapsed > 0)
+      tree["replay_records_per_second"] = _records / elapsed;
+    tree["replay_lag"] = _lag;
+    tree["replay_max_lag"] = _max_lag;
+  }
+  if (_substream)
+    _substream->statistics(tree);
+}
+
+/**
+ *  Record a chunk of data.
+ *
+ *  @param[in] d  Data to write.
+ *
+ *  @return Number of events acknowledged.
+ */
+int capture::write(std::shared_ptr<io::data> const& d) {
+  if (!validate(d, get_name()))
+    return 1;
+
+  if (d->type() == io::raw::static_type()) {
+    std::vector<char> const& payload(
+        std::static_pointer_cast<io::raw>(d)->get_buffer());
+    uint64_t time(std::chrono::duration_cast<std::chrono::microseconds>(
+                      std::chrono::system_clock::now().time_since_epoch())
+                      .count());
+    uint32_t size(payload.size());
+
+    std::shared_ptr<io::raw> r(std::make_shared<io::raw>());
+    std::vector<char>& buffer(r->get_buffer());
+    buffer.resize(header_size + size);
+    for (int i = 7; i >= 0; --i, time >>= 8)
+      buffer[i] = static_cast<char>(time & 0xff);
+    buffer[8] = static_cast<char>(size >> 24);
+    buffer[9] = static_cast<char>((size >> 16) & 0xff);
+    buffer[10] = static_cast<char>((size >> 8) & 0xff);
+    buffer[11] = static_cast<char>(size & 0xff);
+    if (size)
+      memcpy(buffer.data() + header_size, payload.data(), size);
+
+    ++_records;
+    _bytes += size;
+    _substream->write(r);
+  }
+  return 1;
+}
@@ -18,6 +18,7 @@
 
 #include "com/centreon/broker/file/factory.hh"
 
+#include <cstring>
 #include <memory>
 
 #include "com/centreon/broker/exceptions/msg.hh"
@@ -78,9 +79,40 @@ io::endpoint* factory::new_endpoint(
     filename = it->second;
   }
 
+  // Capture mode: chunks are timestamped and kept to be replayed.
+  bool capture(false);
+  double replay_speed(1.0);
+  {
+    std::map<std::string, std::string>::const_iterator it{
+        cfg.params.find("capture")};
+    if (it != cfg.params.end())
+      capture = !strcasecmp(it->second.c_str(), "yes");
+    it = cfg.params.find("replay_speed");
+    if (capture && it != cfg.params.end()) {
+      if (!strcasecmp(it->second.c_str(), "max"))
+        replay_speed = 0;
+      else if (strcasecmp(it->second.c_str(), "original")) {
+        try {
+          replay_speed = std::stod(it->second);
+        } catch (std::exception const& e) {
+          throw exceptions::msg()
+              << "file: 'replay_speed' of endpoint '" << cfg.name
+              << "' must be 'original', 'max' or a number";
+        }
+        if (replay_speed < 0)
+          throw exceptions::msg() << "file: 'replay_speed' of endpoint '"
+                                  << cfg.name << "' cannot be negative";
+      }
+    }
+  }
+
   // Generate opener.
   std::unique_ptr<opener> openr(new opener);
   openr->set_filename(filename);
+  if (capture) {
+    openr->set_auto_delete(false);
+    openr->set_capture(true, replay_speed);
+  }
   is_acceptor = false;
   return openr.release();
 }
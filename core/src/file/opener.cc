@@ -20,7 +20,9 @@
 
 #include <sstream>
 
+#include "com/centreon/broker/bbdo/stream.hh"
 #include "com/centreon/broker/exceptions/msg.hh"
+#include "com/centreon/broker/file/capture.hh"
 #include "com/centreon/broker/file/splitter.hh"
 #include "com/centreon/broker/file/stream.hh"
 
@@ -37,7 +39,11 @@ using namespace com::centreon::broker::file;
  *  Constructor.
  */
 opener::opener()
-    : io::endpoint(false), _auto_delete(true), _max_size(100000000) {}
+    : io::endpoint(false),
+      _auto_delete(true),
+      _capture(false),
+      _max_size(100000000),
+      _replay_speed(1.0) {}
 
 /**
  *  Copy constructor.
@@ -47,8 +53,10 @@ opener::opener()
 opener::opener(opener const& other)
     : io::endpoint(other),
       _auto_delete(other._auto_delete),
+      _capture(other._capture),
       _filename(other._filename),
-      _max_size(other._max_size) {}
+      _max_size(other._max_size),
+      _replay_speed(other._replay_speed) {}
 
 /**
  *  Destructor.
@@ -64,6 +72,13 @@ std::shared_ptr<io::stream> opener::open() {
   // Open splitted file.
   std::shared_ptr<io::stream> retval = std::make_shared<stream>(new splitter(
       _filename, fs_file::open_read_write_truncate, _max_size, _auto_delete));
+
+  // Record or replay timestamps.
+  if (_capture) {
+    std::shared_ptr<io::stream> c(std::make_shared<capture>(_replay_speed));
+    c->set_substream(retval);
+    retval = c;
+  }
   return retval;
 }
 
@@ -77,6 +92,19 @@ void opener::set_auto_delete(bool auto_delete) {
   return;
 }
 
+/**
+ *  Enable or disable the capture mode. In this mode, the write time of
+ *  each chunk is recorded and chunks are read back at the same pace.
+ *
+ *  @param[in] capture       True to enable the capture mode.
+ *  @param[in] replay_speed  Replay speed factor, 0 for the maximum speed.
+ */
+void opener::set_capture(bool capture, double replay_speed) {
+  _capture = capture;
+  _replay_speed = replay_speed;
+  return;
+}
+
 /**
  *  Set the filename.
  *
@@ -96,3 +124,22 @@ void opener::set_max_size(unsigned long long max) {
   _max_size = max;
   return;
 }
+
+/**
+ *  Open a BBDO stream on a single file, that is never split nor deleted
+ *  when read. Writes are appended to the file.
+ *
+ *  @param[in] path  Path of the file.
+ *
+ *  @return The BBDO stream.
+ */
+std::shared_ptr<io::stream> file::open_bbdo_file(std::string const& path) {
+  opener opnr;
+  opnr.set_filename(path);
+  opnr.set_auto_delete(false);
+  opnr.set_max_size(0);
+  std::shared_ptr<bbdo::stream> bs(new bbdo::stream);
+  bs->set_substream(opnr.open());
+  bs->set_coarse(true);
+  return bs;
+}
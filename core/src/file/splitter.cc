@@ -163,7 +163,7 @@ long splitter::read(void* buffer, long max_size) {
   // Read data.
   long rb = fread(buffer, 1, max_size, _rfile.get());
   std::string file_path(get_file_path(_rid));
-  logging::debug(logging::low)
+  LOGGING_DEBUG(logging::low)
       << "file: read " << rb << " bytes from '" << file_path << "'";
   _roffset += rb;
   if (rb == 0) {
@@ -240,8 +240,8 @@ long splitter::write(void const* buffer, long size) {
   fseek(_wfile.get(), _woffset, SEEK_SET);
 
   // Debug message.
-  logging::debug(logging::low) << "file: write request of " << size
-                               << " bytes for '" << get_file_path(_wid) << "'";
+  LOGGING_DEBUG(logging::low) << "file: write request of " << size
+                              << " bytes for '" << get_file_path(_wid) << "'";
 
   // Write data.
   long remaining = size;
@@ -22,6 +22,7 @@
 #include <spdlog/sinks/null_sink.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 
+#include <algorithm>
 #include <fstream>
 #include <json11.hpp>
 
@@ -37,27 +38,55 @@ static std::map<std::string, level::level_enum> dbg_lvls{
     {"err", level::err},     {"critical", level::critical},
     {"off", level::off}};
 
+std::array<std::string, log_v2::log_max> const log_v2::_names{
+    {"core", "config", "tls", "bbdo", "tcp", "sql", "perfdata", "lua",
+     "processing", "bam"}};
+
 log_v2& log_v2::instance() {
   static log_v2 instance;
   return instance;
 }
 
-log_v2::log_v2() {
+log_v2::log_v2()
+    : _async(false),
+      _async_queue_size(0),
+      _async_policy(logging::async_sink::block) {
   auto null_sink = std::make_shared<sinks::null_sink_mt>();
-  _tls_log = std::make_shared<logger>("tls", null_sink);
-  _bbdo_log = std::make_shared<logger>("bbdo", null_sink);
-  _tcp_log = std::make_shared<logger>("tcp", null_sink);
-  _core_log = std::make_shared<logger>("core", null_sink);
-  _config_log = std::make_shared<logger>("config", null_sink);
-  _sql_log = std::make_shared<logger>("sql", null_sink);
-  _perfdata_log = std::make_shared<logger>("perfdata", null_sink);
-  _lua_log = std::make_shared<logger>("lua", null_sink);
-  _processing_log = std::make_shared<logger>("processing", null_sink);
-  _bam_log = std::make_shared<logger>("bam", null_sink);
+  for (int i = 0; i < log_max; i++) {
+    _log[i] = std::make_shared<logger>(_names[i], null_sink);
+    _log_ptr[i] = _log[i].get();
+  }
 }
 
 log_v2::~log_v2() {
-  _core_log->info("log finished");
+  _log[log_core]->info("log finished");
+}
+
+/**
+ *  Replace a logger. The previous one is kept alive until the next load
+ *  since other threads may still hold its raw pointer.
+ *
+ *  @param[in] id The logger to replace.
+ *  @param[in] l  The new logger.
+ */
+void log_v2::_set_logger(logger_id id, std::shared_ptr<spdlog::logger> l) {
+  _log_ptr[id].store(l.get(), std::memory_order_release);
+  _retired.emplace_back(std::move(_log[id]));
+  _log[id] = std::move(l);
+}
+
+/**
+ *  Release the loggers retired by the previous load. A raw pointer is only
+ *  used for the duration of a log call, so they are not in use anymore,
+ *  unless someone else still holds them. An old async_sink goes away with
+ *  its last logger, it writes its remaining messages and stops its thread.
+ */
+void log_v2::_release_retired() {
+  _retired.erase(std::remove_if(_retired.begin(), _retired.end(),
+                                [](std::shared_ptr<spdlog::logger> const& l) {
+                                  return l.use_count() == 1;
+                                }),
+                 _retired.end());
 }
 
 static auto json_validate = [](Json const& js) -> bool {
@@ -93,6 +122,8 @@ bool log_v2::load(std::string const& file,
       return false;
 
     if (json_validate(js)) {
+      _release_retired();
+
       // reset loggers to null sink
       std::vector<sink_ptr> sinks{std::make_shared<sinks::null_sink_mt>()};
 
@@ -111,40 +142,35 @@ bool log_v2::load(std::string const& file,
         }
       }
 
-      _core_log = std::make_shared<logger>("core", sinks.begin(), sinks.end());
-      _core_log->set_level(level::info);
-      _core_log->flush_on(level::info);
-      _core_log->info("{} : log started", broker_name);
+      // Messages queued in the previous sink are written before it is
+      // released.
+      if (_async_sink)
+        _async_sink->flush();
+      if (_async) {
+        _async_sink = std::make_shared<logging::async_sink>(
+            sinks, _async_queue_size, _async_policy);
+        sinks = std::vector<sink_ptr>{_async_sink};
+      } else
+        _async_sink.reset();
+
+      auto core_log =
+          std::make_shared<logger>("core", sinks.begin(), sinks.end());
+      core_log->set_level(level::info);
+      core_log->flush_on(level::info);
+      core_log->info("{} : log started", broker_name);
+      _set_logger(log_core, core_log);
 
       for (auto& entry : js["loggers"].array_items()) {
-        std::shared_ptr<logger>* l;
-        if (entry["name"].string_value() == "core")
-          l = &_core_log;
-        else if (entry["name"].string_value() == "config")
-          l = &_config_log;
-        else if (entry["name"].string_value() == "tls")
-          l = &_tls_log;
-        else if (entry["name"].string_value() == "tcp")
-          l = &_tcp_log;
-        else if (entry["name"].string_value() == "bbdo")
-          l = &_bbdo_log;
-        else if (entry["name"].string_value() == "sql")
-          l = &_sql_log;
-        else if (entry["name"].string_value() == "perfdata")
-          l = &_perfdata_log;
-        else if (entry["name"].string_value() == "lua")
-          l = &_lua_log;
-        else if (entry["name"].string_value() == "processing")
-          l = &_processing_log;
-        else if (entry["name"].string_value() == "bam")
-          l = &_bam_log;
-        else
+        auto found = std::find(_names.begin(), _names.end(),
+                               entry["name"].string_value());
+        if (found == _names.end())
           continue;
 
-        *l = std::make_shared<logger>(entry["name"].string_value(),
-                                      sinks.begin(), sinks.end());
-        (*l)->set_level(dbg_lvls[entry["level"].string_value()]);
-        (*l)->flush_on(dbg_lvls[entry["level"].string_value()]);
+        auto l = std::make_shared<logger>(entry["name"].string_value(),
+                                          sinks.begin(), sinks.end());
+        l->set_level(dbg_lvls[entry["level"].string_value()]);
+        l->flush_on(dbg_lvls[entry["level"].string_value()]);
+        _set_logger(static_cast<logger_id>(found - _names.begin()), l);
       }
 
       return true;
@@ -158,42 +184,38 @@ bool log_v2::load(std::string const& file,
   return false;
 }
 
-std::shared_ptr<spdlog::logger> log_v2::core() {
-  return instance()._core_log;
-}
-
-std::shared_ptr<spdlog::logger> log_v2::config() {
-  return instance()._config_log;
-}
-
-std::shared_ptr<spdlog::logger> log_v2::tls() {
-  return instance()._tls_log;
-}
-
-std::shared_ptr<spdlog::logger> log_v2::bbdo() {
-  return instance()._bbdo_log;
-}
-
-std::shared_ptr<spdlog::logger> log_v2::tcp() {
-  return instance()._tcp_log;
-}
-
-std::shared_ptr<spdlog::logger> log_v2::sql() {
-  return instance()._sql_log;
-}
-
-std::shared_ptr<spdlog::logger> log_v2::perfdata() {
-  return instance()._perfdata_log;
+/**
+ *  Configure the asynchronous mode from the "log" section of the broker
+ *  configuration. It is applied by the next load(), so load() must be
+ *  called again to change the mode of the running loggers.
+ *
+ *  @param[in] conf The broker configuration.
+ */
+void log_v2::set_async(config::state const& conf) {
+  std::lock_guard<std::mutex> lock(_load_m);
+  _async = conf.log_async();
+  _async_queue_size = conf.log_queue_size();
+  if (!logging::async_sink::parse_policy(conf.log_overflow_policy(),
+                                         _async_policy))
+    _async_policy = logging::async_sink::block;
 }
 
-std::shared_ptr<spdlog::logger> log_v2::lua() {
-  return instance()._lua_log;
+bool log_v2::is_async() const {
+  std::lock_guard<std::mutex> lock(_load_m);
+  return static_cast<bool>(_async_sink);
 }
 
-std::shared_ptr<spdlog::logger> log_v2::processing() {
-  return instance()._processing_log;
+/**
+ *  Number of messages waiting to be written in asynchronous mode.
+ */
+size_t log_v2::queued_messages() const {
+  std::lock_guard<std::mutex> lock(_load_m);
+  return _async_sink ? _async_sink->queued() : 0;
 }
 
-std::shared_ptr<spdlog::logger> log_v2::bam() {
-  return instance()._bam_log;
+/**
+ *  Number of messages dropped because the asynchronous queue was full.
+ */
+uint64_t log_v2::dropped_messages() const {
+  return logging::async_sink::total_dropped();
 }
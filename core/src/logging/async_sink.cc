@@ -0,0 +1,186 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#include "com/centreon/broker/logging/async_sink.hh"
+
+using namespace com::centreon::broker::logging;
+
+std::atomic<uint64_t> async_sink::_total_dropped{0};
+
+/**
+ *  Constructor. The writer thread is started here.
+ *
+ *  @param[in] sinks      Sinks the messages are finally written to.
+ *  @param[in] queue_size Maximum number of messages waiting to be written.
+ *  @param[in] policy     What to do when the queue is full.
+ */
+async_sink::async_sink(std::vector<spdlog::sink_ptr> const& sinks,
+                       size_t queue_size,
+                       overflow_policy policy)
+    : _sinks(sinks),
+      _policy(policy),
+      _queue(queue_size),
+      _dropped(0),
+      _flush_requested(false),
+      _writer_waiting(false),
+      _exit(false),
+      _writer(&async_sink::_run, this) {}
+
+/**
+ *  Destructor. Remaining messages are written before the writer thread
+ *  exits.
+ */
+async_sink::~async_sink() {
+  {
+    std::lock_guard<std::mutex> lck(_writer_m);
+    _exit = true;
+  }
+  _writer_cv.notify_all();
+  _writer.join();
+}
+
+/**
+ *  Count a dropped message.
+ */
+void async_sink::_count_dropped() {
+  _dropped.fetch_add(1, std::memory_order_relaxed);
+  _total_dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ *  Wake up the writer thread if it is waiting for messages. The mutex is
+ *  only taken in that case.
+ */
+void async_sink::_wake_writer() {
+  if (_writer_waiting) {
+    std::lock_guard<std::mutex> lck(_writer_m);
+    _writer_cv.notify_one();
+  }
+}
+
+/**
+ *  Writer thread main loop.
+ */
+void async_sink::_run() {
+  spdlog::details::log_msg_buffer msg;
+  for (;;) {
+    while (_queue.try_pop(msg)) {
+      for (auto& s : _sinks)
+        if (s->should_log(msg.level))
+          s->log(msg);
+    }
+
+    if (_flush_requested.exchange(false))
+      for (auto& s : _sinks)
+        s->flush();
+
+    std::unique_lock<std::mutex> lck(_writer_m);
+    if (_exit && _queue.size() == 0)
+      break;
+    _writer_waiting = true;
+    if (_queue.size() == 0 && !_exit)
+      _writer_cv.wait_for(lck, std::chrono::milliseconds(100));
+    _writer_waiting = false;
+  }
+  for (auto& s : _sinks)
+    s->flush();
+}
+
+/**
+ *  Queue a message. This is called by the loggers in the caller thread.
+ *
+ *  @param[in] msg The message to log.
+ */
+void async_sink::log(spdlog::details::log_msg const& msg) {
+  spdlog::details::log_msg_buffer m(msg);
+  while (!_queue.try_push(m)) {
+    switch (_policy) {
+      case drop:
+        _count_dropped();
+        return;
+      case drop_oldest: {
+        spdlog::details::log_msg_buffer old;
+        if (_queue.try_pop(old))
+          _count_dropped();
+      } break;
+      default:
+        _wake_writer();
+        std::this_thread::yield();
+    }
+  }
+  _wake_writer();
+}
+
+/**
+ *  Ask the writer thread to flush the sinks.
+ */
+void async_sink::flush() {
+  _flush_requested = true;
+}
+
+void async_sink::set_pattern(std::string const& pattern) {
+  for (auto& s : _sinks)
+    s->set_pattern(pattern);
+}
+
+void async_sink::set_formatter(std::unique_ptr<spdlog::formatter> f) {
+  for (auto& s : _sinks)
+    s->set_formatter(f->clone());
+}
+
+/**
+ *  Number of messages dropped by this sink.
+ */
+uint64_t async_sink::dropped() const noexcept {
+  return _dropped;
+}
+
+/**
+ *  Approximate number of messages waiting to be written.
+ */
+size_t async_sink::queued() const noexcept {
+  return _queue.size();
+}
+
+/**
+ *  Number of messages dropped by all the async sinks since the start.
+ */
+uint64_t async_sink::total_dropped() noexcept {
+  return _total_dropped;
+}
+
+/**
+ *  Convert an overflow policy name into its value.
+ *
+ *  @param[in]  str    "block", "drop_oldest" or "drop".
+ *  @param[out] policy The policy.
+ *
+ *  @return false if the name is unknown.
+ */
+bool async_sink::parse_policy(std::string const& str,
+                              overflow_policy& policy) {
+  if (str == "block")
+    policy = block;
+  else if (str == "drop_oldest")
+    policy = drop_oldest;
+  else if (str == "drop")
+    policy = drop;
+  else
+    return false;
+  return true;
+}
@@ -60,18 +60,25 @@ static struct option long_options[] = {
   {0, 0, 0, 0}
 };
 
+// Set by the SIGHUP handler, the update is done by the main loop.
+static volatile sig_atomic_t gl_update_requested(0);
+
 /**
  *  Function called when updating configuration (when program receives
- *  SIGHUP).
+ *  SIGHUP). Only async-signal-safe operations can be done here, so the
+ *  update is just requested to the main loop.
  *
  *  @param[in] signum Signal number.
  */
 static void hup_handler(int signum) {
   (void)signum;
+  gl_update_requested = 1;
+}
 
-  // Disable SIGHUP handling during handler execution.
-  signal(SIGHUP, SIG_IGN);
-
+/**
+ *  Update configuration, called by the main loop after a SIGHUP.
+ */
+static void update_configuration() {
   // Log message.
   log_v2::core()->info("main: configuration update requested");
   logging::config(logging::high) << "main: configuration update requested";
@@ -84,6 +91,11 @@ static void hup_handler(int signum) {
     try {
       // Apply resulting configuration.
       config::applier::state::instance().apply(conf);
+      log_v2::instance().set_async(conf);
+      std::string err;
+      if (!log_v2::instance().load("/etc/centreon-broker/log-config.json",
+                                   conf.broker_name(), err))
+        logging::error(logging::low) << err;
 
       gl_state = conf;
     } catch (std::exception const& e) {
@@ -105,9 +117,6 @@ static void hup_handler(int signum) {
     logging::config(logging::high)
         << "main: configuration update failed: unknown exception";
   }
-
-  // Reenable SIGHUP handler.
-  signal(SIGHUP, &hup_handler);
 }
 
 /**
@@ -300,6 +309,7 @@ int main(int argc, char* argv[]) {
         config::applier::state::instance().apply(conf, !check);
         std::string err;
         broker_name = conf.broker_name();
+        log_v2::instance().set_async(conf);
         if (!log_v2::instance().load("/etc/centreon-broker/log-config.json",
                                      broker_name, err))
           logging::error(logging::low) << err;
@@ -339,6 +349,10 @@ int main(int argc, char* argv[]) {
       if (!check)
         for (;;) {
           std::this_thread::sleep_for(std::chrono::seconds(1));
+          if (gl_update_requested) {
+            gl_update_requested = 0;
+            update_configuration();
+          }
         }
       else
         retval = EXIT_SUCCESS;
@@ -94,16 +94,15 @@ bool string::is_number(const std::string& s) {
 }
 
 /**
- * @brief Checks if the string given as parameter is a real UTF-8 string.
- * If it is not, it tries to convert it to UTF-8. Encodings correctly changed
- * are ISO-8859-15 and CP-1252.
+ * @brief Find the first byte of a string that does not belong to a valid
+ * UTF-8 sequence.
  *
  * @param str The string to check
  *
- * @return The string itself or a new string converted to UTF-8. The output
- * string should always be an UTF-8 string.
+ * @return An iterator to this byte, str.end() if the string is UTF-8.
  */
-std::string string::check_string_utf8(std::string const& str) noexcept {
+static std::string::const_iterator first_non_utf8(
+    std::string const& str) noexcept {
   uint32_t val;
   std::string::const_iterator it;
   for (it = str.begin(); it != str.end();) {
@@ -141,6 +140,59 @@ std::string string::check_string_utf8(std::string const& str) noexcept {
     break;
   }
 
+  return it;
+}
+
+/**
+ * @brief Tells if the string given as parameter is a valid UTF-8 string.
+ *
+ * @param str The string to check
+ *
+ * @return true if it is.
+ */
+bool string::is_utf8(std::string const& str) noexcept {
+  return first_non_utf8(str) == str.end();
+}
+
+/**
+ *  Append a string converted to UTF-8 to another one. Contrary to
+ *  check_string_utf8(), nothing is allocated when the string is already
+ *  UTF-8 and the destination has enough capacity.
+ *
+ *  @param[out] dest The destination string.
+ *  @param[in]  str  The string to append.
+ */
+void string::append_utf8(std::string& dest, std::string const& str) {
+  if (is_utf8(str))
+    dest.append(str);
+  else
+    dest.append(check_string_utf8(str));
+}
+
+/**
+ *  Set a string to another one converted to UTF-8, the memory already
+ *  held by the destination is reused.
+ *
+ *  @param[out] dest The destination string.
+ *  @param[in]  str  The string.
+ */
+void string::assign_utf8(std::string& dest, std::string const& str) {
+  dest.clear();
+  append_utf8(dest, str);
+}
+
+/**
+ * @brief Checks if the string given as parameter is a real UTF-8 string.
+ * If it is not, it tries to convert it to UTF-8. Encodings correctly changed
+ * are ISO-8859-15 and CP-1252.
+ *
+ * @param str The string to check
+ *
+ * @return The string itself or a new string converted to UTF-8. The output
+ * string should always be an UTF-8 string.
+ */
+std::string string::check_string_utf8(std::string const& str) noexcept {
+  std::string::const_iterator it{first_non_utf8(str)};
   if (it == str.end())
     return str;
 
@@ -112,14 +112,14 @@ void handle::close() {
     }
     // Call deinitialization routine.
     else {
-      logging::debug(logging::low)
+      LOGGING_DEBUG(logging::low)
           << "modules: running deinitialization routine of '" << _filename
           << "'";
       (*(sym.code))();
     }
 
     // Reset library handle.
-    logging::debug(logging::low)
+    LOGGING_DEBUG(logging::low)
         << "modules: unloading library '" << _filename << "'";
     // Library was not unloaded.
     if (dlclose(_handle)) {
@@ -190,7 +190,7 @@ void handle::update(void const* arg) {
 
   // Found routine.
   if (sym.data) {
-    logging::debug(logging::low)
+    LOGGING_DEBUG(logging::low)
         << "modules: running update routine of '" << _filename << "'";
     (*(void (*)(void const*))(sym.code))(arg);
   }
@@ -207,8 +207,8 @@ void handle::update(void const* arg) {
  */
 void handle::_check_version() {
   // Find version symbol.
-  logging::debug(logging::low) << "modules: checking module version (symbol "
-                               << versionning << ") in '" << _filename << "'";
+  LOGGING_DEBUG(logging::low) << "modules: checking module version (symbol "
+                              << versionning << ") in '" << _filename << "'";
 
   char const** version = (char const**)dlsym(_handle, versionning);
 
@@ -0,0 +1,395 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#include "com/centreon/broker/multiplexing/async_publisher.hh"
+
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+
+#include "com/centreon/broker/exceptions/shutdown.hh"
+#include "com/centreon/broker/file/opener.hh"
+#include "com/centreon/broker/log_v2.hh"
+#include "com/centreon/broker/misc/filesystem.hh"
+#include "com/centreon/broker/multiplexing/engine.hh"
+
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::multiplexing;
+
+// Maximum number of events published at once by the thread.
+static size_t const max_batch_size(1000);
+
+/**
+ *  Default constructor.
+ */
+async_publisher::async_publisher()
+    : _policy(block),
+      _started(false),
+      _spilling(false),
+      _dropped(0),
+      _spilled(0),
+      _thread_waiting(false),
+      _exit(false),
+      _spill_id(0) {}
+
+/**
+ *  Destructor. The thread is stopped if it is still running.
+ */
+async_publisher::~async_publisher() noexcept {
+  try {
+    stop();
+  } catch (std::exception const& e) {
+    log_v2::core()->error("publisher: error while stopping: {}", e.what());
+  }
+}
+
+/**
+ *  Start the publishing thread. From now on, write() only queues events.
+ *
+ *  @param[in] queue_size  Maximum number of events waiting to be published.
+ *  @param[in] policy      What to do when the queue is full.
+ *  @param[in] spill_file  Base path of the spill files, used with the spill
+ *                         policy.
+ */
+void async_publisher::start(size_t queue_size,
+                            overflow_policy policy,
+                            std::string const& spill_file) {
+  if (_started)
+    return;
+  _queue.reset(
+      new misc::mpmc_queue<std::shared_ptr<io::data>>(queue_size));
+  _policy = policy;
+  _spill_file = spill_file;
+  _exit = false;
+  if (_policy == spill)
+    _load_spill_files();
+  _started = true;
+  _thread = std::thread(&async_publisher::_run, this);
+  log_v2::core()->info(
+      "publisher: events are published asynchronously, queue of {} events",
+      _queue->capacity());
+}
+
+/**
+ *  Stop the publishing thread. Waiting events are published before it
+ *  exits, then write() publishes events directly again.
+ */
+void async_publisher::stop() {
+  if (!_started)
+    return;
+  {
+    std::lock_guard<std::mutex> lck(_thread_m);
+    _exit = true;
+  }
+  _thread_cv.notify_all();
+  _thread.join();
+  _started = false;
+
+  // Events queued while the thread was exiting.
+  std::shared_ptr<io::data> d;
+  while (_queue->try_pop(d))
+    publisher::write(d);
+  _spill_writer.reset();
+  if (_dropped)
+    log_v2::core()->info("publisher: {} events dropped since the start",
+                         _dropped);
+}
+
+/**
+ *  Tell if events are queued or directly published.
+ *
+ *  @return true if the publishing thread is running.
+ */
+bool async_publisher::is_async() const noexcept {
+  return _started;
+}
+
+/**
+ *  Queue an event. This is the only work done in the caller thread, unless
+ *  the queue is full.
+ *
+ *  @param[in] d  The event.
+ *
+ *  @return Number of elements acknowledged (1).
+ */
+int async_publisher::write(std::shared_ptr<io::data> const& d) {
+  if (!_started)
+    return publisher::write(d);
+
+  // try_push() moves the event only on success.
+  std::shared_ptr<io::data> e(d);
+  if (_spilling)
+    _spill(e);
+  else {
+    while (!_queue->try_push(e)) {
+      if (_policy == drop) {
+        _count_dropped();
+        return 1;
+      } else if (_policy == spill) {
+        _spill(e);
+        return 1;
+      }
+      _wake_thread();
+      std::this_thread::yield();
+    }
+    _wake_thread();
+  }
+  return 1;
+}
+
+/**
+ *  Queue a list of events.
+ *
+ *  @param[in] to_publish  The events.
+ *
+ *  @return The number of events queued.
+ */
+int async_publisher::write(
+    std::list<std::shared_ptr<io::data>> const& to_publish) {
+  if (!_started)
+    return publisher::write(to_publish);
+  for (auto const& d : to_publish)
+    write(d);
+  return to_publish.size();
+}
+
+/**
+ *  Number of events dropped because the queue was full.
+ */
+uint64_t async_publisher::dropped() const noexcept {
+  return _dropped;
+}
+
+/**
+ *  Number of events written to spill files.
+ */
+uint64_t async_publisher::spilled() const noexcept {
+  return _spilled;
+}
+
+/**
+ *  Approximate number of events waiting in the queue.
+ */
+size_t async_publisher::queued() const noexcept {
+  return _queue ? _queue->size() : 0;
+}
+
+/**
+ *  Convert an overflow policy name into its value.
+ *
+ *  @param[in]  str    "block", "drop" or "spill".
+ *  @param[out] policy The policy.
+ *
+ *  @return false if the name is unknown.
+ */
+bool async_publisher::parse_policy(std::string const& str,
+                                   overflow_policy& policy) {
+  if (str == "block")
+    policy = block;
+  else if (str == "drop")
+    policy = drop;
+  else if (str == "spill")
+    policy = spill;
+  else
+    return false;
+  return true;
+}
+
+/**
+ *  Get the path of a spill file.
+ *
+ *  @param[in] id  Number of the spill file.
+ *
+ *  @return The spill file base path followed by the id.
+ */
+std::string async_publisher::_spill_path(uint32_t id) const {
+  std::string retval(_spill_file);
+  retval.append(".").append(std::to_string(id)).append(".bbdo");
+  return retval;
+}
+
+/**
+ *  Find the spill files left by a previous run. They are published first
+ *  and the numbering of new files continues after them.
+ */
+void async_publisher::_load_spill_files() {
+  std::string dir;
+  std::string name;
+  size_t last_slash(_spill_file.find_last_of('/'));
+  if (last_slash == std::string::npos) {
+    dir = ".";
+    name = _spill_file;
+  } else {
+    dir = _spill_file.substr(0, last_slash);
+    name = _spill_file.substr(last_slash + 1);
+  }
+
+  std::map<uint32_t, std::string> files;
+  size_t offset(dir.size() + 1 + name.size() + 1);
+  for (std::string& f : misc::filesystem::dir_content_with_filter(
+           dir, name + ".*.bbdo")) {
+    char* endptr(nullptr);
+    unsigned long id(strtoul(f.c_str() + offset, &endptr, 10));
+    if (endptr && std::string(endptr) == ".bbdo")
+      files[id] = std::move(f);
+  }
+
+  std::lock_guard<std::mutex> lck(_spill_m);
+  _spill_files.clear();
+  _spill_id = 0;
+  for (auto& p : files) {
+    _spill_files.push_back(std::move(p.second));
+    _spill_id = p.first + 1;
+  }
+  _spilling = !_spill_files.empty();
+  if (_spilling)
+    log_v2::core()->info("publisher: {} spill files to publish first",
+                         _spill_files.size());
+}
+
+/**
+ *  Write an event to the current spill file. If spilling was over, the
+ *  queue is tried again first.
+ *
+ *  @param[in] d  The event.
+ */
+void async_publisher::_spill(std::shared_ptr<io::data>& d) {
+  std::lock_guard<std::mutex> lck(_spill_m);
+  if (!_spilling) {
+    if (_queue->try_push(d)) {
+      _wake_thread();
+      return;
+    }
+    log_v2::core()->info("publisher: queue full, spilling events to '{}'",
+                         _spill_path(_spill_id));
+    _spilling = true;
+  }
+
+  try {
+    if (!_spill_writer) {
+      std::string path(_spill_path(_spill_id++));
+      _spill_writer = file::open_bbdo_file(path);
+      _spill_files.push_back(path);
+    }
+    _spill_writer->write(d);
+    _spilled.fetch_add(1, std::memory_order_relaxed);
+  } catch (std::exception const& e) {
+    _count_dropped();
+    log_v2::core()->error("publisher: cannot spill event of type {}: {}",
+                          d->type(), e.what());
+  }
+}
+
+/**
+ *  Publish the oldest spill file and remove it. When there is no spill file
+ *  left, spilling is over.
+ *
+ *  @return false if there was no spill file to publish.
+ */
+bool async_publisher::_replay_spill() {
+  std::string path;
+  {
+    std::lock_guard<std::mutex> lck(_spill_m);
+    if (_spill_files.empty()) {
+      _spilling = false;
+      return false;
+    }
+    path = _spill_files.front();
+    // Next spilled events will go to a new file.
+    if (_spill_files.size() == 1)
+      _spill_writer.reset();
+  }
+
+  try {
+    std::shared_ptr<io::stream> reader(file::open_bbdo_file(path));
+    std::list<std::shared_ptr<io::data>> batch;
+    for (;;) {
+      std::shared_ptr<io::data> d;
+      try {
+        reader->read(d);
+      } catch (exceptions::shutdown const& e) {
+        (void)e;
+        d.reset();
+      }
+      if (!d)
+        break;
+      batch.push_back(d);
+      if (batch.size() >= max_batch_size) {
+        engine::instance().publish(batch);
+        batch.clear();
+      }
+    }
+    if (!batch.empty())
+      engine::instance().publish(batch);
+  } catch (std::exception const& e) {
+    log_v2::core()->error("publisher: cannot read spill file '{}': {}", path,
+                          e.what());
+  }
+  ::remove(path.c_str());
+
+  std::lock_guard<std::mutex> lck(_spill_m);
+  _spill_files.pop_front();
+  return true;
+}
+
+/**
+ *  Count a dropped event.
+ */
+void async_publisher::_count_dropped() {
+  _dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ *  Wake up the thread if it is waiting for events. The mutex is only taken
+ *  in that case.
+ */
+void async_publisher::_wake_thread() {
+  if (_thread_waiting) {
+    std::lock_guard<std::mutex> lck(_thread_m);
+    _thread_cv.notify_one();
+  }
+}
+
+/**
+ *  Publishing thread main loop. Queued events are published before the
+ *  spilled ones, that are more recent.
+ */
+void async_publisher::_run() {
+  std::list<std::shared_ptr<io::data>> batch;
+  std::shared_ptr<io::data> d;
+  for (;;) {
+    while (batch.size() < max_batch_size && _queue->try_pop(d))
+      batch.push_back(std::move(d));
+    if (!batch.empty()) {
+      engine::instance().publish(batch);
+      batch.clear();
+      continue;
+    }
+
+    if (_spilling && _replay_spill())
+      continue;
+
+    std::unique_lock<std::mutex> lck(_thread_m);
+    if (_exit && _queue->size() == 0 && !_spilling)
+      break;
+    _thread_waiting = true;
+    if (_queue->size() == 0 && !_spilling && !_exit)
+      _thread_cv.wait_for(lck, std::chrono::milliseconds(100));
+    _thread_waiting = false;
+  }
+}
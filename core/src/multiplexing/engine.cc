@@ -31,6 +31,7 @@
 #include "com/centreon/broker/io/events.hh"
 #include "com/centreon/broker/logging/logging.hh"
 #include "com/centreon/broker/multiplexing/muxer.hh"
+#include "com/centreon/broker/stats/stages.hh"
 
 using namespace com::centreon::broker;
 using namespace com::centreon::broker::multiplexing;
@@ -121,6 +122,7 @@ void engine::publish(std::list<std::shared_ptr<io::data>> const& to_publish) {
  *  @param[in] e  Event to publish.
  */
 void engine::_publish(std::shared_ptr<io::data> const& e) {
+  stats::stage_timer timer(stats::stage_engine_publish);
   // Store object for further processing.
   _kiew.push(e);
   // Processing function.
@@ -252,6 +254,7 @@ void engine::stop() {
 void engine::subscribe(muxer* subscriber) {
   std::lock_guard<std::mutex> lock(_muxers_m);
   _muxers.push_back(subscriber);
+  _update_subscribers();
 }
 
 /**
@@ -296,6 +299,7 @@ void engine::unsubscribe(muxer* subscriber) {
       _muxers.erase(it);
       break;
     }
+  _update_subscribers();
 }
 
 /**************************************
@@ -314,6 +318,7 @@ engine::engine()
       _engine_m{},
       _muxers{},
       _muxers_m{},
+      _filters_version(0),
       _write_func(&engine::_nop) {}
 
 /**
@@ -342,14 +347,58 @@ void engine::_nop(std::shared_ptr<io::data> const& d) {
 void engine::_send_to_subscribers() {
   // Process all queued events.
   std::lock_guard<std::mutex> lock(_muxers_m);
+  if (_filters_version != muxer::filters_version())
+    _update_subscribers();
   while (!_kiew.empty()) {
-    // Send object to every subscriber.
-    for (muxer* m : _muxers)
-      m->publish(_kiew.front());
+    // Send object to every subscriber of its type.
+    std::shared_ptr<io::data> const& d(_kiew.front());
+    if (d)
+      for (muxer* m : _subscribers_of(d->type()))
+        m->publish(d);
     _kiew.pop();
   }
 }
 
+/**
+ *  Get the muxers whose write filters accept a type. _muxers_m must be
+ *  locked.
+ *
+ *  @param[in] type  Event type.
+ *
+ *  @return The subscribers of this type.
+ */
+std::vector<muxer*> const& engine::_subscribers_of(uint32_t type) const {
+  static std::vector<muxer*> const none;
+  uint16_t c(type_bitmap::category_index(io::events::category_of_type(type)));
+  if (c >= _subscribers.size())
+    return none;
+  uint16_t e(io::events::element_of_type(type));
+  if (e >= _subscribers[c].size())
+    return none;
+  return _subscribers[c][e];
+}
+
+/**
+ *  Compute the subscribers of each type from the write filters of the
+ *  muxers. _muxers_m must be locked.
+ */
+void engine::_update_subscribers() {
+  // Read the version first, filters changed in the meantime will trigger
+  // another update.
+  _filters_version = muxer::filters_version();
+  _subscribers.clear();
+  for (muxer* m : _muxers)
+    for (uint32_t t : m->get_write_filters_copy()) {
+      uint16_t c(type_bitmap::category_index(io::events::category_of_type(t)));
+      uint16_t e(io::events::element_of_type(t));
+      if (c >= _subscribers.size())
+        _subscribers.resize(c + 1);
+      if (e >= _subscribers[c].size())
+        _subscribers[c].resize(e + 1);
+      _subscribers[c][e].push_back(m);
+    }
+}
+
 /**
  *  The real event publication is done here. This method is just called by
  *  the publish method. No need of a lock, it is already owned by the publish
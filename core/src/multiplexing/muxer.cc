@@ -32,11 +32,13 @@
 #include "com/centreon/broker/misc/string.hh"
 #include "com/centreon/broker/multiplexing/engine.hh"
 #include "com/centreon/broker/persistent_file.hh"
+#include "com/centreon/broker/stats/stages.hh"
 
 using namespace com::centreon::broker;
 using namespace com::centreon::broker::multiplexing;
 
 uint32_t muxer::_event_queue_max_size = std::numeric_limits<uint32_t>::max();
+std::atomic<uint32_t> muxer::_filters_version{0};
 
 /**
  *  Constructor.
@@ -47,7 +49,11 @@ uint32_t muxer::_event_queue_max_size = std::numeric_limits<uint32_t>::max();
  *                         unprocessed events in a persistent storage.
  */
 muxer::muxer(std::string const& name, bool persistent)
-    : io::stream("muxer"), _events_size(0), _name(name), _persistent(persistent) {
+    : io::stream("muxer"),
+      _events_size(0),
+      _name(name),
+      _persistent(persistent),
+      _pos_index(0) {
   // Load head queue file back in memory.
   if (_persistent) {
     try {
@@ -58,6 +64,7 @@ muxer::muxer(std::string const& name, bool persistent)
         mf->read(e, 0);
         if (e) {
           _events.push_back(e);
+          _push_times.push_back(std::chrono::steady_clock::now());
           ++_events_size;
         }
       }
@@ -80,6 +87,7 @@ muxer::muxer(std::string const& name, bool persistent)
       if (!e)
         break;
       _events.push_back(e);
+      _push_times.push_back(std::chrono::steady_clock::now());
       ++_events_size;
     } while (_events_size < event_queue_max_size());
   } catch (exceptions::shutdown const& e) {
@@ -122,6 +130,8 @@ void muxer::ack_events(int count) {
         break;
       }
       _events.pop_front();
+      _push_times.pop_front();
+      --_pos_index;
       --_events_size;
     }
     log_v2::perfdata()->trace("multiplexing: still {} events in {} event queue",
@@ -167,7 +177,7 @@ void muxer::publish(std::shared_ptr<io::data> const event) {
   if (event) {
     std::lock_guard<std::mutex> lock(_mutex);
     // Check if we should process this event.
-    if (_write_filters.find(event->type()) == _write_filters.end())
+    if (!_write_types.test(event->type()))
       return;
     // Check if the event queue limit is reach.
     if (_events_size >= event_queue_max_size()) {
@@ -205,7 +215,9 @@ bool muxer::read(std::shared_ptr<io::data>& event, time_t deadline) {
     if (_pos != _events.end()) {
       event = *_pos;
       ++_pos;
+      std::chrono::steady_clock::time_point pushed(_push_times[_pos_index++]);
       lock.unlock();
+      _record_queue_wait(pushed);
       if (event)
         timed_out = false;
     } else
@@ -215,7 +227,9 @@ bool muxer::read(std::shared_ptr<io::data>& event, time_t deadline) {
   else {
     event = *_pos;
     ++_pos;
+    std::chrono::steady_clock::time_point pushed(_push_times[_pos_index++]);
     lock.unlock();
+    _record_queue_wait(pushed);
   }
 
   return !timed_out;
@@ -230,6 +244,7 @@ bool muxer::read(std::shared_ptr<io::data>& event, time_t deadline) {
 void muxer::set_read_filters(muxer::filters const& fltrs) {
   _read_filters = fltrs;
   _read_filters_str = misc::dump_filters(_read_filters);
+  _read_types = type_bitmap(_read_filters);
 }
 
 /**
@@ -237,11 +252,18 @@ void muxer::set_read_filters(muxer::filters const& fltrs) {
  *
  *  @param[in] fltrs  Write filters. That is any submitted through
  *                    write() must be in this set otherwise it won't be
- *                    multiplexed.
+ *                    multiplexed. The engine is told to compute its
+ *                    subscriber table again.
  */
 void muxer::set_write_filters(muxer::filters const& fltrs) {
-  _write_filters = fltrs;
-  _write_filters_str = misc::dump_filters(_write_filters);
+  type_bitmap types(fltrs);
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _write_filters = fltrs;
+    _write_filters_str = misc::dump_filters(_write_filters);
+    _write_types = std::move(types);
+  }
+  ++_filters_version;
 }
 
 /**
@@ -262,6 +284,16 @@ muxer::filters const& muxer::get_write_filters() const {
   return _write_filters;
 }
 
+/**
+ *  Get a copy of the write filters, safe while they are being set.
+ *
+ *  @return  The write filters.
+ */
+muxer::filters muxer::get_write_filters_copy() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _write_filters;
+}
+
 /**
  *  Get the read filters as a string.
  *
@@ -299,6 +331,7 @@ void muxer::nack_events() {
       _name);
   std::lock_guard<std::mutex> lock(_mutex);
   _pos = _events.begin();
+  _pos_index = 0;
 }
 
 /**
@@ -320,10 +353,7 @@ void muxer::statistics(json11::Json::object& tree) const {
   }
 
   // Unacknowledged events count.
-  int unacknowledged = 0;
-  for (auto it = _events.begin(); it != _pos; ++it)
-    ++unacknowledged;
-  tree["unacknowledged_events"] = unacknowledged;
+  tree["unacknowledged_events"] = static_cast<int>(_pos_index);
 }
 
 /**
@@ -340,11 +370,21 @@ void muxer::wake() {
  *  @param[in] d  Event to multiplex.
  */
 int muxer::write(std::shared_ptr<io::data> const& d) {
-  if (d && _read_filters.find(d->type()) != _read_filters.end())
+  if (d && _read_types.test(d->type()))
     engine::instance().publish(d);
   return 1;
 }
 
+/**
+ *  Get the version of the write filters of all the muxers. It changes each
+ *  time write filters are set.
+ *
+ *  @return  The version.
+ */
+uint32_t muxer::filters_version() noexcept {
+  return _filters_version;
+}
+
 /**
  *  Get the memory file name associated with this muxer.
  *
@@ -389,6 +429,7 @@ void muxer::_clean() {
       while (!_events.empty()) {
         mf->write(_events.front());
         _events.pop_front();
+        _push_times.pop_front();
         --_events_size;
       }
     } catch (std::exception const& e) {
@@ -398,6 +439,8 @@ void muxer::_clean() {
     }
   }
   _events.clear();
+  _push_times.clear();
+  _pos_index = 0;
   _events_size = 0;
 }
 
@@ -432,6 +475,19 @@ std::string muxer::_memory_file() const {
   return memory_file(_name);
 }
 
+/**
+ *  Record the time an event spent in the queue before being read.
+ *
+ *  @param[in] pushed  Time the event was pushed to the queue.
+ */
+void muxer::_record_queue_wait(
+    std::chrono::steady_clock::time_point pushed) noexcept {
+  stats::stage_histogram(stats::stage_muxer_queue_wait)
+      .record(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                  std::chrono::steady_clock::now() - pushed)
+                  .count());
+}
+
 /**
  *  Push event to queue (_mutex is locked when this method is called).
  *
@@ -440,6 +496,7 @@ std::string muxer::_memory_file() const {
 void muxer::_push_to_queue(std::shared_ptr<io::data> const& event) {
   bool pos_has_no_more_to_read(_pos == _events.end());
   _events.push_back(event);
+  _push_times.push_back(std::chrono::steady_clock::now());
   ++_events_size;
 
   if (pos_has_no_more_to_read) {
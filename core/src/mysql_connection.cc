@@ -24,6 +24,7 @@
 #include "com/centreon/broker/log_v2.hh"
 #include "com/centreon/broker/logging/logging.hh"
 #include "com/centreon/broker/mysql_manager.hh"
+#include "com/centreon/broker/stats/stages.hh"
 
 using namespace com::centreon::broker;
 using namespace com::centreon::broker::database;
@@ -133,6 +134,7 @@ void mysql_connection::_commit(mysql_task* t) {
   std::string err_msg;
   if (_need_commit) {
     log_v2::sql()->debug("mysql_connection: commit");
+    stats::stage_timer timer(stats::stage_sql_commit);
     while (attempts++ < MAX_ATTEMPTS && (res = mysql_commit(_conn))) {
       err_msg = ::mysql_error(_conn);
       if (_server_error(::mysql_errno(_conn))) {
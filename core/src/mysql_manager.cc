@@ -109,7 +109,7 @@ void mysql_manager::clear() {
             << "mysql_manager: Unable to stop a connection: " << e.what();
       }
   }
-  logging::debug(logging::low) << "mysql_manager: clear finished";
+  LOGGING_DEBUG(logging::low) << "mysql_manager: clear finished";
 }
 
 void mysql_manager::update_connections() {
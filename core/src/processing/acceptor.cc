@@ -59,11 +59,13 @@ void acceptor::accept() {
   // Try to accept connection.
   std::shared_ptr<io::stream> s(_endp->open());
   if (s) {
-    // Create feeder thread.
+    // Create feeder.
     std::string name(fmt::format("{}-{}", _name, ++connection_id));
     log_v2::core()->info("New incoming connection '{}'", name);
     std::shared_ptr<processing::feeder> f(std::make_shared<processing::feeder>(
         name, s, _read_filters, _write_filters));
+    if (!get_stats_path().empty())
+      f->set_stats_path(get_stats_path() + '/' + name);
 
     std::lock_guard<std::mutex> lock(_stat_mutex);
     _feeders.push_back(f);
@@ -157,6 +159,7 @@ void acceptor::_forward_statistic(json11::Json::object& tree) {
   // Get statistic of acceptor.
   _endp->stats(tree);
   // Get statistics of feeders
+  std::lock_guard<std::mutex> lock(_stat_mutex);
   for (std::list<std::shared_ptr<processing::feeder> >::iterator
            it(_feeders.begin()),
        end(_feeders.end());
@@ -167,6 +170,16 @@ void acceptor::_forward_statistic(json11::Json::object& tree) {
   }
 }
 
+/**
+ *  Gather the statistics of the acceptor, its feeders publish their own
+ *  statistics under it.
+ *
+ *  @param[in] tree  The tree.
+ */
+void acceptor::_forward_details(json11::Json::object& tree) {
+  _endp->stats(tree);
+}
+
 void acceptor::_set_listening(bool listening) noexcept {
   _listening = listening;
   set_state(listening ? "listening" : "disconnected");
@@ -194,8 +207,16 @@ void acceptor::_callback() noexcept {
   _state_cv.notify_all();
   lock.unlock();
 
+  time_t fill_stats_time(time(nullptr));
+
   // Run as long as no exit request was made.
   while (!_should_exit) {
+    // Filling stats
+    if (time(nullptr) >= fill_stats_time) {
+      fill_stats_time = time(nullptr) + 5;
+      _publish_stats();
+    }
+
     try {
       _set_listening(true);
       // Try to accept connection.
@@ -26,6 +26,7 @@
 #include "com/centreon/broker/logging/logging.hh"
 #include "com/centreon/broker/multiplexing/muxer.hh"
 #include "com/centreon/broker/multiplexing/subscriber.hh"
+#include "com/centreon/broker/stats/stages.hh"
 
 using namespace com::centreon::broker;
 using namespace com::centreon::broker::processing;
@@ -232,14 +233,14 @@ void failover::run() {
         // Filling stats
         if (time(nullptr) >= fill_stats_time) {
           fill_stats_time += 5;
-          set_queued_events(_subscriber->get_muxer().get_event_queue_size());
+          _publish_stats();
         }
 
         // Read from endpoint stream.
         d.reset();
         bool timed_out_stream(true);
         if (stream_can_read) {
-          logging::debug(logging::low)
+          LOGGING_DEBUG(logging::low)
               << "failover: reading event from endpoint '" << _name << "'";
           _update_status("reading event from stream");
           try {
@@ -252,7 +253,7 @@ void failover::run() {
             stream_can_read = false;
           }
           if (d) {
-            logging::debug(logging::low)
+            LOGGING_DEBUG(logging::low)
                 << "failover: writing event of endpoint '" << _name
                 << "' to multiplexing engine";
             _update_status("writing event to multiplexing engine");
@@ -268,9 +269,9 @@ void failover::run() {
         d.reset();
         bool timed_out_muxer(true);
         if (muxer_can_read) {
-          logging::debug(logging::low) << "failover: reading event from "
-                                          "multiplexing engine for endpoint '"
-                                       << _name << "'";
+          LOGGING_DEBUG(logging::low) << "failover: reading event from "
+                                         "multiplexing engine for endpoint '"
+                                      << _name << "'";
           _update_status("reading event from multiplexing engine");
           try {
             timed_out_muxer = !_subscriber->get_muxer().read(d, 0);
@@ -283,15 +284,16 @@ void failover::run() {
             muxer_can_read = false;
           }
           if (d) {
-            log_v2::processing()->debug(
-                "failover: writing event of multiplexing engine to endpoint "
-                "'{}'",
-                _name);
+            LOG_V2_DEBUG(log_v2::processing(),
+                         "failover: writing event of multiplexing engine to "
+                         "endpoint '{}'",
+                         _name);
             _update_status("writing event to stream");
             int we(0);
 
             try {
               std::lock_guard<std::timed_mutex> stream_lock(_stream_m);
+              stats::stage_timer timer(stats::stage_stream_write);
               we = _stream->write(d);
             } catch (exceptions::shutdown const& e) {
               log_v2::processing()->debug(
@@ -374,12 +376,17 @@ void failover::run() {
       set_state("connecting");
     }
 
-    // Sleep a while before attempting a reconnection.
+    // Sleep a while before attempting a reconnection. Statistics are
+    // still published, the queue keeps growing while disconnected.
     _update_status("sleeping before reconnection");
+    _publish_stats();
 
     for (ssize_t i = 0;
-         !_endpoint->is_ready() && !should_exit() && i < _retry_interval; i++)
+         !_endpoint->is_ready() && !should_exit() && i < _retry_interval;
+         i++) {
       std::this_thread::sleep_for(std::chrono::seconds(1));
+      _publish_stats();
+    }
 
     _update_status("");
 
@@ -391,6 +398,7 @@ void failover::run() {
     _stream.reset();
     set_state("connecting");
   }
+  _publish_stats();
 
   // Exit failover thread if necessary.
   if (_failover) {
@@ -421,6 +429,8 @@ void failover::set_buffering_timeout(time_t secs) {
  */
 void failover::set_failover(std::shared_ptr<failover> fo) {
   _failover = fo;
+  if (_failover && !get_stats_path().empty())
+    _failover->set_stats_path(get_stats_path() + "/failover");
 }
 
 /**
@@ -433,6 +443,18 @@ void failover::set_retry_interval(time_t retry_interval) {
   _retry_interval = retry_interval;
 }
 
+/**
+ *  Move the statistics of this failover and of its own failover in the
+ *  stats registry.
+ *
+ *  @param[in] path  New path.
+ */
+void failover::set_stats_path(std::string const& path) {
+  endpoint::set_stats_path(path);
+  if (_failover)
+    _failover->set_stats_path(path + "/failover");
+}
+
 /**
  *  Configuration update request.
  */
@@ -489,6 +511,20 @@ std::string const& failover::_get_write_filters() const {
  *  @param[in] tree  The tree.
  */
 void failover::_forward_statistic(json11::Json::object& tree) {
+  _forward_details(tree);
+  json11::Json::object subtree;
+  if (_failover)
+    _failover->stats(subtree);
+  tree["failover"] = subtree;
+}
+
+/**
+ *  Gather the statistics of this failover, its own failover publishes its
+ *  statistics under it.
+ *
+ *  @param[in] tree  The tree.
+ */
+void failover::_forward_details(json11::Json::object& tree) {
   {
     std::lock_guard<std::mutex> lock(_status_m);
     tree["status"] = _status;
@@ -502,10 +538,6 @@ void failover::_forward_statistic(json11::Json::object& tree) {
       tree["status"] = "busy";
   }
   _subscriber->get_muxer().statistics(tree);
-  json11::Json::object subtree;
-  if (_failover)
-    _failover->stats(subtree);
-  tree["failover"] = subtree;
 }
 
 /**************************************
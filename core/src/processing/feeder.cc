@@ -18,8 +18,6 @@
 
 #include "com/centreon/broker/processing/feeder.hh"
 
-#include <unistd.h>
-
 #include "com/centreon/broker/exceptions/msg.hh"
 #include "com/centreon/broker/exceptions/shutdown.hh"
 #include "com/centreon/broker/io/raw.hh"
@@ -27,6 +25,8 @@
 #include "com/centreon/broker/log_v2.hh"
 #include "com/centreon/broker/logging/logging.hh"
 #include "com/centreon/broker/multiplexing/muxer.hh"
+#include "com/centreon/broker/pool.hh"
+#include "com/centreon/broker/stats/stages.hh"
 
 using namespace com::centreon::broker;
 using namespace com::centreon::broker::processing;
@@ -37,8 +37,10 @@ using namespace com::centreon::broker::processing;
  *                                     *
  **************************************/
 
+std::chrono::milliseconds const feeder::idle_delay(100);
+
 /**
- *  Constructor.
+ *  Constructor. The first turn is posted to the thread pool.
  *
  *  @param[in] name           Name.
  *  @param[in] client         Client stream.
@@ -53,7 +55,13 @@ feeder::feeder(std::string const& name,
       _state{feeder::stopped},
       _should_exit{false},
       _client(client),
-      _subscriber(name, false) {
+      _subscriber(name, false),
+      _strand(pool::io_context()),
+      _timer(pool::io_context()),
+      _timer_cancelled(false),
+      _fill_stats_time(time(nullptr)),
+      _stream_can_read(true),
+      _muxer_can_read(true) {
   if (!client)
     throw exceptions::msg()
         << "could not process '" << _name << "' with no client stream";
@@ -64,14 +72,19 @@ feeder::feeder(std::string const& name,
   set_last_connection_attempt(timestamp::now());
   set_last_connection_success(timestamp::now());
   set_state("connecting");
-  std::unique_lock<std::mutex> lck(_state_m);
-  _thread = std::thread(&feeder::_callback, this);
-  _state_cv.wait(lck,
-                 [& state = this->_state] { return state != feeder::stopped; });
+
+  log_v2::processing()->info("feeder: client '{}' is starting", _name);
+  set_state("connected");
+  {
+    std::lock_guard<std::mutex> lck(_state_m);
+    _state = feeder::running;
+  }
+  _schedule(false);
 }
 
 /**
- *  Destructor.
+ *  Destructor. It wakes up a waiting turn and waits for the last one to
+ *  finish.
  */
 feeder::~feeder() {
   std::unique_lock<std::mutex> lock(_state_m);
@@ -81,11 +94,12 @@ feeder::~feeder() {
       break;
     case running:
       _should_exit = true;
-      _state_cv.wait(lock, [this] { return _state == finished; });
-      _thread.join();
+      asio::post(_strand, [this] { _cancel_timer(); });
+      _state_cv.wait(lock, [this] {
+        return _state == finished && _timer_cancelled;
+      });
       break;
     case finished:
-      _thread.join();
       break;
   }
 }
@@ -127,78 +141,109 @@ void feeder::_forward_statistic(json11::Json::object& tree) {
   _subscriber.get_muxer().statistics(tree);
 }
 
+/**
+ *  Post the next turn to the thread pool.
+ *
+ *  @param[in] idle  true if the last turn had nothing to do, the next one is
+ *                   then delayed.
+ */
+void feeder::_schedule(bool idle) {
+  if (idle) {
+    _timer.expires_after(idle_delay);
+    _timer.async_wait(asio::bind_executor(
+        _strand, [this](std::error_code const&) { _callback(); }));
+  } else
+    asio::post(_strand, [this] { _callback(); });
+}
+
+/**
+ *  Cancel the timer, so that a waiting turn starts at once and sees the
+ *  feeder has to exit.
+ */
+void feeder::_cancel_timer() noexcept {
+  try {
+    _timer.cancel();
+  } catch (std::exception const& e) {
+    log_v2::processing()->error("feeder '{}': cannot cancel timer: {}", _name,
+                                e.what());
+  }
+  std::lock_guard<std::mutex> lock(_state_m);
+  _timer_cancelled = true;
+  _state_cv.notify_all();
+}
+
+/**
+ *  A turn: move events between the client stream and the muxer, at most
+ *  max_events_per_turn of them.
+ */
 void feeder::_callback() noexcept {
-  log_v2::processing()->info("feeder: thread of client '{}' is starting",
-                             _name);
-  time_t fill_stats_time = time(nullptr);
-  std::unique_lock<std::mutex> lock(_state_m);
+  if (_should_exit) {
+    _stop();
+    return;
+  }
 
   try {
-    set_state("connected");
-    bool stream_can_read(true);
-    bool muxer_can_read(true);
+    // Filling stats
+    if (time(nullptr) >= _fill_stats_time) {
+      _fill_stats_time += 5;
+      _publish_stats();
+    }
+
     std::shared_ptr<io::data> d;
-    _state = feeder::running;
-    _state_cv.notify_all();
-    lock.unlock();
-    while (!_should_exit) {
+    uint32_t count(0);
+    while (count < max_events_per_turn && !_should_exit) {
       // Read from stream.
-      bool timed_out_stream(true);
-
-      // Filling stats
-      if (time(nullptr) >= fill_stats_time) {
-        fill_stats_time += 5;
-        set_queued_events(_subscriber.get_muxer().get_event_queue_size());
-      }
-
-      if (stream_can_read) {
+      if (_stream_can_read) {
         try {
           misc::read_lock lock(_client_m);
-          timed_out_stream = !_client->read(d, 0);
+          _client->read(d, 0);
         } catch (exceptions::shutdown const& e) {
-          stream_can_read = false;
+          _stream_can_read = false;
         }
         if (d) {
-          log_v2::processing()->trace(
-              "feeder '{}': sending 1 event from stream to muxer", _name);
+          LOG_V2_TRACE(log_v2::processing(),
+                       "feeder '{}': sending 1 event from stream to muxer",
+                       _name);
           {
             misc::read_lock lock(_client_m);
             _subscriber.get_muxer().write(d);
           }
+          d.reset();
           tick();
+          ++count;
           continue;  // Stream read bias.
         }
       }
 
       // Read from muxer.
-      d.reset();
-      bool timed_out_muxer(true);
-      if (muxer_can_read)
+      if (_muxer_can_read)
         try {
-          timed_out_muxer = !_subscriber.get_muxer().read(d, 0);
+          _subscriber.get_muxer().read(d, 0);
         } catch (exceptions::shutdown const& e) {
-          muxer_can_read = false;
-        }
-      if (d) {
-        log_v2::processing()->trace(
-            "feeder '{}': sending 1 event from muxer to client", _name);
-        {
-          misc::read_lock lock(_client_m);
-          _client->write(d);
+          _muxer_can_read = false;
         }
-        _subscriber.get_muxer().ack_events(1);
-        tick();
+      if (!d)
+        break;
+      LOG_V2_TRACE(log_v2::processing(),
+                   "feeder '{}': sending 1 event from muxer to client", _name);
+      {
+        misc::read_lock lock(_client_m);
+        stats::stage_timer timer(stats::stage_stream_write);
+        _client->write(d);
       }
-
-      // If both timed out, sleep a while.
       d.reset();
-      if (timed_out_stream && timed_out_muxer) {
-        log_v2::processing()->trace(
-            "feeder '{}': timeout on stream and muxer, waiting for 100000µs",
-            _name);
-        ::usleep(100000);
-      }
+      _subscriber.get_muxer().ack_events(1);
+      tick();
+      ++count;
     }
+
+    // If there was nothing to do, wait a while.
+    if (!count)
+      log_v2::processing()->trace(
+          "feeder '{}': timeout on stream and muxer, waiting for {}ms", _name,
+          idle_delay.count());
+    _schedule(!count);
+    return;
   } catch (exceptions::shutdown const& e) {
     // Normal termination.
     (void)e;
@@ -213,22 +258,28 @@ void feeder::_callback() noexcept {
         << "feeder: unknown error occured while processing client '" << _name
         << "'";
   }
+  _stop();
+}
 
+/**
+ *  Last turn: release the client and tell the destructor it can go on.
+ */
+void feeder::_stop() noexcept {
   /* If we are here, that is because the loop is finished, and if we want
    * is_finished() to return true, we have to set _should_exit to true. */
   _should_exit = true;
-  std::unique_lock<std::mutex> lock_stop(_state_m);
-  _state = feeder::finished;
-  _state_cv.notify_all();
-  lock_stop.unlock();
-
   {
     misc::read_lock lock(_client_m);
     _client.reset();
     set_state("disconnected");
     _subscriber.get_muxer().remove_queue_files();
   }
-  log_v2::processing()->info("feeder: thread of client '{}' will exit", _name);
+  log_v2::processing()->info("feeder: client '{}' is finished", _name);
+
+  // The feeder may be destroyed as soon as the state is finished.
+  std::lock_guard<std::mutex> lock(_state_m);
+  _state = feeder::finished;
+  _state_cv.notify_all();
 }
 
 uint32_t feeder::_get_queued_events() const {
@@ -24,6 +24,7 @@
 
 #include "com/centreon/broker/io/events.hh"
 #include "com/centreon/broker/misc/string.hh"
+#include "com/centreon/broker/multiplexing/muxer.hh"
 
 using namespace com::centreon::broker;
 using namespace com::centreon::broker::processing;
@@ -33,27 +34,41 @@ using namespace com::centreon::broker::processing;
  *
  *  @param[in] name  The name of the thread.
  */
-stat_visitable::stat_visitable(std::string const& name)
-    : _state{""}, _queued_events{0}, _name(name) {}
+stat_visitable::stat_visitable(std::string const& name) : _name(name) {
+  _stats.add<stats::text>("name")->set(name);
+  _stats.add<stats::text>("queue_file_path")
+      ->set(multiplexing::muxer::queue_file(name));
+  _stats.add<stats::text>("memory_file_path")
+      ->set(multiplexing::muxer::memory_file(name));
+  _stats_state = _stats.add<stats::text>("state");
+  _stats_last_error = _stats.add<stats::text>("last_error");
+  _stats_last_connection_attempt =
+      _stats.add<stats::gauge>("last_connection_attempt");
+  _stats_last_connection_success =
+      _stats.add<stats::gauge>("last_connection_success");
+  _stats_last_event_at = _stats.add<stats::gauge>("last_event_at");
+  _stats_speed = _stats.add<stats::meter>("event_processing_speed");
+  _stats_queued_events = _stats.add<stats::gauge>("queued_events");
+  _stats_details = _stats.add<stats::tree>("");
+}
 
 /**
- *  Gather statistics on this thread.
+ *  Gather statistics on this thread. The streams are asked for their
+ *  statistics, prefer the stats registry that does not lock them.
  *
  *  @param[in] tree  Tree of information.
  */
 void stat_visitable::stats(json11::Json::object& tree) {
-  std::lock_guard<std::mutex> lock(_stat_mutex);
-  tree["state"] = std::string(_state);
-  tree["read_filters"] = _get_read_filters();
-  tree["write_filters"] = _get_write_filters();
-  tree["event_processing_speed"] =
-      _event_processing_speed.get_processing_speed();
-  tree["last_connection_attempt"] =
-      static_cast<double>(_last_connection_attempt);
-  tree["last_connection_success"] =
-      static_cast<double>(_last_connection_success);
-  tree["last_event_at"] =
-      static_cast<double>(_event_processing_speed.get_last_event_time());
+  tree["state"] = _stats_state->get();
+  {
+    std::lock_guard<std::mutex> lock(_stat_mutex);
+    tree["read_filters"] = _get_read_filters();
+    tree["write_filters"] = _get_write_filters();
+  }
+  tree["event_processing_speed"] = _stats_speed->get_speed();
+  tree["last_connection_attempt"] = _stats_last_connection_attempt->get();
+  tree["last_connection_success"] = _stats_last_connection_success->get();
+  tree["last_event_at"] = _stats_last_event_at->get();
   tree["queued_events"] = static_cast<int>(_get_queued_events());
 
   // Forward the stats.
@@ -69,14 +84,32 @@ std::string const& stat_visitable::get_name() const {
   return _name;
 }
 
+/**
+ *  Get the path of the statistics of this thread in the stats registry.
+ *
+ *  @return The path, empty if they are not published.
+ */
+std::string const& stat_visitable::get_stats_path() const noexcept {
+  return _stats.path();
+}
+
+/**
+ *  Publish the statistics of this thread in the stats registry, or move
+ *  them if they are already published.
+ *
+ *  @param[in] path  New path.
+ */
+void stat_visitable::set_stats_path(std::string const& path) {
+  _stats.publish(path);
+}
+
 /**
  *  Set the last error.
  *
  *  @param[in] last_error  The last error.
  */
 void stat_visitable::set_last_error(std::string const& last_error) {
-  std::lock_guard<std::mutex> lock(_stat_mutex);
-  _last_error = last_error;
+  _stats_last_error->set(last_error);
 }
 
 /**
@@ -86,8 +119,8 @@ void stat_visitable::set_last_error(std::string const& last_error) {
  */
 void stat_visitable::set_last_connection_attempt(
     timestamp last_connection_attempt) {
-  std::lock_guard<std::mutex> lock(_stat_mutex);
-  _last_connection_attempt = last_connection_attempt;
+  _stats_last_connection_attempt->set(
+      static_cast<double>(last_connection_attempt));
 }
 
 /**
@@ -97,16 +130,17 @@ void stat_visitable::set_last_connection_attempt(
  */
 void stat_visitable::set_last_connection_success(
     timestamp last_connection_success) {
-  std::lock_guard<std::mutex> lock(_stat_mutex);
-  _last_connection_success = last_connection_success;
+  _stats_last_connection_success->set(
+      static_cast<double>(last_connection_success));
 }
 
 /**
  *  Tick the event processing computation.
  */
 void stat_visitable::tick(uint32_t events) {
-  std::lock_guard<std::mutex> lock(_stat_mutex);
-  _event_processing_speed.tick(events);
+  _stats_speed->tick(events);
+  _stats_last_event_at->set(
+      static_cast<double>(_stats_speed->get_last_event_time()));
 }
 
 /**
@@ -120,10 +154,38 @@ void stat_visitable::_forward_statistic(json11::Json::object& tree) {
   (void)tree;
 }
 
+/**
+ *  @brief Gather the statistics published by _publish_stats().
+ *
+ *  Same as _forward_statistic() by default.
+ *
+ *  @param[in] tree  The tree gathering the stats.
+ */
+void stat_visitable::_forward_details(json11::Json::object& tree) {
+  _forward_statistic(tree);
+}
+
+/**
+ *  Publish the statistics of the streams in the stats registry. It must
+ *  be called by the processing thread, the one already owning the
+ *  streams, so that stats readers never wait for them.
+ */
+void stat_visitable::_publish_stats() {
+  json11::Json::object tree;
+  {
+    std::lock_guard<std::mutex> lock(_stat_mutex);
+    tree["read_filters"] = _get_read_filters();
+    tree["write_filters"] = _get_write_filters();
+  }
+  _stats_queued_events->set(_get_queued_events());
+  _forward_details(tree);
+  _stats_details->set(tree);
+}
+
 void stat_visitable::set_state(char const* state) {
-  _state = state;
+  _stats_state->set(state);
 }
 
 void stat_visitable::set_queued_events(uint32_t queued_events) {
-  _queued_events = queued_events;
+  _stats_queued_events->set(queued_events);
 }
@@ -127,7 +127,7 @@ mysql_stmt query_preparator::prepare_insert(mysql& ms, bool ignore) {
   query.resize(query.size() - 1);
   query.append(")");
 
-  logging::debug(logging::low) << "mysql: query_preparator: " << query;
+  LOGGING_DEBUG(logging::low) << "mysql: query_preparator: " << query;
   // Prepare statement.
   mysql_stmt retval;
   try {
@@ -203,7 +203,7 @@ mysql_stmt query_preparator::prepare_insert_or_update(mysql& ms) {
     insert_bind_mapping.insert(
         std::make_pair(it->first, it->second + insert_size));
 
-  logging::debug(logging::low) << "mysql: query_preparator: " << insert;
+  LOGGING_DEBUG(logging::low) << "mysql: query_preparator: " << insert;
   // Prepare statement.
   mysql_stmt retval;
   try {
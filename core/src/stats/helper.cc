@@ -24,11 +24,13 @@
 #include "com/centreon/broker/config/applier/endpoint.hh"
 #include "com/centreon/broker/config/applier/modules.hh"
 #include "com/centreon/broker/config/endpoint.hh"
+#include "com/centreon/broker/log_v2.hh"
 #include "com/centreon/broker/misc/filesystem.hh"
 #include "com/centreon/broker/multiplexing/muxer.hh"
 #include "com/centreon/broker/mysql_manager.hh"
 #include "com/centreon/broker/pool.hh"
 #include "com/centreon/broker/processing/endpoint.hh"
+#include "com/centreon/broker/stats/stages.hh"
 
 using namespace com::centreon::broker;
 using namespace com::centreon::broker::stats;
@@ -49,6 +51,13 @@ void com::centreon::broker::stats::get_generic_stats(
   pool["size"] = static_cast<int32_t>(pool::instance().get_current_size());
   pool["latency"] = fmt::format("{:.3f}ms", pool::instance().get_latency());
   object["thread_pool"] = pool;
+  json11::Json::object log;
+  log["async"] = log_v2::instance().is_async();
+  log["queued_messages"] =
+      static_cast<int32_t>(log_v2::instance().queued_messages());
+  log["dropped_messages"] =
+      std::to_string(log_v2::instance().dropped_messages());
+  object["log"] = log;
 }
 
 void com::centreon::broker::stats::get_mysql_stats(
@@ -114,3 +123,65 @@ bool stats::get_endpoint_stats(std::vector<json11::Json::object>& object) {
     return false;
   }
 }
+
+/**
+ *  Get the durations of the pipeline stages, in milliseconds.
+ *
+ *  @param[out] object  One subtree per stage.
+ */
+void stats::get_stage_stats(json11::Json::object& object) noexcept {
+  for (int i = 0; i < stage_count; ++i) {
+    histogram::snapshot s(stage_histogram(static_cast<stage>(i)).get_snapshot());
+    json11::Json::object subtree;
+    subtree["count"] = static_cast<double>(s.count);
+    if (s.count) {
+      subtree["mean"] = s.mean() / 1000000;
+      subtree["p50"] = s.percentile(0.5) / 1000000.0;
+      subtree["p90"] = s.percentile(0.9) / 1000000.0;
+      subtree["p99"] = s.percentile(0.99) / 1000000.0;
+      subtree["p999"] = s.percentile(0.999) / 1000000.0;
+      subtree["max"] = s.max / 1000000.0;
+    }
+    object[stage_name(static_cast<stage>(i))] = subtree;
+  }
+}
+
+/**
+ *  Get the durations of the pipeline stages in the Prometheus text format,
+ *  as histograms with fixed bounds from 1us to 10s.
+ *
+ *  @return The metrics.
+ */
+std::string stats::get_stage_prometheus() {
+  static uint64_t const bounds[] = {
+      1000,      2000,      5000,       10000,      20000,      50000,
+      100000,    200000,    500000,     1000000,    2000000,    5000000,
+      10000000,  20000000,  50000000,   100000000,  200000000,  500000000,
+      1000000000, 2000000000, 5000000000, 10000000000};
+  std::string retval(
+      "# HELP centreon_broker_stage_duration_seconds Duration of the "
+      "pipeline stages.\n"
+      "# TYPE centreon_broker_stage_duration_seconds histogram\n");
+  for (int i = 0; i < stage_count; ++i) {
+    char const* name(stage_name(static_cast<stage>(i)));
+    histogram::snapshot s(stage_histogram(static_cast<stage>(i)).get_snapshot());
+    uint32_t bucket(0);
+    uint64_t cumulated(0);
+    for (uint64_t bound : bounds) {
+      while (bucket < s.buckets.size() &&
+             histogram::bucket_upper_bound(bucket) <= bound)
+        cumulated += s.buckets[bucket++];
+      retval.append(fmt::format(
+          "centreon_broker_stage_duration_seconds_bucket{{stage=\"{}\","
+          "le=\"{}\"}} {}\n",
+          name, bound / 1000000000.0, cumulated));
+    }
+    retval.append(fmt::format(
+        "centreon_broker_stage_duration_seconds_bucket{{stage=\"{}\","
+        "le=\"+Inf\"}} {}\n"
+        "centreon_broker_stage_duration_seconds_sum{{stage=\"{}\"}} {}\n"
+        "centreon_broker_stage_duration_seconds_count{{stage=\"{}\"}} {}\n",
+        name, s.count, name, s.sum / 1000000000.0, name, s.count));
+  }
+  return retval;
+}
@@ -0,0 +1,168 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#include "com/centreon/broker/stats/histogram.hh"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::stats;
+
+uint32_t const histogram::sub_bucket_bits;
+uint32_t const histogram::sub_buckets;
+uint32_t const histogram::max_power;
+uint32_t const histogram::bucket_count;
+uint32_t const histogram::shard_count;
+
+/**
+ *  Empty snapshot constructor.
+ */
+histogram::snapshot::snapshot()
+    : count(0), sum(0), max(0), buckets(bucket_count, 0) {}
+
+/**
+ *  Get the mean of the recorded values.
+ *
+ *  @return The mean, 0 if nothing was recorded.
+ */
+double histogram::snapshot::mean() const {
+  return count ? static_cast<double>(sum) / count : 0;
+}
+
+/**
+ *  Get a percentile of the recorded values.
+ *
+ *  @param[in] p  Percentile, between 0 and 1.
+ *
+ *  @return The upper bound of the bucket containing the percentile, never
+ *          more than the maximum recorded value.
+ */
+uint64_t histogram::snapshot::percentile(double p) const {
+  if (!count)
+    return 0;
+  uint64_t rank(static_cast<uint64_t>(std::ceil(p * count)));
+  if (!rank)
+    rank = 1;
+  uint64_t seen(0);
+  for (uint32_t i = 0; i < buckets.size(); ++i) {
+    seen += buckets[i];
+    if (seen >= rank)
+      return std::min(bucket_upper_bound(i), max);
+  }
+  return max;
+}
+
+/**
+ *  Constructor.
+ */
+histogram::histogram() {
+  reset();
+}
+
+/**
+ *  Get the bucket counting a value.
+ *
+ *  @param[in] value  Value.
+ *
+ *  @return Bucket index.
+ */
+uint32_t histogram::bucket_of(uint64_t value) noexcept {
+  if (value < sub_buckets)
+    return static_cast<uint32_t>(value);
+  uint32_t power(63 - __builtin_clzll(value));
+  if (power > max_power)
+    return bucket_count - 1;
+  return (power - sub_bucket_bits + 1) * sub_buckets +
+         static_cast<uint32_t>((value >> (power - sub_bucket_bits)) &
+                               (sub_buckets - 1));
+}
+
+/**
+ *  Get the greatest value counted by a bucket.
+ *
+ *  @param[in] bucket  Bucket index.
+ *
+ *  @return Upper bound of the bucket.
+ */
+uint64_t histogram::bucket_upper_bound(uint32_t bucket) noexcept {
+  if (bucket < sub_buckets)
+    return bucket;
+  uint32_t power(bucket / sub_buckets + sub_bucket_bits - 1);
+  uint64_t mantissa(sub_buckets + bucket % sub_buckets);
+  return ((mantissa + 1) << (power - sub_bucket_bits)) - 1;
+}
+
+/**
+ *  Record a value.
+ *
+ *  @param[in] value  Value, usually a duration in nanoseconds.
+ */
+void histogram::record(uint64_t value) noexcept {
+  shard& s(_shards[_shard_index()]);
+  s.buckets[bucket_of(value)].fetch_add(1, std::memory_order_relaxed);
+  s.count.fetch_add(1, std::memory_order_relaxed);
+  s.sum.fetch_add(value, std::memory_order_relaxed);
+  uint64_t max(s.max.load(std::memory_order_relaxed));
+  while (value > max && !s.max.compare_exchange_weak(
+                            max, value, std::memory_order_relaxed))
+    ;
+}
+
+/**
+ *  Forget all the recorded values.
+ */
+void histogram::reset() noexcept {
+  for (shard& s : _shards) {
+    for (std::atomic<uint64_t>& b : s.buckets)
+      b.store(0, std::memory_order_relaxed);
+    s.count.store(0, std::memory_order_relaxed);
+    s.sum.store(0, std::memory_order_relaxed);
+    s.max.store(0, std::memory_order_relaxed);
+  }
+}
+
+/**
+ *  Sum the shards. Records done meanwhile may be partially seen, which is
+ *  fine for statistics.
+ *
+ *  @return The merged histogram.
+ */
+histogram::snapshot histogram::get_snapshot() const {
+  snapshot retval;
+  for (shard const& s : _shards) {
+    for (uint32_t i = 0; i < bucket_count; ++i)
+      retval.buckets[i] += s.buckets[i].load(std::memory_order_relaxed);
+    retval.count += s.count.load(std::memory_order_relaxed);
+    retval.sum += s.sum.load(std::memory_order_relaxed);
+    retval.max = std::max(retval.max, s.max.load(std::memory_order_relaxed));
+  }
+  return retval;
+}
+
+/**
+ *  Get the shard of the calling thread. Threads are given shards in a
+ *  round robin way the first time they record a value.
+ *
+ *  @return Shard index.
+ */
+uint32_t histogram::_shard_index() noexcept {
+  static std::atomic<uint32_t> next(0);
+  thread_local uint32_t const index(next.fetch_add(1) % shard_count);
+  return index;
+}
@@ -0,0 +1,306 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#include "com/centreon/broker/stats/registry.hh"
+
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::stats;
+
+int const meter::window_length;
+
+namespace {
+/**
+ *  Node of the tree built by a snapshot.
+ */
+struct node {
+  json11::Json value;
+  std::map<std::string, node> children;
+};
+
+/**
+ *  Convert a node to json. A tree metric published on a node that also has
+ *  children is merged with them.
+ *
+ *  @param[in] n  Node.
+ *
+ *  @return Its json value.
+ */
+json11::Json to_json(node const& n) {
+  if (n.children.empty())
+    return n.value;
+  json11::Json::object retval;
+  if (n.value.is_object())
+    retval = n.value.object_items();
+  for (auto const& c : n.children)
+    retval[c.first] = to_json(c.second);
+  return retval;
+}
+
+/**
+ *  Get the full path of a metric.
+ *
+ *  @param[in] path  Path of its group.
+ *  @param[in] name  Name of the metric in the group.
+ *
+ *  @return Full path.
+ */
+std::string full_path(std::string const& path, std::string const& name) {
+  return name.empty() ? path : path + '/' + name;
+}
+
+/**
+ *  Check whether a path is in a subtree.
+ *
+ *  @param[in] path     Path.
+ *  @param[in] subtree  Subtree root.
+ *
+ *  @return true if path is the subtree root or below it.
+ */
+bool in_subtree(std::string const& path, std::string const& subtree) {
+  return path.compare(0, subtree.size(), subtree) == 0 &&
+         (path.size() == subtree.size() || path[subtree.size()] == '/');
+}
+}  // namespace
+
+json11::Json counter::value() const {
+  return static_cast<double>(get());
+}
+
+json11::Json gauge::value() const {
+  return get();
+}
+
+text::text() : _value(std::make_shared<std::string const>()) {}
+
+/**
+ *  Replace the string.
+ *
+ *  @param[in] v  New value.
+ */
+void text::set(std::string const& v) {
+  std::atomic_store(&_value, std::make_shared<std::string const>(v));
+}
+
+std::string text::get() const {
+  return *std::atomic_load(&_value);
+}
+
+json11::Json text::value() const {
+  return get();
+}
+
+tree::tree() : _value(std::make_shared<json11::Json const>()) {}
+
+/**
+ *  Replace the object.
+ *
+ *  @param[in] v  New value.
+ */
+void tree::set(json11::Json::object const& v) {
+  std::atomic_store(&_value, std::make_shared<json11::Json const>(v));
+}
+
+json11::Json tree::value() const {
+  return *std::atomic_load(&_value);
+}
+
+/**
+ *  Constructor.
+ */
+meter::meter() : _last_tick(0) {
+  for (int i = 0; i < window_length; ++i) {
+    _events[i].store(0, std::memory_order_relaxed);
+    _seconds[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+/**
+ *  Count processed events.
+ *
+ *  @param[in] events  Number of events.
+ */
+void meter::tick(uint32_t events) noexcept {
+  time_t now(time(nullptr));
+  int slot(now % window_length);
+  time_t second(_seconds[slot].load(std::memory_order_relaxed));
+  if (second != now && _seconds[slot].compare_exchange_strong(
+                           second, now, std::memory_order_relaxed))
+    _events[slot].store(0, std::memory_order_relaxed);
+  _events[slot].fetch_add(events, std::memory_order_relaxed);
+  _last_tick.store(now, std::memory_order_relaxed);
+}
+
+/**
+ *  Get the processing speed.
+ *
+ *  @return Events per second.
+ */
+double meter::get_speed() const noexcept {
+  time_t now(time(nullptr));
+  uint64_t events(0);
+  for (int i = 0; i < window_length; ++i)
+    if (now - _seconds[i].load(std::memory_order_relaxed) < window_length)
+      events += _events[i].load(std::memory_order_relaxed);
+  return static_cast<double>(events) / window_length;
+}
+
+/**
+ *  Get the time of the last tick.
+ *
+ *  @return Last tick time, 0 if no event was processed.
+ */
+time_t meter::get_last_event_time() const noexcept {
+  return _last_tick.load(std::memory_order_relaxed);
+}
+
+json11::Json meter::value() const {
+  return get_speed();
+}
+
+/**
+ *  Constructor.
+ */
+registry::registry() : _metrics(std::make_shared<metric_map const>()) {}
+
+/**
+ *  Get the registry instance.
+ *
+ *  @return The registry.
+ */
+registry& registry::instance() {
+  static registry instance;
+  return instance;
+}
+
+/**
+ *  Publish metrics. A metric already published with the same path is
+ *  replaced.
+ *
+ *  @param[in] path     Path of the group of metrics.
+ *  @param[in] metrics  Metrics with their names relative to path.
+ */
+void registry::add(std::string const& path, metric_list const& metrics) {
+  std::lock_guard<std::mutex> lock(_update_m);
+  std::shared_ptr<metric_map> m(std::make_shared<metric_map>(*_metrics));
+  for (auto const& p : metrics)
+    (*m)[full_path(path, p.first)] = p.second;
+  std::atomic_store(&_metrics, std::shared_ptr<metric_map const>(m));
+}
+
+/**
+ *  Withdraw metrics. A path now published by another metric is kept, so
+ *  an object replaced by another one with the same name can be destroyed
+ *  after its successor was created.
+ *
+ *  @param[in] path     Path of the group of metrics.
+ *  @param[in] metrics  Metrics with their names relative to path.
+ */
+void registry::remove(std::string const& path, metric_list const& metrics) {
+  std::lock_guard<std::mutex> lock(_update_m);
+  std::shared_ptr<metric_map> m(std::make_shared<metric_map>(*_metrics));
+  for (auto const& p : metrics) {
+    auto it(m->find(full_path(path, p.first)));
+    if (it != m->end() && it->second == p.second)
+      m->erase(it);
+  }
+  std::atomic_store(&_metrics, std::shared_ptr<metric_map const>(m));
+}
+
+/**
+ *  Read the published metrics.
+ *
+ *  @param[in] subtrees  Paths of the wanted subtrees, all the metrics are
+ *                       read when empty.
+ *
+ *  @return The metrics, as a tree following their paths.
+ */
+json11::Json::object registry::snapshot(
+    std::vector<std::string> const& subtrees) const {
+  std::shared_ptr<metric_map const> metrics(std::atomic_load(&_metrics));
+
+  node root;
+  auto insert = [&root](std::string const& path, metric const& m) {
+    node* n(&root);
+    size_t start(0);
+    for (;;) {
+      size_t end(path.find('/', start));
+      n = &n->children[path.substr(start, end - start)];
+      if (end == std::string::npos)
+        break;
+      start = end + 1;
+    }
+    n->value = m.value();
+  };
+
+  if (subtrees.empty())
+    for (auto const& p : *metrics)
+      insert(p.first, *p.second);
+  else
+    for (std::string const& s : subtrees)
+      for (auto it(metrics->lower_bound(s));
+           it != metrics->end() && it->first.compare(0, s.size(), s) == 0;
+           ++it)
+        if (in_subtree(it->first, s))
+          insert(it->first, *it->second);
+
+  json11::Json::object retval;
+  for (auto const& c : root.children)
+    retval[c.first] = to_json(c.second);
+  return retval;
+}
+
+/**
+ *  Destructor.
+ */
+group::~group() noexcept {
+  unpublish();
+}
+
+/**
+ *  Get the path of the group.
+ *
+ *  @return Its path, empty if it is not published.
+ */
+std::string const& group::path() const noexcept {
+  return _path;
+}
+
+/**
+ *  Publish the metrics of the group, moving them if they were already
+ *  published.
+ *
+ *  @param[in] path  New path of the group.
+ */
+void group::publish(std::string const& path) {
+  unpublish();
+  _path = path;
+  registry::instance().add(_path, _metrics);
+}
+
+/**
+ *  Withdraw the metrics of the group from the registry.
+ */
+void group::unpublish() noexcept {
+  if (!_path.empty()) {
+    try {
+      registry::instance().remove(_path, _metrics);
+    } catch (...) {
+    }
+    _path.clear();
+  }
+}
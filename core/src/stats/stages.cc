@@ -0,0 +1,49 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#include "com/centreon/broker/stats/stages.hh"
+
+using namespace com::centreon::broker;
+
+static char const* const stage_names[stats::stage_count] = {
+    "bbdo_decode", "engine_publish", "muxer_queue_wait",
+    "stream_write", "sql_commit",    "rrd_update"};
+
+static stats::histogram stage_histograms[stats::stage_count];
+
+/**
+ *  Get the name of a stage.
+ *
+ *  @param[in] s  Stage.
+ *
+ *  @return Its name.
+ */
+char const* stats::stage_name(stage s) noexcept {
+  return stage_names[s];
+}
+
+/**
+ *  Get the histogram of a stage.
+ *
+ *  @param[in] s  Stage.
+ *
+ *  @return The histogram of the durations of this stage.
+ */
+stats::histogram& stats::stage_histogram(stage s) noexcept {
+  return stage_histograms[s];
+}
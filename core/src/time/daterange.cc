@@ -389,14 +389,17 @@ uint32_t daterange::year_start() const throw() {
  *
  *  @param[in] middnight  Midnight of base day.
  *  @param[in] skip       Number of days to skip (in seconds).
+ *  @param[in] tz         Timezone of the date.
  *
  *  @return Midnight of the day in skip seconds.
  */
-static time_t _add_round_days_to_midnight(time_t midnight, time_t skip) {
+static time_t _add_round_days_to_midnight(time_t midnight,
+                                          time_t skip,
+                                          timezone_rules const& tz) {
   // Compute expected time with no DST.
   time_t next_day_time(midnight + skip);
   struct tm next_day;
-  localtime_r(&next_day_time, &next_day);
+  tz.localtime(next_day_time, next_day);
 
   // There was a DST shift in between.
   if (next_day.tm_hour || next_day.tm_min || next_day.tm_sec) {
@@ -407,11 +410,11 @@ static time_t _add_round_days_to_midnight(time_t midnight, time_t skip) {
     ** time to midnight, convert back and we're done.
     */
     next_day_time += 12 * 60 * 60 + skip;
-    localtime_r(&next_day_time, &next_day);
+    tz.localtime(next_day_time, next_day);
     next_day.tm_hour = 0;
     next_day.tm_min = 0;
     next_day.tm_sec = 0;
-    next_day_time = mktime(&next_day);
+    next_day_time = tz.mktime(next_day);
   }
 
   return (next_day_time);
@@ -424,12 +427,14 @@ static time_t _add_round_days_to_midnight(time_t midnight, time_t skip) {
  *  @param[in] year      Year.
  *  @param[in] month     Month.
  *  @param[in] monthday  Day in month.
+ *  @param[in] tz        Timezone of the date.
  *
  *  @return Requested timestamp, (time_t)-1 if conversion failed.
  */
 static time_t calculate_time_from_day_of_month(int year,
                                                int month,
-                                               int monthday) {
+                                               int monthday,
+                                               timezone_rules const& tz) {
   time_t midnight;
   tm t;
 
@@ -442,7 +447,7 @@ static time_t calculate_time_from_day_of_month(int year,
     t.tm_mon = month;
     t.tm_mday = monthday;
     t.tm_isdst = -1;
-    midnight = mktime(&t);
+    midnight = tz.mktime(t);
 
     // If we rolled over to the next month, time is invalid, assume the
     // user's intention is to keep it in the current month.
@@ -462,7 +467,7 @@ static time_t calculate_time_from_day_of_month(int year,
       t.tm_year = year;
       t.tm_mday = day;
       t.tm_isdst = -1;
-      midnight = mktime(&t);
+      midnight = tz.mktime(t);
     } while ((midnight == (time_t)-1) || (t.tm_mon != month));
 
     // Now that we know the last day, back up more.
@@ -475,7 +480,7 @@ static time_t calculate_time_from_day_of_month(int year,
     else
       t.tm_mday += monthday + 1;
     t.tm_isdst = -1;
-    midnight = mktime(&t);
+    midnight = tz.mktime(t);
   }
 
   return (midnight);
@@ -490,13 +495,16 @@ static time_t calculate_time_from_day_of_month(int year,
  *  @param[in] weekday         Target weekday.
  *  @param[in] weekday_offset  Weekday offset (1 is first, 2 is second,
  *                             -1 is last).
+ *  @param[in] tz              Timezone of the date.
  *
  *  @return Requested timestamp, (time_t)-1 if conversion failed.
  */
-static time_t calculate_time_from_weekday_of_month(int year,
-                                                   int month,
-                                                   int weekday,
-                                                   int weekday_offset) {
+static time_t calculate_time_from_weekday_of_month(
+    int year,
+    int month,
+    int weekday,
+    int weekday_offset,
+    timezone_rules const& tz) {
   // Compute first day of month (to get weekday).
   tm t;
   t.tm_sec = 0;
@@ -506,7 +514,7 @@ static time_t calculate_time_from_weekday_of_month(int year,
   t.tm_mon = month;
   t.tm_mday = 1;
   t.tm_isdst = -1;
-  time_t midnight(mktime(&t));
+  time_t midnight(tz.mktime(t));
 
   // How many days must we advance to reach the first instance of the
   // weekday this month ?
@@ -525,7 +533,7 @@ static time_t calculate_time_from_weekday_of_month(int year,
     t.tm_year = year;
     t.tm_mday = days + 1;
     t.tm_isdst = -1;
-    midnight = mktime(&t);
+    midnight = tz.mktime(t);
 
     // If we rolled over to the next month, time is invalid, assume the
     // user's intention is to keep it in the current month.
@@ -545,7 +553,7 @@ static time_t calculate_time_from_weekday_of_month(int year,
       t.tm_year = year;
       t.tm_mday = days + 1;
       t.tm_isdst = -1;
-      midnight = mktime(&t);
+      midnight = tz.mktime(t);
     } while ((midnight == (time_t)-1) || (t.tm_mon != month));
 
     // Now that we know the last instance of the weekday, back up more.
@@ -558,7 +566,7 @@ static time_t calculate_time_from_weekday_of_month(int year,
     else
       t.tm_mday += days;
     t.tm_isdst = -1;
-    midnight = mktime(&t);
+    midnight = tz.mktime(t);
   }
 
   return (midnight);
@@ -575,7 +583,10 @@ static time_t calculate_time_from_weekday_of_month(int year,
  *
  *  @return True on success, otherwise false.
  */
-bool daterange::_calendar_date_to_time_t(time_t& start, time_t& end) const {
+bool daterange::_calendar_date_to_time_t(time_info const& ti,
+                                         time_t& start,
+                                         time_t& end) const {
+  timezone_rules const& tz(*ti.tz);
   tm t;
   t.tm_sec = 0;
   t.tm_min = 0;
@@ -585,7 +596,7 @@ bool daterange::_calendar_date_to_time_t(time_t& start, time_t& end) const {
   t.tm_mday = _month_day_start;
   t.tm_mon = _month_start;
   t.tm_year = _year_start - 1900;
-  if ((start = mktime(&t)) == (time_t)-1)
+  if ((start = tz.mktime(t)) == (time_t)-1)
     return (false);
 
   if (_year_end) {
@@ -602,7 +613,7 @@ bool daterange::_calendar_date_to_time_t(time_t& start, time_t& end) const {
     ** valid to check that we're less than or equal to 23:59:59, which
     ** value is provided by mktime().
     */
-    if ((end = mktime(&t)) == (time_t)-1)
+    if ((end = tz.mktime(t)) == (time_t)-1)
       return (false);
     ++end;
   } else
@@ -623,6 +634,7 @@ bool daterange::_calendar_date_to_time_t(time_t& start, time_t& end) const {
 bool daterange::_month_date_to_time_t(time_info const& ti,
                                       time_t& start,
                                       time_t& end) const {
+  timezone_rules const& tz(*ti.tz);
   // what year should we use?
   int year = ti.preftime.tm_year;
   // int year(std::max(ti.preftime.tm_year, ti.curtime.tm_year));
@@ -632,18 +644,19 @@ bool daterange::_month_date_to_time_t(time_info const& ti,
       || (_month_end == ti.curtime.tm_mon
           && _month_day_end < ti.curtime.tm_mday))
     ++year;*/
-  start =
-      calculate_time_from_day_of_month(year, _month_start, _month_day_start);
+  start = calculate_time_from_day_of_month(year, _month_start, _month_day_start,
+                                           tz);
 
   // start date was bad.
   if (!start)
     return (false);
 
   // use same year as was calculated for start time above
-  end = calculate_time_from_day_of_month(year, _month_end, _month_day_end);
+  end = calculate_time_from_day_of_month(year, _month_end, _month_day_end, tz);
   // advance a year if necessary: august 5 - february 2
   if (end < start)
-    end = calculate_time_from_day_of_month(++year, _month_end, _month_day_end);
+    end = calculate_time_from_day_of_month(++year, _month_end, _month_day_end,
+                                           tz);
 
   // end date was bad - see if we can handle the error
   if (!end) {
@@ -652,7 +665,7 @@ bool daterange::_month_date_to_time_t(time_info const& ti,
       return (false);
     // else end date slipped past end of month, so use last
     // day of month as end date
-    end = calculate_time_from_day_of_month(year, _month_end, -1);
+    end = calculate_time_from_day_of_month(year, _month_end, -1, tz);
   }
   return (true);
 }
@@ -669,6 +682,7 @@ bool daterange::_month_date_to_time_t(time_info const& ti,
 bool daterange::_month_day_to_time_t(time_info const& ti,
                                      time_t& start,
                                      time_t& end) const {
+  timezone_rules const& tz(*ti.tz);
   // What year/month should we use ?
   int year;
   int month;
@@ -686,12 +700,12 @@ bool daterange::_month_day_to_time_t(time_info const& ti,
   }
 
   // Compute start date.
-  start = calculate_time_from_day_of_month(year, month, _month_day_start);
+  start = calculate_time_from_day_of_month(year, month, _month_day_start, tz);
   if (start == (time_t)-1)
     return (false);
 
   // Use same year and month as was calculated for start time above.
-  end = calculate_time_from_day_of_month(year, month, _month_day_end);
+  end = calculate_time_from_day_of_month(year, month, _month_day_end, tz);
   if (end == (time_t)-1) {
     // End date can't be helped, so skip it.
     if (_month_day_end < 0)
@@ -705,9 +719,9 @@ bool daterange::_month_day_to_time_t(time_info const& ti,
       month = 0;
       ++year;
     }
-    end = calculate_time_from_day_of_month(year, month, 0);
+    end = calculate_time_from_day_of_month(year, month, 0, tz);
   } else
-    end = _add_round_days_to_midnight(end, 24 * 60 * 60);
+    end = _add_round_days_to_midnight(end, 24 * 60 * 60, tz);
   return (true);
 }
 
@@ -723,25 +737,26 @@ bool daterange::_month_day_to_time_t(time_info const& ti,
 bool daterange::_month_week_day_to_time_t(time_info const& ti,
                                           time_t& start,
                                           time_t& end) const {
+  timezone_rules const& tz(*ti.tz);
   // What year should we use?
   int year = ti.preftime.tm_year;
 
   while (true) {
     // Calculate time of specified weekday of specific month.
     start = calculate_time_from_weekday_of_month(
-        year, _month_start, _week_day_start, _week_day_start_offset);
+        year, _month_start, _week_day_start, _week_day_start_offset, tz);
     if ((time_t)-1 == start)
       return (false);
 
     // Use same year as was calculated for start time above.
     end = calculate_time_from_weekday_of_month(year, _month_end, _week_day_end,
-                                               _week_day_end_offset);
+                                               _week_day_end_offset, tz);
 
     // Advance a year if necessary :
     // thursday 2 august - monday 3 february
     if ((end != (time_t)-1) && (end < start))
       end = calculate_time_from_weekday_of_month(
-          year + 1, _month_end, _week_day_end, _week_day_end_offset);
+          year + 1, _month_end, _week_day_end, _week_day_end_offset, tz);
 
     if ((time_t)-1 == end) {
       // End date can't be helped, so skip it.
@@ -759,11 +774,11 @@ bool daterange::_month_week_day_to_time_t(time_info const& ti,
         end_month = 0;
         end_year = year + 1;
       }
-      end = calculate_time_from_day_of_month(end_year, end_month, 0);
+      end = calculate_time_from_day_of_month(end_year, end_month, 0, tz);
       if ((time_t)-1 == end)
         return (false);
     } else
-      end = _add_round_days_to_midnight(end, 24 * 60 * 60);
+      end = _add_round_days_to_midnight(end, 24 * 60 * 60, tz);
 
     // We should have an interval that includes or is above
     // preferred time.
@@ -790,6 +805,7 @@ bool daterange::_month_week_day_to_time_t(time_info const& ti,
 bool daterange::_week_day_to_time_t(time_info const& ti,
                                     time_t& start,
                                     time_t& end) const {
+  timezone_rules const& tz(*ti.tz);
   // What year/month should we use ?
   int year;
   int month;
@@ -799,11 +815,11 @@ bool daterange::_week_day_to_time_t(time_info const& ti,
   while (true) {
     // Calculate time of specified weekday of month.
     start = calculate_time_from_weekday_of_month(year, month, _week_day_start,
-                                                 _week_day_start_offset);
+                                                 _week_day_start_offset, tz);
 
     // Use same year and month as was calculated for start time above.
     end = calculate_time_from_weekday_of_month(year, month, _week_day_end,
-                                               _week_day_end_offset);
+                                               _week_day_end_offset, tz);
     if (end == (time_t)-1) {
       // End date can't be helped, so skip it.
       if (_week_day_end_offset < 0)
@@ -820,9 +836,9 @@ bool daterange::_week_day_to_time_t(time_info const& ti,
         end_month = 0;
         end_year = year + 1;
       }
-      end = calculate_time_from_day_of_month(end_year, end_month, 0);
+      end = calculate_time_from_day_of_month(end_year, end_month, 0, tz);
     } else
-      end = _add_round_days_to_midnight(end, 24 * 60 * 60);
+      end = _add_round_days_to_midnight(end, 24 * 60 * 60, tz);
 
     // Error checking.
     if (((time_t)-1 == start) || ((time_t)-1 == end) || (start > end))
@@ -854,26 +870,29 @@ bool daterange::_week_day_to_time_t(time_info const& ti,
  *  @param[in]  preferred_time  Preferred time.
  *  @param[out] start  Variable to fill start time.
  *  @param[out] end    Variable to fill end time.
+ *  @param[in]  tz     Timezone in which the date range is expressed.
  *
  *  @return True on success, otherwise false.
  */
 bool daterange::to_time_t(time_t const preferred_time,
                           time_t& start,
-                          time_t& end) const {
+                          time_t& end,
+                          timezone_rules const& tz) const {
   bool ret = false;
 
   // Compute time information.
   time_info ti;
+  ti.tz = &tz;
   ti.preferred_time = preferred_time;
-  localtime_r(&preferred_time, &ti.preftime);
+  tz.localtime(preferred_time, ti.preftime);
   ti.preftime.tm_sec = 0;
   ti.preftime.tm_min = 0;
   ti.preftime.tm_hour = 0;
-  ti.midnight = mktime(&ti.preftime);
+  ti.midnight = tz.mktime(ti.preftime);
 
   switch (_type) {
     case calendar_date:
-      ret = _calendar_date_to_time_t(start, end);
+      ret = _calendar_date_to_time_t(ti, start, end);
       break;
     case month_date:
       ret = _month_date_to_time_t(ti, start, end);
@@ -903,11 +922,12 @@ bool daterange::to_time_t(time_t const preferred_time,
 
       // Advance start date to next skip day
       if (!(days % _skip_interval))
-        start = _add_round_days_to_midnight(start, days * 24 * 60 * 60);
+        start = _add_round_days_to_midnight(start, days * 24 * 60 * 60, tz);
       else
         start = _add_round_days_to_midnight(
             start,
-            ((days - (days % _skip_interval) + _skip_interval) * 24 * 60 * 60));
+            ((days - (days % _skip_interval) + _skip_interval) * 24 * 60 * 60),
+            tz);
     }
   }
 
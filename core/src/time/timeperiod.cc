@@ -17,18 +17,19 @@
 */
 
 #include "com/centreon/broker/time/timeperiod.hh"
+#include <algorithm>
 #include <ctime>
 #include <sstream>
 #include <stdexcept>
 #include "com/centreon/broker/exceptions/msg.hh"
-#include "com/centreon/broker/time/timezone_locker.hh"
 
 using namespace com::centreon::broker::time;
 
 /**
  *  Default constructor.
  */
-timeperiod::timeperiod() : _id(0) {
+timeperiod::timeperiod()
+    : _id(0), _tz(timezone_rules::get("")), _cache_start(0), _cache_end(0) {
   _timeranges.resize(7);
   _exceptions.resize(daterange::daterange_types);
 }
@@ -38,7 +39,8 @@ timeperiod::timeperiod() : _id(0) {
  *
  *  @param[in] obj  The object to copy.
  */
-timeperiod::timeperiod(timeperiod const& obj) {
+timeperiod::timeperiod(timeperiod const& obj)
+    : _cache_start(0), _cache_end(0) {
   timeperiod::operator=(obj);
 }
 
@@ -65,7 +67,12 @@ timeperiod::timeperiod(uint32_t id,
                        std::string const& thursday,
                        std::string const& friday,
                        std::string const& saturday)
-    : _id(id), _alias(alias), _timeperiod_name(name) {
+    : _id(id),
+      _alias(alias),
+      _timeperiod_name(name),
+      _tz(timezone_rules::get("")),
+      _cache_start(0),
+      _cache_end(0) {
   _timeranges.resize(7);
   _exceptions.resize(daterange::daterange_types);
   std::vector<bool> success;
@@ -102,6 +109,8 @@ timeperiod timeperiod::operator=(timeperiod const& obj) {
     _timeperiod_name = obj._timeperiod_name;
     _timeranges = obj._timeranges;
     _timezone = obj._timezone;
+    _tz = obj._tz;
+    _invalidate_cache();
   }
   return (*this);
 }
@@ -174,6 +183,7 @@ std::list<daterange> const& timeperiod::get_exceptions_from_type(
  */
 void timeperiod::add_exceptions(std::list<daterange> const& val) {
   _exceptions.push_back(val);
+  _invalidate_cache();
 }
 
 /**
@@ -191,6 +201,7 @@ bool timeperiod::add_exception(std::string const& days,
   ss << days << " " << range;
 
   // Parse everything.
+  _invalidate_cache();
   return (daterange::build_dateranges_from_string(ss.str(), _exceptions));
 }
 
@@ -210,6 +221,7 @@ std::vector<timeperiod::ptr> const& timeperiod::get_included() const noexcept {
  */
 void timeperiod::add_included(timeperiod::ptr val) {
   _include.push_back(val);
+  _invalidate_cache();
 }
 
 /**
@@ -228,6 +240,7 @@ std::vector<timeperiod::ptr> const& timeperiod::get_excluded() const throw() {
  */
 void timeperiod::add_excluded(timeperiod::ptr val) {
   _exclude.push_back(val);
+  _invalidate_cache();
 }
 
 /**
@@ -278,6 +291,7 @@ std::list<timerange> const& timeperiod::get_timeranges_by_day(int day) const
  *  @return  True if the string is valid.
  */
 bool timeperiod::set_timerange(std::string const& timerange_text, int day) {
+  _invalidate_cache();
   return (timerange::build_timeranges_from_string(timerange_text,
                                                   _timeranges[day]));
 }
@@ -298,6 +312,8 @@ std::string const& timeperiod::get_timezone() const throw() {
  */
 void timeperiod::set_timezone(std::string const& tz) {
   _timezone = tz;
+  _tz = timezone_rules::get(tz);
+  _invalidate_cache();
 }
 
 /**
@@ -315,11 +331,139 @@ bool timeperiod::is_valid(time_t preferred_time) const {
  *  Get the next valid time from preferred time in this timeperiod.
  *
  *  @param[in] preferred_time The preferred time.
- *  @return The next valid time.
+ *  @return The next valid time, (time_t)-1 if none in the next 8 days.
  */
 time_t timeperiod::get_next_valid(time_t preferred_time) const {
-  // Set timezone.
-  timezone_locker tzlock(_timezone.empty() ? nullptr : _timezone.c_str());
+  if (preferred_time == (time_t)-1)
+    return ((time_t)-1);
+
+  std::lock_guard<std::mutex> lock(_cache_m);
+  time_t limit;
+  std::vector<std::pair<time_t, time_t> >::const_iterator it(
+      _find_interval(preferred_time, limit));
+  if (it == _cache.end())
+    return ((time_t)-1);
+  time_t retval(std::max(it->first, preferred_time));
+  return (retval < limit ? retval : (time_t)-1);
+}
+
+/**
+ *  Get the next invalid time from preferred time in this timeperiod.
+ *
+ *  @param[in] preferred_time  The preferred time.
+ *
+ *  @return The next invalid time, (time_t)-1 if none in the next 8 days.
+ */
+time_t timeperiod::get_next_invalid(time_t preferred_time) const {
+  if (preferred_time == (time_t)-1)
+    return ((time_t)-1);
+
+  std::lock_guard<std::mutex> lock(_cache_m);
+  time_t limit;
+  std::vector<std::pair<time_t, time_t> >::const_iterator it(
+      _find_interval(preferred_time, limit));
+  if (it == _cache.end() || it->first > preferred_time)
+    return (preferred_time);
+  return (it->second < limit ? it->second : (time_t)-1);
+}
+
+/**
+ *  Get midnight of the day of some time in the timezone of this
+ *  timeperiod.
+ *
+ *  @param[in] t  Time.
+ *
+ *  @return Midnight of the day.
+ */
+time_t timeperiod::_midnight(time_t t) const {
+  struct tm tmp;
+  _tz->localtime(t, tmp);
+  tmp.tm_sec = 0;
+  tmp.tm_min = 0;
+  tmp.tm_hour = 0;
+  tmp.tm_isdst = -1;
+  return (_tz->mktime(tmp));
+}
+
+/**
+ *  Find the first cached interval ending after some time. The cache is
+ *  rebuilt if it does not cover the 8 days looked up from this time.
+ *  _cache_m must be locked.
+ *
+ *  @param[in]  t      Time.
+ *  @param[out] limit  End of the lookup, midnight 8 days after t.
+ *
+ *  @return Iterator to the interval, _cache.end() if none.
+ */
+std::vector<std::pair<time_t, time_t> >::const_iterator
+timeperiod::_find_interval(time_t t, time_t& limit) const {
+  time_t midnight(_midnight(t));
+  limit = add_round_days_to_midnight(midnight, 8 * 24 * 60 * 60, *_tz);
+  if (midnight < _cache_start || limit > _cache_end)
+    _build_cache(midnight);
+  return (std::upper_bound(
+      _cache.begin(), _cache.end(), t,
+      [](time_t value, std::pair<time_t, time_t> const& interval) {
+        return (value < interval.second);
+      }));
+}
+
+/**
+ *  Materialize the valid intervals of cache_days days.
+ *
+ *  @param[in] midnight  First day of the cache.
+ */
+void timeperiod::_build_cache(time_t midnight) const {
+  _cache.clear();
+  _cache_start = midnight;
+  _cache_end =
+      add_round_days_to_midnight(midnight, cache_days * 24 * 60 * 60, *_tz);
+
+  time_t current(midnight);
+  while (current < _cache_end) {
+    time_t start(_get_next_valid(current));
+    // Nothing valid in the next 8 days.
+    if (start == (time_t)-1) {
+      current += 7 * 24 * 60 * 60;
+      continue;
+    }
+    if (start >= _cache_end)
+      break;
+
+    // Valid for at least 7 days, the next lookup will extend the
+    // interval.
+    time_t end(_get_next_invalid(start));
+    if (end == (time_t)-1)
+      end = start + 7 * 24 * 60 * 60;
+
+    if (!_cache.empty() && _cache.back().second == start && start != end)
+      _cache.back().second = end;
+    else
+      _cache.push_back(std::make_pair(start, end));
+    // Empty ranges must not stop the walk.
+    current = (end > start) ? end : start + 1;
+  }
+}
+
+/**
+ *  Drop the valid intervals cache.
+ */
+void timeperiod::_invalidate_cache() {
+  std::lock_guard<std::mutex> lock(_cache_m);
+  _cache.clear();
+  _cache_start = 0;
+  _cache_end = 0;
+}
+
+/**
+ *  Get the next valid time from preferred time, day by day.
+ *
+ *  @param[in] preferred_time The preferred time.
+ *  @return The next valid time.
+ */
+time_t timeperiod::_get_next_valid(time_t preferred_time) const {
+  // Timezone rules are immutable, no need to touch the global timezone.
+  timezone_rules const& tz(*_tz);
 
   // Check preferred_time.
   if (preferred_time != (time_t)-1) {
@@ -328,22 +472,23 @@ time_t timeperiod::get_next_valid(time_t preferred_time) const {
     int weekday;
     {
       struct tm preftime;
-      localtime_r(&preferred_time, &preftime);
+      tz.localtime(preferred_time, preftime);
       weekday = preftime.tm_wday;
       preftime.tm_sec = 0;
       preftime.tm_min = 0;
       preftime.tm_hour = 0;
-      midnight = mktime(&preftime);
+      preftime.tm_isdst = -1;
+      midnight = tz.mktime(preftime);
     }
 
     // Loop through the next 8 days (today which is
     // already started plus 7 days ahead).
     for (int i(0); i < 8; ++i) {
       // Compute current day's midnight.
-      time_t day_start(
-          timeperiod::add_round_days_to_midnight(midnight, i * 24 * 60 * 60));
+      time_t day_start(timeperiod::add_round_days_to_midnight(
+          midnight, i * 24 * 60 * 60, tz));
       struct tm day_midnight;
-      localtime_r(&day_start, &day_midnight);
+      tz.localtime(day_start, day_midnight);
 
       // Check all time ranges for this day of the week.
       time_t earliest_time((time_t)-1);
@@ -354,7 +499,7 @@ time_t timeperiod::get_next_valid(time_t preferred_time) const {
         // Get range limits.
         time_t range_start((time_t)-1);
         time_t range_end((time_t)-1);
-        if (trange->to_time_t(day_midnight, range_start, range_end)) {
+        if (trange->to_time_t(day_midnight, range_start, range_end, tz)) {
           // Range is out of bound.
           if (preferred_time < range_end) {
             time_t potential_time((time_t)-1);
@@ -384,15 +529,15 @@ time_t timeperiod::get_next_valid(time_t preferred_time) const {
 }
 
 /**
- *  Get the next invalid time from preferred time in this timeperiod.
+ *  Get the next invalid time from preferred time, day by day.
  *
  *  @param[in] preferred_time  The preferred time.
  *
  *  @return                    The next invalid time.
  */
-time_t timeperiod::get_next_invalid(time_t preferred_time) const {
-  // Set timezone.
-  timezone_locker tzlock(_timezone.empty() ? nullptr : _timezone.c_str());
+time_t timeperiod::_get_next_invalid(time_t preferred_time) const {
+  // Timezone rules are immutable, no need to touch the global timezone.
+  timezone_rules const& tz(*_tz);
 
   // Check preferred_time.
   if (preferred_time != (time_t)-1) {
@@ -401,24 +546,25 @@ time_t timeperiod::get_next_invalid(time_t preferred_time) const {
     int weekday;
     {
       struct tm preftime;
-      localtime_r(&preferred_time, &preftime);
+      tz.localtime(preferred_time, preftime);
       weekday = preftime.tm_wday;
       preftime.tm_sec = 0;
       preftime.tm_min = 0;
       preftime.tm_hour = 0;
-      midnight = mktime(&preftime);
+      preftime.tm_isdst = -1;
+      midnight = tz.mktime(preftime);
     }
 
     // Loop through the next 8 days (today which is
     // already started plus 7 days ahead).
     for (int i(0); i < 8; ++i) {
       // Compute current day's midnight.
-      time_t day_start(
-          timeperiod::add_round_days_to_midnight(midnight, i * 24 * 60 * 60));
+      time_t day_start(timeperiod::add_round_days_to_midnight(
+          midnight, i * 24 * 60 * 60, tz));
       time_t day_end(
-          timeperiod::add_round_days_to_midnight(day_start, 24 * 60 * 60));
+          timeperiod::add_round_days_to_midnight(day_start, 24 * 60 * 60, tz));
       struct tm day_midnight;
-      localtime_r(&day_start, &day_midnight);
+      tz.localtime(day_start, day_midnight);
 
       // Try to find an invalid time in all ranges.
       time_t earliest_time(preferred_time > day_start ? preferred_time
@@ -432,7 +578,7 @@ time_t timeperiod::get_next_invalid(time_t preferred_time) const {
           // Get range limits.
           time_t range_start((time_t)-1);
           time_t range_end((time_t)-1);
-          if (trange->to_time_t(day_midnight, range_start, range_end) &&
+          if (trange->to_time_t(day_midnight, range_start, range_end, tz) &&
               (earliest_time >= range_start) && (earliest_time < range_end)) {
             invalid_in_all_periods = false;
             earliest_time = range_end;
@@ -486,14 +632,17 @@ uint32_t timeperiod::duration_intersect(time_t start_time,
  *
  *  @param[in] middnight  Midnight of base day.
  *  @param[in] skip       Number of days to skip (in seconds).
+ *  @param[in] tz         Timezone of the day.
  *
  *  @return Midnight of the day in skip seconds.
  */
-time_t timeperiod::add_round_days_to_midnight(time_t midnight, long long skip) {
+time_t timeperiod::add_round_days_to_midnight(time_t midnight,
+                                              long long skip,
+                                              timezone_rules const& tz) {
   // Compute expected time with no DST.
   time_t next_day_time(midnight + skip);
   struct tm next_day;
-  localtime_r(&next_day_time, &next_day);
+  tz.localtime(next_day_time, next_day);
 
   // There was a DST shift in between.
   if (next_day.tm_hour || next_day.tm_min || next_day.tm_sec) {
@@ -504,11 +653,12 @@ time_t timeperiod::add_round_days_to_midnight(time_t midnight, long long skip) {
     ** time to midnight, convert back and we're done.
     */
     next_day_time += 12 * 60 * 60;
-    localtime_r(&next_day_time, &next_day);
+    tz.localtime(next_day_time, next_day);
     next_day.tm_hour = 0;
     next_day.tm_min = 0;
     next_day.tm_sec = 0;
-    next_day_time = mktime(&next_day);
+    next_day.tm_isdst = -1;
+    next_day_time = tz.mktime(next_day);
   }
 
   return (next_day_time);
@@ -175,20 +175,26 @@ uint64_t timerange::end_minute() const throw() {
  *  @param[in]  midnight     Midnight of day.
  *  @param[out] range_start  Start of time range in this specific day.
  *  @param[out] range_end    End of time range in this specific day.
+ *  @param[in]  tz           Timezone of midnight.
  *
  *  @return True upon successful conversion.
  */
 bool timerange::to_time_t(struct tm const& midnight,
                           time_t& range_start,
-                          time_t& range_end) const {
+                          time_t& range_end,
+                          timezone_rules const& tz) const {
   struct tm my_tm;
   memcpy(&my_tm, &midnight, sizeof(my_tm));
+  // DST might be different from the one of midnight.
   my_tm.tm_hour = start_hour();
   my_tm.tm_min = start_minute();
-  range_start = mktime(&my_tm);
+  my_tm.tm_isdst = -1;
+  range_start = tz.mktime(my_tm);
+  memcpy(&my_tm, &midnight, sizeof(my_tm));
   my_tm.tm_hour = end_hour();
   my_tm.tm_min = end_minute();
-  range_end = mktime(&my_tm);
+  my_tm.tm_isdst = -1;
+  range_end = tz.mktime(my_tm);
   return (true);
 }
 
@@ -0,0 +1,565 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#include "com/centreon/broker/time/timezone_rules.hh"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+#include "com/centreon/broker/logging/logging.hh"
+
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::time;
+
+/**
+ *  Floor division.
+ */
+static int64_t floor_div(int64_t a, int64_t b) {
+  int64_t q(a / b);
+  if ((a % b != 0) && ((a < 0) != (b < 0)))
+    --q;
+  return q;
+}
+
+/**
+ *  Number of days since 1970-01-01 of a date of the proleptic Gregorian
+ *  calendar.
+ *
+ *  @param[in] y  Year.
+ *  @param[in] m  Month (1-12).
+ *  @param[in] d  Day of month (1-31).
+ */
+static int64_t days_from_civil(int64_t y, int m, int d) {
+  y -= m <= 2;
+  int64_t era(floor_div(y, 400));
+  int64_t yoe(y - era * 400);
+  int64_t doy((153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1);
+  int64_t doe(yoe * 365 + yoe / 4 - yoe / 100 + doy);
+  return era * 146097 + doe - 719468;
+}
+
+/**
+ *  Date of a number of days since 1970-01-01.
+ *
+ *  @param[in]  z  Number of days.
+ *  @param[out] y  Year.
+ *  @param[out] m  Month (1-12).
+ *  @param[out] d  Day of month (1-31).
+ */
+static void civil_from_days(int64_t z, int64_t& y, int& m, int& d) {
+  z += 719468;
+  int64_t era(floor_div(z, 146097));
+  int64_t doe(z - era * 146097);
+  int64_t yoe((doe - doe / 1460 + doe / 36524 - doe / 146096) / 365);
+  y = yoe + era * 400;
+  int64_t doy(doe - (365 * yoe + yoe / 4 - yoe / 100));
+  int64_t mp((5 * doy + 2) / 153);
+  d = doy - (153 * mp + 2) / 5 + 1;
+  m = mp < 10 ? mp + 3 : mp - 9;
+  y += m <= 2;
+}
+
+/**
+ *  Week day (0 is sunday) of a number of days since 1970-01-01.
+ */
+static int weekday_from_days(int64_t z) {
+  return static_cast<int>(((z % 7) + 11) % 7);
+}
+
+/**
+ *  Read a big endian integer.
+ */
+static int64_t read_be(unsigned char const* p, int size) {
+  uint64_t v(0);
+  for (int i = 0; i < size; ++i)
+    v = (v << 8) | p[i];
+  if (size == 4)
+    return static_cast<int32_t>(static_cast<uint32_t>(v));
+  return static_cast<int64_t>(v);
+}
+
+/**
+ *  Default constructor, UTC rules.
+ */
+timezone_rules::timezone_rules()
+    : _has_posix(false), _has_dst(false), _std{0, false}, _dst{0, true} {}
+
+/**
+ *  Destructor.
+ */
+timezone_rules::~timezone_rules() {}
+
+/**
+ *  Get the rules of a timezone. The first call for a name reads the
+ *  timezone database, following calls return the cached object.
+ *
+ *  @param[in] name  Timezone name (Europe/Paris, :Europe/Paris, a file
+ *                   path or a POSIX TZ string). An empty name is the
+ *                   local timezone, as set by TZ when first requested
+ *                   or by /etc/localtime.
+ *
+ *  @return Timezone rules. Unknown timezones are UTC, as with the C
+ *          library.
+ */
+std::shared_ptr<timezone_rules const> timezone_rules::get(
+    std::string const& name) {
+  static std::mutex m;
+  static std::unordered_map<std::string, std::shared_ptr<timezone_rules const>>
+      cache;
+
+  std::lock_guard<std::mutex> lock(m);
+  std::shared_ptr<timezone_rules const>& retval(cache[name]);
+  if (!retval) {
+    std::shared_ptr<timezone_rules> tz(std::make_shared<timezone_rules>());
+    std::string tz_name(name);
+    if (tz_name.empty() && getenv("TZ"))
+      tz_name = getenv("TZ");
+    if (!tz_name.empty() && tz_name[0] == ':')
+      tz_name.erase(0, 1);
+    tz->_name = tz_name;
+
+    bool loaded(false);
+    if (tz_name.empty())
+      loaded = tz->_load_file("/etc/localtime");
+    else if (tz_name[0] == '/')
+      loaded = tz->_load_file(tz_name);
+    else if (tz_name.find("..") == std::string::npos) {
+      char const* dir(getenv("TZDIR"));
+      loaded = tz->_load_file(
+          std::string(dir && *dir ? dir : "/usr/share/zoneinfo") + "/" +
+          tz_name);
+    }
+    if (!loaded && !tz_name.empty())
+      loaded = tz->_parse_posix(tz_name);
+    if (!loaded) {
+      logging::error(logging::medium)
+          << "core: could not load timezone '" << tz_name
+          << "', UTC will be used";
+      tz->_transitions.clear();
+      tz->_transition_types.clear();
+      tz->_types.clear();
+      tz->_has_posix = false;
+    }
+    retval = tz;
+  }
+  return retval;
+}
+
+/**
+ *  Get the local timezone, i.e. the timezone of the TZ environment
+ *  variable or /etc/localtime.
+ *
+ *  @return Local timezone rules.
+ */
+timezone_rules const& timezone_rules::local() {
+  static std::shared_ptr<timezone_rules const> tz(get(""));
+  return *tz;
+}
+
+/**
+ *  Get the UTC timezone.
+ *
+ *  @return UTC rules.
+ */
+timezone_rules const& timezone_rules::utc() {
+  static timezone_rules const tz;
+  return tz;
+}
+
+/**
+ *  Get the timezone name.
+ *
+ *  @return Timezone name, empty when read from /etc/localtime.
+ */
+std::string const& timezone_rules::get_name() const noexcept {
+  return _name;
+}
+
+/**
+ *  Get the offset from UTC at some time.
+ *
+ *  @param[in]  t       UTC time.
+ *  @param[out] is_dst  If not null, set to true if DST is in effect.
+ *
+ *  @return Offset in seconds, positive east of Greenwich.
+ */
+int32_t timezone_rules::offset(time_t t, bool* is_dst) const {
+  type const* tp(nullptr);
+  if (_transitions.empty() || t < _transitions.front()) {
+    if (_transitions.empty() && _has_posix)
+      return _posix_offset(t, is_dst);
+    if (!_types.empty())
+      tp = &_types.front();
+  } else {
+    size_t idx(std::upper_bound(_transitions.begin(), _transitions.end(),
+                                static_cast<int64_t>(t)) -
+               _transitions.begin() - 1);
+    if (idx == _transitions.size() - 1 && _has_posix)
+      return _posix_offset(t, is_dst);
+    tp = &_types[_transition_types[idx]];
+  }
+  if (is_dst)
+    *is_dst = tp ? tp->is_dst : false;
+  return tp ? tp->utoff : 0;
+}
+
+/**
+ *  Convert a UTC time to local broken-down time, like localtime_r().
+ *
+ *  @param[in]  t       UTC time.
+ *  @param[out] result  Broken-down local time.
+ */
+void timezone_rules::localtime(time_t t, struct tm& result) const {
+  bool is_dst(false);
+  int64_t local(static_cast<int64_t>(t) + offset(t, &is_dst));
+  int64_t days(floor_div(local, 86400));
+  int64_t secs(local - days * 86400);
+  int64_t year;
+  int month;
+  int mday;
+  civil_from_days(days, year, month, mday);
+
+  memset(&result, 0, sizeof(result));
+  result.tm_year = static_cast<int>(year - 1900);
+  result.tm_mon = month - 1;
+  result.tm_mday = mday;
+  result.tm_hour = static_cast<int>(secs / 3600);
+  result.tm_min = static_cast<int>(secs / 60 % 60);
+  result.tm_sec = static_cast<int>(secs % 60);
+  result.tm_wday = weekday_from_days(days);
+  result.tm_yday = static_cast<int>(days - days_from_civil(year, 1, 1));
+  result.tm_isdst = is_dst ? 1 : 0;
+}
+
+/**
+ *  Convert local broken-down time to UTC time, like the mktime() of glibc.
+ *  Fields can be out of their range, t is normalized on return. Local
+ *  times skipped by a DST change are moved forward, ambiguous local times
+ *  use tm_isdst if it is set or the first occurrence otherwise.
+ *
+ *  @param[in,out] t  Broken-down local time.
+ *
+ *  @return UTC time.
+ */
+time_t timezone_rules::mktime(struct tm& t) const {
+  int64_t year(t.tm_year + 1900LL + floor_div(t.tm_mon, 12));
+  int month(static_cast<int>(t.tm_mon - floor_div(t.tm_mon, 12) * 12));
+  int64_t local((days_from_civil(year, month + 1, 1) + t.tm_mday - 1) * 86400 +
+                t.tm_hour * 3600LL + t.tm_min * 60LL + t.tm_sec);
+
+  // Offsets around the local time, transitions are never this close.
+  int32_t offsets[3] = {offset(local - 86400), offset(local),
+                        offset(local + 86400)};
+  time_t retval(0);
+  bool found(false);
+  bool found_dst_match(false);
+  for (int32_t off : offsets) {
+    time_t candidate(local - off);
+    bool is_dst;
+    if (offset(candidate, &is_dst) != off)
+      continue;
+    bool dst_match(t.tm_isdst >= 0 && (t.tm_isdst > 0) == is_dst);
+    if (!found || (dst_match && !found_dst_match) ||
+        (dst_match == found_dst_match && candidate < retval)) {
+      retval = candidate;
+      found = true;
+      found_dst_match = dst_match;
+    }
+  }
+  // Skipped local time: use the offset before the change.
+  if (!found)
+    retval = local - std::min(offsets[0], offsets[2]);
+  // A tm_isdst that does not match the local time means the time is
+  // expressed with the offset of the nearest time having this tm_isdst,
+  // searched week by week as glibc does, or one hour away if there is
+  // none.
+  else if (t.tm_isdst >= 0 && !found_dst_match) {
+    static int64_t const stride(601200);
+    static int64_t const delta_bound(536454000 / 2 + stride);
+    bool other_found(false);
+    for (int64_t delta(stride); !other_found && delta < delta_bound;
+         delta += stride)
+      for (int direction = -1; direction <= 1; direction += 2) {
+        bool is_dst;
+        int32_t off(offset(retval + delta * direction, &is_dst));
+        if (is_dst == (t.tm_isdst > 0)) {
+          retval = local - off;
+          other_found = true;
+          break;
+        }
+      }
+    if (!other_found)
+      retval += t.tm_isdst > 0 ? -3600 : 3600;
+  }
+
+  localtime(retval, t);
+  return retval;
+}
+
+/**
+ *  Load a TZif file.
+ *
+ *  @param[in] path  File path.
+ *
+ *  @return True on success.
+ */
+bool timezone_rules::_load_file(std::string const& path) {
+  std::ifstream ifs(path.c_str(), std::ios::binary);
+  if (!ifs.is_open())
+    return false;
+  std::ostringstream oss;
+  oss << ifs.rdbuf();
+  std::string const data(oss.str());
+  unsigned char const* p(reinterpret_cast<unsigned char const*>(data.data()));
+  size_t size(data.size());
+
+  if (size < 44 || memcmp(p, "TZif", 4))
+    return false;
+  char version(p[4]);
+
+  // Skip the version 1 block if a 64 bits block follows.
+  size_t pos(0);
+  int time_size(4);
+  for (;;) {
+    if (size < pos + 44 || memcmp(p + pos, "TZif", 4))
+      return false;
+    int64_t isutcnt(read_be(p + pos + 20, 4));
+    int64_t isstdcnt(read_be(p + pos + 24, 4));
+    int64_t leapcnt(read_be(p + pos + 28, 4));
+    int64_t timecnt(read_be(p + pos + 32, 4));
+    int64_t typecnt(read_be(p + pos + 36, 4));
+    int64_t charcnt(read_be(p + pos + 40, 4));
+    if (isutcnt < 0 || isstdcnt < 0 || leapcnt < 0 || timecnt < 0 ||
+        typecnt <= 0 || charcnt < 0)
+      return false;
+    size_t block(timecnt * time_size + timecnt + typecnt * 6 + charcnt +
+                 leapcnt * (time_size + 4) + isstdcnt + isutcnt);
+    if (size < pos + 44 + block)
+      return false;
+    if (time_size == 4 && version >= '2') {
+      pos += 44 + block;
+      time_size = 8;
+      continue;
+    }
+
+    unsigned char const* q(p + pos + 44);
+    _transitions.resize(timecnt);
+    for (int64_t i = 0; i < timecnt; ++i, q += time_size)
+      _transitions[i] = read_be(q, time_size);
+    _transition_types.assign(q, q + timecnt);
+    q += timecnt;
+    _types.resize(typecnt);
+    for (int64_t i = 0; i < typecnt; ++i, q += 6) {
+      _types[i].utoff = static_cast<int32_t>(read_be(q, 4));
+      _types[i].is_dst = q[4] != 0;
+    }
+    for (uint8_t t : _transition_types)
+      if (t >= typecnt)
+        return false;
+    pos += 44 + block;
+    break;
+  }
+
+  // Footer of version 2+ files.
+  if (time_size == 8 && pos < size && data[pos] == '\n') {
+    size_t end(data.find('\n', pos + 1));
+    if (end != std::string::npos && end > pos + 1)
+      _parse_posix(data.substr(pos + 1, end - pos - 1));
+  }
+  return true;
+}
+
+/**
+ *  Parse a POSIX TZ string such as CET-1CEST,M3.5.0,M10.5.0/3.
+ *
+ *  @param[in] str  TZ string.
+ *
+ *  @return True on success.
+ */
+bool timezone_rules::_parse_posix(std::string const& str) {
+  char const* p(str.c_str());
+
+  auto parse_name = [&p]() -> bool {
+    if (*p == '<') {
+      while (*p && *p != '>')
+        ++p;
+      if (!*p)
+        return false;
+      ++p;
+      return true;
+    }
+    char const* start(p);
+    while (isalpha(static_cast<unsigned char>(*p)))
+      ++p;
+    return p - start >= 3;
+  };
+  auto parse_time = [&p](int32_t& value) -> bool {
+    int sign(1);
+    if (*p == '+' || *p == '-')
+      sign = (*p++ == '-') ? -1 : 1;
+    if (!isdigit(static_cast<unsigned char>(*p)))
+      return false;
+    int32_t parts[3] = {0, 0, 0};
+    for (int i = 0; i < 3; ++i) {
+      if (i && *p != ':')
+        break;
+      if (i)
+        ++p;
+      while (isdigit(static_cast<unsigned char>(*p)))
+        parts[i] = parts[i] * 10 + (*p++ - '0');
+    }
+    value = sign * (parts[0] * 3600 + parts[1] * 60 + parts[2]);
+    return true;
+  };
+  auto parse_rule = [&p, &parse_time](rule& r) -> bool {
+    auto number = [&p]() -> int {
+      int v(0);
+      while (isdigit(static_cast<unsigned char>(*p)))
+        v = v * 10 + (*p++ - '0');
+      return v;
+    };
+    if (*p == 'M') {
+      ++p;
+      r.kind = rule::month_week_day;
+      r.month = number();
+      if (*p++ != '.')
+        return false;
+      r.week = number();
+      if (*p++ != '.')
+        return false;
+      r.day = number();
+      if (r.month < 1 || r.month > 12 || r.week < 1 || r.week > 5 ||
+          r.day > 6)
+        return false;
+    } else if (*p == 'J') {
+      ++p;
+      r.kind = rule::julian;
+      r.day = number();
+      if (r.day < 1 || r.day > 365)
+        return false;
+    } else if (isdigit(static_cast<unsigned char>(*p))) {
+      r.kind = rule::day_of_year;
+      r.day = number();
+      if (r.day > 365)
+        return false;
+    } else
+      return false;
+    r.time = 7200;
+    if (*p == '/') {
+      ++p;
+      return parse_time(r.time);
+    }
+    return true;
+  };
+
+  int32_t value;
+  if (!parse_name() || !parse_time(value))
+    return false;
+  _std.utoff = -value;
+  _std.is_dst = false;
+  _has_dst = false;
+  if (*p) {
+    if (!parse_name())
+      return false;
+    _has_dst = true;
+    _dst.is_dst = true;
+    _dst.utoff = _std.utoff + 3600;
+    if (*p && *p != ',') {
+      if (!parse_time(value))
+        return false;
+      _dst.utoff = -value;
+    }
+    if (*p == ',') {
+      ++p;
+      if (!parse_rule(_dst_start) || *p++ != ',' || !parse_rule(_dst_end))
+        return false;
+    } else {
+      // Default rules of the C library.
+      _dst_start = {rule::month_week_day, 3, 2, 0, 7200};
+      _dst_end = {rule::month_week_day, 11, 1, 0, 7200};
+    }
+    if (*p)
+      return false;
+  }
+  _has_posix = true;
+  return true;
+}
+
+/**
+ *  Get the local time of a rule in some year.
+ *
+ *  @param[in] r     Rule.
+ *  @param[in] year  Year.
+ *
+ *  @return Seconds since the epoch on the local time scale.
+ */
+int64_t timezone_rules::_rule_time(rule const& r, int year) const {
+  int64_t jan1(days_from_civil(year, 1, 1));
+  int64_t day;
+  switch (r.kind) {
+    case rule::julian: {
+      bool leap((year % 4 == 0 && year % 100 != 0) || year % 400 == 0);
+      day = jan1 + r.day - 1 + ((leap && r.day >= 60) ? 1 : 0);
+    } break;
+    case rule::day_of_year:
+      day = jan1 + r.day;
+      break;
+    default: {
+      int64_t first(days_from_civil(year, r.month, 1));
+      int64_t next(r.month == 12 ? days_from_civil(year + 1, 1, 1)
+                                 : days_from_civil(year, r.month + 1, 1));
+      day = first + (r.day - weekday_from_days(first) + 7) % 7 +
+            (r.week - 1) * 7;
+      while (day >= next)
+        day -= 7;
+    }
+  }
+  return day * 86400 + r.time;
+}
+
+/**
+ *  Get the offset from UTC with the POSIX rule.
+ *
+ *  @param[in]  t       UTC time.
+ *  @param[out] is_dst  If not null, set to true if DST is in effect.
+ *
+ *  @return Offset in seconds.
+ */
+int32_t timezone_rules::_posix_offset(time_t t, bool* is_dst) const {
+  bool dst(false);
+  if (_has_dst) {
+    int64_t year;
+    int month;
+    int mday;
+    civil_from_days(floor_div(static_cast<int64_t>(t) + _std.utoff, 86400),
+                    year, month, mday);
+    int64_t start(_rule_time(_dst_start, year) - _std.utoff);
+    int64_t end(_rule_time(_dst_end, year) - _dst.utoff);
+    if (start < end)
+      dst = (t >= start && t < end);
+    else
+      dst = (t < end || t >= start);
+  }
+  if (is_dst)
+    *is_dst = dst;
+  return dst ? _dst.utoff : _std.utoff;
+}
@@ -307,3 +307,131 @@ TEST(parser, global) {
   ASSERT_EQ(s.command_file(), "/var/lib/centreon-broker/command.sock");
   ASSERT_EQ(s.cache_directory(), "/var/lib/centreon-broker/");
 }
+
+/**
+ *  Check that the 'log' section configuring log_v2 is properly parsed.
+ */
+TEST(parser, log) {
+  std::string config_file(misc::temp_path());
+
+  FILE* file_stream(fopen(config_file.c_str(), "w"));
+  if (!file_stream)
+    throw(exceptions::msg()
+          << "could not open '" << config_file.c_str() << "'");
+  std::string data;
+  data =
+      "{\n"
+      "  \"centreonBroker\": {\n"
+      "     \"broker_id\": 1,\n"
+      "     \"log\": {\n"
+      "       \"async\": true,\n"
+      "       \"queue_size\": 1024,\n"
+      "       \"overflow_policy\": \"drop\"\n"
+      "     }\n"
+      "  }\n"
+      "}\n";
+  if (fwrite(data.c_str(), data.size(), 1, file_stream) != 1)
+    throw(exceptions::msg()
+          << "could not write content of '" << config_file.c_str() << "'");
+  fclose(file_stream);
+
+  config::parser p;
+  config::state s{p.parse(config_file)};
+  ::remove(config_file.c_str());
+
+  ASSERT_TRUE(s.log_async());
+  ASSERT_EQ(s.log_queue_size(), 1024u);
+  ASSERT_EQ(s.log_overflow_policy(), "drop");
+}
+
+/**
+ *  Check that an unknown log overflow policy is rejected.
+ */
+TEST(parser, logBadPolicy) {
+  std::string config_file(misc::temp_path());
+
+  FILE* file_stream(fopen(config_file.c_str(), "w"));
+  if (!file_stream)
+    throw(exceptions::msg()
+          << "could not open '" << config_file.c_str() << "'");
+  std::string data;
+  data =
+      "{\n"
+      "  \"centreonBroker\": {\n"
+      "     \"log\": { \"overflow_policy\": \"foo\" }\n"
+      "  }\n"
+      "}\n";
+  if (fwrite(data.c_str(), data.size(), 1, file_stream) != 1)
+    throw(exceptions::msg()
+          << "could not write content of '" << config_file.c_str() << "'");
+  fclose(file_stream);
+
+  config::parser p;
+  ASSERT_THROW(p.parse(config_file), exceptions::msg);
+  ::remove(config_file.c_str());
+}
+
+/**
+ *  Check that the 'publisher' section of the cbmod module is properly parsed.
+ */
+TEST(parser, publisher) {
+  std::string config_file(misc::temp_path());
+
+  FILE* file_stream(fopen(config_file.c_str(), "w"));
+  if (!file_stream)
+    throw(exceptions::msg()
+          << "could not open '" << config_file.c_str() << "'");
+  std::string data;
+  data =
+      "{\n"
+      "  \"centreonBroker\": {\n"
+      "     \"broker_id\": 1,\n"
+      "     \"publisher\": {\n"
+      "       \"async\": true,\n"
+      "       \"queue_size\": 4096,\n"
+      "       \"overflow_policy\": \"spill\",\n"
+      "       \"spill_file\": \"/var/lib/centreon-engine/spill\"\n"
+      "     }\n"
+      "  }\n"
+      "}\n";
+  if (fwrite(data.c_str(), data.size(), 1, file_stream) != 1)
+    throw(exceptions::msg()
+          << "could not write content of '" << config_file.c_str() << "'");
+  fclose(file_stream);
+
+  config::parser p;
+  config::state s{p.parse(config_file)};
+  ::remove(config_file.c_str());
+
+  ASSERT_TRUE(s.publisher_async());
+  ASSERT_EQ(s.publisher_queue_size(), 4096u);
+  ASSERT_EQ(s.publisher_overflow_policy(), "spill");
+  ASSERT_EQ(s.publisher_spill_file(), "/var/lib/centreon-engine/spill");
+}
+
+/**
+ *  Check that an unknown publisher overflow policy is rejected.
+ */
+TEST(parser, publisherBadPolicy) {
+  std::string config_file(misc::temp_path());
+
+  FILE* file_stream(fopen(config_file.c_str(), "w"));
+  if (!file_stream)
+    throw(exceptions::msg()
+          << "could not open '" << config_file.c_str() << "'");
+  std::string data;
+  data =
+      "{\n"
+      "  \"centreonBroker\": {\n"
+      "     \"publisher\": { \"overflow_policy\": \"drop_oldest\" }\n"
+      "  }\n"
+      "}\n";
+  if (fwrite(data.c_str(), data.size(), 1, file_stream) != 1)
+    throw(exceptions::msg()
+          << "could not write content of '" << config_file.c_str() << "'");
+  fclose(file_stream);
+
+  config::parser p;
+  ASSERT_THROW(p.parse(config_file), exceptions::msg);
+  ::remove(config_file.c_str());
+}
@@ -0,0 +1,203 @@
+/*
+ * Copyright 2020 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include "com/centreon/broker/bbdo/stream.hh"
+#include "com/centreon/broker/config/applier/init.hh"
+#include "com/centreon/broker/exceptions/shutdown.hh"
+#include "com/centreon/broker/file/opener.hh"
+#include "com/centreon/broker/file/splitter.hh"
+#include "com/centreon/broker/instance_broadcast.hh"
+#include "com/centreon/broker/io/raw.hh"
+#include "com/centreon/broker/misc/filesystem.hh"
+#include "com/centreon/broker/misc/misc.hh"
+
+using namespace com::centreon::broker;
+
+class FileCaptureReplay : public testing::Test {
+ public:
+  void SetUp() override {
+    config::applier::init();
+    _path = misc::temp_path();
+  }
+
+  void TearDown() override {
+    file::splitter(_path, file::fs_file::open_read_write_truncate)
+        .remove_all_files();
+    config::applier::deinit();
+  }
+
+  std::shared_ptr<io::stream> open(double speed) {
+    file::opener opnr;
+    opnr.set_filename(_path);
+    opnr.set_auto_delete(false);
+    opnr.set_capture(true, speed);
+    return opnr.open();
+  }
+
+  static std::shared_ptr<io::raw> chunk(char c, size_t size) {
+    std::shared_ptr<io::raw> r(std::make_shared<io::raw>());
+    r->get_buffer().assign(size, c);
+    return r;
+  }
+
+  /**
+   *  Replay all the records of the capture file.
+   *
+   *  @return The records.
+   */
+  std::vector<std::vector<char>> replay(double speed) {
+    std::vector<std::vector<char>> retval;
+    std::shared_ptr<io::stream> s(open(speed));
+    try {
+      for (;;) {
+        std::shared_ptr<io::data> d;
+        s->read(d, -1);
+        if (d)
+          retval.push_back(std::static_pointer_cast<io::raw>(d)->get_buffer());
+      }
+    } catch (exceptions::shutdown const& e) {
+      (void)e;
+    }
+    return retval;
+  }
+
+ protected:
+  std::string _path;
+};
+
+/**
+ *  Records are read back as they were written, whatever their size.
+ */
+TEST_F(FileCaptureReplay, Records) {
+  {
+    std::shared_ptr<io::stream> s(open(1));
+    s->write(chunk('a', 10));
+    s->write(chunk('b', 20000));
+    s->write(chunk('c', 1));
+  }
+  std::vector<std::vector<char>> records(replay(0));
+  ASSERT_EQ(records.size(), 3u);
+  ASSERT_EQ(records[0], std::vector<char>(10, 'a'));
+  ASSERT_EQ(records[1], std::vector<char>(20000, 'b'));
+  ASSERT_EQ(records[2], std::vector<char>(1, 'c'));
+
+  // The capture file is kept and can be replayed again.
+  ASSERT_EQ(replay(0).size(), 3u);
+}
+
+/**
+ *  Delays between records are replayed divided by the speed.
+ */
+TEST_F(FileCaptureReplay, Speed) {
+  {
+    std::shared_ptr<io::stream> s(open(1));
+    for (int i = 0; i < 3; ++i) {
+      s->write(chunk('a', 10));
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+  }
+
+  std::chrono::steady_clock::time_point start(std::chrono::steady_clock::now());
+  ASSERT_EQ(replay(1).size(), 3u);
+  ASSERT_GE(std::chrono::steady_clock::now() - start,
+            std::chrono::milliseconds(190));
+
+  start = std::chrono::steady_clock::now();
+  ASSERT_EQ(replay(2).size(), 3u);
+  ASSERT_GE(std::chrono::steady_clock::now() - start,
+            std::chrono::milliseconds(95));
+
+  start = std::chrono::steady_clock::now();
+  ASSERT_EQ(replay(0).size(), 3u);
+  ASSERT_LT(std::chrono::steady_clock::now() - start,
+            std::chrono::milliseconds(95));
+}
+
+/**
+ *  A captured BBDO stream is decoded on replay.
+ */
+TEST_F(FileCaptureReplay, Bbdo) {
+  {
+    std::shared_ptr<bbdo::stream> bs(std::make_shared<bbdo::stream>());
+    bs->set_substream(open(1));
+    bs->set_coarse(true);
+    for (uint32_t i = 1; i <= 100; ++i) {
+      std::shared_ptr<instance_broadcast> ib(
+          std::make_shared<instance_broadcast>());
+      ib->poller_id = i;
+      ib->poller_name = "poller";
+      bs->write(ib);
+    }
+  }
+
+  std::shared_ptr<bbdo::stream> bs(std::make_shared<bbdo::stream>());
+  bs->set_substream(open(0));
+  bs->set_coarse(true);
+  uint32_t count(0);
+  try {
+    for (;;) {
+      std::shared_ptr<io::data> d;
+      bs->read(d, -1);
+      if (d && d->type() == instance_broadcast::static_type()) {
+        ++count;
+        ASSERT_EQ(std::static_pointer_cast<instance_broadcast>(d)->poller_id,
+                  count);
+      }
+    }
+  } catch (exceptions::shutdown const& e) {
+    (void)e;
+  }
+  ASSERT_EQ(count, 100u);
+}
+
+/**
+ *  When the deadline expires before the replay time of the next record,
+ *  read() times out and the record is returned by the next call.
+ */
+TEST_F(FileCaptureReplay, Deadline) {
+  {
+    std::shared_ptr<io::stream> s(open(1));
+    s->write(chunk('a', 10));
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    s->write(chunk('b', 20));
+  }
+
+  std::shared_ptr<io::stream> s(open(1));
+  std::shared_ptr<io::data> d;
+  ASSERT_TRUE(s->read(d, -1));
+  ASSERT_TRUE(d);
+
+  std::chrono::steady_clock::time_point start(std::chrono::steady_clock::now());
+  ASSERT_FALSE(s->read(d, time(nullptr)));
+  ASSERT_FALSE(d);
+  ASSERT_LT(std::chrono::steady_clock::now() - start,
+            std::chrono::milliseconds(200));
+
+  ASSERT_TRUE(s->read(d, -1));
+  ASSERT_TRUE(d);
+  ASSERT_EQ(std::static_pointer_cast<io::raw>(d)->get_buffer(),
+            std::vector<char>(20, 'b'));
+  ASSERT_GE(std::chrono::steady_clock::now() - start,
+            std::chrono::milliseconds(200));
+}
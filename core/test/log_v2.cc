@@ -0,0 +1,181 @@
+/*
+ * Copyright 2020 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+#include "com/centreon/broker/log_v2.hh"
+#include <gtest/gtest.h>
+#include <spdlog/sinks/base_sink.h>
+#include <fstream>
+#include "com/centreon/broker/logging/logging.hh"
+
+using namespace com::centreon::broker;
+
+static int evaluations = 0;
+
+static std::string costly_arg() {
+  ++evaluations;
+  return std::string(64, 'x');
+}
+
+TEST(LogV2, DisabledMacroDoesNotEvaluateArgs) {
+  evaluations = 0;
+  log_v2::tcp()->set_level(spdlog::level::info);
+  LOG_V2_TRACE(log_v2::tcp(), "value {}", costly_arg());
+  LOG_V2_DEBUG(log_v2::tcp(), "value {}", costly_arg());
+  ASSERT_EQ(evaluations, 0);
+}
+
+TEST(LogV2, EnabledMacroEvaluatesArgs) {
+  evaluations = 0;
+  log_v2::tcp()->set_level(spdlog::level::info);
+  LOG_V2_INFO(log_v2::tcp(), "value {}", costly_arg());
+  ASSERT_EQ(evaluations, 1);
+}
+
+TEST(LogV2, RawPointerStable) {
+  spdlog::logger* l = log_v2::bam();
+  ASSERT_EQ(l, log_v2::bam());
+  ASSERT_EQ(l, log_v2::get(log_v2::log_bam));
+  ASSERT_EQ(l->name(), "bam");
+}
+
+TEST(LogV2, LegacyMacroEvaluatesArgsOnlyIfEnabled) {
+  evaluations = 0;
+  LOGGING_DEBUG(logging::low) << "value " << costly_arg();
+  bool enabled = LOGGING_DEBUG_COMPILED(logging::low) &&
+                 logging::manager::instance().is_enabled(logging::debug_type,
+                                                         logging::low);
+  ASSERT_EQ(evaluations, enabled ? 1 : 0);
+}
+
+/**
+ *  Argument counting how many times it is formatted.
+ */
+struct counted_arg {};
+static int formats = 0;
+
+namespace fmt {
+template <>
+struct formatter<counted_arg> : formatter<std::string> {
+  template <typename FormatContext>
+  auto format(counted_arg const&, FormatContext& ctx) -> decltype(ctx.out()) {
+    ++formats;
+    return formatter<std::string>::format("counted", ctx);
+  }
+};
+}  // namespace fmt
+
+TEST(LogV2, DisabledMessageIsNotFormatted) {
+  formats = 0;
+  log_v2::tcp()->set_level(spdlog::level::info);
+  LOG_V2_TRACE(log_v2::tcp(), "value {}", counted_arg());
+  log_v2::tcp()->trace("value {}", counted_arg());
+  ASSERT_EQ(formats, 0);
+  LOG_V2_INFO(log_v2::tcp(), "value {}", counted_arg());
+  ASSERT_EQ(formats, 1);
+}
+
+/**
+ *  Sink counting messages. It can be blocked to simulate a slow disk.
+ */
+class counting_sink : public spdlog::sinks::base_sink<std::mutex> {
+ public:
+  std::atomic<int> count{0};
+  std::mutex gate;
+
+ protected:
+  void sink_it_(spdlog::details::log_msg const&) override {
+    std::lock_guard<std::mutex> lck(gate);
+    ++count;
+  }
+  void flush_() override {}
+};
+
+TEST(LogV2, AsyncSinkWritesEverything) {
+  auto s = std::make_shared<counting_sink>();
+  {
+    auto async = std::make_shared<logging::async_sink>(
+        std::vector<spdlog::sink_ptr>{s}, 64, logging::async_sink::block);
+    spdlog::logger l("async", async);
+    for (int i = 0; i < 10000; i++)
+      l.info("message {}", i);
+    ASSERT_EQ(async->dropped(), 0u);
+  }
+  ASSERT_EQ(s->count, 10000);
+}
+
+TEST(LogV2, AsyncSinkDropCountsMessages) {
+  auto s = std::make_shared<counting_sink>();
+  uint64_t dropped;
+  {
+    std::unique_lock<std::mutex> blocked(s->gate);
+    auto async = std::make_shared<logging::async_sink>(
+        std::vector<spdlog::sink_ptr>{s}, 2, logging::async_sink::drop);
+    spdlog::logger l("async", async);
+    for (int i = 0; i < 100; i++)
+      l.info("message {}", i);
+    dropped = async->dropped();
+    ASSERT_GE(dropped, 97u);
+    blocked.unlock();
+  }
+  ASSERT_EQ(s->count + dropped, 100u);
+}
+
+TEST(LogV2, AsyncSinkDropOldest) {
+  auto s = std::make_shared<counting_sink>();
+  {
+    std::unique_lock<std::mutex> blocked(s->gate);
+    auto async = std::make_shared<logging::async_sink>(
+        std::vector<spdlog::sink_ptr>{s}, 2, logging::async_sink::drop_oldest);
+    spdlog::logger l("async", async);
+    for (int i = 0; i < 100; i++)
+      l.info("message {}", i);
+    ASSERT_GE(async->dropped(), 97u);
+    blocked.unlock();
+  }
+  ASSERT_LE(s->count, 3);
+}
+
+/**
+ *  A reload switches the running loggers between the two modes, the
+ *  pointers got before it stay usable.
+ */
+TEST(LogV2, ReloadChangesMode) {
+  std::string file("/tmp/log_v2_reload.json");
+  {
+    std::ofstream f(file);
+    f << "{\"console\": false, \"loggers\": [{\"name\": \"tcp\", \"level\": "
+         "\"info\"}]}";
+  }
+  config::state conf;
+  std::string err;
+
+  conf.log_async(true);
+  conf.log_queue_size(64);
+  log_v2::instance().set_async(conf);
+  ASSERT_TRUE(log_v2::instance().load(file, "test", err)) << err;
+  ASSERT_TRUE(log_v2::instance().is_async());
+  spdlog::logger* l = log_v2::tcp();
+
+  conf.log_async(false);
+  log_v2::instance().set_async(conf);
+  ASSERT_TRUE(log_v2::instance().load(file, "test", err)) << err;
+  ASSERT_FALSE(log_v2::instance().is_async());
+  l->info("still valid");
+  ASSERT_TRUE(log_v2::instance().load(file, "test", err)) << err;
+  ::remove(file.c_str());
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright 2020 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+#include "com/centreon/broker/misc/mpmc_queue.hh"
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using namespace com::centreon::broker::misc;
+
+TEST(MpmcQueue, CapacityIsPowerOfTwo) {
+  mpmc_queue<int> q(100);
+  ASSERT_EQ(q.capacity(), 128u);
+}
+
+TEST(MpmcQueue, FullAndEmpty) {
+  mpmc_queue<int> q(4);
+  int v;
+  ASSERT_FALSE(q.try_pop(v));
+  for (int i = 0; i < 4; i++) {
+    v = i;
+    ASSERT_TRUE(q.try_push(v));
+  }
+  v = 4;
+  ASSERT_FALSE(q.try_push(v));
+  ASSERT_EQ(q.size(), 4u);
+  for (int i = 0; i < 4; i++) {
+    ASSERT_TRUE(q.try_pop(v));
+    ASSERT_EQ(v, i);
+  }
+  ASSERT_FALSE(q.try_pop(v));
+}
+
+TEST(MpmcQueue, ConcurrentProducers) {
+  constexpr int producers = 4;
+  constexpr int count = 100000;
+  mpmc_queue<int> q(1024);
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; p++)
+    threads.emplace_back([&q]() {
+      for (int i = 1; i <= count; i++) {
+        int v = i;
+        while (!q.try_push(v))
+          std::this_thread::yield();
+      }
+    });
+
+  int64_t sum = 0;
+  int received = 0;
+  while (received < producers * count) {
+    int v;
+    if (q.try_pop(v)) {
+      sum += v;
+      received++;
+    } else
+      std::this_thread::yield();
+  }
+  for (auto& t : threads)
+    t.join();
+  ASSERT_EQ(sum, static_cast<int64_t>(producers) * count * (count + 1) / 2);
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright 2020 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+#include "com/centreon/broker/misc/object_pool.hh"
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include "com/centreon/broker/misc/mpmc_queue.hh"
+
+using namespace com::centreon::broker::misc;
+
+namespace {
+struct event {
+  event() : id(0) {}
+  int id;
+  std::string output;
+};
+}  // namespace
+
+TEST(ObjectPool, Recycle) {
+  object_pool<event> pool;
+  event* first;
+  {
+    std::shared_ptr<event> e(pool.acquire());
+    first = e.get();
+    e->id = 12;
+    e->output = std::string(1000, 'a');
+    ASSERT_EQ(pool.allocated(), 1u);
+    ASSERT_EQ(pool.available(), 0u);
+  }
+  ASSERT_EQ(pool.available(), 1u);
+
+  std::shared_ptr<event> e(pool.acquire());
+  ASSERT_EQ(e.get(), first);
+  ASSERT_EQ(e->id, 0);
+  ASSERT_TRUE(e->output.empty());
+  ASSERT_GE(e->output.capacity(), 1000u);
+  ASSERT_EQ(pool.allocated(), 1u);
+}
+
+TEST(ObjectPool, MaxFree) {
+  object_pool<event> pool(2);
+  {
+    std::vector<std::shared_ptr<event>> v;
+    for (int i = 0; i < 5; i++)
+      v.push_back(pool.acquire());
+    ASSERT_EQ(pool.allocated(), 5u);
+  }
+  ASSERT_EQ(pool.available(), 2u);
+  ASSERT_EQ(pool.allocated(), 2u);
+}
+
+TEST(ObjectPool, OutlivePool) {
+  std::shared_ptr<event> e;
+  {
+    object_pool<event> pool;
+    e = pool.acquire();
+    e->output = "still there";
+  }
+  ASSERT_EQ(e->output, "still there");
+  e.reset();
+}
+
+TEST(ObjectPool, ReleaseFromOtherThread) {
+  constexpr int count = 100000;
+  object_pool<event> pool;
+  mpmc_queue<std::shared_ptr<event>> q(256);
+  // Assertions cannot stop the test from another thread, mismatches are
+  // counted and checked after the join.
+  int mismatches(0);
+  std::thread consumer([&q, &mismatches]() {
+    std::shared_ptr<event> e;
+    for (int i = 0; i < count;) {
+      if (q.try_pop(e)) {
+        if (e->output != std::to_string(e->id))
+          ++mismatches;
+        e.reset();
+        ++i;
+      } else
+        std::this_thread::yield();
+    }
+  });
+  for (int i = 0; i < count; i++) {
+    std::shared_ptr<event> e(pool.acquire());
+    EXPECT_TRUE(e->output.empty());
+    e->id = i;
+    e->output = std::to_string(i);
+    while (!q.try_push(e))
+      std::this_thread::yield();
+  }
+  consumer.join();
+  ASSERT_EQ(mismatches, 0);
+  // Objects are reused: at most the queue and the threads hold some.
+  ASSERT_LE(pool.allocated(), 256u + 2u);
+  ASSERT_EQ(pool.available(), pool.allocated());
+}
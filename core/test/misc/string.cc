@@ -73,6 +73,16 @@ TEST(string_check_utf8, utf8) {
   ASSERT_EQ(string::check_string_utf8(txt), "L'accès à l'hôtel est encombré");
 }
 
+/*
+ * Given strings encoded in UTF-8 and in ISO-8859-15
+ * Then the is_utf8 function only accepts the first one.
+ */
+TEST(string_check_utf8, is_utf8) {
+  ASSERT_TRUE(string::is_utf8(""));
+  ASSERT_TRUE(string::is_utf8("L'accès à l'hôtel est encombré"));
+  ASSERT_FALSE(string::is_utf8("L'acc\350s \340 l'h\364tel est encombr\351"));
+}
+
 /*
  * Given a string encoded in CP-1252
  * Then the check_string_utf8 function converts it to UTF-8.
@@ -197,6 +207,16 @@ TEST(string_check_utf8, vietnam) {
   ASSERT_EQ(string::check_string_utf8(txt), txt);
 }
 
+/* The destination keeps its memory and non UTF-8 strings are converted */
+TEST(string_assign_utf8, reuse) {
+  std::string dest(64, 'x');
+  char const* data(dest.data());
+  string::assign_utf8(dest, "超级杀手");
+  string::append_utf8(dest, "\xe9\xe7");
+  ASSERT_EQ(dest, "超级杀手éç");
+  ASSERT_EQ(dest.data(), data);
+}
+
 TEST(truncate, nominal1) {
   std::string str("foobar");
   ASSERT_EQ(string::truncate(str, 3), "foo");
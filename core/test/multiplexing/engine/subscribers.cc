@@ -0,0 +1,130 @@
+/*
+ * Copyright 2020 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+
+#include "com/centreon/broker/config/applier/init.hh"
+#include "com/centreon/broker/instance_broadcast.hh"
+#include "com/centreon/broker/io/events.hh"
+#include "com/centreon/broker/io/raw.hh"
+#include "com/centreon/broker/multiplexing/engine.hh"
+#include "com/centreon/broker/multiplexing/subscriber.hh"
+#include "com/centreon/broker/multiplexing/type_bitmap.hh"
+
+using namespace com::centreon::broker;
+
+class EngineSubscribers : public testing::Test {
+ public:
+  void SetUp() override {
+    config::applier::init();
+    multiplexing::engine::instance().start();
+  }
+
+  void TearDown() override {
+    multiplexing::engine::instance().stop();
+    config::applier::deinit();
+    ::remove(".unprocessed");
+  }
+
+  static void publish_raw() {
+    multiplexing::engine::instance().publish(std::make_shared<io::raw>());
+  }
+
+  static void publish_broadcast() {
+    multiplexing::engine::instance().publish(
+        std::make_shared<instance_broadcast>());
+  }
+
+  /**
+   *  Read all the available events of a muxer.
+   *
+   *  @return The types of the events read.
+   */
+  static std::vector<uint32_t> read_all(multiplexing::muxer& m) {
+    std::vector<uint32_t> retval;
+    for (;;) {
+      std::shared_ptr<io::data> d;
+      m.read(d, 0);
+      if (!d)
+        break;
+      retval.push_back(d->type());
+    }
+    m.ack_events(retval.size());
+    return retval;
+  }
+};
+
+TEST_F(EngineSubscribers, Bitmap) {
+  multiplexing::type_bitmap b(std::unordered_set<uint32_t>{
+      io::raw::static_type(),
+      io::events::data_type<io::events::neb, 200>::value});
+  ASSERT_TRUE(b.test(io::raw::static_type()));
+  ASSERT_TRUE(b.test(io::events::data_type<io::events::neb, 200>::value));
+  ASSERT_FALSE(b.test(instance_broadcast::static_type()));
+  ASSERT_FALSE(b.test(io::events::data_type<io::events::neb, 199>::value));
+  ASSERT_FALSE(b.test(io::events::data_type<io::events::neb, 1000>::value));
+  ASSERT_FALSE(b.test(io::events::data_type<io::events::bam, 1>::value));
+  b.clear();
+  ASSERT_FALSE(b.test(io::raw::static_type()));
+}
+
+TEST_F(EngineSubscribers, OnlyMatchingMuxers) {
+  multiplexing::subscriber raw("core_multiplexing_engine_subscribers_raw",
+                               false);
+  raw.get_muxer().set_write_filters({io::raw::static_type()});
+  multiplexing::subscriber broadcast(
+      "core_multiplexing_engine_subscribers_broadcast", false);
+  broadcast.get_muxer().set_write_filters(
+      {instance_broadcast::static_type()});
+
+  publish_raw();
+  publish_broadcast();
+  publish_raw();
+
+  ASSERT_EQ(read_all(raw.get_muxer()),
+            std::vector<uint32_t>(2, io::raw::static_type()));
+  ASSERT_EQ(read_all(broadcast.get_muxer()),
+            std::vector<uint32_t>(1, instance_broadcast::static_type()));
+}
+
+TEST_F(EngineSubscribers, FiltersChange) {
+  multiplexing::subscriber s("core_multiplexing_engine_subscribers_change",
+                             false);
+  s.get_muxer().set_write_filters({io::raw::static_type()});
+  publish_broadcast();
+  ASSERT_TRUE(read_all(s.get_muxer()).empty());
+
+  s.get_muxer().set_write_filters(
+      {io::raw::static_type(), instance_broadcast::static_type()});
+  publish_broadcast();
+  publish_raw();
+  std::vector<uint32_t> expected{instance_broadcast::static_type(),
+                                 io::raw::static_type()};
+  ASSERT_EQ(read_all(s.get_muxer()), expected);
+}
+
+TEST_F(EngineSubscribers, Unsubscribe) {
+  std::unique_ptr<multiplexing::subscriber> s(new multiplexing::subscriber(
+      "core_multiplexing_engine_subscribers_unsubscribe", false));
+  s->get_muxer().set_write_filters({io::raw::static_type()});
+  s.reset();
+  ASSERT_NO_THROW(publish_raw());
+}
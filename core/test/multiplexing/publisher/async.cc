@@ -0,0 +1,176 @@
+/*
+ * Copyright 2020 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include <cstdio>
+
+#include "com/centreon/broker/config/applier/init.hh"
+#include "com/centreon/broker/file/opener.hh"
+#include "com/centreon/broker/instance_broadcast.hh"
+#include "com/centreon/broker/misc/filesystem.hh"
+#include "com/centreon/broker/misc/misc.hh"
+#include "com/centreon/broker/multiplexing/async_publisher.hh"
+#include "com/centreon/broker/multiplexing/engine.hh"
+#include "com/centreon/broker/multiplexing/muxer.hh"
+#include "com/centreon/broker/multiplexing/subscriber.hh"
+
+using namespace com::centreon::broker;
+
+class PublisherAsync : public testing::Test {
+ protected:
+  std::unique_ptr<multiplexing::subscriber> _s;
+  std::string _spill_file;
+
+ public:
+  void SetUp() override {
+    config::applier::init();
+    std::unordered_set<uint32_t> filters{instance_broadcast::static_type()};
+    _s.reset(new multiplexing::subscriber("core_multiplexing_publisher_async",
+                                          ""));
+    _s->get_muxer().set_read_filters(filters);
+    _s->get_muxer().set_write_filters(filters);
+    multiplexing::engine::instance().start();
+    _spill_file = misc::temp_path();
+  }
+
+  void TearDown() override {
+    for (int i = 0; i < 10; ++i)
+      ::remove(fmt::format("{}.{}.bbdo", _spill_file, i).c_str());
+    _s.reset();
+    ::remove(multiplexing::muxer::memory_file(
+                 "core_multiplexing_publisher_async")
+                 .c_str());
+    ::remove(
+        multiplexing::muxer::queue_file("core_multiplexing_publisher_async")
+            .c_str());
+    config::applier::deinit();
+  }
+
+  static std::shared_ptr<io::data> event(uint32_t id) {
+    std::shared_ptr<instance_broadcast> ib(new instance_broadcast);
+    ib->poller_id = id;
+    ib->poller_name = "poller";
+    return ib;
+  }
+
+  /**
+   *  Read the published events and check they are in order.
+   *
+   *  @param[in] count  Number of events that may have been published.
+   *
+   *  @return Number of events read.
+   */
+  uint32_t read_in_order(uint32_t count) {
+    uint32_t read(0);
+    uint32_t last(0);
+    for (uint32_t i = 0; i < count; ++i) {
+      std::shared_ptr<io::data> d;
+      _s->get_muxer().read(d, 0);
+      if (!d)
+        break;
+      EXPECT_EQ(d->type(), instance_broadcast::static_type());
+      uint32_t id(std::static_pointer_cast<instance_broadcast>(d)->poller_id);
+      if (read)
+        EXPECT_GT(id, last);
+      last = id;
+      ++read;
+    }
+    _s->get_muxer().ack_events(read);
+    return read;
+  }
+};
+
+/**
+ *  Without start(), events are directly published.
+ */
+TEST_F(PublisherAsync, NotStarted) {
+  multiplexing::async_publisher p;
+  ASSERT_FALSE(p.is_async());
+  p.write(event(1));
+  ASSERT_EQ(p.queued(), 0u);
+  ASSERT_EQ(read_in_order(1), 1u);
+}
+
+/**
+ *  With the block policy, no event is lost and their order is kept.
+ */
+TEST_F(PublisherAsync, Block) {
+  multiplexing::async_publisher p;
+  p.start(4, multiplexing::async_publisher::block, _spill_file);
+  ASSERT_TRUE(p.is_async());
+  for (uint32_t i = 1; i <= 1000; ++i)
+    p.write(event(i));
+  p.stop();
+  ASSERT_FALSE(p.is_async());
+  ASSERT_EQ(p.dropped(), 0u);
+  ASSERT_EQ(read_in_order(1000), 1000u);
+}
+
+/**
+ *  With the drop policy, events are either published or counted as dropped.
+ */
+TEST_F(PublisherAsync, Drop) {
+  multiplexing::async_publisher p;
+  p.start(4, multiplexing::async_publisher::drop, _spill_file);
+  for (uint32_t i = 1; i <= 1000; ++i)
+    p.write(event(i));
+  p.stop();
+  ASSERT_EQ(read_in_order(1000) + p.dropped(), 1000u);
+}
+
+/**
+ *  With the spill policy, no event is lost and their order is kept, even
+ *  when some of them went through spill files.
+ */
+TEST_F(PublisherAsync, Spill) {
+  multiplexing::async_publisher p;
+  p.start(4, multiplexing::async_publisher::spill, _spill_file);
+  // Write until some events are spilled, the queue being much smaller
+  // than what the thread can publish at once.
+  uint32_t count(0);
+  while (count < 1000 || (!p.spilled() && count < 100000))
+    p.write(event(++count));
+  p.stop();
+  ASSERT_GT(p.spilled(), 0u);
+  ASSERT_EQ(p.dropped(), 0u);
+  ASSERT_EQ(read_in_order(count), count);
+}
+
+/**
+ *  Spill files left by a previous run are published before the new events.
+ */
+TEST_F(PublisherAsync, SpillFilesFromPreviousRun) {
+  {
+    std::shared_ptr<io::stream> s(
+        file::open_bbdo_file(fmt::format("{}.3.bbdo", _spill_file)));
+    for (uint32_t i = 1; i <= 10; ++i)
+      s->write(event(i));
+  }
+
+  multiplexing::async_publisher p;
+  p.start(4, multiplexing::async_publisher::spill, _spill_file);
+  for (uint32_t i = 11; i <= 20; ++i)
+    p.write(event(i));
+  p.stop();
+  ASSERT_EQ(read_in_order(20), 20u);
+  ASSERT_FALSE(
+      misc::filesystem::file_exists(fmt::format("{}.3.bbdo", _spill_file)));
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright 2020 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include "com/centreon/broker/processing/failover.hh"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include "com/centreon/broker/config/applier/init.hh"
+#include "com/centreon/broker/exceptions/msg.hh"
+#include "com/centreon/broker/multiplexing/muxer.hh"
+#include "com/centreon/broker/multiplexing/subscriber.hh"
+#include "com/centreon/broker/stats/registry.hh"
+
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::processing;
+
+/**
+ *  Endpoint that can never be opened.
+ */
+class UnreachableEndpoint : public io::endpoint {
+ public:
+  UnreachableEndpoint() : io::endpoint(false) {}
+  std::shared_ptr<io::stream> open() override {
+    throw exceptions::msg() << "unreachable endpoint";
+  }
+};
+
+class ProcessingFailover : public ::testing::Test {
+ public:
+  void SetUp() override {
+    try {
+      config::applier::init();
+    } catch (std::exception const& e) {
+      (void)e;
+    }
+  }
+
+  void TearDown() override {
+    ::remove(multiplexing::muxer::memory_file("test-failover").c_str());
+    ::remove(multiplexing::muxer::queue_file("test-failover").c_str());
+    config::applier::deinit();
+  }
+};
+
+/**
+ *  The statistics of a failover that cannot connect are published while
+ *  it waits before reconnecting.
+ */
+TEST_F(ProcessingFailover, StatsWhileDisconnected) {
+  std::shared_ptr<multiplexing::subscriber> s(
+      std::make_shared<multiplexing::subscriber>("test-failover", ""));
+  std::unique_ptr<failover> f(new failover(
+      std::make_shared<UnreachableEndpoint>(), s, "test-failover"));
+  f->set_retry_interval(1);
+  f->set_stats_path("endpoint test-failover");
+  f->start();
+
+  json11::Json e;
+  for (int i = 0; i < 50; ++i) {
+    e = stats::registry::instance().snapshot(
+        {"endpoint test-failover"})["endpoint test-failover"];
+    if (e["status"].string_value() == "sleeping before reconnection")
+      break;
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+  f.reset();
+
+  ASSERT_EQ(e["status"].string_value(), "sleeping before reconnection");
+  ASSERT_EQ(e["state"].string_value(), "connecting");
+  ASSERT_TRUE(e["queued_events"].is_number());
+  ASSERT_TRUE(e["unacknowledged_events"].is_number());
+}
@@ -19,10 +19,14 @@
 
 #include "com/centreon/broker/processing/feeder.hh"
 #include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <string>
 #include <thread>
+#include <vector>
 #include "com/centreon/broker/config/applier/state.hh"
+#include "com/centreon/broker/instance_broadcast.hh"
 #include "com/centreon/broker/multiplexing/engine.hh"
 #include "com/centreon/broker/io/events.hh"
 
@@ -41,6 +45,20 @@ class TestStream : public io::stream {
   }
 };
 
+class CountingStream : public io::stream {
+  std::atomic<uint32_t>& _count;
+
+ public:
+  CountingStream(std::atomic<uint32_t>& count)
+      : io::stream("CountingStream"), _count(count) {}
+  bool read(std::shared_ptr<io::data>&, time_t) { return false; }
+
+  int write(std::shared_ptr<io::data> const&) {
+    ++_count;
+    return 1;
+  }
+};
+
 class TestFeeder : public ::testing::Test {
  public:
   void SetUp() override {
@@ -77,3 +95,32 @@ TEST_F(TestFeeder, isFinished) {
   _feeder->stats(tree);
   ASSERT_EQ(tree["state"].string_value(), "connected");
 }
+
+TEST_F(TestFeeder, ManyFeeders) {
+  std::vector<std::unique_ptr<feeder>> feeders;
+  for (int i = 0; i < 200; ++i)
+    feeders.emplace_back(new feeder("test-feeder-" + std::to_string(i),
+                                    std::make_shared<TestStream>(), {}, {}));
+  for (auto& f : feeders)
+    ASSERT_FALSE(f->is_finished());
+  ASSERT_NO_THROW(feeders.clear());
+}
+
+TEST_F(TestFeeder, EventsFromMuxer) {
+  std::atomic<uint32_t> count{0};
+  std::unordered_set<uint32_t> filters{instance_broadcast::static_type()};
+  feeder f("test-feeder-events", std::make_shared<CountingStream>(count),
+           filters, filters);
+  multiplexing::engine::instance().start();
+
+  // More events than a single turn handles.
+  uint32_t const total(3000);
+  for (uint32_t i = 0; i < total; ++i)
+    multiplexing::engine::instance().publish(
+        std::make_shared<instance_broadcast>());
+
+  for (int i = 0; i < 100 && count < total; ++i)
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  ASSERT_EQ(count.load(), total);
+  multiplexing::engine::instance().stop();
+}
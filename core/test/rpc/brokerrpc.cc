@@ -21,11 +21,14 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <cstdio>
 #include <fstream>
 #include <json11.hpp>
 
 #include "com/centreon/broker/log_v2.hh"
+#include "com/centreon/broker/stats/registry.hh"
+#include "com/centreon/broker/stats/stages.hh"
 #include "com/centreon/broker/version.hh"
 
 using namespace com::centreon;
@@ -81,6 +84,40 @@ TEST_F(BrokerRpc, GetVersion) {
   brpc.shutdown();
 }
 
+TEST_F(BrokerRpc, GetStageStats) {
+  stats::histogram& h(stats::stage_histogram(stats::stage_sql_commit));
+  h.reset();
+  h.record(1000);
+  h.record(2000);
+  brokerrpc brpc("0.0.0.0", 40000, "test");
+  auto output = execute("GetStageStats");
+  ASSERT_EQ(output.size(), static_cast<size_t>(stats::stage_count));
+  ASSERT_EQ(output.front(), "bbdo_decode " +
+                                std::to_string(stats::stage_histogram(
+                                                   stats::stage_bbdo_decode)
+                                                   .get_snapshot()
+                                                   .count));
+  ASSERT_NE(std::find(output.begin(), output.end(), "sql_commit 2"),
+            output.end());
+  brpc.shutdown();
+}
+
+TEST_F(BrokerRpc, GetStats) {
+  stats::group g;
+  g.add<stats::counter>("events")->add(3);
+  g.add<stats::text>("state")->set("connected");
+  g.publish("endpoint rpc-test");
+  brokerrpc brpc("0.0.0.0", 40000, "test");
+  auto output = execute("GetStats 'endpoint rpc-test/events'");
+  ASSERT_EQ(output.size(), 1);
+  std::string err;
+  json11::Json result(json11::Json::parse(output.front(), err));
+  ASSERT_TRUE(err.empty());
+  ASSERT_EQ(result["endpoint rpc-test"]["events"].number_value(), 3);
+  ASSERT_TRUE(result["endpoint rpc-test"]["state"].is_null());
+  brpc.shutdown();
+}
+
 TEST_F(BrokerRpc, ConfReloadBad) {
   brokerrpc brpc("0.0.0.0", 40000, "test");
   auto output = execute("DebugConfReload /root/testfail.json");
@@ -61,6 +61,27 @@ class BrokerRPCClient {
 
     return false;
   }
+
+  bool GetStageStats(StageStatsList* response) {
+    const ::google::protobuf::Empty e;
+    grpc::ClientContext context;
+    grpc::Status status = _stub->GetStageStats(&context, e, response);
+    if (!status.ok()) {
+      std::cout << "GetStageStats rpc failed." << std::endl;
+      return false;
+    }
+    return true;
+  }
+
+  bool GetStats(StatsQuery const& request, GenericString* response) {
+    grpc::ClientContext context;
+    grpc::Status status = _stub->GetStats(&context, request, response);
+    if (!status.ok()) {
+      std::cout << "GetStats rpc failed." << std::endl;
+      return false;
+    }
+    return true;
+  }
 };
 
 int main(int argc, char** argv) {
@@ -87,6 +108,20 @@ int main(int argc, char** argv) {
     else
       std::cout << "DebugConfReload OK" << std::endl;
   }
+  else if (strcmp(argv[1], "GetStageStats") == 0) {
+    StageStatsList response;
+    status = client.GetStageStats(&response) ? 0 : 1;
+    for (StageStats const& s : response.stages())
+      std::cout << s.name() << " " << s.count() << std::endl;
+  }
+  else if (strcmp(argv[1], "GetStats") == 0) {
+    StatsQuery request;
+    for (int i = 2; i < argc; ++i)
+      request.add_subtrees(argv[i]);
+    GenericString response;
+    status = client.GetStats(request, &response) ? 0 : 1;
+    std::cout << response.str_arg() << std::endl;
+  }
 
   exit(status);
 }
@@ -0,0 +1,92 @@
+/*
+ * Copyright 2020 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include "com/centreon/broker/stats/histogram.hh"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "com/centreon/broker/stats/helper.hh"
+#include "com/centreon/broker/stats/stages.hh"
+
+using namespace com::centreon::broker;
+
+TEST(StatsHistogram, Buckets) {
+  for (uint64_t v : {0ull, 1ull, 15ull, 16ull, 17ull, 31ull, 32ull, 1000ull,
+                     123456789ull, 1ull << 40}) {
+    uint32_t b(stats::histogram::bucket_of(v));
+    ASSERT_LT(b, stats::histogram::bucket_count);
+    ASSERT_GE(stats::histogram::bucket_upper_bound(b), v);
+    if (b) {
+      ASSERT_LT(stats::histogram::bucket_upper_bound(b - 1), v);
+    }
+    // Bounds are at most 1/16 away from the values.
+    ASSERT_LE(stats::histogram::bucket_upper_bound(b) - v, v / 16);
+  }
+  ASSERT_EQ(stats::histogram::bucket_of(~0ull),
+            stats::histogram::bucket_count - 1);
+}
+
+TEST(StatsHistogram, Percentiles) {
+  stats::histogram h;
+  for (uint64_t i = 1; i <= 1000; ++i)
+    h.record(i * 1000);
+  stats::histogram::snapshot s(h.get_snapshot());
+  ASSERT_EQ(s.count, 1000u);
+  ASSERT_EQ(s.max, 1000000u);
+  ASSERT_DOUBLE_EQ(s.mean(), 500500.0);
+  ASSERT_NEAR(s.percentile(0.5), 500000, 500000 / 16);
+  ASSERT_NEAR(s.percentile(0.99), 990000, 990000 / 16);
+  ASSERT_EQ(s.percentile(1), 1000000u);
+
+  h.reset();
+  ASSERT_EQ(h.get_snapshot().count, 0u);
+  ASSERT_EQ(h.get_snapshot().percentile(0.5), 0u);
+}
+
+TEST(StatsHistogram, Threads) {
+  stats::histogram h;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 16; ++i)
+    threads.emplace_back([&h, i] {
+      for (uint64_t j = 0; j < 10000; ++j)
+        h.record(j + i);
+    });
+  for (std::thread& t : threads)
+    t.join();
+  stats::histogram::snapshot s(h.get_snapshot());
+  ASSERT_EQ(s.count, 160000u);
+  ASSERT_EQ(s.max, 10014u);
+}
+
+TEST(StatsHistogram, Prometheus) {
+  stats::stage_histogram(stats::stage_rrd_update).reset();
+  {
+    stats::stage_timer t(stats::stage_rrd_update);
+  }
+  std::string text(stats::get_stage_prometheus());
+  ASSERT_NE(text.find("centreon_broker_stage_duration_seconds_count{stage="
+                      "\"rrd_update\"} 1\n"),
+            std::string::npos);
+  ASSERT_NE(text.find("centreon_broker_stage_duration_seconds_bucket{stage="
+                      "\"rrd_update\",le=\"+Inf\"} 1\n"),
+            std::string::npos);
+}
@@ -0,0 +1,122 @@
+/*
+ * Copyright 2020 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include "com/centreon/broker/stats/registry.hh"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+using namespace com::centreon::broker;
+
+TEST(StatsRegistry, Snapshot) {
+  stats::group g;
+  std::shared_ptr<stats::counter> c(g.add<stats::counter>("events"));
+  std::shared_ptr<stats::text> t(g.add<stats::text>("state"));
+  std::shared_ptr<stats::tree> d(g.add<stats::tree>(""));
+  g.add<stats::gauge>("queue/size")->set(12.5);
+  c->add(2);
+  c->add();
+  t->set("connected");
+  d->set(json11::Json::object{{"status", "reading"}});
+
+  // Nothing is visible before the group is published.
+  ASSERT_TRUE(stats::registry::instance()
+                  .snapshot({"endpoint registry-test"})
+                  .empty());
+
+  g.publish("endpoint registry-test");
+  json11::Json result(
+      stats::registry::instance().snapshot({"endpoint registry-test"}));
+  json11::Json const& e(result["endpoint registry-test"]);
+  ASSERT_EQ(e["events"].number_value(), 3);
+  ASSERT_EQ(e["state"].string_value(), "connected");
+  ASSERT_EQ(e["status"].string_value(), "reading");
+  ASSERT_EQ(e["queue"]["size"].number_value(), 12.5);
+
+  // Only the asked subtrees are given.
+  result = stats::registry::instance().snapshot(
+      {"endpoint registry-test/queue", "endpoint registry-test/state"});
+  ASSERT_EQ(result["endpoint registry-test"].object_items().size(), 2u);
+  ASSERT_EQ(result["endpoint registry-test"]["queue"]["size"].number_value(),
+            12.5);
+
+  // A subtree is made of whole path components.
+  ASSERT_TRUE(
+      stats::registry::instance().snapshot({"endpoint registry-tes"}).empty());
+
+  g.unpublish();
+  ASSERT_TRUE(stats::registry::instance()
+                  .snapshot({"endpoint registry-test"})
+                  .empty());
+}
+
+TEST(StatsRegistry, Move) {
+  stats::group g;
+  g.add<stats::counter>("events")->add(5);
+  g.publish("endpoint registry-parent");
+  g.publish("endpoint registry-other/failover");
+  json11::Json result(stats::registry::instance().snapshot(
+      {"endpoint registry-parent", "endpoint registry-other"}));
+  ASSERT_TRUE(result["endpoint registry-parent"].is_null());
+  ASSERT_EQ(result["endpoint registry-other"]["failover"]["events"]
+                .number_value(),
+            5);
+}
+
+TEST(StatsRegistry, Replace) {
+  std::unique_ptr<stats::group> old_group(new stats::group);
+  old_group->add<stats::counter>("events")->add(1);
+  old_group->publish("endpoint registry-replace");
+  stats::group new_group;
+  new_group.add<stats::counter>("events")->add(2);
+  new_group.publish("endpoint registry-replace");
+
+  // The old group is destroyed after its successor was published.
+  old_group.reset();
+  json11::Json result(
+      stats::registry::instance().snapshot({"endpoint registry-replace"}));
+  ASSERT_EQ(result["endpoint registry-replace"]["events"].number_value(), 2);
+}
+
+TEST(StatsRegistry, Threads) {
+  stats::group g;
+  std::shared_ptr<stats::counter> c(g.add<stats::counter>("events"));
+  std::shared_ptr<stats::meter> m(g.add<stats::meter>("speed"));
+  g.publish("endpoint registry-threads");
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i)
+    threads.emplace_back([c, m] {
+      for (int j = 0; j < 10000; ++j) {
+        c->add();
+        m->tick();
+      }
+    });
+  // Snapshots taken meanwhile never wait for the writers.
+  for (int i = 0; i < 100; ++i)
+    stats::registry::instance().snapshot({"endpoint registry-threads"});
+  for (std::thread& t : threads)
+    t.join();
+
+  ASSERT_EQ(c->get(), 40000u);
+  ASSERT_GT(m->get_speed(), 0);
+  ASSERT_NE(m->get_last_event_time(), 0);
+}
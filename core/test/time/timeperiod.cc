@@ -0,0 +1,162 @@
+/*
+ * Copyright 2020 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+#include "com/centreon/broker/time/timeperiod.hh"
+#include <gtest/gtest.h>
+
+using namespace com::centreon::broker;
+
+/**
+ *  Day by day lookups, as done before the valid intervals cache.
+ */
+static time_t reference_next_valid(time::timeperiod const& tp, time_t t) {
+  time::timezone_rules const& tz(
+      *time::timezone_rules::get(tp.get_timezone()));
+  struct tm preftime;
+  tz.localtime(t, preftime);
+  int weekday(preftime.tm_wday);
+  preftime.tm_sec = 0;
+  preftime.tm_min = 0;
+  preftime.tm_hour = 0;
+  preftime.tm_isdst = -1;
+  time_t midnight(tz.mktime(preftime));
+  for (int i = 0; i < 8; ++i) {
+    time_t day_start(time::timeperiod::add_round_days_to_midnight(
+        midnight, i * 24 * 60 * 60, tz));
+    struct tm day_midnight;
+    tz.localtime(day_start, day_midnight);
+    time_t earliest((time_t)-1);
+    for (time::timerange const& tr :
+         tp.get_timeranges_by_day((weekday + i) % 7)) {
+      time_t start, end;
+      tr.to_time_t(day_midnight, start, end, tz);
+      if (t < end) {
+        time_t potential(start >= t ? start : t);
+        if (earliest == (time_t)-1 || potential < earliest)
+          earliest = potential;
+      }
+    }
+    if (earliest != (time_t)-1)
+      return earliest;
+  }
+  return (time_t)-1;
+}
+
+static time_t reference_next_invalid(time::timeperiod const& tp, time_t t) {
+  time::timezone_rules const& tz(
+      *time::timezone_rules::get(tp.get_timezone()));
+  struct tm preftime;
+  tz.localtime(t, preftime);
+  int weekday(preftime.tm_wday);
+  preftime.tm_sec = 0;
+  preftime.tm_min = 0;
+  preftime.tm_hour = 0;
+  preftime.tm_isdst = -1;
+  time_t midnight(tz.mktime(preftime));
+  for (int i = 0; i < 8; ++i) {
+    time_t day_start(time::timeperiod::add_round_days_to_midnight(
+        midnight, i * 24 * 60 * 60, tz));
+    time_t day_end(time::timeperiod::add_round_days_to_midnight(
+        day_start, 24 * 60 * 60, tz));
+    struct tm day_midnight;
+    tz.localtime(day_start, day_midnight);
+    time_t earliest(t > day_start ? t : day_start);
+    while (earliest < day_end) {
+      bool invalid(true);
+      for (time::timerange const& tr :
+           tp.get_timeranges_by_day((weekday + i) % 7)) {
+        time_t start, end;
+        tr.to_time_t(day_midnight, start, end, tz);
+        if (earliest >= start && earliest < end) {
+          invalid = false;
+          earliest = end;
+        }
+      }
+      if (invalid)
+        return earliest;
+    }
+  }
+  return (time_t)-1;
+}
+
+static time::timeperiod make_timeperiod(char const* week_days,
+                                        char const* week_end,
+                                        char const* timezone) {
+  time::timeperiod tp;
+  for (int i = 1; i < 6; ++i)
+    tp.set_timerange(week_days, i);
+  tp.set_timerange(week_end, 0);
+  tp.set_timerange(week_end, 6);
+  tp.set_timezone(timezone);
+  return tp;
+}
+
+static void compare_with_reference(time::timeperiod const& tp) {
+  // 2020-01-01 00:00:00 UTC, one year.
+  time_t const first(1577836800);
+  for (time_t t = first; t < first + 366 * 24 * 3600; t += 37 * 60) {
+    ASSERT_EQ(tp.get_next_valid(t), reference_next_valid(tp, t)) << t;
+    ASSERT_EQ(tp.get_next_invalid(t), reference_next_invalid(tp, t)) << t;
+  }
+  // Going backward.
+  for (time_t t = first + 366 * 24 * 3600; t > first; t -= 24 * 3600 + 11) {
+    ASSERT_EQ(tp.get_next_valid(t), reference_next_valid(tp, t)) << t;
+    ASSERT_EQ(tp.get_next_invalid(t), reference_next_invalid(tp, t)) << t;
+  }
+}
+
+TEST(Timeperiod, WorkingHours) {
+  compare_with_reference(make_timeperiod("08:00-18:00", "", "UTC"));
+  compare_with_reference(make_timeperiod("08:00-18:00", "", "Europe/Paris"));
+}
+
+TEST(Timeperiod, NightsAndWeekEnds) {
+  compare_with_reference(make_timeperiod("00:00-08:00,18:00-24:00",
+                                         "00:00-24:00", "Europe/Paris"));
+}
+
+TEST(Timeperiod, Always) {
+  compare_with_reference(
+      make_timeperiod("00:00-24:00", "00:00-24:00", "America/New_York"));
+}
+
+TEST(Timeperiod, Sparse) {
+  compare_with_reference(make_timeperiod("", "02:00-03:00", "Europe/Paris"));
+}
+
+TEST(Timeperiod, Never) {
+  compare_with_reference(make_timeperiod("", "", "UTC"));
+}
+
+TEST(Timeperiod, CacheInvalidation) {
+  time::timeperiod tp(make_timeperiod("08:00-18:00", "", "UTC"));
+  // 2020-06-15 (Monday) 00:00:00 UTC.
+  time_t const monday(1592179200);
+  ASSERT_EQ(tp.get_next_valid(monday), monday + 8 * 3600);
+  tp.set_timerange("06:00-18:00", 1);
+  ASSERT_EQ(tp.get_next_valid(monday), monday + 6 * 3600);
+  tp.set_timezone("Asia/Tokyo");
+  ASSERT_EQ(tp.get_next_valid(monday), monday);
+  ASSERT_EQ(tp.get_next_invalid(monday), monday + 9 * 3600);
+}
+
+TEST(Timeperiod, DurationIntersect) {
+  time::timeperiod tp(make_timeperiod("08:00-18:00", "", "UTC"));
+  // 2020-06-01 (Monday) to 2020-07-01 (Wednesday), 22 working days.
+  ASSERT_EQ(tp.duration_intersect(1590969600, 1593561600), 22u * 10 * 3600);
+}
@@ -0,0 +1,152 @@
+/*
+ * Copyright 2020 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+#include "com/centreon/broker/time/timezone_rules.hh"
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include "com/centreon/broker/time/timeperiod.hh"
+
+using namespace com::centreon::broker;
+
+/**
+ *  Compare conversions with the ones of the C library on a timezone.
+ */
+static void compare_with_libc(char const* name) {
+  std::shared_ptr<time::timezone_rules const> tz(
+      time::timezone_rules::get(name));
+
+  char const* old_tz(getenv("TZ"));
+  std::string saved(old_tz ? old_tz : "");
+  setenv("TZ", name, 1);
+  tzset();
+
+  // Every 7 hours and 13 minutes between 1970 and 2040.
+  int count(0);
+  for (time_t t = 0; t < 2208988800; t += 7 * 3600 + 13 * 60) {
+    struct tm expected;
+    struct tm result;
+    localtime_r(&t, &expected);
+    tz->localtime(t, result);
+    ASSERT_EQ(result.tm_year, expected.tm_year) << name << " " << t;
+    ASSERT_EQ(result.tm_yday, expected.tm_yday) << name << " " << t;
+    ASSERT_EQ(result.tm_hour, expected.tm_hour) << name << " " << t;
+    ASSERT_EQ(result.tm_min, expected.tm_min) << name << " " << t;
+    ASSERT_EQ(result.tm_wday, expected.tm_wday) << name << " " << t;
+    ASSERT_EQ(result.tm_isdst, expected.tm_isdst) << name << " " << t;
+
+    // Midnight of the day, as computed by timeperiods.
+    expected.tm_hour = 0;
+    expected.tm_min = 0;
+    expected.tm_sec = 0;
+    result = expected;
+    ASSERT_EQ(tz->mktime(result), mktime(&expected)) << name << " " << t;
+
+    // Noon with a tm_isdst that may not match the local time, on a
+    // sample of days.
+    if (++count % 16)
+      continue;
+    for (int isdst = 0; isdst <= 1; ++isdst) {
+      expected.tm_hour = 12;
+      expected.tm_isdst = isdst;
+      result = expected;
+      ASSERT_EQ(tz->mktime(result), mktime(&expected))
+          << name << " " << t << " " << isdst;
+      localtime_r(&t, &expected);
+    }
+  }
+
+  if (old_tz)
+    setenv("TZ", saved.c_str(), 1);
+  else
+    unsetenv("TZ");
+  tzset();
+}
+
+TEST(TimezoneRules, SameAsLibc) {
+  compare_with_libc("Europe/Paris");
+  compare_with_libc("America/New_York");
+  compare_with_libc("Australia/Sydney");
+  compare_with_libc("Asia/Kolkata");
+}
+
+TEST(TimezoneRules, PosixString) {
+  compare_with_libc("CET-1CEST,M3.5.0,M10.5.0/3");
+}
+
+TEST(TimezoneRules, UnknownIsUTC) {
+  std::shared_ptr<time::timezone_rules const> tz(
+      time::timezone_rules::get("Nowhere/Unknown"));
+  ASSERT_EQ(tz->offset(1600000000), 0);
+  struct tm t;
+  tz->localtime(86400 + 3600, t);
+  ASSERT_EQ(t.tm_mday, 2);
+  ASSERT_EQ(t.tm_hour, 1);
+}
+
+TEST(TimezoneRules, Cached) {
+  ASSERT_EQ(time::timezone_rules::get("Europe/Paris"),
+            time::timezone_rules::get("Europe/Paris"));
+  ASSERT_EQ(time::timezone_rules::get("Europe/Paris")->get_name(),
+            "Europe/Paris");
+}
+
+TEST(TimezoneRules, DstDayLength) {
+  std::shared_ptr<time::timezone_rules const> tz(
+      time::timezone_rules::get("Europe/Paris"));
+  // 2020-03-29 00:00:00 in Paris, the day only lasts 23 hours.
+  time_t midnight(1585436400);
+  ASSERT_EQ(time::timeperiod::add_round_days_to_midnight(midnight, 86400, *tz),
+            midnight + 23 * 3600);
+  // 2020-10-25 00:00:00 in Paris, the day lasts 25 hours.
+  midnight = 1603576800;
+  ASSERT_EQ(time::timeperiod::add_round_days_to_midnight(midnight, 86400, *tz),
+            midnight + 25 * 3600);
+}
+
+TEST(TimezoneRules, ConcurrentTimeperiods) {
+  time::timeperiod paris;
+  paris.set_timerange("08:00-18:00", 1);
+  paris.set_timezone("Europe/Paris");
+  time::timeperiod tokyo;
+  tokyo.set_timerange("08:00-18:00", 1);
+  tokyo.set_timezone("Asia/Tokyo");
+
+  // 2020-06-15 (Monday) 00:00:00 UTC.
+  time_t const now(1592179200);
+  time_t const paris_start(now + 6 * 3600);
+  time_t const tokyo_start(now - 1 * 3600);
+
+  std::vector<std::thread> threads;
+  std::vector<int> errors(8, 0);
+  for (int i = 0; i < 8; ++i)
+    threads.emplace_back([&, i] {
+      time::timeperiod const& tp(i % 2 ? tokyo : paris);
+      time_t expected(i % 2 ? now : paris_start);
+      for (int j = 0; j < 2000; ++j)
+        if (tp.get_next_valid(now) != expected)
+          ++errors[i];
+    });
+  for (std::thread& t : threads)
+    t.join();
+  for (int e : errors)
+    ASSERT_EQ(e, 0);
+  ASSERT_EQ(tokyo.get_next_invalid(tokyo_start), now + 9 * 3600);
+}
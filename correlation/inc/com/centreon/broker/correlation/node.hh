@@ -21,7 +21,7 @@
 
 #include <map>
 #include <memory>
-#include <set>
+#include <vector>
 #include "com/centreon/broker/correlation/issue.hh"
 #include "com/centreon/broker/correlation/state.hh"
 #include "com/centreon/broker/io/data.hh"
@@ -41,11 +41,12 @@ namespace correlation {
  *  @brief Node in the IT graph.
  *
  *  A node is an element of the IT infrastructure graph. It can
- *  either be an host or a service.
+ *  either be an host or a service. Links to other nodes are kept in
+ *  flat arrays sorted by address.
  */
 class node : public correlation::state {
  public:
-  typedef std::set<node*> node_map;
+  typedef std::vector<node*> node_map;
 
   node();
   node(node const& other);
@@ -22,8 +22,11 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
 #include "com/centreon/broker/correlation/node.hh"
 #include "com/centreon/broker/io/stream.hh"
+#include "com/centreon/broker/misc/pair.hh"
 #include "com/centreon/broker/namespace.hh"
 
 CCB_BEGIN()
@@ -39,6 +42,12 @@ namespace correlation {
  *  Generate correlation events from a monitoring stream composed of
  *  various monitoring events (host/service statuses, downtimes,
  *  acknowledgements, ...).
+ *
+ *  Nodes are stored in a table and found by their (host id, service id)
+ *  through a hash index. The persistent cache holds a full dump of the
+ *  nodes, completed by a journal where only the nodes modified since the
+ *  last save are appended. The journal is merged into a new full dump once
+ *  it would be larger than it.
  */
 class stream : public io::stream {
  public:
@@ -52,22 +61,39 @@ class stream : public io::stream {
   void update();
   int write(std::shared_ptr<io::data> const& d);
   void set_state(std::map<std::pair<uint64_t, uint64_t>, node> const& st);
-  std::map<std::pair<uint64_t, uint64_t>, node> const& get_state() const;
+  std::vector<node> const& get_state() const;
+  node const* find_node(uint64_t host_id, uint64_t service_id) const;
 
  private:
   stream(stream const& other);
   stream& operator=(stream const& other);
+  node* _find_node(uint64_t host_id, uint64_t service_id);
+  std::string _journal_file() const;
+  std::string _merged_journal_file() const;
   void _load_correlation();
-  void _load_correlation_event(std::shared_ptr<io::data> const& d);
+  void _load_correlation_event(std::shared_ptr<io::data> const& d,
+                               bool reset = false);
+  void _modified(node const& n);
   void _save_persistent_cache();
+  void _write_journal();
 
   std::shared_ptr<persistent_cache> _cache;
   std::string _correlation_file;
   bool _passive;
+  bool _load;
 
   std::unique_ptr<io::stream> _pblsh;
 
-  std::map<std::pair<uint64_t, uint64_t>, node> _nodes;
+  // Nodes are never added once the table is built, their addresses are
+  // stable.
+  std::vector<node> _nodes;
+  std::unordered_map<std::pair<uint64_t, uint64_t>, uint32_t> _index;
+
+  // Nodes modified since the last save.
+  std::vector<bool> _dirty;
+  std::vector<uint32_t> _dirty_nodes;
+  // Nodes written to the journal since the last full dump.
+  size_t _journaled;
 };
 }  // namespace correlation
 
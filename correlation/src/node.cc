@@ -17,6 +17,7 @@
 */
 
 #include "com/centreon/broker/correlation/node.hh"
+#include <algorithm>
 #include <ctime>
 #include "com/centreon/broker/correlation/issue.hh"
 #include "com/centreon/broker/correlation/issue_parent.hh"
@@ -27,6 +28,42 @@
 using namespace com::centreon::broker;
 using namespace com::centreon::broker::correlation;
 
+/**
+ *  Check if a node is in a link array.
+ *
+ *  @param[in] m  Sorted link array.
+ *  @param[in] n  Node.
+ *
+ *  @return True if n is in m.
+ */
+static bool has_link(node::node_map const& m, node* n) {
+  return std::binary_search(m.begin(), m.end(), n);
+}
+
+/**
+ *  Insert a node in a link array, if it is not already there.
+ *
+ *  @param[in,out] m  Sorted link array.
+ *  @param[in]     n  Node.
+ */
+static void insert_link(node::node_map& m, node* n) {
+  node::node_map::iterator it(std::lower_bound(m.begin(), m.end(), n));
+  if (it == m.end() || *it != n)
+    m.insert(it, n);
+}
+
+/**
+ *  Remove a node from a link array.
+ *
+ *  @param[in,out] m  Sorted link array.
+ *  @param[in]     n  Node.
+ */
+static void erase_link(node::node_map& m, node* n) {
+  node::node_map::iterator it(std::lower_bound(m.begin(), m.end(), n));
+  if (it != m.end() && *it == n)
+    m.erase(it);
+}
+
 /**************************************
  *                                     *
  *           Public Methods            *
@@ -63,19 +100,19 @@ node::~node() {
 
   // Remove self from children.
   for (it = _children.begin(), end = _children.end(); it != end; ++it)
-    (*it)->_parents.erase(this);
+    erase_link((*it)->_parents, this);
 
   // Remove self from node depending on self.
   for (it = _depended_by.begin(), end = _depended_by.end(); it != end; ++it)
-    (*it)->_depends_on.erase(this);
+    erase_link((*it)->_depends_on, this);
 
   // Remove self from dependencies.
   for (it = _depends_on.begin(), end = _depends_on.end(); it != end; ++it)
-    (*it)->_depended_by.erase(this);
+    erase_link((*it)->_depended_by, this);
 
   // Remove self from parents.
   for (it = _parents.begin(), end = _parents.end(); it != end; ++it)
-    (*it)->_children.erase(this);
+    erase_link((*it)->_children, this);
 }
 
 /**
@@ -174,13 +211,13 @@ bool node::operator!=(node const& other) const {
  *  @param[in,out] n  New child.
  */
 void node::add_child(node* n) {
-  if (_parents.find(n) != _parents.end())
+  if (has_link(_parents, n))
     throw(exceptions::msg()
           << "correlation: trying to insert node (" << n->host_id << ", "
           << n->service_id << ") as children of node (" << n->host_id << ", "
           << n->service_id << "), but this node is already a parent");
-  _children.insert(n);
-  n->_parents.insert(this);
+  insert_link(_children, n);
+  insert_link(n->_parents, this);
   return;
 }
 
@@ -190,15 +227,15 @@ void node::add_child(node* n) {
  *  @param[in,out] n  New node depending on this node.
  */
 void node::add_depended(node* n) {
-  if (_depends_on.find(n) != _depends_on.end())
+  if (has_link(_depends_on, n))
     throw(exceptions::msg() << "correlation: trying to insert node ("
                             << n->host_id << ", " << n->service_id
                             << ") as inverse dependency "
                                " of node ("
                             << n->host_id << ", " << n->service_id
                             << "), but this node is already a dependency");
-  _depended_by.insert(n);
-  n->_depends_on.insert(this);
+  insert_link(_depended_by, n);
+  insert_link(n->_depends_on, this);
   return;
 }
 
@@ -208,7 +245,7 @@ void node::add_depended(node* n) {
  *  @param[in,out] n  New dependency.
  */
 void node::add_dependency(node* n) {
-  if (_depended_by.find(n) != _depended_by.end())
+  if (has_link(_depended_by, n))
     throw(exceptions::msg()
           << "correlation: trying to insert node (" << n->host_id << ", "
           << n->service_id
@@ -216,8 +253,8 @@ void node::add_dependency(node* n) {
              " node ("
           << n->host_id << ", " << n->service_id
           << "), but this node is already an inverse dependency");
-  _depends_on.insert(n);
-  n->_depended_by.insert(this);
+  insert_link(_depends_on, n);
+  insert_link(n->_depended_by, this);
   return;
 }
 
@@ -227,13 +264,13 @@ void node::add_dependency(node* n) {
  *  @param[in,out] n  New parent.
  */
 void node::add_parent(node* n) {
-  if (_children.find(n) != _children.end())
+  if (has_link(_children, n))
     throw(exceptions::msg()
           << "correlation: trying to insert node (" << n->host_id << ", "
           << n->service_id << ") as parent of node (" << n->host_id << ", "
           << n->service_id << "), but this node is already a children");
-  _parents.insert(n);
-  n->_children.insert(this);
+  insert_link(_parents, n);
+  insert_link(n->_children, this);
   return;
 }
 
@@ -279,8 +316,8 @@ node::node_map const& node::get_parents() const {
  *  @param[in,out] n Child node.
  */
 void node::remove_child(node* n) {
-  _children.erase(n);
-  n->_parents.erase(this);
+  erase_link(_children, n);
+  erase_link(n->_parents, this);
   return;
 }
 
@@ -290,8 +327,8 @@ void node::remove_child(node* n) {
  *  @param[in,out] n Node which depends on this node.
  */
 void node::remove_depended(node* n) {
-  _depended_by.erase(n);
-  n->_depends_on.erase(this);
+  erase_link(_depended_by, n);
+  erase_link(n->_depends_on, this);
   return;
 }
 
@@ -301,8 +338,8 @@ void node::remove_depended(node* n) {
  *  @param[in,out] n Node of which this node depends.
  */
 void node::remove_dependency(node* n) {
-  _depends_on.erase(n);
-  n->_depended_by.erase(this);
+  erase_link(_depends_on, n);
+  erase_link(n->_depended_by, this);
   return;
 }
 
@@ -312,8 +349,8 @@ void node::remove_dependency(node* n) {
  *  @param[in,out] n Parent node.
  */
 void node::remove_parent(node* n) {
-  _parents.erase(n);
-  n->_children.erase(this);
+  erase_link(_parents, n);
+  erase_link(n->_children, this);
   return;
 }
 
@@ -416,7 +453,7 @@ void node::manage_status(short new_state,
 void node::manage_ack(neb::acknowledgement const& ack, io::stream* stream) {
   // Acknowledgement was created.
   if (ack.deletion_time.is_null()) {
-    logging::debug(logging::low)
+    LOGGING_DEBUG(logging::low)
         << "correlation: acknowledgement on node (" << ack.host_id << ", "
         << ack.service_id << ") created at " << ack.entry_time;
     acknowledgement.reset(new neb::acknowledgement(ack));
@@ -435,7 +472,7 @@ void node::manage_ack(neb::acknowledgement const& ack, io::stream* stream) {
   }
   // Acknowledgement was deleted.
   else {
-    logging::debug(logging::low)
+    LOGGING_DEBUG(logging::low)
         << "correlation: acknowledgement on node (" << ack.host_id << ", "
         << ack.service_id << ") created at " << ack.entry_time
         << " was deleted at " << ack.deletion_time;
@@ -455,7 +492,7 @@ void node::manage_downtime(neb::downtime const& dwn, io::stream* stream) {
   bool finished(!dwn.actual_end_time.is_null());
   if (started) {
     if (!finished) {
-      logging::debug(logging::low)
+      LOGGING_DEBUG(logging::low)
           << "correlation: downtime (" << dwn.actual_start_time << "-"
           << dwn.actual_end_time << ") on node (" << dwn.host_id << ", "
           << dwn.service_id << ") is starting";
@@ -464,7 +501,7 @@ void node::manage_downtime(neb::downtime const& dwn, io::stream* stream) {
         _generate_state_event(dwn.actual_start_time, current_state, true,
                               stream);
     } else {
-      logging::debug(logging::low)
+      LOGGING_DEBUG(logging::low)
           << "correlation: downtime (" << dwn.actual_start_time << "-"
           << dwn.actual_end_time << ") on node (" << dwn.host_id << ", "
           << dwn.service_id << ") finished";
@@ -606,22 +643,22 @@ void node::_internal_copy(node const& n) {
   node_map::iterator it, end;
   _children = n._children;
   for (it = _children.begin(), end = _children.end(); it != end; ++it)
-    (*it)->_parents.insert(this);
+    insert_link((*it)->_parents, this);
 
   // Copy nodes depending on copied node.
   _depended_by = n._depended_by;
   for (it = _depended_by.begin(), end = _depended_by.end(); it != end; ++it)
-    (*it)->_depends_on.insert(this);
+    insert_link((*it)->_depends_on, this);
 
   // Copy nodes on which the copied node depends.
   _depends_on = n._depends_on;
   for (it = _depends_on.begin(), end = _depends_on.end(); it != end; ++it)
-    (*it)->_depended_by.insert(this);
+    insert_link((*it)->_depended_by, this);
 
   // Copy parents.
   _parents = n._parents;
   for (it = _parents.begin(), end = _parents.end(); it != end; ++it)
-    (*it)->_children.insert(this);
+    insert_link((*it)->_children, this);
 
   return;
 }
@@ -653,7 +690,7 @@ void node::_generate_state_event(timestamp start_time,
       !acknowledgement->is_sticky
       // Downtime start/stop do not remove non-sticky acknowledgements.
       && (in_downtime == new_in_downtime)) {
-    logging::debug(logging::low)
+    LOGGING_DEBUG(logging::low)
         << "correlation: reseting non-sticky acknowledgement of node ("
         << host_id << ", " << service_id << ")";
     acknowledgement.reset();
@@ -17,12 +17,15 @@
 */
 
 #include "com/centreon/broker/correlation/stream.hh"
+#include <cstdio>
 #include "com/centreon/broker/config/applier/state.hh"
 #include "com/centreon/broker/correlation/engine_state.hh"
 #include "com/centreon/broker/correlation/node.hh"
 #include "com/centreon/broker/exceptions/msg.hh"
 #include "com/centreon/broker/exceptions/shutdown.hh"
+#include "com/centreon/broker/file/opener.hh"
 #include "com/centreon/broker/logging/logging.hh"
+#include "com/centreon/broker/misc/filesystem.hh"
 #include "com/centreon/broker/multiplexing/publisher.hh"
 #include "com/centreon/broker/neb/acknowledgement.hh"
 #include "com/centreon/broker/neb/downtime.hh"
@@ -41,8 +44,9 @@ using namespace com::centreon::broker::correlation;
  *
  *  @param[in]      correlation_file  Correlation file.
  *  @param[int,out] cache             Persistent cache.
- *  @param[in]      load_correlation  True if we should load correlation
- *                                    state from persistent cache.
+ *  @param[in]      load_correlation  True if the nodes given to
+ *                                    set_state() should be completed by
+ *                                    the persistent cache.
  *  @param[in]      passive           Is this stream passive ?
  *                                    (won't send any event)
  */
@@ -51,7 +55,10 @@ stream::stream(std::string const& correlation_file,
                bool load_correlation,
                bool passive)
     : io::stream("correlation"),
-      _cache(cache), _correlation_file(correlation_file) {
+      _cache(cache),
+      _correlation_file(correlation_file),
+      _load(load_correlation),
+      _journaled(0) {
   if (!passive) {
     // Events will be written to publisher.
     _pblsh.reset(new multiplexing::publisher);
@@ -62,16 +69,18 @@ stream::stream(std::string const& correlation_file,
     es->started = true;
     _pblsh->write(es);
   }
-
-  // Load the correlation.
-  if (load_correlation)
-    _load_correlation();
 }
 
 /**
  *  Destructor.
  */
 stream::~stream() {
+  try {
+    _save_persistent_cache();
+  } catch (std::exception const& e) {
+    logging::error(logging::medium)
+        << "correlator: error while saving correlation state: " << e.what();
+  }
   try {
     if (_pblsh) {
       std::shared_ptr<engine_state> es(new engine_state);
@@ -101,12 +110,10 @@ bool stream::read(std::shared_ptr<io::data>& d, time_t deadline) {
 }
 
 /**
- *  Update the stream.
+ *  Update the stream: save the nodes modified since the last save.
  */
 void stream::update() {
   _save_persistent_cache();
-  _load_correlation();
-  return;
 }
 
 /**
@@ -121,78 +128,75 @@ int stream::write(std::shared_ptr<io::data> const& d) {
 
   if (d->type() == neb::host_status::static_type()) {
     neb::host_status const& hs = *std::static_pointer_cast<neb::host_status>(d);
-    std::map<std::pair<uint64_t, uint64_t>, node>::iterator found =
-        _nodes.find({hs.host_id, 0});
-    if (found != _nodes.end()) {
+    node* found(_find_node(hs.host_id, 0));
+    if (found) {
       logging::debug(logging::medium)
           << "correlation: processing host status " << hs.last_hard_state
           << " for node (" << hs.host_id << ", 0)";
-      found->second.manage_status(hs.last_hard_state, hs.last_hard_state_change,
-                                  _pblsh.get());
+      found->manage_status(hs.last_hard_state, hs.last_hard_state_change,
+                           _pblsh.get());
+      _modified(*found);
     }
   } else if (d->type() == neb::service_status::static_type()) {
     neb::service_status const& ss =
         *std::static_pointer_cast<neb::service_status>(d);
-    std::map<std::pair<uint64_t, uint64_t>, node>::iterator found{
-        _nodes.find({ss.host_id, ss.service_id})};
-    if (found != _nodes.end()) {
+    node* found(_find_node(ss.host_id, ss.service_id));
+    if (found) {
       logging::debug(logging::medium)
           << "correlation: processing service status " << ss.last_hard_state
           << " for node (" << ss.host_id << ", " << ss.service_id << ")";
-      found->second.manage_status(ss.last_hard_state, ss.last_hard_state_change,
-                                  _pblsh.get());
+      found->manage_status(ss.last_hard_state, ss.last_hard_state_change,
+                           _pblsh.get());
+      _modified(*found);
     }
   } else if (d->type() == neb::host::static_type()) {
     neb::host const& h(*std::static_pointer_cast<neb::host>(d));
-    std::map<std::pair<uint64_t, uint64_t>, node>::const_iterator it(
-        _nodes.find({h.host_id, 0}));
-    if ((it != _nodes.end()) && _pblsh.get()) {
+    node const* found(find_node(h.host_id, 0));
+    if (found && _pblsh.get()) {
       logging::debug(logging::medium)
           << "correlation: generating state event for host " << h.host_id
           << " following its (re)declaration";
-      _pblsh->write(std::make_shared<state>(it->second));
+      _pblsh->write(std::make_shared<state>(*found));
     }
   } else if (d->type() == neb::service::static_type()) {
     neb::service const& s(*std::static_pointer_cast<neb::service>(d));
-    std::map<std::pair<uint64_t, uint64_t>, node>::const_iterator it(
-        _nodes.find({s.host_id, s.service_id}));
-    if ((it != _nodes.end()) && _pblsh.get()) {
+    node const* found(find_node(s.host_id, s.service_id));
+    if (found && _pblsh.get()) {
       logging::debug(logging::medium)
           << "correlation: generating state event for service (" << s.host_id
           << ", " << s.service_id << ") following its (re)declaration";
-      _pblsh->write(std::make_shared<state>(it->second));
+      _pblsh->write(std::make_shared<state>(*found));
     }
   } else if (d->type() == neb::acknowledgement::static_type()) {
     neb::acknowledgement const& ack =
         *std::static_pointer_cast<neb::acknowledgement>(d);
-    std::map<std::pair<uint64_t, uint64_t>, node>::iterator found =
-        _nodes.find({ack.host_id, ack.service_id});
-    if (found != _nodes.end()) {
+    node* found(_find_node(ack.host_id, ack.service_id));
+    if (found) {
       logging::debug(logging::medium)
           << "correlation: processing ack for node (" << ack.host_id << ", "
           << ack.service_id << ")";
-      found->second.manage_ack(ack, _pblsh.get());
+      found->manage_ack(ack, _pblsh.get());
+      _modified(*found);
     }
   } else if (d->type() == neb::downtime::static_type()) {
     neb::downtime const& dwn = *std::static_pointer_cast<neb::downtime>(d);
-    std::map<std::pair<uint64_t, uint64_t>, node>::iterator found =
-        _nodes.find({dwn.host_id, dwn.service_id});
-    if (found != _nodes.end()) {
+    node* found(_find_node(dwn.host_id, dwn.service_id));
+    if (found) {
       logging::debug(logging::medium)
           << "correlation: processing downtime (" << dwn.actual_start_time
           << "-" << dwn.actual_end_time << ") for node (" << dwn.host_id << ", "
           << dwn.service_id << ")";
-      found->second.manage_downtime(dwn, _pblsh.get());
+      found->manage_downtime(dwn, _pblsh.get());
+      _modified(*found);
     }
   } else if (d->type() == neb::log_entry::static_type()) {
     neb::log_entry const& entry = *std::static_pointer_cast<neb::log_entry>(d);
-    std::map<std::pair<uint64_t, uint64_t>, node>::iterator found =
-        _nodes.find({entry.host_id, entry.service_id});
-    if (found != _nodes.end()) {
+    node* found(_find_node(entry.host_id, entry.service_id));
+    if (found) {
       logging::debug(logging::medium)
           << "correlation: processing log for node (" << entry.host_id << ", "
           << entry.service_id << ")";
-      found->second.manage_log(entry, _pblsh.get());
+      found->manage_log(entry, _pblsh.get());
     }
   }
 
@@ -200,37 +204,175 @@ int stream::write(std::shared_ptr<io::data> const& d) {
 }
 
 /**
- *  Set the state.
+ *  Set the state. The node table is built again, links between the
+ *  given nodes are copied to the new nodes. The first time, the saved
+ *  state of these nodes is loaded if the stream was asked to.
  *
  *  @param[in] st  the state.
  */
 void stream::set_state(
     std::map<std::pair<uint64_t, uint64_t>, node> const& st) {
-  _nodes = st;
+  std::vector<node> nodes(st.size());
+  std::unordered_map<std::pair<uint64_t, uint64_t>, uint32_t> index;
+  index.reserve(st.size());
+
+  // Copy nodes without their links.
+  uint32_t i(0);
+  for (auto const& p : st) {
+    node const& from(p.second);
+    node& to(nodes[i]);
+    static_cast<state&>(to) = from;
+    if (from.my_issue)
+      to.my_issue.reset(new issue(*from.my_issue));
+    if (from.acknowledgement)
+      to.acknowledgement.reset(
+          new neb::acknowledgement(*from.acknowledgement));
+    to.downtimes = from.downtimes;
+    index[{from.host_id, from.service_id}] = i;
+    ++i;
+  }
+
+  // Links, each one is created from one of its ends.
+  i = 0;
+  for (auto const& p : st) {
+    node& to(nodes[i++]);
+    for (node const* n : p.second.get_children()) {
+      auto found(index.find({n->host_id, n->service_id}));
+      if (found != index.end())
+        to.add_child(&nodes[found->second]);
+    }
+    for (node const* n : p.second.get_dependencies()) {
+      auto found(index.find({n->host_id, n->service_id}));
+      if (found != index.end())
+        to.add_dependency(&nodes[found->second]);
+    }
+  }
+
+  _nodes = std::move(nodes);
+  _index = std::move(index);
+
+  if (_load) {
+    _load_correlation();
+    _load = false;
+  }
+
+  // The previous dump is about other nodes, next save will be a full one.
+  _dirty.assign(_nodes.size(), true);
+  _dirty_nodes.resize(_nodes.size());
+  for (i = 0; i < _nodes.size(); ++i)
+    _dirty_nodes[i] = i;
 }
 
 /**
  *  Get the state.
  *
- *  @return  The state.
+ *  @return  The node table.
  */
-std::map<std::pair<uint64_t, uint64_t>, node> const& stream::get_state() const {
+std::vector<node> const& stream::get_state() const {
   return _nodes;
 }
 
 /**
- *  Load correlation from the configuration file and the persistent
- *  cache.
+ *  Find a node.
+ *
+ *  @param[in] host_id     Host id of the node.
+ *  @param[in] service_id  Service id of the node, 0 for a host.
+ *
+ *  @return  The node, nullptr if not found.
+ */
+node const* stream::find_node(uint64_t host_id, uint64_t service_id) const {
+  auto found(_index.find({host_id, service_id}));
+  return found == _index.end() ? nullptr : &_nodes[found->second];
+}
+
+/**
+ *  Find a node.
+ *
+ *  @param[in] host_id     Host id of the node.
+ *  @param[in] service_id  Service id of the node, 0 for a host.
+ *
+ *  @return  The node, nullptr if not found.
+ */
+node* stream::_find_node(uint64_t host_id, uint64_t service_id) {
+  auto found(_index.find({host_id, service_id}));
+  return found == _index.end() ? nullptr : &_nodes[found->second];
+}
+
+/**
+ *  Get the path of the journal.
+ *
+ *  @return  The persistent cache file followed by ".journal".
+ */
+std::string stream::_journal_file() const {
+  std::string retval(_cache->get_cache_file());
+  retval.append(".journal");
+  return retval;
+}
+
+/**
+ *  Get the path of a journal merged into a dump not committed yet.
+ *
+ *  @return  The journal followed by ".merged".
+ */
+std::string stream::_merged_journal_file() const {
+  std::string retval(_journal_file());
+  retval.append(".merged");
+  return retval;
+}
+
+/**
+ *  Load correlation from the persistent cache, then from the journal.
  */
 void stream::_load_correlation() {
+  if (_cache == nullptr)
+    return;
+
   // Load the cache.
-  if (_cache != nullptr) {
-    std::shared_ptr<io::data> d;
-    while (true) {
-      _cache->get(d);
-      if (!d)
-        break;
-      _load_correlation_event(d);
+  std::shared_ptr<io::data> d;
+  while (true) {
+    _cache->get(d);
+    if (!d)
+      break;
+    _load_correlation_event(d);
+  }
+
+  // Replay the journal, each node written there replaces the one of the
+  // cache.
+  _journaled = 0;
+  std::string journal(_journal_file());
+
+  // A merged journal is left by a crash during a full dump. It still
+  // applies to the cache if the new dump was not committed.
+  std::string merged(_merged_journal_file());
+  if (misc::filesystem::file_exists(merged)) {
+    std::string new_cache(_cache->get_cache_file());
+    new_cache.append(".new");
+    if (misc::filesystem::file_exists(new_cache))
+      ::rename(merged.c_str(), journal.c_str());
+    else
+      ::remove(merged.c_str());
+  }
+
+  if (misc::filesystem::file_exists(journal)) {
+    try {
+      std::shared_ptr<io::stream> js(file::open_bbdo_file(journal));
+      for (;;) {
+        d.reset();
+        try {
+          js->read(d);
+        } catch (exceptions::shutdown const& e) {
+          (void)e;
+        }
+        if (!d)
+          break;
+        if (d->type() == state::static_type())
+          ++_journaled;
+        _load_correlation_event(d, true);
+      }
+    } catch (std::exception const& e) {
+      logging::error(logging::medium)
+          << "correlation: could not read journal '" << journal
+          << "': " << e.what();
     }
   }
 }
@@ -238,70 +380,119 @@ void stream::_load_correlation() {
 /**
  *  Load a correlation event from the cache.
  *
- *  @param[in] d  The event.
+ *  @param[in] d      The event.
+ *  @param[in] reset  True if a state event starts a new version of the
+ *                    node: its issue, downtimes and acknowledgement are
+ *                    cleared, the following events restore them.
  */
-void stream::_load_correlation_event(std::shared_ptr<io::data> const& d) {
+void stream::_load_correlation_event(std::shared_ptr<io::data> const& d,
+                                     bool reset) {
   if (!d)
     return;
 
   if (d->type() == issue::static_type()) {
     issue const& iss = *std::static_pointer_cast<issue>(d);
-    std::map<std::pair<uint64_t, uint64_t>, node>::iterator found =
-        _nodes.find({iss.host_id, iss.service_id});
-    if (found != _nodes.end()) {
+    node* found(_find_node(iss.host_id, iss.service_id));
+    if (found) {
       logging::debug(logging::medium)
           << "correlation: loading initial issue for node (" << iss.host_id
           << ", " << iss.service_id << ")";
-      found->second.my_issue.reset(new issue(iss));
+      found->my_issue.reset(new issue(iss));
     }
   } else if (d->type() == state::static_type()) {
     state const& st = *std::static_pointer_cast<state>(d);
-    std::map<std::pair<uint64_t, uint64_t>, node>::iterator found =
-        _nodes.find({st.host_id, st.service_id});
-    if (found != _nodes.end()) {
+    node* found(_find_node(st.host_id, st.service_id));
+    if (found) {
       logging::debug(logging::medium)
           << "correlation: loading initial state for node (" << st.host_id
           << ", " << st.service_id << ")";
-      *static_cast<state*>(&found->second) = st;
+      if (reset) {
+        found->my_issue.reset();
+        found->acknowledgement.reset();
+        found->downtimes.clear();
+      }
+      *static_cast<state*>(found) = st;
     }
   } else if (d->type() == neb::downtime::static_type()) {
     neb::downtime const& dwn = *std::static_pointer_cast<neb::downtime>(d);
-    std::map<std::pair<uint64_t, uint64_t>, node>::iterator found =
-        _nodes.find({dwn.host_id, dwn.service_id});
-    if (found != _nodes.end()) {
+    node* found(_find_node(dwn.host_id, dwn.service_id));
+    if (found) {
       logging::debug(logging::medium)
           << "correlation: loading initial downtime for node (" << dwn.host_id
           << ", " << dwn.service_id << ")";
-      found->second.manage_downtime(dwn, nullptr);
+      found->manage_downtime(dwn, nullptr);
     }
   } else if (d->type() == neb::acknowledgement::static_type()) {
     neb::acknowledgement const& ack =
         *std::static_pointer_cast<neb::acknowledgement>(d);
-    std::map<std::pair<uint64_t, uint64_t>, node>::iterator found =
-        _nodes.find({ack.host_id, ack.service_id});
-    if (found != _nodes.end()) {
+    node* found(_find_node(ack.host_id, ack.service_id));
+    if (found) {
       logging::debug(logging::medium)
           << "correlation: loading initial acknowledgement for node ("
           << ack.host_id << ", " << ack.service_id << ")";
-      found->second.manage_ack(ack, nullptr);
+      found->manage_ack(ack, nullptr);
     }
   }
 }
 
 /**
- *  Save content of the correlation memory in the persistent cache.
+ *  Remember a node was modified, it will be saved by the next
+ *  _save_persistent_cache().
+ *
+ *  @param[in] n  A node of the table.
+ */
+void stream::_modified(node const& n) {
+  uint32_t i(&n - _nodes.data());
+  if (!_dirty[i]) {
+    _dirty[i] = true;
+    _dirty_nodes.push_back(i);
+  }
+}
+
+/**
+ *  Save the modified nodes. They are appended to the journal, unless the
+ *  journal would be larger than a full dump of the nodes.
  */
 void stream::_save_persistent_cache() {
   // No cache, nothing to do.
-  if (_cache == nullptr)
+  if (_cache == nullptr || _dirty_nodes.empty())
     return;
 
-  // Serialize to the cache.
-  _cache->transaction();
-  for (std::map<std::pair<uint64_t, uint64_t>, node>::const_iterator
-           it = _nodes.begin(),
-           end = _nodes.end();
-       it != end; ++it)
-    it->second.serialize(*_cache);
-  _cache->commit();
+  if (_journaled + _dirty_nodes.size() >= _nodes.size()) {
+    // Serialize to the cache. The journal is only removed once the new
+    // dump is committed, it is renamed before so that it is never replayed
+    // over the new dump.
+    _cache->transaction();
+    for (node const& n : _nodes)
+      n.serialize(*_cache);
+    std::string merged(_merged_journal_file());
+    ::rename(_journal_file().c_str(), merged.c_str());
+    _cache->commit();
+    ::remove(merged.c_str());
+    _journaled = 0;
+  } else
+    _write_journal();
+
+  for (uint32_t i : _dirty_nodes)
+    _dirty[i] = false;
+  _dirty_nodes.clear();
+}
+
+/**
+ *  Append the modified nodes to the journal. The state comes first, it
+ *  tells the loader that the node is replaced.
+ */
+void stream::_write_journal() {
+  std::shared_ptr<io::stream> js(file::open_bbdo_file(_journal_file()));
+  for (uint32_t i : _dirty_nodes) {
+    node const& n(_nodes[i]);
+    js->write(std::make_shared<state>(n));
+    if (n.my_issue)
+      js->write(std::make_shared<issue>(*n.my_issue));
+    for (auto const& p : n.downtimes)
+      js->write(std::make_shared<neb::downtime>(p.second));
+    if (n.acknowledgement)
+      js->write(std::make_shared<neb::acknowledgement>(*n.acknowledgement));
+  }
+  _journaled += _dirty_nodes.size();
 }
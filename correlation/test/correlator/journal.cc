@@ -0,0 +1,156 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include "com/centreon/broker/config/applier/init.hh"
+#include "com/centreon/broker/correlation/engine_state.hh"
+#include "com/centreon/broker/correlation/internal.hh"
+#include "com/centreon/broker/correlation/issue.hh"
+#include "com/centreon/broker/correlation/state.hh"
+#include "com/centreon/broker/correlation/stream.hh"
+#include "com/centreon/broker/io/events.hh"
+#include "com/centreon/broker/misc/filesystem.hh"
+#include "com/centreon/broker/neb/service_status.hh"
+#include "com/centreon/broker/persistent_cache.hh"
+
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::correlation;
+
+/**
+ *  Nodes are saved in a cache file and a journal. The stream is destroyed
+ *  without anything left to save, as if broker crashed right after the
+ *  last journal write, and a new stream loads the saved state.
+ */
+class CorrelationJournal : public ::testing::Test {
+ public:
+  void SetUp() override {
+    config::applier::init();
+    io::events& e(io::events::instance());
+    e.register_category("correlation", io::events::correlation);
+    e.register_event(io::events::correlation, correlation::de_engine_state,
+                     "engine_state", &correlation::engine_state::operations,
+                     correlation::engine_state::entries);
+    e.register_event(io::events::correlation, correlation::de_state, "state",
+                     &correlation::state::operations,
+                     correlation::state::entries);
+    e.register_event(io::events::correlation, correlation::de_issue, "issue",
+                     &correlation::issue::operations,
+                     correlation::issue::entries, "issues");
+    _remove_files();
+  }
+
+  void TearDown() override {
+    _remove_files();
+    io::events::instance().unregister_category(io::events::correlation);
+    config::applier::deinit();
+  }
+
+ protected:
+  std::string const _path = "/tmp/broker_correlation_journal";
+
+  void _remove_files() {
+    for (char const* suffix :
+         {"", ".new", ".old", ".journal", ".journal.merged"})
+      ::remove((_path + suffix).c_str());
+  }
+
+  /**
+   *  Four OK services of the same host.
+   */
+  static std::map<std::pair<uint64_t, uint64_t>, node> _nodes() {
+    std::map<std::pair<uint64_t, uint64_t>, node> retval;
+    for (uint32_t i = 1; i <= 4; ++i) {
+      node& n(retval[{1u, i}]);
+      n.host_id = 1;
+      n.service_id = i;
+      n.current_state = 0;
+    }
+    return retval;
+  }
+
+  static void _set_status(correlation::stream& s,
+                          uint32_t service_id,
+                          short state) {
+    std::shared_ptr<neb::service_status> ss(new neb::service_status);
+    ss->host_id = 1;
+    ss->service_id = service_id;
+    ss->last_hard_state = state;
+    ss->last_hard_state_change = 1000 + service_id;
+    s.write(ss);
+  }
+
+  /**
+   *  Dump the nodes, then journal two status changes.
+   */
+  void _write() {
+    std::shared_ptr<persistent_cache> cache(new persistent_cache(_path));
+    correlation::stream s("", cache, true, true);
+    s.set_state(_nodes());
+    s.update();
+    _set_status(s, 1, 2);
+    s.update();
+    _set_status(s, 2, 1);
+    s.update();
+    ASSERT_TRUE(misc::filesystem::file_exists(_path + ".journal"));
+  }
+
+  /**
+   *  Load the saved state in a new stream.
+   */
+  std::unique_ptr<correlation::stream> _read() {
+    std::shared_ptr<persistent_cache> cache(new persistent_cache(_path));
+    std::unique_ptr<correlation::stream> retval(
+        new correlation::stream("", cache, true, true));
+    retval->set_state(_nodes());
+    return retval;
+  }
+};
+
+TEST_F(CorrelationJournal, Replay) {
+  _write();
+  std::unique_ptr<correlation::stream> s(_read());
+  ASSERT_EQ(s->find_node(1, 1)->current_state, 2);
+  ASSERT_TRUE(s->find_node(1, 1)->my_issue);
+  ASSERT_EQ(s->find_node(1, 1)->my_issue->start_time, 1001);
+  ASSERT_EQ(s->find_node(1, 2)->current_state, 1);
+  ASSERT_EQ(s->find_node(1, 3)->current_state, 0);
+  ASSERT_FALSE(s->find_node(1, 3)->my_issue);
+}
+
+TEST_F(CorrelationJournal, MergedIntoCommittedDump) {
+  _write();
+  // Crash after the commit of a dump, before the removal of its journal.
+  ::rename((_path + ".journal").c_str(), (_path + ".journal.merged").c_str());
+  std::unique_ptr<correlation::stream> s(_read());
+  ASSERT_EQ(s->find_node(1, 1)->current_state, 0);
+  ASSERT_EQ(s->find_node(1, 2)->current_state, 0);
+  ASSERT_FALSE(misc::filesystem::file_exists(_path + ".journal.merged"));
+}
+
+TEST_F(CorrelationJournal, MergedIntoUncommittedDump) {
+  _write();
+  // Crash during a dump, before its commit.
+  ::rename((_path + ".journal").c_str(), (_path + ".journal.merged").c_str());
+  std::ofstream(_path + ".new").close();
+  std::unique_ptr<correlation::stream> s(_read());
+  ASSERT_EQ(s->find_node(1, 1)->current_state, 2);
+  ASSERT_EQ(s->find_node(1, 2)->current_state, 1);
+}
@@ -16,72 +16,62 @@
 ** For more information : contact@centreon.com
 */
 
-#include <QMap>
-#include <QPair>
-#include <cstdlib>
-#include <iostream>
+#include <gtest/gtest.h>
+#include <map>
 #include "com/centreon/broker/config/applier/init.hh"
 #include "com/centreon/broker/correlation/stream.hh"
-#include "com/centreon/broker/exceptions/msg.hh"
 
 using namespace com::centreon::broker;
 using namespace com::centreon::broker::correlation;
 
+class CorrelationSetState : public ::testing::Test {
+ public:
+  void SetUp() override { config::applier::init(); }
+  void TearDown() override { config::applier::deinit(); }
+};
+
 /**
  *  Check that state can be properly set to the correlator.
- *
- *  @return 0 on success.
  */
-int main() {
-  // Return value.
-  int retval(EXIT_FAILURE);
-
-  // Initialization.
-  config::applier::init();
-
-  try {
-    // Create state.
-    QMap<QPair<uint32_t, uint32_t>, node> state;
-    node& n1(state[qMakePair(42u, 24u)]);
-    n1.host_id = 42;
-    n1.service_id = 24;
-    n1.current_state = 3;
-    n1.my_issue.reset(new issue);
-    n1.my_issue->host_id = 42;
-    n1.my_issue->service_id = 24;
-    n1.my_issue->start_time = 123456;
-    node& n2(state[qMakePair(77u, 56u)]);
-    n2.host_id = 77;
-    n2.service_id = 56;
-    n2.current_state = 2;
-    n2.my_issue.reset(new issue);
-    n2.my_issue->host_id = 77;
-    n2.my_issue->service_id = 56;
-    n2.my_issue->start_time = 7466;
-    node& n3(state[qMakePair(123u, 0u)]);
-    n3.host_id = 123;
-    n3.service_id = 0;
-    n3.current_state = 0;
-    n1.add_parent(&n2);
-
-    // Set state to correlator.
-    correlation::stream c("", std::shared_ptr<persistent_cache>(), false);
-    c.set_state(state);
-
-    // Compare states.
-    if (c.get_state() != state)
-      throw(exceptions::msg() << "state mismatch");
+TEST_F(CorrelationSetState, GetState) {
+  // Create state.
+  std::map<std::pair<uint64_t, uint64_t>, node> state;
+  node& n1(state[{42u, 24u}]);
+  n1.host_id = 42;
+  n1.service_id = 24;
+  n1.current_state = 3;
+  n1.my_issue.reset(new issue);
+  n1.my_issue->host_id = 42;
+  n1.my_issue->service_id = 24;
+  n1.my_issue->start_time = 123456;
+  node& n2(state[{77u, 56u}]);
+  n2.host_id = 77;
+  n2.service_id = 56;
+  n2.current_state = 2;
+  n2.my_issue.reset(new issue);
+  n2.my_issue->host_id = 77;
+  n2.my_issue->service_id = 56;
+  n2.my_issue->start_time = 7466;
+  node& n3(state[{123u, 0u}]);
+  n3.host_id = 123;
+  n3.service_id = 0;
+  n3.current_state = 0;
+  n1.add_parent(&n2);
 
-    // Success.
-    retval = EXIT_SUCCESS;
-  } catch (std::exception const& e) {
-    std::cout << e.what() << std::endl;
-  } catch (...) {
-    std::cout << "unknown exception" << std::endl;
-  }
+  // Set state to correlator.
+  correlation::stream c("", std::shared_ptr<persistent_cache>(), false, true);
+  c.set_state(state);
 
-  // Cleanup.
-  config::applier::deinit();
+  // Compare states.
+  std::vector<node> const& nodes(c.get_state());
+  ASSERT_EQ(nodes.size(), state.size());
+  for (node const& n : nodes)
+    ASSERT_TRUE(n == state[std::make_pair(n.host_id, n.service_id)]);
 
-  return (retval);
+  // Links point to the nodes of the correlator.
+  node const* found(c.find_node(42, 24));
+  ASSERT_NE(found, nullptr);
+  ASSERT_EQ(found->get_parents().size(), 1u);
+  ASSERT_EQ(*found->get_parents().begin(), c.find_node(77, 56));
+  ASSERT_EQ(c.find_node(1, 1), nullptr);
 }
@@ -0,0 +1,212 @@
+#!/bin/bash
+#
+# Copyright 2020 Centreon
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# For more information : contact@centreon.com
+#
+
+# End-to-end benchmark of Centreon Broker built on the generator module.
+#
+# Each scenario runs a generator_sender and a generator_receiver, either in
+# the same cbd (muxer only) or in two cbd connected by TCP. The receiver
+# statistics give the throughput and the latency percentiles.
+
+# Variables.
+cbd=
+module_dir=
+work_dir=/tmp
+scenarios="local bbdo tls compression tls_compression retention"
+rate=0
+count=1000000
+hosts=100
+services_per_host=10
+mix="service_status:60,host_status:10,log_entry:20,perfdata:10,dummy:1"
+port=5699
+timeout=600
+
+# Browse arguments.
+while [ $# -ge 1 ] ; do
+  if [ x"$1" = x"--help" ] ; then
+    echo "USAGE: $0 --cbd <cbd> --module-dir <dir> [options] [scenario...]"
+    echo
+    echo "  --work-dir <dir>           Directory in which a temporary directory"
+    echo "                             of configurations, logs and retention"
+    echo "                             files is created ($work_dir)."
+    echo "  --rate <n>                 Events per second, 0 for no limit ($rate)."
+    echo "  --count <n>                Events to send ($count)."
+    echo "  --hosts <n>                Generated hosts ($hosts)."
+    echo "  --services-per-host <n>    Generated services per host ($services_per_host)."
+    echo "  --mix <kind:weight,...>    Event mix ($mix)."
+    echo "  --port <n>                 TCP port between the cbd ($port)."
+    echo "  --timeout <s>              Maximum duration of a scenario ($timeout)."
+    echo
+    echo "Scenarios: $scenarios"
+    exit 0
+  elif [ x"$1" = x"--cbd" ] ; then
+    shift
+    cbd="$1"
+  elif [ x"$1" = x"--module-dir" ] ; then
+    shift
+    module_dir="$1"
+  elif [ x"$1" = x"--work-dir" ] ; then
+    shift
+    work_dir="$1"
+  elif [ x"$1" = x"--rate" ] ; then
+    shift
+    rate="$1"
+  elif [ x"$1" = x"--count" ] ; then
+    shift
+    count="$1"
+  elif [ x"$1" = x"--hosts" ] ; then
+    shift
+    hosts="$1"
+  elif [ x"$1" = x"--services-per-host" ] ; then
+    shift
+    services_per_host="$1"
+  elif [ x"$1" = x"--mix" ] ; then
+    shift
+    mix="$1"
+  elif [ x"$1" = x"--port" ] ; then
+    shift
+    port="$1"
+  elif [ x"$1" = x"--timeout" ] ; then
+    shift
+    timeout="$1"
+  else
+    selected="$selected $1"
+  fi
+  shift
+done
+if [ -n "$selected" ] ; then
+  scenarios="$selected"
+fi
+if [ -z "$cbd" -o -z "$module_dir" ] ; then
+  echo "$0: --cbd and --module-dir are mandatory, see --help" >&2
+  exit 1
+fi
+bench_dir=$(cd "$(dirname "$0")" && pwd)
+
+# Only this directory is written and removed, never the --work-dir itself.
+run_dir=$(mktemp -d "$work_dir/centreon-broker-bench.XXXXXX") || exit 1
+trap 'rm -rf "$run_dir"' EXIT
+
+# Generate a configuration from a template.
+#   $1  template name
+#   $2  tls
+#   $3  compression
+#   $4  event queue max size
+configure() {
+  sed -e "s|@MODULE_DIR@|$module_dir|g" \
+      -e "s|@WORK_DIR@|$scenario_dir|g" \
+      -e "s|@RATE@|$rate|g" \
+      -e "s|@COUNT@|$count|g" \
+      -e "s|@HOSTS@|$hosts|g" \
+      -e "s|@SERVICES_PER_HOST@|$services_per_host|g" \
+      -e "s|@MIX@|$mix|g" \
+      -e "s|@PORT@|$port|g" \
+      -e "s|@TLS@|$2|g" \
+      -e "s|@COMPRESSION@|$3|g" \
+      -e "s|@QUEUE_SIZE@|$4|g" \
+      "$bench_dir/$1.json.in" > "$scenario_dir/$1.json"
+}
+
+# Print the receiver statistics read from a stats fifo.
+#   $1  stats fifo
+#   $2  1 to only print the number of received events
+receiver_stats() {
+  timeout 5 cat "$1" 2>/dev/null | python3 -c '
+import json, sys
+def find(node):
+  if isinstance(node, dict):
+    if "events_by_type" in node:
+      return node
+    for v in node.values():
+      r = find(v)
+      if r is not None:
+        return r
+  return None
+try:
+  r = find(json.load(sys.stdin)) or {}
+except ValueError:
+  r = {}
+if sys.argv[1] == "1":
+  print(int(r.get("events", 0)))
+else:
+  print("  events:      %d" % r.get("events", 0))
+  print("  events/s:    %.0f" % r.get("events_per_second", 0))
+  for p in ("p50", "p90", "p99", "max"):
+    print("  latency %-4s %.3f ms" % (p + ":", r.get("latency_" + p, 0) * 1000))
+' "$2"
+}
+
+# Wait until the receiver got all the events.
+#   $1  stats fifo
+wait_events() {
+  local start=$(date +%s)
+  while [ $(( $(date +%s) - start )) -lt "$timeout" ] ; do
+    received=$(receiver_stats "$1" 1)
+    if [ -n "$received" ] && [ "$received" -ge "$count" ] ; then
+      return 0
+    fi
+    sleep 1
+  done
+  echo "  timeout: $received events received" >&2
+  return 1
+}
+
+run_scenario() {
+  local tls=no compression=no queue_size=100000 delay=0 stats
+  case "$1" in
+    local) ;;
+    bbdo) ;;
+    tls) tls=yes ;;
+    compression) compression=yes ;;
+    tls_compression) tls=yes ; compression=yes ;;
+    retention) queue_size=10000 ; delay=5 ;;
+    *) echo "unknown scenario '$1'" >&2 ; return 1 ;;
+  esac
+
+  scenario_dir="$run_dir/$1"
+  mkdir "$scenario_dir" || return 1
+  echo "$1:"
+  if [ "$1" = "local" ] ; then
+    configure local "$tls" "$compression" "$queue_size"
+    "$cbd" "$scenario_dir/local.json" &
+    pids=$!
+    stats="$scenario_dir/bench-local-stats.json"
+  else
+    # With a delay, the receiver starts late and the events go through
+    # the retention files of the sender.
+    configure sender "$tls" "$compression" "$queue_size"
+    configure receiver "$tls" "$compression" "$queue_size"
+    "$cbd" "$scenario_dir/sender.json" &
+    pids=$!
+    sleep "$delay"
+    "$cbd" "$scenario_dir/receiver.json" &
+    pids="$pids $!"
+    stats="$scenario_dir/bench-receiver-stats.json"
+  fi
+  wait_events "$stats" && receiver_stats "$stats" 0
+  local result=$?
+  kill $pids 2>/dev/null
+  wait $pids 2>/dev/null
+  return $result
+}
+
+status=0
+for s in $scenarios ; do
+  run_scenario "$s" || status=1
+done
+exit $status
@@ -35,7 +35,8 @@ namespace generator {
  *
  *  This is the base event transmitted by the generator module. It
  *  contains a monotonic incremental integer used to verify that the
- *  event order is not broken.
+ *  event order is not broken, and the time it was sent at, used to
+ *  measure the latency of the event chain.
  */
 class dummy : public io::data {
  public:
@@ -55,6 +56,8 @@ class dummy : public io::data {
   }
 
   uint32_t number;
+  // Seconds since the epoch, with microseconds.
+  double send_time;
 
   static mapping::entry const entries[];
   static io::event_info::event_operations const operations;
@@ -19,6 +19,7 @@
 #ifndef CCB_GENERATOR_ENDPOINT_HH
 #define CCB_GENERATOR_ENDPOINT_HH
 
+#include "com/centreon/broker/generator/sender.hh"
 #include "com/centreon/broker/io/endpoint.hh"
 #include "com/centreon/broker/namespace.hh"
 
@@ -35,7 +36,8 @@ class endpoint : public io::endpoint {
  public:
   enum endpoint_type { type_receiver = 1, type_sender };
 
-  endpoint(endpoint_type type);
+  endpoint(endpoint_type type,
+           sender::settings const& settings = sender::settings());
   ~endpoint();
   std::shared_ptr<io::stream> open();
 
@@ -44,6 +46,7 @@ class endpoint : public io::endpoint {
   endpoint& operator=(endpoint const& other);
 
   endpoint_type _type;
+  sender::settings _settings;
 };
 }  // namespace generator
 
@@ -37,7 +37,7 @@ class factory : public io::factory {
   factory(factory const& other) = delete;
   ~factory() = default;
   factory& operator=(factory const& other) = delete;
-  bool has_endpoint(config::endpoint& cfg);
+  bool has_endpoint(config::endpoint& cfg, flag* flag);
   io::endpoint* new_endpoint(config::endpoint& cfg,
                              bool& is_acceptor,
                              std::shared_ptr<persistent_cache> cache =
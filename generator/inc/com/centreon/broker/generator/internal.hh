@@ -19,6 +19,8 @@
 #ifndef CCB_GENERATOR_INTERNAL_HH
 #define CCB_GENERATOR_INTERNAL_HH
 
+#include "com/centreon/broker/namespace.hh"
+
 CCB_BEGIN()
 
 namespace generator {
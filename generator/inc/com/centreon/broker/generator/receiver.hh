@@ -19,8 +19,11 @@
 #ifndef CCB_GENERATOR_RECEIVER_HH
 #define CCB_GENERATOR_RECEIVER_HH
 
+#include <chrono>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 #include "com/centreon/broker/io/stream.hh"
 #include "com/centreon/broker/namespace.hh"
 
@@ -31,20 +34,35 @@ namespace generator {
  *  @class receiver receiver.hh "com/centreon/broker/generator/receiver.hh"
  *  @brief Receive generated events.
  *
- *  Receive and control events generated by senders.
+ *  Receive and control events generated by senders. The receiver counts
+ *  events by type and measures the latency of dummy events, it reports
+ *  the throughput and the latency percentiles in its statistics.
  */
 class receiver : public io::stream {
  public:
   receiver();
   ~receiver();
   bool read(std::shared_ptr<io::data>& d, time_t deadline);
+  void statistics(json11::Json::object& tree) const;
   int write(std::shared_ptr<io::data> const& d);
 
  private:
+  // Latency buckets per doubling of the latency in microseconds.
+  static uint32_t const buckets_per_power = 8;
+
   receiver(receiver const& other);
   receiver& operator=(receiver const& other);
+  double _percentile(double p) const;
 
+  mutable std::mutex _mutex;
   std::unordered_map<uint32_t, uint32_t> _last_numbers;
+  std::unordered_map<uint32_t, uint64_t> _events_by_type;
+  uint64_t _events;
+  std::chrono::steady_clock::time_point _first;
+  std::chrono::steady_clock::time_point _last;
+  std::vector<uint64_t> _latencies;
+  uint64_t _latency_count;
+  double _latency_max;
 };
 }  // namespace generator
 
@@ -19,6 +19,10 @@
 #ifndef CCB_GENERATOR_SENDER_HH
 #define CCB_GENERATOR_SENDER_HH
 
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
 #include "com/centreon/broker/io/stream.hh"
 #include "com/centreon/broker/namespace.hh"
 
@@ -29,11 +33,35 @@ namespace generator {
  *  @class sender sender.hh "com/centreon/broker/generator/sender.hh"
  *  @brief Generate events.
  *
- *  Generate events.
+ *  Generate a mix of events at a target rate. Each kind of event has a
+ *  weight in the mix, events are interleaved in proportion to their
+ *  weight. Dummy events carry their sending time and are used by the
+ *  receiver to measure latency.
  */
 class sender : public io::stream {
  public:
-  sender();
+  enum event_kind {
+    kind_dummy = 0,
+    kind_service_status,
+    kind_host_status,
+    kind_log_entry,
+    kind_perfdata
+  };
+
+  struct settings {
+    // Events per second, 0 for no limit.
+    uint32_t rate;
+    // Number of events to send, 0 for no limit.
+    uint64_t count;
+    uint32_t hosts;
+    uint32_t services_per_host;
+    std::vector<std::pair<event_kind, uint32_t>> mix;
+
+    settings();
+    static settings parse(std::map<std::string, std::string> const& params);
+  };
+
+  sender(settings const& s = settings());
   ~sender();
   bool read(std::shared_ptr<io::data>& d, time_t deadline);
   int write(std::shared_ptr<io::data> const& d);
@@ -41,8 +69,15 @@ class sender : public io::stream {
  private:
   sender(sender const& other);
   sender& operator=(sender const& other);
+  void _throttle();
 
+  settings _settings;
+  std::vector<event_kind> _schedule;
   uint32_t _number;
+  uint64_t _sent;
+  uint64_t _next_service;
+  uint64_t _next_host;
+  std::chrono::steady_clock::time_point _start;
 };
 }  // namespace generator
 
@@ -28,14 +28,16 @@ using namespace com::centreon::broker::generator;
  *
  *  @param[in] n  Number value.
  */
-dummy::dummy(uint32_t n) : io::data(dummy::static_type()), number(n) {}
+dummy::dummy(uint32_t n)
+    : io::data(dummy::static_type()), number(n), send_time(0) {}
 
 /**
  *  Copy constructor.
  *
  *  @param[in] other  Object to copy.
  */
-dummy::dummy(dummy const& other) : io::data(other), number(other.number) {}
+dummy::dummy(dummy const& other)
+    : io::data(other), number(other.number), send_time(other.send_time) {}
 
 /**
  *  Destructor.
@@ -53,13 +55,15 @@ dummy& dummy::operator=(dummy const& other) {
   if (this != &other) {
     io::data::operator=(other);
     number = other.number;
+    send_time = other.send_time;
   }
   return *this;
 }
 
 // Mapping.
 mapping::entry const dummy::entries[] = {
-    mapping::entry(&dummy::number, "number"), mapping::entry()};
+    mapping::entry(&dummy::number, "number"),
+    mapping::entry(&dummy::send_time, "send_time"), mapping::entry()};
 
 // Operations.
 static io::data* new_dummy() {
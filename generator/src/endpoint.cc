@@ -26,10 +26,12 @@ using namespace com::centreon::broker::generator;
 /**
  *  Constructor.
  *
- *  @param[in] type  Kind of stream to create in open().
+ *  @param[in] type      Kind of stream to create in open().
+ *  @param[in] settings  Settings of the senders.
  */
-endpoint::endpoint(endpoint::endpoint_type type)
-    : io::endpoint(false), _type(type) {}
+endpoint::endpoint(endpoint::endpoint_type type,
+                   sender::settings const& settings)
+    : io::endpoint(false), _type(type), _settings(settings) {}
 
 /**
  *  Destructor.
@@ -46,6 +48,6 @@ std::shared_ptr<io::stream> endpoint::open() {
   if (_type == type_receiver)
     s = std::make_shared<receiver>();
   else if (_type == type_sender)
-    s = std::make_shared<sender>();
+    s = std::make_shared<sender>(_settings);
   return (s);
 }
@@ -33,11 +33,14 @@ using namespace com::centreon::broker::generator;
 /**
  *  Check if a configuration match the generator streams.
  *
- *  @param[in] cfg  Endpoint configuration.
+ *  @param[in]  cfg   Endpoint configuration.
+ *  @param[out] flag  Set to no, generator streams are not negotiated.
  *
  *  @return True if configuration matches any of the generator streams.
  */
-bool factory::has_endpoint(config::endpoint& cfg) {
+bool factory::has_endpoint(config::endpoint& cfg, flag* flag) {
+  if (flag)
+    *flag = no;
   return ((cfg.type == "generator_receiver") ||
           (cfg.type == "generator_sender"));
 }
@@ -58,11 +61,12 @@ io::endpoint* factory::new_endpoint(
   (void)cache;
 
   // Generate opener.
-  std::auto_ptr<io::endpoint> s;
+  std::unique_ptr<io::endpoint> s;
   if (cfg.type == "generator_receiver")
     s.reset(new endpoint(endpoint::type_receiver));
   else if (cfg.type == "generator_sender")
-    s.reset(new endpoint(endpoint::type_sender));
+    s.reset(new endpoint(endpoint::type_sender,
+                         sender::settings::parse(cfg.params)));
   is_acceptor = false;
   return (s.release());
 }
@@ -83,9 +83,8 @@ void broker_module_init(void const* arg) {
     }
 
     // Register bam events.
-    e.register_event(io::events::generator, generator::de_dummy,
-                     io::event_info("dummy", &generator::dummy::operations,
-                                    generator::dummy::entries));
+    e.register_event(io::events::generator, generator::de_dummy, "dummy",
+                     &generator::dummy::operations, generator::dummy::entries);
   }
   return;
 }
@@ -17,6 +17,9 @@
 */
 
 #include "com/centreon/broker/generator/receiver.hh"
+#include <algorithm>
+#include <cmath>
+#include <fmt/format.h>
 #include "com/centreon/broker/exceptions/msg.hh"
 #include "com/centreon/broker/exceptions/shutdown.hh"
 #include "com/centreon/broker/generator/dummy.hh"
@@ -27,7 +30,9 @@ using namespace com::centreon::broker::generator;
 /**
  *  Constructor.
  */
-receiver::receiver() {}
+receiver::receiver()
+    : io::stream("generator_receiver"),
+      _events(0), _latency_count(0), _latency_max(0) {}
 
 /**
  *  Destructor.
@@ -50,6 +55,54 @@ bool receiver::read(std::shared_ptr<io::data>& d, time_t deadline) {
   return (true);
 }
 
+/**
+ *  Get the upper bound of the latency bucket containing a percentile.
+ *
+ *  @param[in] p  Percentile, between 0 and 1.
+ *
+ *  @return Latency in seconds.
+ */
+double receiver::_percentile(double p) const {
+  uint64_t rank(static_cast<uint64_t>(std::ceil(p * _latency_count)));
+  if (!rank)
+    rank = 1;
+  uint64_t seen(0);
+  for (size_t i = 0; i < _latencies.size(); ++i) {
+    seen += _latencies[i];
+    if (seen >= rank)
+      return std::min(
+          std::exp2(static_cast<double>(i + 1) / buckets_per_power) / 1000000,
+          _latency_max);
+  }
+  return _latency_max;
+}
+
+/**
+ *  Get the receiver statistics: events received, throughput and latency
+ *  percentiles of dummy events.
+ *
+ *  @param[out] tree  Output tree.
+ */
+void receiver::statistics(json11::Json::object& tree) const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  tree["events"] = static_cast<double>(_events);
+  double elapsed(std::chrono::duration<double>(_last - _first).count());
+  if (_events > 1 && elapsed > 0)
+    tree["events_per_second"] = (_events - 1) / elapsed;
+  json11::Json::object types;
+  for (std::pair<uint32_t const, uint64_t> const& p : _events_by_type)
+    types[fmt::format("{}:{}", io::events::category_of_type(p.first),
+                      io::events::element_of_type(p.first))] =
+        static_cast<double>(p.second);
+  tree["events_by_type"] = types;
+  if (_latency_count) {
+    tree["latency_p50"] = _percentile(0.5);
+    tree["latency_p90"] = _percentile(0.9);
+    tree["latency_p99"] = _percentile(0.99);
+    tree["latency_max"] = _latency_max;
+  }
+}
+
 /**
  *  Receive a new event.
  *
@@ -58,7 +111,16 @@ bool receiver::read(std::shared_ptr<io::data>& d, time_t deadline) {
  *  @return 1.
  */
 int receiver::write(std::shared_ptr<io::data> const& d) {
-  if (d && (d->type() == dummy::static_type())) {
+  if (!d)
+    return 1;
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  _last = std::chrono::steady_clock::now();
+  if (!_events++)
+    _first = _last;
+  ++_events_by_type[d->type()];
+
+  if (d->type() == dummy::static_type()) {
     dummy const& e(*(static_cast<dummy*>(d.get())));
 
     // Find last number of the Broker instance.
@@ -77,6 +139,27 @@ int receiver::write(std::shared_ptr<io::data> const& d) {
             << e.source_id << ": got " << e.number << ", expected "
             << it->second);
     it->second = e.number;
+
+    // Latency.
+    if (e.send_time > 0) {
+      double latency(
+          std::chrono::duration<double>(
+              std::chrono::system_clock::now().time_since_epoch())
+              .count() -
+          e.send_time);
+      if (latency < 0)
+        latency = 0;
+      double us(latency * 1000000);
+      size_t bucket(us < 1 ? 0
+                           : static_cast<size_t>(std::log2(us) *
+                                                 buckets_per_power));
+      if (bucket >= _latencies.size())
+        _latencies.resize(bucket + 1);
+      ++_latencies[bucket];
+      ++_latency_count;
+      if (latency > _latency_max)
+        _latency_max = latency;
+    }
   }
   return (1);
 }
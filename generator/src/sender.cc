@@ -17,17 +17,171 @@
 */
 
 #include "com/centreon/broker/generator/sender.hh"
+#include <cstdint>
+#include <fmt/format.h>
 #include <memory>
+#include <thread>
+#include "com/centreon/broker/exceptions/msg.hh"
 #include "com/centreon/broker/exceptions/shutdown.hh"
 #include "com/centreon/broker/generator/dummy.hh"
+#include "com/centreon/broker/misc/string.hh"
+#include "com/centreon/broker/neb/host_status.hh"
+#include "com/centreon/broker/neb/log_entry.hh"
+#include "com/centreon/broker/neb/service_status.hh"
 
 using namespace com::centreon::broker;
 using namespace com::centreon::broker::generator;
 
+/**
+ *  Default settings: dummy events only, as fast as possible.
+ */
+sender::settings::settings()
+    : rate(0),
+      count(0),
+      hosts(100),
+      services_per_host(10),
+      mix{{kind_dummy, 1}} {}
+
+// The sender builds the whole schedule of the mix.
+static uint32_t const max_mix_weight(1000000);
+
+/**
+ *  Parse a numeric parameter.
+ *
+ *  @param[in] name   Parameter name.
+ *  @param[in] value  Parameter value.
+ *  @param[in] max    Greatest accepted value.
+ *
+ *  @return The number.
+ */
+static uint64_t parse_number(std::string const& name,
+                             std::string const& value,
+                             uint64_t max) {
+  uint64_t retval;
+  try {
+    // stoull() accepts negative numbers and wraps them.
+    if (value.find('-') != std::string::npos)
+      throw std::invalid_argument(value);
+    retval = std::stoull(value);
+  } catch (std::exception const& e) {
+    throw exceptions::msg() << "generator: " << name << " must be a number";
+  }
+  if (retval > max)
+    throw exceptions::msg() << "generator: " << name
+                            << " cannot be greater than " << max;
+  return retval;
+}
+
+/**
+ *  Build settings from the parameters of an endpoint configuration.
+ *
+ *  Known parameters are rate, count, hosts, services_per_host and mix.
+ *  The mix is a comma separated list of kind:weight, where kind is one
+ *  of dummy, service_status, host_status, log_entry or perfdata.
+ *
+ *  @param[in] params  Endpoint parameters.
+ *
+ *  @return The settings.
+ */
+sender::settings sender::settings::parse(
+    std::map<std::string, std::string> const& params) {
+  settings retval;
+  std::map<std::string, std::string>::const_iterator it;
+  if ((it = params.find("rate")) != params.end())
+    retval.rate = parse_number(it->first, it->second, UINT32_MAX);
+  if ((it = params.find("count")) != params.end())
+    retval.count = parse_number(it->first, it->second, UINT64_MAX);
+  if ((it = params.find("hosts")) != params.end())
+    retval.hosts = parse_number(it->first, it->second, UINT32_MAX);
+  if ((it = params.find("services_per_host")) != params.end())
+    retval.services_per_host =
+        parse_number(it->first, it->second, UINT32_MAX);
+  if (!retval.hosts || !retval.services_per_host)
+    throw exceptions::msg()
+        << "generator: hosts and services_per_host cannot be 0";
+
+  if ((it = params.find("mix")) != params.end()) {
+    static std::map<std::string, event_kind> const kinds{
+        {"dummy", kind_dummy},
+        {"service_status", kind_service_status},
+        {"host_status", kind_host_status},
+        {"log_entry", kind_log_entry},
+        {"perfdata", kind_perfdata}};
+    retval.mix.clear();
+    uint64_t total(0);
+    for (std::string item : misc::string::split(it->second, ',')) {
+      misc::string::trim(item);
+      if (item.empty())
+        continue;
+      size_t pos(item.find(':'));
+      std::string name(item.substr(0, pos));
+      misc::string::trim(name);
+      std::map<std::string, event_kind>::const_iterator k(kinds.find(name));
+      if (k == kinds.end())
+        throw exceptions::msg()
+            << "generator: unknown event kind '" << name << "' in mix";
+      uint32_t weight(1);
+      if (pos != std::string::npos)
+        weight = parse_number(fmt::format("the weight of '{}' in mix", name),
+                              item.substr(pos + 1), max_mix_weight);
+      if (weight) {
+        retval.mix.emplace_back(k->second, weight);
+        total += weight;
+      }
+    }
+    if (retval.mix.empty())
+      throw exceptions::msg() << "generator: the mix contains no event";
+    if (total > max_mix_weight)
+      throw exceptions::msg() << "generator: the weights of the mix cannot "
+                                 "sum to more than "
+                              << max_mix_weight;
+  }
+  return retval;
+}
+
 /**
  *  Constructor.
+ *
+ *  The order of the events is computed once with a smooth weighted round
+ *  robin, so that each kind is spread evenly in the generated flow.
+ *
+ *  @param[in] s  Generator settings.
  */
-sender::sender() : _number(0) {}
+sender::sender(settings const& s)
+    : io::stream("generator_sender"),
+      _settings(s),
+      _number(0),
+      _sent(0),
+      _next_service(0),
+      _next_host(0),
+      _start(std::chrono::steady_clock::now()) {
+  uint32_t g(0);
+  for (std::pair<event_kind, uint32_t> const& p : _settings.mix) {
+    uint32_t a(p.second), b(g);
+    while (b) {
+      uint32_t t(a % b);
+      a = b;
+      b = t;
+    }
+    g = a;
+  }
+  uint32_t total(0);
+  std::vector<int64_t> current(_settings.mix.size(), 0);
+  for (std::pair<event_kind, uint32_t>& p : _settings.mix) {
+    p.second /= g;
+    total += p.second;
+  }
+  for (uint32_t i = 0; i < total; ++i) {
+    size_t best(0);
+    for (size_t j = 0; j < current.size(); ++j) {
+      current[j] += _settings.mix[j].second;
+      if (current[j] > current[best])
+        best = j;
+    }
+    current[best] -= total;
+    _schedule.push_back(_settings.mix[best].first);
+  }
+}
 
 /**
  *  Destructor.
@@ -35,19 +189,117 @@ sender::sender() : _number(0) {}
 sender::~sender() {}
 
 /**
- *  Create a new dummy event.
+ *  Create a new event.
  *
- *  @param[out] d         Set to a new dummy event.
- *  @param[in]  deadline  Unused.
+ *  @param[out] d         Set to a new event, or to null if all the events
+ *                        were sent.
+ *  @param[in]  deadline  Used when no more event has to be sent.
  *
- *  @return True.
+ *  @return True if an event was generated.
  */
 bool sender::read(std::shared_ptr<io::data>& d, time_t deadline) {
-  (void)deadline;
-  d = std::make_shared<dummy>(dummy(++_number));
+  d.reset();
+  if (_settings.count && _sent >= _settings.count) {
+    if (deadline == (time_t)-1 || deadline > time(nullptr))
+      std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    return false;
+  }
+  _throttle();
+
+  event_kind kind(_schedule[_sent % _schedule.size()]);
+  ++_sent;
+  time_t now(time(nullptr));
+  uint64_t services(static_cast<uint64_t>(_settings.hosts) *
+                    _settings.services_per_host);
+  switch (kind) {
+    case kind_service_status:
+    case kind_perfdata: {
+      uint64_t k(_next_service++ % services);
+      std::shared_ptr<neb::service_status> ss(
+          std::make_shared<neb::service_status>());
+      ss->host_id = k / _settings.services_per_host + 1;
+      ss->service_id = k % _settings.services_per_host + 1;
+      ss->host_name = fmt::format("host_{}", ss->host_id);
+      ss->service_description = fmt::format("service_{}", ss->service_id);
+      ss->check_command = "check_generator";
+      ss->check_interval = 5;
+      ss->check_type = 0;
+      ss->current_check_attempt = 1;
+      ss->current_state = k % 4;
+      ss->state_type = 1;
+      ss->has_been_checked = true;
+      ss->active_checks_enabled = true;
+      ss->execution_time = 0.1;
+      ss->latency = 0.2;
+      ss->max_check_attempts = 3;
+      ss->last_check = now;
+      ss->last_update = now;
+      ss->next_check = now + 300;
+      ss->output = fmt::format("generated status {} of {}", _sent,
+                               ss->service_description);
+      if (kind == kind_perfdata)
+        ss->perf_data = fmt::format(
+            "time={}s;1;2;0;10 size={}B;;;0; load={}",
+            (_sent % 1000) / 100.0, _sent % 65536, _sent % 100);
+      d = ss;
+    } break;
+    case kind_host_status: {
+      std::shared_ptr<neb::host_status> hs(
+          std::make_shared<neb::host_status>());
+      hs->host_id = _next_host++ % _settings.hosts + 1;
+      hs->check_command = "check_generator_host";
+      hs->check_interval = 5;
+      hs->current_check_attempt = 1;
+      hs->current_state = 0;
+      hs->state_type = 1;
+      hs->has_been_checked = true;
+      hs->active_checks_enabled = true;
+      hs->max_check_attempts = 3;
+      hs->last_check = now;
+      hs->last_update = now;
+      hs->last_time_up = now;
+      hs->next_check = now + 300;
+      hs->output = fmt::format("generated host status {}", _sent);
+      d = hs;
+    } break;
+    case kind_log_entry: {
+      uint64_t k(_next_service++ % services);
+      std::shared_ptr<neb::log_entry> le(std::make_shared<neb::log_entry>());
+      le->c_time = now;
+      le->host_id = k / _settings.services_per_host + 1;
+      le->service_id = k % _settings.services_per_host + 1;
+      le->host_name = fmt::format("host_{}", le->host_id);
+      le->service_description = fmt::format("service_{}", le->service_id);
+      le->msg_type = 0;
+      le->status = k % 4;
+      le->retry = 1;
+      le->output = fmt::format("SERVICE ALERT: {};{};generated {}",
+                               le->host_name, le->service_description, _sent);
+      d = le;
+    } break;
+    default: {
+      std::shared_ptr<dummy> dm(std::make_shared<dummy>(++_number));
+      dm->send_time = std::chrono::duration<double>(
+                          std::chrono::system_clock::now().time_since_epoch())
+                          .count();
+      d = dm;
+    }
+  }
   return true;
 }
 
+/**
+ *  Wait until the next event can be sent at the configured rate.
+ */
+void sender::_throttle() {
+  if (!_settings.rate)
+    return;
+  std::chrono::steady_clock::time_point next(
+      _start + std::chrono::microseconds(_sent * 1000000 / _settings.rate));
+  if (next > std::chrono::steady_clock::now())
+    std::this_thread::sleep_until(next);
+}
+
 /**
  *  Throw an exception.
  *
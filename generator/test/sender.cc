@@ -0,0 +1,119 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#include "com/centreon/broker/generator/sender.hh"
+#include <gtest/gtest.h>
+#include "com/centreon/broker/exceptions/msg.hh"
+#include "com/centreon/broker/generator/dummy.hh"
+#include "com/centreon/broker/neb/host_status.hh"
+#include "com/centreon/broker/neb/log_entry.hh"
+#include "com/centreon/broker/neb/service_status.hh"
+
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::generator;
+
+TEST(GeneratorSender, ParseDefaults) {
+  sender::settings s(sender::settings::parse({}));
+  ASSERT_EQ(s.rate, 0u);
+  ASSERT_EQ(s.count, 0u);
+  ASSERT_EQ(s.hosts, 100u);
+  ASSERT_EQ(s.services_per_host, 10u);
+  ASSERT_EQ(s.mix.size(), 1u);
+  ASSERT_EQ(s.mix[0].first, sender::kind_dummy);
+}
+
+TEST(GeneratorSender, Parse) {
+  sender::settings s(sender::settings::parse(
+      {{"rate", "1000"},
+       {"count", "10000000000"},
+       {"hosts", "4294967295"},
+       {"services_per_host", "3"},
+       {"mix", " service_status:6, host_status ,log_entry:0,dummy:2 "}}));
+  ASSERT_EQ(s.rate, 1000u);
+  ASSERT_EQ(s.count, 10000000000ull);
+  ASSERT_EQ(s.hosts, 4294967295u);
+  ASSERT_EQ(s.services_per_host, 3u);
+  ASSERT_EQ(s.mix.size(), 3u);
+  ASSERT_EQ(s.mix[0].first, sender::kind_service_status);
+  ASSERT_EQ(s.mix[0].second, 6u);
+  ASSERT_EQ(s.mix[1].first, sender::kind_host_status);
+  ASSERT_EQ(s.mix[1].second, 1u);
+  ASSERT_EQ(s.mix[2].first, sender::kind_dummy);
+  ASSERT_EQ(s.mix[2].second, 2u);
+}
+
+TEST(GeneratorSender, ParseInvalid) {
+  std::map<std::string, std::string> const invalid[]{
+      {{"rate", "fast"}},
+      {{"rate", "4294967296"}},
+      {{"count", "-1"}},
+      {{"hosts", "-1"}},
+      {{"hosts", "4294967296"}},
+      {{"hosts", "0"}},
+      {{"services_per_host", "0"}},
+      {{"services_per_host", "10000000000"}},
+      {{"mix", "unknown:1"}},
+      {{"mix", "dummy:heavy"}},
+      {{"mix", "dummy:0"}},
+      {{"mix", ""}},
+      {{"mix", "dummy:1000001"}},
+      {{"mix", "dummy:600000,perfdata:400001"}}};
+  for (std::map<std::string, std::string> const& params : invalid)
+    ASSERT_THROW(sender::settings::parse(params), exceptions::msg)
+        << params.begin()->first << "=" << params.begin()->second;
+}
+
+TEST(GeneratorSender, WeightedRoundRobin) {
+  // Weights are reduced by their gcd and kinds are interleaved.
+  sender s(sender::settings::parse(
+      {{"mix", "service_status:30,host_status:10,log_entry:20"}}));
+  uint32_t const expected[]{
+      neb::service_status::static_type(), neb::log_entry::static_type(),
+      neb::service_status::static_type(), neb::host_status::static_type(),
+      neb::log_entry::static_type(),      neb::service_status::static_type()};
+  std::shared_ptr<io::data> d;
+  for (int round = 0; round < 3; ++round)
+    for (uint32_t type : expected) {
+      ASSERT_TRUE(s.read(d, -1));
+      ASSERT_EQ(d->type(), type);
+    }
+}
+
+TEST(GeneratorSender, Count) {
+  sender s(sender::settings::parse({{"count", "2"}}));
+  std::shared_ptr<io::data> d;
+  ASSERT_TRUE(s.read(d, -1));
+  ASSERT_EQ(d->type(), dummy::static_type());
+  ASSERT_TRUE(s.read(d, -1));
+  ASSERT_FALSE(s.read(d, 0));
+  ASSERT_FALSE(d);
+}
+
+TEST(GeneratorSender, ManyServices) {
+  // hosts * services_per_host does not fit in 32 bits.
+  sender s(sender::settings::parse({{"hosts", "65536"},
+                                    {"services_per_host", "65536"},
+                                    {"mix", "service_status"}}));
+  std::shared_ptr<io::data> d;
+  for (uint32_t i = 1; i <= 2; ++i) {
+    ASSERT_TRUE(s.read(d, -1));
+    neb::service_status const& ss(static_cast<neb::service_status&>(*d));
+    ASSERT_EQ(ss.host_id, 1u);
+    ASSERT_EQ(ss.service_id, i);
+  }
+}
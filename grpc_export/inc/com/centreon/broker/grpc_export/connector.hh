@@ -0,0 +1,59 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#ifndef CCB_GRPC_EXPORT_CONNECTOR_HH
+#define CCB_GRPC_EXPORT_CONNECTOR_HH
+
+#include <memory>
+#include <string>
+#include "com/centreon/broker/io/endpoint.hh"
+#include "com/centreon/broker/namespace.hh"
+
+CCB_BEGIN()
+
+namespace grpc_export {
+/**
+ *  @class connector connector.hh "com/centreon/broker/grpc_export/connector.hh"
+ *  @brief Connect to a gRPC event consumer.
+ */
+class connector : public io::endpoint {
+  std::string _host;
+  unsigned short _port;
+  uint32_t _batch_size;
+  uint32_t _max_pending_events;
+  uint32_t _ack_timeout;
+  uint32_t _connect_timeout;
+
+ public:
+  connector();
+  connector(connector const& other) = delete;
+  connector& operator=(connector const& other) = delete;
+  ~connector() noexcept {}
+  void connect_to(std::string const& host,
+                  unsigned short port,
+                  uint32_t batch_size,
+                  uint32_t max_pending_events,
+                  uint32_t ack_timeout,
+                  uint32_t connect_timeout);
+  std::shared_ptr<io::stream> open() override;
+};
+}  // namespace grpc_export
+
+CCB_END()
+
+#endif  // !CCB_GRPC_EXPORT_CONNECTOR_HH
@@ -0,0 +1,62 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#ifndef CCB_GRPC_EXPORT_SERIALIZER_HH
+#define CCB_GRPC_EXPORT_SERIALIZER_HH
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "grpc_export.pb.h"
+#include "com/centreon/broker/io/data.hh"
+#include "com/centreon/broker/mapping/entry.hh"
+#include "com/centreon/broker/namespace.hh"
+
+CCB_BEGIN()
+
+namespace grpc_export {
+/**
+ *  @class serializer serializer.hh
+ *  "com/centreon/broker/grpc_export/serializer.hh"
+ *  @brief Convert broker events to protobuf messages.
+ *
+ *  The message type of an event is built from its mapping, each mapped
+ *  property giving an optional field numbered after its position in the
+ *  mapping. Events are then written directly in the protobuf wire format,
+ *  without going through reflection.
+ */
+class serializer {
+  typedef std::vector<std::pair<mapping::entry const*, int> > layout;
+
+  std::unordered_map<uint32_t, layout> _layouts;
+
+  layout const* _get_layout(uint32_t type);
+
+ public:
+  serializer() = default;
+  ~serializer() noexcept = default;
+  serializer(serializer const&) = delete;
+  serializer& operator=(serializer const&) = delete;
+  bool describe(uint32_t type, EventType& out);
+  bool encode(io::data const& d, Event& out);
+};
+}  // namespace grpc_export
+
+CCB_END()
+
+#endif  // !CCB_GRPC_EXPORT_SERIALIZER_HH
@@ -0,0 +1,98 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#ifndef CCB_GRPC_EXPORT_STREAM_HH
+#define CCB_GRPC_EXPORT_STREAM_HH
+
+#include <grpcpp/grpcpp.h>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include "com/centreon/broker/grpc_export/serializer.hh"
+#include "com/centreon/broker/io/stream.hh"
+#include "com/centreon/broker/namespace.hh"
+#include "grpc_export.grpc.pb.h"
+
+CCB_BEGIN()
+
+namespace grpc_export {
+/**
+ *  @class stream stream.hh "com/centreon/broker/grpc_export/stream.hh"
+ *  @brief Export events to a gRPC consumer.
+ *
+ *  Events are sent by batches on a single Export call. The consumer
+ *  acknowledges the batches it processed, the events of a batch are only
+ *  acknowledged to the multiplexing engine at this time, so that the
+ *  retention of the endpoint keeps everything the consumer did not get.
+ *  When more than max_pending_events are waiting for their
+ *  acknowledgement, writing blocks for at most ack_timeout seconds.
+ */
+class stream : public io::stream {
+  uint32_t _batch_size;
+  uint32_t _max_pending_events;
+  uint32_t _ack_timeout;
+
+  std::unique_ptr<EventExport::Stub> _stub;
+  grpc::ClientContext _context;
+  std::unique_ptr<grpc::ClientReaderWriter<EventBatch, Ack> > _rw;
+  std::thread _ack_thread;
+  bool _finished;
+
+  serializer _serializer;
+  std::unordered_set<uint32_t> _described;
+  EventBatch _batch;
+  uint64_t _last_batch_id;
+
+  // Shared with the acknowledgement thread.
+  mutable std::mutex _ack_m;
+  std::condition_variable _ack_cv;
+  std::deque<std::pair<uint64_t, uint32_t> > _in_flight;
+  uint32_t _pending;
+  int _acknowledged;
+  bool _broken;
+  std::string _error;
+  uint64_t _batches_sent;
+  uint64_t _events_sent;
+
+  void _read_acks();
+  void _send_batch();
+  void _check_broken();
+  int _pop_acknowledged();
+
+ public:
+  stream(std::shared_ptr<grpc::Channel> const& channel,
+         uint32_t batch_size,
+         uint32_t max_pending_events,
+         uint32_t ack_timeout);
+  ~stream();
+  stream(stream const&) = delete;
+  stream& operator=(stream const&) = delete;
+  int flush() override;
+  bool read(std::shared_ptr<io::data>& d, time_t deadline) override;
+  void statistics(json11::Json::object& tree) const override;
+  int write(std::shared_ptr<io::data> const& d) override;
+};
+}  // namespace grpc_export
+
+CCB_END()
+
+#endif  // !CCB_GRPC_EXPORT_STREAM_HH
@@ -0,0 +1,85 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#include "com/centreon/broker/grpc_export/connector.hh"
+#include <chrono>
+#include "com/centreon/broker/exceptions/msg.hh"
+#include "com/centreon/broker/grpc_export/stream.hh"
+#include "com/centreon/broker/log_v2.hh"
+
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::grpc_export;
+
+/**************************************
+ *                                     *
+ *           Public Methods            *
+ *                                     *
+ **************************************/
+
+/**
+ *  Default constructor.
+ */
+connector::connector()
+    : io::endpoint(false),
+      _port(0),
+      _batch_size(0),
+      _max_pending_events(0),
+      _ack_timeout(0),
+      _connect_timeout(0) {}
+
+/**
+ *  Set connection parameters.
+ *
+ *  @param[in] host                Host of the consumer.
+ *  @param[in] port                Port of the consumer.
+ *  @param[in] batch_size          Maximum number of events per batch.
+ *  @param[in] max_pending_events  Number of unacknowledged events above
+ *                                 which writing blocks.
+ *  @param[in] ack_timeout         Time in seconds writing may block.
+ *  @param[in] connect_timeout     Time in seconds connecting may take.
+ */
+void connector::connect_to(std::string const& host,
+                           unsigned short port,
+                           uint32_t batch_size,
+                           uint32_t max_pending_events,
+                           uint32_t ack_timeout,
+                           uint32_t connect_timeout) {
+  _host = host;
+  _port = port;
+  _batch_size = batch_size;
+  _max_pending_events = max_pending_events;
+  _ack_timeout = ack_timeout;
+  _connect_timeout = connect_timeout;
+}
+
+/**
+ *  Connect to the consumer.
+ *
+ *  @return Export stream.
+ */
+std::shared_ptr<io::stream> connector::open() {
+  std::string address(_host + ':' + std::to_string(_port));
+  log_v2::core()->info("grpc_export: connecting to {}", address);
+  std::shared_ptr<grpc::Channel> channel(
+      grpc::CreateChannel(address, grpc::InsecureChannelCredentials()));
+  if (!channel->WaitForConnected(std::chrono::system_clock::now() +
+                                 std::chrono::seconds(_connect_timeout)))
+    throw exceptions::msg() << "grpc_export: cannot connect to " << address;
+  return std::make_shared<stream>(channel, _batch_size, _max_pending_events,
+                                  _ack_timeout);
+}
@@ -0,0 +1,131 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#include "com/centreon/broker/grpc_export/factory.hh"
+#include <cstring>
+#include <memory>
+#include "com/centreon/broker/config/parser.hh"
+#include "com/centreon/broker/exceptions/msg.hh"
+#include "com/centreon/broker/grpc_export/connector.hh"
+
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::grpc_export;
+
+/**************************************
+ *                                     *
+ *           Static Objects            *
+ *                                     *
+ **************************************/
+
+/**
+ *  Find a parameter in configuration.
+ *
+ *  @param[in] cfg Configuration object.
+ *  @param[in] key Property to get.
+ *
+ *  @return Property value.
+ */
+static std::string find_param(config::endpoint const& cfg,
+                              std::string const& key) {
+  std::map<std::string, std::string>::const_iterator it{cfg.params.find(key)};
+  if (cfg.params.end() == it)
+    throw exceptions::msg() << "grpc_export: no '" << key
+                            << "' defined for endpoint '" << cfg.name << "'";
+  return it->second;
+}
+
+/**
+ *  Get a parameter in configuration, or return a default value.
+ *
+ *  @param[in] cfg Configuration object.
+ *  @param[in] key Property to get.
+ *  @param[in] def The default value if nothing found.
+ *
+ *  @return Property value.
+ */
+static uint32_t get_uint_param(config::endpoint const& cfg,
+                               std::string const& key,
+                               uint32_t def) {
+  std::map<std::string, std::string>::const_iterator it(cfg.params.find(key));
+  if (cfg.params.end() == it)
+    return def;
+  else {
+    try {
+      return std::stoul(it->second);
+    } catch (std::exception const& ex) {
+      throw exceptions::msg() << "grpc_export: '" << key
+                              << "' must be numeric for endpoint '"
+                              << cfg.name << "'";
+    }
+  }
+}
+
+/**************************************
+ *                                     *
+ *           Public Methods            *
+ *                                     *
+ **************************************/
+
+/**
+ *  Check if a configuration match the gRPC export layer.
+ *
+ *  @param[in] cfg  Endpoint configuration.
+ *
+ *  @return true if the configuration matches the gRPC export layer.
+ */
+bool factory::has_endpoint(config::endpoint& cfg, flag* flag) {
+  if (flag)
+    *flag = no;
+  return !strncasecmp(cfg.type.c_str(), "grpc_export", 12);
+}
+
+/**
+ *  Build a gRPC export endpoint from a configuration.
+ *
+ *  @param[in]  cfg         Endpoint configuration.
+ *  @param[out] is_acceptor Will be set to false.
+ *  @param[in]  cache       Unused.
+ *
+ *  @return Endpoint matching the given configuration.
+ */
+io::endpoint* factory::new_endpoint(
+    config::endpoint& cfg,
+    bool& is_acceptor,
+    std::shared_ptr<persistent_cache> cache) const {
+  (void)cache;
+  std::string host(find_param(cfg, "host"));
+  uint32_t port(get_uint_param(cfg, "port", 0));
+  if (!port || port > 65535)
+    throw exceptions::msg() << "grpc_export: no valid 'port' defined for "
+                            << "endpoint '" << cfg.name << "'";
+  uint32_t batch_size(get_uint_param(cfg, "batch_size", 1000));
+  uint32_t max_pending_events(
+      get_uint_param(cfg, "max_pending_events", 100000));
+  uint32_t ack_timeout(get_uint_param(cfg, "ack_timeout", 30));
+  uint32_t connect_timeout(get_uint_param(cfg, "connect_timeout", 10));
+  if (!connect_timeout)
+    throw exceptions::msg() << "grpc_export: 'connect_timeout' cannot be 0 "
+                            << "for endpoint '" << cfg.name << "'";
+
+  // Connector.
+  std::unique_ptr<grpc_export::connector> c(new grpc_export::connector);
+  c->connect_to(host, port, batch_size, max_pending_events, ack_timeout,
+                connect_timeout);
+  is_acceptor = false;
+  return c.release();
+}
@@ -0,0 +1,215 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#include "com/centreon/broker/grpc_export/serializer.hh"
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+#include <google/protobuf/wire_format_lite.h>
+#include <unordered_set>
+#include "com/centreon/broker/io/events.hh"
+
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::grpc_export;
+using google::protobuf::FieldDescriptorProto;
+using google::protobuf::internal::WireFormatLite;
+
+/**
+ *  Make a valid protobuf identifier of a broker name.
+ *
+ *  @param[in] name  Name of an event or of a property.
+ *
+ *  @return The identifier.
+ */
+static std::string identifier(std::string const& name) {
+  std::string retval(name);
+  for (char& c : retval)
+    if (!isalnum(static_cast<unsigned char>(c)))
+      c = '_';
+  if (retval.empty() || isdigit(static_cast<unsigned char>(retval[0])))
+    retval.insert(0, 1, '_');
+  return retval;
+}
+
+/**
+ *  Check if a number is valid for its mapping entry.
+ *
+ *  @param[in] e  Mapping entry.
+ *  @param[in] v  Value.
+ *
+ *  @return false if the entry declares this value as invalid.
+ */
+static bool is_valid(mapping::entry const& e, int64_t v) {
+  return !(((e.get_attribute() & mapping::entry::invalid_on_zero) && v == 0) ||
+           ((e.get_attribute() & mapping::entry::invalid_on_minus_one) &&
+            v == -1));
+}
+
+/**
+ *  Get the fields of a type, building them on first use.
+ *
+ *  @param[in] type  Event type.
+ *
+ *  @return The mapping entries of the type with their field numbers,
+ *          nullptr if the type has no mapping.
+ */
+serializer::layout const* serializer::_get_layout(uint32_t type) {
+  auto found(_layouts.find(type));
+  if (found != _layouts.end())
+    return &found->second;
+
+  io::event_info const* info(io::events::instance().get_event_info(type));
+  if (!info || !info->get_mapping())
+    return nullptr;
+
+  layout& l(_layouts[type]);
+  std::unordered_set<std::string> names;
+  int number(0);
+  for (mapping::entry const* e(info->get_mapping()); !e->is_null(); ++e) {
+    ++number;
+    char const* name(e->get_name_v2());
+    if (!name || !name[0] || !names.insert(name).second)
+      continue;
+    switch (e->get_type()) {
+      case mapping::source::BOOL:
+      case mapping::source::DOUBLE:
+      case mapping::source::INT:
+      case mapping::source::SHORT:
+      case mapping::source::STRING:
+      case mapping::source::TIME:
+      case mapping::source::UINT:
+      case mapping::source::USHORT:
+        l.emplace_back(e, number);
+        break;
+      default:;
+    }
+  }
+  return &l;
+}
+
+/**
+ *  Build the message type of an event type.
+ *
+ *  @param[in]  type  Event type.
+ *  @param[out] out   Message type.
+ *
+ *  @return false if the type has no mapping and cannot be exported.
+ */
+bool serializer::describe(uint32_t type, EventType& out) {
+  layout const* l(_get_layout(type));
+  if (!l)
+    return false;
+
+  out.set_type(type);
+  google::protobuf::DescriptorProto* desc(out.mutable_message_type());
+  desc->set_name(
+      identifier(io::events::instance().get_event_info(type)->get_name()));
+  for (auto const& p : *l) {
+    FieldDescriptorProto* f(desc->add_field());
+    f->set_name(identifier(p.first->get_name_v2()));
+    f->set_number(p.second);
+    f->set_label(FieldDescriptorProto::LABEL_OPTIONAL);
+    switch (p.first->get_type()) {
+      case mapping::source::BOOL:
+        f->set_type(FieldDescriptorProto::TYPE_BOOL);
+        break;
+      case mapping::source::DOUBLE:
+        f->set_type(FieldDescriptorProto::TYPE_DOUBLE);
+        break;
+      case mapping::source::INT:
+      case mapping::source::SHORT:
+        f->set_type(FieldDescriptorProto::TYPE_SINT32);
+        break;
+      case mapping::source::STRING:
+        f->set_type(FieldDescriptorProto::TYPE_STRING);
+        break;
+      case mapping::source::TIME:
+        f->set_type(FieldDescriptorProto::TYPE_INT64);
+        break;
+      default:
+        f->set_type(FieldDescriptorProto::TYPE_UINT32);
+    }
+  }
+  return true;
+}
+
+/**
+ *  Encode an event. Properties holding a value declared invalid by the
+ *  mapping are not written, so that the consumer sees them as unset.
+ *
+ *  @param[in]  d    Event.
+ *  @param[out] out  Encoded event.
+ *
+ *  @return false if the type has no mapping and cannot be exported.
+ */
+bool serializer::encode(io::data const& d, Event& out) {
+  layout const* l(_get_layout(d.type()));
+  if (!l)
+    return false;
+
+  out.set_type(d.type());
+  out.set_source_id(d.source_id);
+  out.set_destination_id(d.destination_id);
+  std::string* payload(out.mutable_payload());
+  payload->clear();
+  google::protobuf::io::StringOutputStream sos(payload);
+  google::protobuf::io::CodedOutputStream cos(&sos);
+  for (auto const& p : *l) {
+    mapping::entry const& e(*p.first);
+    int number(p.second);
+    switch (e.get_type()) {
+      case mapping::source::BOOL:
+        WireFormatLite::WriteBool(number, e.get_bool(d), &cos);
+        break;
+      case mapping::source::DOUBLE:
+        WireFormatLite::WriteDouble(number, e.get_double(d), &cos);
+        break;
+      case mapping::source::INT: {
+        int v(e.get_int(d));
+        if (is_valid(e, v))
+          WireFormatLite::WriteSInt32(number, v, &cos);
+      } break;
+      case mapping::source::SHORT: {
+        short v(e.get_short(d));
+        if (is_valid(e, v))
+          WireFormatLite::WriteSInt32(number, v, &cos);
+      } break;
+      case mapping::source::STRING: {
+        std::string const& v(e.get_string(d));
+        if (!v.empty() ||
+            !(e.get_attribute() & mapping::entry::invalid_on_zero))
+          WireFormatLite::WriteString(number, v, &cos);
+      } break;
+      case mapping::source::TIME: {
+        time_t v(e.get_time(d));
+        if (is_valid(e, v))
+          WireFormatLite::WriteInt64(number, v, &cos);
+      } break;
+      case mapping::source::UINT: {
+        uint32_t v(e.get_uint(d));
+        if (is_valid(e, v))
+          WireFormatLite::WriteUInt32(number, v, &cos);
+      } break;
+      case mapping::source::USHORT: {
+        unsigned short v(e.get_ushort(d));
+        if (is_valid(e, v))
+          WireFormatLite::WriteUInt32(number, v, &cos);
+      } break;
+    }
+  }
+  return true;
+}
@@ -0,0 +1,233 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#include "com/centreon/broker/grpc_export/stream.hh"
+#include "com/centreon/broker/exceptions/msg.hh"
+#include "com/centreon/broker/exceptions/shutdown.hh"
+#include "com/centreon/broker/log_v2.hh"
+
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::grpc_export;
+
+/**
+ *  Constructor. The Export call is started at once.
+ *
+ *  @param[in] channel             Channel to the consumer.
+ *  @param[in] batch_size          Maximum number of events per batch.
+ *  @param[in] max_pending_events  Number of unacknowledged events above
+ *                                 which writing blocks.
+ *  @param[in] ack_timeout         Time in seconds writing may block.
+ */
+stream::stream(std::shared_ptr<grpc::Channel> const& channel,
+               uint32_t batch_size,
+               uint32_t max_pending_events,
+               uint32_t ack_timeout)
+    : io::stream("grpc_export"),
+      _batch_size{batch_size ? batch_size : 1},
+      _max_pending_events{max_pending_events},
+      _ack_timeout{ack_timeout},
+      _stub{EventExport::NewStub(channel)},
+      _finished{false},
+      _last_batch_id{0},
+      _pending{0},
+      _acknowledged{0},
+      _broken{false},
+      _batches_sent{0},
+      _events_sent{0} {
+  _rw = _stub->Export(&_context);
+  _ack_thread = std::thread(&stream::_read_acks, this);
+}
+
+/**
+ *  Destructor. Events not acknowledged yet are kept in the retention of
+ *  the endpoint, so the call is just cancelled.
+ */
+stream::~stream() {
+  if (!_finished) {
+    _context.TryCancel();
+    _ack_thread.join();
+    _rw->Finish();
+  }
+}
+
+/**
+ *  Send the current batch.
+ *
+ *  @return Number of events acknowledged since the last call.
+ */
+int stream::flush() {
+  _check_broken();
+  _send_batch();
+  return _pop_acknowledged();
+}
+
+/**
+ *  Read from the consumer.
+ *
+ *  @param[out] d         Cleared.
+ *  @param[in]  deadline  Timeout.
+ *
+ *  @return This method will throw.
+ */
+bool stream::read(std::shared_ptr<io::data>& d, time_t deadline) {
+  (void)deadline;
+  d.reset();
+  throw exceptions::shutdown() << "cannot read from a gRPC export stream";
+  return true;
+}
+
+/**
+ *  Get endpoint statistics.
+ *
+ *  @param[out] tree Output tree.
+ */
+void stream::statistics(json11::Json::object& tree) const {
+  std::lock_guard<std::mutex> lock(_ack_m);
+  tree["batches_sent"] = static_cast<double>(_batches_sent);
+  tree["events_sent"] = static_cast<double>(_events_sent);
+  tree["events_pending"] = static_cast<double>(_pending);
+  if (_broken)
+    tree["status"] = _error;
+}
+
+/**
+ *  Add an event to the current batch, the batch is sent once full.
+ *
+ *  @param[in] d  Event.
+ *
+ *  @return Number of events acknowledged since the last call.
+ */
+int stream::write(std::shared_ptr<io::data> const& d) {
+  if (!validate(d, get_name()))
+    return 0;
+  _check_broken();
+
+  // The type of the event is sent with its first occurrence.
+  if (_described.insert(d->type()).second) {
+    EventType t;
+    if (_serializer.describe(d->type(), t))
+      _batch.add_types()->Swap(&t);
+  }
+
+  // Events without mapping are not sent but still counted in the batch, so
+  // that they are acknowledged in order with the others.
+  if (!_serializer.encode(*d, *_batch.add_events()))
+    _batch.mutable_events()->RemoveLast();
+  _batch.set_size(_batch.size() + 1);
+
+  if (_batch.size() >= _batch_size)
+    _send_batch();
+  return _pop_acknowledged();
+}
+
+/**
+ *  Read the acknowledgements of the consumer until the call ends.
+ */
+void stream::_read_acks() {
+  Ack ack;
+  while (_rw->Read(&ack)) {
+    std::lock_guard<std::mutex> lock(_ack_m);
+    while (!_in_flight.empty() &&
+           _in_flight.front().first <= ack.batch_id()) {
+      _acknowledged += _in_flight.front().second;
+      _pending -= _in_flight.front().second;
+      _in_flight.pop_front();
+    }
+    _ack_cv.notify_all();
+  }
+  std::lock_guard<std::mutex> lock(_ack_m);
+  _broken = true;
+  _error = "export call closed";
+  _ack_cv.notify_all();
+}
+
+/**
+ *  Send the current batch, waiting for acknowledgements if too many events
+ *  are pending.
+ */
+void stream::_send_batch() {
+  uint32_t count(_batch.size());
+  if (!count)
+    return;
+
+  {
+    std::unique_lock<std::mutex> lock(_ack_m);
+    if (!_ack_cv.wait_for(lock, std::chrono::seconds(_ack_timeout),
+                          [this, count] {
+                            return _broken || !_pending ||
+                                   _pending + count <= _max_pending_events;
+                          }))
+      throw exceptions::msg()
+          << "grpc_export: no acknowledgement from the consumer in "
+          << _ack_timeout << "s with " << _pending << " events pending";
+    if (!_broken) {
+      _batch.set_id(++_last_batch_id);
+      _in_flight.emplace_back(_last_batch_id, count);
+      _pending += count;
+    }
+  }
+  _check_broken();
+
+  if (!_rw->Write(_batch)) {
+    _check_broken();
+    throw exceptions::msg() << "grpc_export: cannot send batch "
+                            << _batch.id() << " to the consumer";
+  }
+  log_v2::core()->trace("grpc_export: batch {} of {} events sent",
+                        _batch.id(), count);
+
+  {
+    std::lock_guard<std::mutex> lock(_ack_m);
+    ++_batches_sent;
+    _events_sent += count;
+  }
+  _batch.Clear();
+}
+
+/**
+ *  Throw the error of the call if it ended.
+ */
+void stream::_check_broken() {
+  {
+    std::lock_guard<std::mutex> lock(_ack_m);
+    if (!_broken)
+      return;
+  }
+  if (!_finished) {
+    _ack_thread.join();
+    grpc::Status status(_rw->Finish());
+    _finished = true;
+    std::lock_guard<std::mutex> lock(_ack_m);
+    if (!status.ok())
+      _error = status.error_message();
+    log_v2::core()->error("grpc_export: export call ended: {}", _error);
+  }
+  throw exceptions::msg() << "grpc_export: " << _error;
+}
+
+/**
+ *  Get the events acknowledged since the last call.
+ *
+ *  @return Number of events.
+ */
+int stream::_pop_acknowledged() {
+  std::lock_guard<std::mutex> lock(_ack_m);
+  int retval(_acknowledged);
+  _acknowledged = 0;
+  return retval;
+}
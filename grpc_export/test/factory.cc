@@ -0,0 +1,61 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#include "com/centreon/broker/grpc_export/factory.hh"
+#include <gtest/gtest.h>
+#include "com/centreon/broker/exceptions/msg.hh"
+
+using namespace com::centreon::broker;
+
+TEST(GrpcExportFactory, HasEndpoint) {
+  grpc_export::factory fact;
+  config::endpoint cfg(config::endpoint::io_type::output);
+
+  cfg.type = "tcp";
+  ASSERT_FALSE(fact.has_endpoint(cfg, nullptr));
+  cfg.type = "grpc_export";
+  ASSERT_TRUE(fact.has_endpoint(cfg, nullptr));
+  ASSERT_FALSE(cfg.cache_enabled);
+}
+
+TEST(GrpcExportFactory, MissingParams) {
+  grpc_export::factory fact;
+  config::endpoint cfg(config::endpoint::io_type::output);
+  std::shared_ptr<persistent_cache> cache;
+  bool is_acceptor;
+
+  ASSERT_THROW(fact.new_endpoint(cfg, is_acceptor, cache), exceptions::msg);
+  cfg.params["host"] = "localhost";
+  ASSERT_THROW(fact.new_endpoint(cfg, is_acceptor, cache), exceptions::msg);
+  cfg.params["port"] = "4317";
+  ASSERT_NO_THROW(delete fact.new_endpoint(cfg, is_acceptor, cache));
+  ASSERT_FALSE(is_acceptor);
+  cfg.params["port"] = "toto";
+  ASSERT_THROW(fact.new_endpoint(cfg, is_acceptor, cache), exceptions::msg);
+  cfg.params["port"] = "4317";
+  cfg.params["batch_size"] = "toto";
+  ASSERT_THROW(fact.new_endpoint(cfg, is_acceptor, cache), exceptions::msg);
+  cfg.params["batch_size"] = "10";
+  cfg.params["max_pending_events"] = "100";
+  cfg.params["ack_timeout"] = "5";
+  ASSERT_NO_THROW(delete fact.new_endpoint(cfg, is_acceptor, cache));
+  cfg.params["connect_timeout"] = "0";
+  ASSERT_THROW(fact.new_endpoint(cfg, is_acceptor, cache), exceptions::msg);
+  cfg.params["connect_timeout"] = "2";
+  ASSERT_NO_THROW(delete fact.new_endpoint(cfg, is_acceptor, cache));
+}
@@ -0,0 +1,100 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#include "com/centreon/broker/grpc_export/serializer.hh"
+#include <google/protobuf/descriptor.h>
+#include <google/protobuf/dynamic_message.h>
+#include <gtest/gtest.h>
+#include "com/centreon/broker/config/applier/init.hh"
+#include "com/centreon/broker/instance_broadcast.hh"
+
+using namespace com::centreon::broker;
+namespace pb = google::protobuf;
+
+class GrpcExportSerializer : public testing::Test {
+ public:
+  void SetUp() override { config::applier::init(); }
+  void TearDown() override { config::applier::deinit(); }
+};
+
+TEST_F(GrpcExportSerializer, Describe) {
+  grpc_export::serializer s;
+  grpc_export::EventType t;
+
+  ASSERT_TRUE(s.describe(instance_broadcast::static_type(), t));
+  ASSERT_EQ(t.type(), instance_broadcast::static_type());
+  pb::DescriptorProto const& d(t.message_type());
+  ASSERT_EQ(d.name(), "instance_broadcast");
+  ASSERT_EQ(d.field_size(), 5);
+  ASSERT_EQ(d.field(0).name(), "broker_id");
+  ASSERT_EQ(d.field(0).number(), 1);
+  ASSERT_EQ(d.field(0).type(), pb::FieldDescriptorProto_Type_TYPE_UINT32);
+  ASSERT_EQ(d.field(1).type(), pb::FieldDescriptorProto_Type_TYPE_STRING);
+  ASSERT_EQ(d.field(2).type(), pb::FieldDescriptorProto_Type_TYPE_BOOL);
+  ASSERT_EQ(d.field(4).name(), "poller_name");
+  ASSERT_EQ(d.field(4).number(), 5);
+}
+
+TEST_F(GrpcExportSerializer, Unknown) {
+  grpc_export::serializer s;
+  grpc_export::EventType t;
+  grpc_export::Event e;
+  io::data d(0xffffffff);
+
+  ASSERT_FALSE(s.describe(d.type(), t));
+  ASSERT_FALSE(s.encode(d, e));
+}
+
+TEST_F(GrpcExportSerializer, Decode) {
+  grpc_export::serializer s;
+  grpc_export::EventType t;
+  grpc_export::Event e;
+  instance_broadcast ib;
+  ib.broker_id = 0;
+  ib.broker_name = "central-broker";
+  ib.enabled = true;
+  ib.poller_id = 42;
+  ib.poller_name = "central";
+  ib.source_id = 3;
+
+  ASSERT_TRUE(s.describe(ib.type(), t));
+  ASSERT_TRUE(s.encode(ib, e));
+  ASSERT_EQ(e.type(), ib.type());
+  ASSERT_EQ(e.source_id(), 3u);
+
+  // Decode the event as a consumer would, from the sent descriptor only.
+  pb::FileDescriptorProto file;
+  file.set_name("event.proto");
+  *file.add_message_type() = t.message_type();
+  pb::DescriptorPool pool;
+  pb::FileDescriptor const* fd(pool.BuildFile(file));
+  ASSERT_NE(fd, nullptr);
+  pb::Descriptor const* desc(fd->message_type(0));
+  pb::DynamicMessageFactory factory(&pool);
+  std::unique_ptr<pb::Message> msg(factory.GetPrototype(desc)->New());
+  ASSERT_TRUE(msg->ParseFromString(e.payload()));
+
+  pb::Reflection const* r(msg->GetReflection());
+  ASSERT_FALSE(r->HasField(*msg, desc->FindFieldByName("broker_id")));
+  ASSERT_EQ(r->GetString(*msg, desc->FindFieldByName("broker_name")),
+            "central-broker");
+  ASSERT_TRUE(r->GetBool(*msg, desc->FindFieldByName("enabled")));
+  ASSERT_EQ(r->GetUInt32(*msg, desc->FindFieldByName("poller_id")), 42u);
+  ASSERT_EQ(r->GetString(*msg, desc->FindFieldByName("poller_name")),
+            "central");
+}
@@ -0,0 +1,155 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#include "com/centreon/broker/grpc_export/stream.hh"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include "com/centreon/broker/config/applier/init.hh"
+#include "com/centreon/broker/exceptions/msg.hh"
+#include "com/centreon/broker/grpc_export/connector.hh"
+#include "com/centreon/broker/instance_broadcast.hh"
+
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::grpc_export;
+
+/**
+ *  Consumer acknowledging the batches it receives, unless told to stay
+ *  silent or to end the call after a number of batches.
+ */
+class consumer : public EventExport::Service {
+ public:
+  std::atomic<bool> ack;
+  std::atomic<uint32_t> close_after;
+  std::atomic<uint32_t> batches;
+  std::atomic<uint32_t> events;
+  std::atomic<uint32_t> types;
+
+  consumer() : ack(true), close_after(0), batches(0), events(0), types(0) {}
+
+  grpc::Status Export(
+      grpc::ServerContext* context,
+      grpc::ServerReaderWriter<Ack, EventBatch>* rw) override {
+    (void)context;
+    EventBatch batch;
+    while (rw->Read(&batch)) {
+      ++batches;
+      events += batch.size();
+      types += batch.types_size();
+      if (ack) {
+        Ack a;
+        a.set_batch_id(batch.id());
+        rw->Write(a);
+      }
+      if (close_after && batches >= close_after)
+        return grpc::Status(grpc::UNAVAILABLE, "consumer stopped");
+    }
+    return grpc::Status::OK;
+  }
+};
+
+class GrpcExportStream : public testing::Test {
+ public:
+  void SetUp() override {
+    config::applier::init();
+    grpc::ServerBuilder builder;
+    builder.AddListeningPort("127.0.0.1:0", grpc::InsecureServerCredentials(),
+                             &_port);
+    builder.RegisterService(&_consumer);
+    _server = builder.BuildAndStart();
+    _channel = grpc::CreateChannel("127.0.0.1:" + std::to_string(_port),
+                                   grpc::InsecureChannelCredentials());
+  }
+
+  void TearDown() override {
+    _server->Shutdown(std::chrono::system_clock::now());
+    config::applier::deinit();
+  }
+
+  /**
+   *  Flush the stream until count events are acknowledged.
+   */
+  static int wait_acks(stream& s, int count) {
+    int retval(0);
+    for (int i = 0; i < 100 && retval < count; ++i) {
+      retval += s.flush();
+      if (retval < count)
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    return retval;
+  }
+
+  consumer _consumer;
+  int _port;
+  std::unique_ptr<grpc::Server> _server;
+  std::shared_ptr<grpc::Channel> _channel;
+};
+
+TEST_F(GrpcExportStream, Read) {
+  stream s(_channel, 10, 100, 1);
+  std::shared_ptr<io::data> d;
+  ASSERT_THROW(s.read(d, -1), exceptions::msg);
+}
+
+TEST_F(GrpcExportStream, Acknowledged) {
+  stream s(_channel, 2, 100, 5);
+  int acked(0);
+  for (int i = 0; i < 5; ++i)
+    acked += s.write(std::make_shared<instance_broadcast>());
+  acked += wait_acks(s, 5 - acked);
+
+  ASSERT_EQ(acked, 5);
+  ASSERT_EQ(_consumer.batches, 3u);
+  ASSERT_EQ(_consumer.events, 5u);
+  ASSERT_EQ(_consumer.types, 1u);
+  json11::Json::object tree;
+  s.statistics(tree);
+  ASSERT_EQ(tree["events_sent"].number_value(), 5);
+  ASSERT_EQ(tree["events_pending"].number_value(), 0);
+}
+
+TEST_F(GrpcExportStream, NoAcknowledgement) {
+  _consumer.ack = false;
+  stream s(_channel, 1, 2, 1);
+  ASSERT_EQ(s.write(std::make_shared<instance_broadcast>()), 0);
+  ASSERT_EQ(s.write(std::make_shared<instance_broadcast>()), 0);
+  ASSERT_THROW(s.write(std::make_shared<instance_broadcast>()),
+               exceptions::msg);
+}
+
+TEST_F(GrpcExportStream, ConsumerStopped) {
+  _consumer.close_after = 1;
+  stream s(_channel, 1, 100, 1);
+  s.write(std::make_shared<instance_broadcast>());
+  ASSERT_THROW(
+      {
+        for (int i = 0; i < 100; ++i) {
+          s.write(std::make_shared<instance_broadcast>());
+          std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+      },
+      exceptions::msg);
+}
+
+TEST_F(GrpcExportStream, ConnectWithoutAckTimeout) {
+  connector c;
+  c.connect_to("127.0.0.1", _port, 1, 100, 0, 5);
+  std::shared_ptr<io::stream> s(c.open());
+  ASSERT_EQ(s->write(std::make_shared<instance_broadcast>()), 0);
+  ASSERT_EQ(wait_acks(static_cast<stream&>(*s), 1), 1);
+}
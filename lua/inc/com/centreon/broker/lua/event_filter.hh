@@ -0,0 +1,99 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#ifndef CCB_LUA_EVENT_FILTER_HH
+#define CCB_LUA_EVENT_FILTER_HH
+
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include "com/centreon/broker/io/data.hh"
+#include "com/centreon/broker/mapping/entry.hh"
+#include "com/centreon/broker/namespace.hh"
+
+extern "C" {
+#include "lauxlib.h"
+#include "lua.h"
+#include "lualib.h"
+}
+
+CCB_BEGIN()
+
+namespace lua {
+/**
+ *  @class event_filter event_filter.hh
+ * "com/centreon/broker/lua/event_filter.hh"
+ *  @brief Filter applied to events before they enter the Lua interpreter.
+ *
+ *  The script declares it once, usually from its init() function, with
+ *  broker.set_filter(). Its argument is a table with the optional fields:
+ *  * categories: an array of categories, such as { 1, 3 }.
+ *  * elements: an array of { category, element } pairs.
+ *  * hosts: an array of host IDs.
+ *  * services: an array of { host_id, service_id } pairs.
+ *
+ *  An event is accepted if its category or its type is declared, or if
+ *  neither categories nor elements are declared. Then, if hosts or services
+ *  are declared, an event with a host_id is accepted only if its host or its
+ *  service is declared. Events without host_id are not concerned by this
+ *  second rule. broker.set_filter() called without argument removes the
+ *  filter.
+ *
+ *  The filter also restricts events to a shard when several interpreters
+ *  run the same script.
+ */
+class event_filter {
+  struct id_entries {
+    mapping::entry const* host_id;
+    mapping::entry const* service_id;
+  };
+
+  bool _active;
+  uint32_t _shard_count;
+  uint32_t _shard_index;
+  std::unordered_set<unsigned short> _categories;
+  std::unordered_set<uint32_t> _types;
+  std::unordered_set<uint32_t> _hosts;
+  std::set<std::pair<uint32_t, uint32_t>> _services;
+
+  // Mapping entries of the IDs, per event type.
+  std::unordered_map<uint32_t, id_entries> _entries;
+
+  id_entries const& _get_entries(uint32_t type);
+  static uint32_t _get_id(mapping::entry const* entry, io::data const& d);
+
+ public:
+  event_filter();
+  event_filter(event_filter const&) = delete;
+  event_filter& operator=(event_filter const&) = delete;
+  ~event_filter() = default;
+  bool is_active() const noexcept;
+  bool accepts(io::data const& d);
+  void clear();
+  void set(lua_State* L, int index);
+  void set_shard(uint32_t count, uint32_t index);
+
+  static void event_filter_reg(lua_State* L, event_filter& filter);
+};
+}  // namespace lua
+
+CCB_END()
+
+#endif  // !CCB_LUA_EVENT_FILTER_HH
@@ -0,0 +1,74 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#ifndef CCB_LUA_JSON_ENCODER_HH
+#define CCB_LUA_JSON_ENCODER_HH
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "com/centreon/broker/io/data.hh"
+#include "com/centreon/broker/mapping/entry.hh"
+#include "com/centreon/broker/namespace.hh"
+
+CCB_BEGIN()
+
+namespace lua {
+/**
+ *  @class json_encoder json_encoder.hh
+ * "com/centreon/broker/lua/json_encoder.hh"
+ *  @brief JSON writer used by broker.json_encode().
+ *
+ *  Broker events are serialized directly from their mapping, the JSON keys
+ *  of each event type are computed once. Strings are escaped by blocks of
+ *  16 bytes when SSE2 is available.
+ *
+ *  The output buffer is kept between two encodings so that its memory is
+ *  reused, clear() must be called before a new encoding.
+ */
+class json_encoder {
+  struct field {
+    mapping::entry const* entry;
+    // The separator and the key, for example: , "host_id":
+    std::string key;
+  };
+
+  std::string _buffer;
+  std::unordered_map<uint32_t, std::vector<field>> _fields;
+
+  std::vector<field> const& _get_fields(uint32_t type);
+
+ public:
+  json_encoder() = default;
+  json_encoder(json_encoder const&) = delete;
+  json_encoder& operator=(json_encoder const&) = delete;
+  ~json_encoder() = default;
+  void clear() noexcept;
+  std::string const& str() const noexcept;
+  void append(char c);
+  void append(char const* str, size_t len);
+  void append_escaped(char const* str, size_t len);
+  void append_string(char const* str, size_t len);
+  void append_event(io::data const& d);
+};
+}  // namespace lua
+
+CCB_END()
+
+#endif  // !CCB_LUA_JSON_ENCODER_HH
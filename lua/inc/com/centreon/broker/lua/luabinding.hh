@@ -20,7 +20,9 @@
 #define CCB_LUA_LUABINDING_HH
 
 #include <map>
+#include <vector>
 
+#include "com/centreon/broker/lua/event_filter.hh"
 #include "com/centreon/broker/lua/macro_cache.hh"
 #include "com/centreon/broker/misc/variant.hh"
 
@@ -73,6 +75,19 @@ namespace lua {
  *
  *                        NFFFNFFNNN.....
  *
+ *    For the same purpose, the script may also declare once, from init(), a
+ *    filter on categories, elements, hosts or services with
+ *    broker.set_filter(). This one is applied before entering the Lua
+ *    interpreter. Events it rejects are acknowledged immediately if no event
+ *    given to the script is waiting for an acknowledgement.
+ *
+ *  * a global write_batch(events) : this one is not mandatory. If it is
+ *    defined, write() becomes optional and is not called anymore. Events are
+ *    given to write_batch() by arrays of at most broker_batch_size events
+ *    (another global variable of the script, 100 by default) and the
+ *    function returns true to acknowledge them as write() does. An
+ *    incomplete array is given when broker has no more events to send.
+ *
  *  * a global flush() : this one is not mandatory but may be should. The good
  *    practice is to have a write function that keeps a queue of received
  *    events. When this queue reaches the a max size, it is sent to a peer using
@@ -94,6 +109,21 @@ class luabinding {
   // True if there is a flush() function in the Lua script.
   bool _flush;
 
+  // True if there is a write_batch() function in the Lua script.
+  bool _write_batch;
+
+  // Max number of events given to write_batch().
+  uint32_t _batch_size;
+
+  // Events waiting to be given to write_batch().
+  std::vector<std::shared_ptr<io::data>> _batch;
+
+  // Filter declared by the script with broker.set_filter().
+  event_filter _event_filter;
+
+  // True if events given to the script are not acknowledged yet.
+  bool _pending;
+
   // The cache.
   macro_cache& _cache;
 
@@ -107,6 +137,7 @@ class luabinding {
   void _load_script(const std::string& lua_script);
   void _init_script(std::map<std::string, misc::variant> const& conf_params);
   void _update_lua_path(std::string const& path);
+  void _push_event(std::shared_ptr<io::data> const& data);
 
  public:
   luabinding(std::string const& lua_script,
@@ -119,6 +150,9 @@ class luabinding {
   int32_t write(std::shared_ptr<io::data> const& data) noexcept;
   bool has_flush() const noexcept;
   int32_t flush() noexcept;
+  bool has_write_batch() const noexcept;
+  void set_shard(uint32_t count, uint32_t index);
+  int32_t send_batch() noexcept;
 };
 
 // Event conversion to Lua table.
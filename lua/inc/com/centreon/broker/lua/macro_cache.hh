@@ -80,6 +80,7 @@ class macro_cache {
 
  public:
   macro_cache(std::shared_ptr<persistent_cache> const& cache);
+  macro_cache(macro_cache const& other);
   ~macro_cache();
 
   void write(std::shared_ptr<io::data> const& data);
@@ -117,7 +118,6 @@ class macro_cache {
       uint64_t id) const;
 
  private:
-  macro_cache(macro_cache const& f);
   macro_cache& operator=(macro_cache const& f);
 
   void _process_instance(std::shared_ptr<io::data> const& data);
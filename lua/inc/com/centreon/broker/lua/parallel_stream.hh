@@ -0,0 +1,78 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#ifndef CCB_LUA_PARALLEL_STREAM_HH
+#define CCB_LUA_PARALLEL_STREAM_HH
+
+#include <memory>
+#include <vector>
+
+#include "com/centreon/broker/lua/stream.hh"
+
+CCB_BEGIN()
+
+namespace lua {
+
+/**
+ *  @class parallel_stream parallel_stream.hh
+ * "com/centreon/broker/lua/parallel_stream.hh"
+ *  @brief Several Lua interpreters running the same script.
+ *
+ *  Each interpreter is a lua::stream, with its own thread and its own copy of
+ *  the cache. All the events are written to all the streams, so that their
+ *  caches stay complete, but each one only gives to its script the events of
+ *  its shard, chosen from the event host_id. So events of a host are always
+ *  handled by the same interpreter, in the order they were received.
+ *
+ *  Since each stream receives the same sequence of events, the events
+ *  acknowledged by all of them are the first ones of this sequence. Their
+ *  number is the minimum of the acknowledgements returned by the streams, so
+ *  an interpreter that stays behind blocks the acknowledgement of all of
+ *  them. A warning is logged in this case.
+ */
+class parallel_stream : public io::stream {
+  static constexpr int _lag_warning_events = 10000;
+  static constexpr time_t _lag_warning_interval = 60;
+
+  std::vector<std::unique_ptr<lua::stream>> _streams;
+
+  /* Events acknowledged by each stream and not yet by all of them. */
+  std::vector<int> _acks;
+  time_t _last_lag_warning;
+
+  int _merge_acks();
+
+ public:
+  parallel_stream(std::string const& lua_script,
+                  std::map<std::string, misc::variant> const& conf_params,
+                  std::shared_ptr<persistent_cache> const& cache,
+                  uint32_t max_queue_size,
+                  uint32_t count);
+  parallel_stream& operator=(parallel_stream const& other) = delete;
+  parallel_stream(parallel_stream const& other) = delete;
+  ~parallel_stream() = default;
+  bool read(std::shared_ptr<io::data>& d, time_t deadline) override;
+  int write(std::shared_ptr<io::data> const& d) override;
+  int flush() override;
+  void statistics(json11::Json::object& tree) const override;
+};
+}  // namespace lua
+
+CCB_END()
+
+#endif  // !CCB_LUA_PARALLEL_STREAM_HH
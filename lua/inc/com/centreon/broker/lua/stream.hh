@@ -54,8 +54,12 @@ namespace lua {
  *  flush function sets a flag _flush to true. Then the stream thread gets the
  *  information of a flush call and can call it.
  *
- *  When the flush flag is false, and the queue is empty, if it is not time to
- *  exit, the thread waits for 500ms before rechecking events.
+ *  The stream thread sleeps on a condition variable, it is woken up by
+ *  write(), flush() and the destructor. Each time, all the exposed events are
+ *  handled in one batch.
+ *
+ *  If a max queue size is configured, write() waits for the stream thread to
+ *  take the exposed events when this size is reached.
  */
 class stream : public io::stream {
   std::thread _thread;
@@ -63,9 +67,16 @@ class stream : public io::stream {
   /* Macro cache */
   macro_cache _cache;
 
+  /* Max size of _exposed_events, 0 for no limit. */
+  const uint32_t _max_queue_size;
+
   /* _exposed_events is just filled by the write() function. This access is
-   * locked by the _exposed_events_m mutex. */
+   * locked by the _exposed_events_m mutex. The stream thread waits for events
+   * on _exposed_events_cv whereas write() waits for room on _queue_room_cv
+   * when the queue is full. */
   mutable std::mutex _exposed_events_m;
+  std::condition_variable _exposed_events_cv;
+  std::condition_variable _queue_room_cv;
   std::deque<std::shared_ptr<io::data>> _exposed_events;
 
   /* _acks_count is the number of events to acknowledge regards to the muxer.
@@ -91,10 +102,24 @@ class stream : public io::stream {
    * it is set to true only when it is not already set. */
   std::atomic_bool _flush;
 
+  void _start(std::string const& lua_script,
+              std::map<std::string, misc::variant> const& conf_params,
+              uint32_t shard_count,
+              uint32_t shard_index);
+
  public:
   stream(std::string const& lua_script,
          std::map<std::string, misc::variant> const& conf_params,
-         std::shared_ptr<persistent_cache> const& cache);
+         std::shared_ptr<persistent_cache> const& cache,
+         uint32_t max_queue_size = 0,
+         uint32_t shard_count = 1,
+         uint32_t shard_index = 0);
+  stream(std::string const& lua_script,
+         std::map<std::string, misc::variant> const& conf_params,
+         macro_cache const& cache,
+         uint32_t max_queue_size,
+         uint32_t shard_count,
+         uint32_t shard_index);
   stream& operator=(stream const& other) = delete;
   stream(stream const& other) = delete;
   ~stream();
@@ -104,6 +129,7 @@ class stream : public io::stream {
   int flush() override;
   bool stats_mean_square(double& a, double& b) const noexcept;
   void statistics(json11::Json::object& tree) const override;
+  macro_cache const& get_cache() const;
 };
 }  // namespace lua
 
@@ -28,7 +28,9 @@
 #include <sstream>
 
 #include "com/centreon/broker/io/data.hh"
+#include "com/centreon/broker/exceptions/msg.hh"
 #include "com/centreon/broker/io/events.hh"
+#include "com/centreon/broker/lua/json_encoder.hh"
 #include "com/centreon/broker/mapping/entry.hh"
 #include "com/centreon/broker/storage/exceptions/perfdata.hh"
 #include "com/centreon/broker/storage/parser.hh"
@@ -36,16 +38,27 @@
 using namespace com::centreon::broker;
 using namespace com::centreon::broker::lua;
 
-static void broker_json_encode(lua_State* L, std::ostringstream& oss);
+static void broker_json_encode(lua_State* L, json_encoder& encoder);
 static void broker_json_decode(lua_State* L, json11::Json const& it);
 
+/**
+ *  The encoder used by json_encode(), its buffer is reused from one call to
+ *  the other.
+ *
+ *  @return The encoder of the current thread.
+ */
+static json_encoder& get_json_encoder() {
+  static thread_local json_encoder encoder;
+  return encoder;
+}
+
 /**
  *  The json_encode function for Lua tables
  *
  *  @param L The Lua interpreter
- *  @param oss The output stream
+ *  @param encoder The json encoder
  */
-static void broker_json_encode_table(lua_State* L, std::ostringstream& oss) {
+static void broker_json_encode_table(lua_State* L, json_encoder& encoder) {
   bool array(false);
   /* We must parse the table from the first key */
   lua_pushnil(L); /* this tells lua_next to start from the first key */
@@ -58,8 +71,8 @@ static void broker_json_encode_table(lua_State* L, std::ostringstream& oss) {
       int index(lua_tointeger(L, -2));
       if (index == 1) {
         array = true;
-        oss << '[';
-        broker_json_encode(L, oss);
+        encoder.append('[');
+        broker_json_encode(L, encoder);
         lua_pop(L, 1);
         while (lua_next(L, -2)) {
 #if LUA53
@@ -67,203 +80,100 @@ static void broker_json_encode_table(lua_State* L, std::ostringstream& oss) {
 #else
           if (lua_isnumber(L, -2)) {
 #endif
-            oss << ',';
-            broker_json_encode(L, oss);
+            encoder.append(',');
+            broker_json_encode(L, encoder);
           }
           lua_pop(L, 1);
         }
-        oss << ']';
+        encoder.append(']');
       }
     }
   } else {
     /* There are no key, the table is empty */
-    oss << "[]";
+    encoder.append("[]", 2);
     return;
   }
 
   if (!array) {
-    oss << "{\"" << lua_tostring(L, -2) << "\":";
-    broker_json_encode(L, oss);
-    lua_pop(L, 1);
-    while (lua_next(L, -2)) {
-      oss << ",\"" << lua_tostring(L, -2) << "\":";
-      broker_json_encode(L, oss);
+    char sep = '{';
+    do {
+      /* The key is converted on a copy, lua_next() needs the original. */
+      size_t len;
+      lua_pushvalue(L, -2);
+      char const* key(lua_tolstring(L, -1, &len));
+      if (!key)
+        throw exceptions::msg()
+            << "json_encode: table keys must be strings or numbers";
+      encoder.append(sep);
+      encoder.append_string(key, len);
+      encoder.append(':');
       lua_pop(L, 1);
-    }
-    oss << '}';
+      broker_json_encode(L, encoder);
+      lua_pop(L, 1);
+      sep = ',';
+    } while (lua_next(L, -2));
+    encoder.append('}');
   }
 }
 
-static void escape_str(const char* content, std::ostringstream& oss) {
-  /* If the string contains '"', we must escape it */
-  size_t pos(strcspn(content, "\\\"\t\r\n"));
-  if (content[pos] != 0) {
-    std::string str(content);
-    char replacement[3] = "\\\\";
-    do {
-      switch (str[pos]) {
-        case '\\':
-          replacement[1] = '\\';
-          break;
-        case '"':
-          replacement[1] = '"';
-          break;
-        case '\t':
-          replacement[1] = 't';
-          break;
-        case '\r':
-          replacement[1] = 'r';
-          break;
-        case '\n':
-          replacement[1] = 'n';
-          break;
-      }
-      str.replace(pos, 1, replacement);
-      pos += 2;
-    } while ((pos = str.find_first_of("\\\"\t\r\n", pos)) != std::string::npos);
-    oss << str;
-  } else
-    oss << content;
-}
-
-static void broker_json_encode_broker_event(std::shared_ptr<io::data> e,
-                                     std::ostringstream& oss) {
-  io::event_info const* info = io::events::instance().get_event_info(e->type());
-  if (info) {
-    oss << fmt::format("{{ \"_type\": {}, \"category\": {}, \"element\": {}",
-                       e->type(), static_cast<uint32_t>(e->type()) >> 16,
-                       static_cast<uint32_t>(e->type()) & 0xffff);
-    for (const mapping::entry* current_entry = info->get_mapping();
-         !current_entry->is_null(); ++current_entry) {
-      char const* entry_name(current_entry->get_name_v2());
-      if (entry_name && *entry_name) {
-        switch (current_entry->get_type()) {
-          case mapping::source::BOOL:
-            oss << fmt::format(", \"{}\":{}", entry_name,
-                               current_entry->get_bool(*e));
-            break;
-          case mapping::source::DOUBLE:
-            oss << fmt::format(", \"{}\":{}", entry_name,
-                               current_entry->get_double(*e));
-            break;
-          case mapping::source::INT:
-            switch (current_entry->get_attribute()) {
-              case mapping::entry::invalid_on_zero: {
-                int val(current_entry->get_int(*e));
-                if (val != 0)
-                  oss << fmt::format(", \"{}\":{}", entry_name, val);
-              } break;
-              case mapping::entry::invalid_on_minus_one: {
-                int val(current_entry->get_int(*e));
-                if (val != -1)
-                  oss << fmt::format(", \"{}\":{}", entry_name, val);
-              } break;
-              default:
-                oss << fmt::format(", \"{}\":{}", entry_name,
-                                   current_entry->get_int(*e));
-            }
-            break;
-          case mapping::source::SHORT:
-            oss << fmt::format(", \"{}\":{}", entry_name,
-                               current_entry->get_short(*e));
-            break;
-          case mapping::source::STRING:
-            if (current_entry->get_attribute() ==
-                mapping::entry::invalid_on_zero) {
-              std::string val{current_entry->get_string(*e)};
-              if (!val.empty()) {
-                oss << fmt::format(", \"{}\":\"", entry_name);
-                escape_str(val.c_str(), oss);
-                oss << '"';
-              }
-            } else {
-              oss << fmt::format(", \"{}\":\"", entry_name);
-              escape_str(current_entry->get_string(*e).c_str(), oss);
-              oss << '"';
-            }
-            break;
-          case mapping::source::TIME:
-            switch (current_entry->get_attribute()) {
-              case mapping::entry::invalid_on_zero: {
-                time_t val = current_entry->get_time(*e);
-                if (val != 0)
-                  oss << fmt::format(", \"{}\":\"{}\"", entry_name, val);
-              } break;
-              case mapping::entry::invalid_on_minus_one: {
-                time_t val = current_entry->get_time(*e);
-                if (val != -1)
-                  oss << fmt::format(", \"{}\":\"{}\"", entry_name, val);
-              } break;
-              default:
-                oss << fmt::format(", \"{}\":\"{}\"", entry_name,
-                                   current_entry->get_time(*e));
-            }
-            break;
-          case mapping::source::UINT:
-            switch (current_entry->get_attribute()) {
-              case mapping::entry::invalid_on_zero: {
-                uint32_t val = current_entry->get_uint(*e);
-                if (val != 0)
-                  oss << fmt::format(", \"{}\":{}", entry_name, val);
-              } break;
-              case mapping::entry::invalid_on_minus_one: {
-                uint32_t val = current_entry->get_uint(*e);
-                if (val != static_cast<uint32_t>(-1))
-                  oss << fmt::format(", \"{}\":{}", entry_name, val);
-              } break;
-              default:
-                oss << fmt::format(", \"{}\":{}", entry_name,
-                                   current_entry->get_uint(*e));
-            }
-            break;
-          default:  // Error in one of the mappings.
-            throw exceptions::msg() << "invalid mapping for object "
-                                    << "of type '" << info->get_name()
-                                    << "': " << current_entry->get_type()
-                                    << " is not a known type ID";
-        }
-      }
-    }
-    oss << "}}";
-  } else
-    throw exceptions::msg() << "cannot bind object of type " << e->type()
-                            << " to database query: mapping does not exist";
+/**
+ *  Get the broker event at the given index of the stack.
+ *
+ *  @param L The Lua interpreter
+ *  @param index The index in the stack
+ *
+ *  @return The event or nullptr if it is not a broker event.
+ */
+static std::shared_ptr<io::data> const* to_broker_event(lua_State* L,
+                                                        int index) {
+  void* ptr = lua_touserdata(L, index);
+  if (ptr && lua_getmetatable(L, index)) {
+    luaL_getmetatable(L, "broker_event");
+    bool is_event = lua_rawequal(L, -1, -2);
+    lua_pop(L, 2);
+    if (is_event)
+      return static_cast<std::shared_ptr<io::data> const*>(ptr);
+  }
+  return nullptr;
 }
 
 /**
  *  The json_encode function for Lua objects others than tables
  *
  *  @param L The Lua interpreter
- *  @param oss The output stream
+ *  @param encoder The json encoder
  */
-static void broker_json_encode(lua_State* L, std::ostringstream& oss) {
+static void broker_json_encode(lua_State* L, json_encoder& encoder) {
   switch (lua_type(L, -1)) {
-    case LUA_TNUMBER:
-      oss << lua_tostring(L, -1);
-      break;
+    case LUA_TNUMBER: {
+      size_t len;
+      char const* content = lua_tolstring(L, -1, &len);
+      encoder.append(content, len);
+    } break;
     case LUA_TSTRING: {
       /* If the string contains '"', we must escape it */
-      const char* content = lua_tostring(L, -1);
-      oss << '"';
-      escape_str(content, oss);
-      oss << '"';
+      size_t len;
+      char const* content = lua_tolstring(L, -1, &len);
+      encoder.append_string(content, len);
     } break;
     case LUA_TBOOLEAN:
-      oss << (lua_toboolean(L, -1) ? "true" : "false");
+      if (lua_toboolean(L, -1))
+        encoder.append("true", 4);
+      else
+        encoder.append("false", 5);
       break;
     case LUA_TTABLE:
-      broker_json_encode_table(L, oss);
+      broker_json_encode_table(L, encoder);
       break;
     case LUA_TUSERDATA: {
-      void* ptr = luaL_checkudata(L, 1, "broker_event");
-      if (ptr) {
-        auto event = static_cast<std::shared_ptr<io::data>*>(ptr);
-        broker_json_encode_broker_event(*event, oss);
+      std::shared_ptr<io::data> const* event = to_broker_event(L, -1);
+      if (event) {
+        encoder.append_event(**event);
         break;
       }
     }
     default:
-      luaL_error(L, "json_encode: type not implemented");
+      throw exceptions::msg() << "json_encode: type not implemented";
   }
 }
 
@@ -275,9 +185,59 @@ static void broker_json_encode(lua_State* L, std::ostringstream& oss) {
  *  @return 1
  */
 static int l_broker_json_encode(lua_State* L) {
-  std::ostringstream oss;
-  broker_json_encode(L, oss);
-  lua_pushstring(L, oss.str().c_str());
+  json_encoder& encoder(get_json_encoder());
+  encoder.clear();
+  bool error = false;
+  try {
+    lua_settop(L, 1);
+    broker_json_encode(L, encoder);
+  } catch (std::exception const& e) {
+    // Lua errors do not unwind the C++ stack, the message is pushed here and
+    // the error raised once the exception is destroyed.
+    lua_pushstring(L, e.what());
+    error = true;
+  }
+  if (error)
+    return lua_error(L);
+  lua_pushlstring(L, encoder.str().data(), encoder.str().size());
+  return 1;
+}
+
+/**
+ *  The Lua json_encode_batch function. It takes an array of objects, usually
+ *  the one given to write_batch(), and returns them encoded as NDJSON: one
+ *  json per line, each line ending with a newline.
+ *
+ *  @param L The Lua interpreter
+ *
+ *  @return 1
+ */
+static int l_broker_json_encode_batch(lua_State* L) {
+  json_encoder& encoder(get_json_encoder());
+  encoder.clear();
+  bool error = false;
+  try {
+    lua_settop(L, 1);
+    if (!lua_istable(L, 1))
+      throw exceptions::msg() << "json_encode_batch: an array is expected";
+    for (int i = 1;; ++i) {
+      lua_rawgeti(L, 1, i);
+      if (lua_isnil(L, -1)) {
+        lua_pop(L, 1);
+        break;
+      }
+      broker_json_encode(L, encoder);
+      encoder.append('\n');
+      lua_pop(L, 1);
+    }
+  } catch (std::exception const& e) {
+    lua_settop(L, 0);
+    lua_pushstring(L, e.what());
+    error = true;
+  }
+  if (error)
+    return lua_error(L);
+  lua_pushlstring(L, encoder.str().data(), encoder.str().size());
   return 1;
 }
 
@@ -547,6 +507,7 @@ static int l_broker_stat(lua_State* L) {
  */
 void broker_utils::broker_utils_reg(lua_State* L) {
   luaL_Reg s_broker_regs[] = {{"json_encode", l_broker_json_encode},
+                              {"json_encode_batch", l_broker_json_encode_batch},
                               {"json_decode", l_broker_json_decode},
                               {"parse_perfdata", l_broker_parse_perfdata},
                               {"url_encode", l_broker_url_encode},
@@ -20,6 +20,7 @@
 #include <fstream>
 #include <sstream>
 #include "com/centreon/broker/exceptions/msg.hh"
+#include "com/centreon/broker/lua/parallel_stream.hh"
 #include "com/centreon/broker/lua/stream.hh"
 
 using namespace com::centreon::broker;
@@ -28,7 +29,8 @@ using namespace com::centreon::broker::lua;
 /**
  *  Default constructor.
  */
-connector::connector() : io::endpoint(false) {}
+connector::connector()
+    : io::endpoint(false), _max_queue_size{0}, _vm_count{1} {}
 
 /**
  *  Copy constructor.
@@ -39,7 +41,9 @@ connector::connector(connector const& other)
     : io::endpoint(other),
       _lua_script(other._lua_script),
       _conf_params(other._conf_params),
-      _cache(other._cache) {}
+      _cache(other._cache),
+      _max_queue_size(other._max_queue_size),
+      _vm_count(other._vm_count) {}
 
 /**
  *  Destructor.
@@ -53,14 +57,22 @@ connector::~connector() {}
  *  @param[in] cfg_params              A hash table containing the user
  *                                     parameters
  *  @param[in] cache                   The cache
+ *  @param[in] max_queue_size          Max number of events waiting for the
+ *                                     Lua thread, 0 for no limit
+ *  @param[in] vm_count                Number of Lua interpreters running
+ *                                     the script
  */
 void connector::connect_to(
     std::string const& lua_script,
     std::map<std::string, misc::variant> const& cfg_params,
-    std::shared_ptr<persistent_cache> const& cache) {
+    std::shared_ptr<persistent_cache> const& cache,
+    uint32_t max_queue_size,
+    uint32_t vm_count) {
   _conf_params = cfg_params;
   _lua_script = lua_script;
   _cache = cache;
+  _max_queue_size = max_queue_size;
+  _vm_count = vm_count;
 }
 
 /**
@@ -69,5 +81,9 @@ void connector::connect_to(
  *  @return a lua connection object.
  */
 std::shared_ptr<io::stream> connector::open() {
-  return std::make_shared<stream>(_lua_script, _conf_params, _cache);
+  if (_vm_count > 1)
+    return std::make_shared<parallel_stream>(_lua_script, _conf_params, _cache,
+                                             _max_queue_size, _vm_count);
+  return std::make_shared<stream>(_lua_script, _conf_params, _cache,
+                                  _max_queue_size);
 }
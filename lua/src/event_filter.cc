@@ -0,0 +1,327 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#include "com/centreon/broker/lua/event_filter.hh"
+
+#include <cstring>
+
+#include "com/centreon/broker/exceptions/msg.hh"
+#include "com/centreon/broker/io/events.hh"
+#include "com/centreon/broker/log_v2.hh"
+
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::lua;
+
+/**
+ *  Get the integer at the given index of the Lua stack.
+ *
+ *  @param L      The Lua interpreter.
+ *  @param index  The index in the stack.
+ *  @param field  The filter field being read, used in error messages.
+ *
+ *  @return The integer.
+ */
+static uint32_t get_id(lua_State* L, int index, char const* field) {
+  if (!lua_isnumber(L, index))
+    throw exceptions::msg() << "broker.set_filter: '" << field
+                            << "' must only contain integers";
+  return static_cast<uint32_t>(lua_tointeger(L, index));
+}
+
+/**
+ *  Get the pair of integers stored as { a, b } at the given index of the Lua
+ *  stack.
+ *
+ *  @param L      The Lua interpreter.
+ *  @param index  The index in the stack.
+ *  @param field  The filter field being read, used in error messages.
+ *
+ *  @return The pair.
+ */
+static std::pair<uint32_t, uint32_t> get_id_pair(lua_State* L,
+                                                 int index,
+                                                 char const* field) {
+  if (!lua_istable(L, index))
+    throw exceptions::msg() << "broker.set_filter: '" << field
+                            << "' must only contain pairs of integers";
+  lua_rawgeti(L, index, 1);
+  lua_rawgeti(L, index, 2);
+  if (!lua_isnumber(L, -2) || !lua_isnumber(L, -1)) {
+    lua_pop(L, 2);
+    throw exceptions::msg() << "broker.set_filter: '" << field
+                            << "' must only contain pairs of integers";
+  }
+  std::pair<uint32_t, uint32_t> retval(
+      static_cast<uint32_t>(lua_tointeger(L, -2)),
+      static_cast<uint32_t>(lua_tointeger(L, -1)));
+  lua_pop(L, 2);
+  return retval;
+}
+
+/**
+ *  Call a function on each value of the array stored in the given field of
+ *  the table on the top of the Lua stack.
+ *
+ *  @param L      The Lua interpreter.
+ *  @param field  The field to read.
+ *  @param f      The function called with the index of the value in the
+ *                stack.
+ */
+template <typename F>
+static void for_each_value(lua_State* L, char const* field, F f) {
+  lua_getfield(L, -1, field);
+  if (lua_isnil(L, -1)) {
+    lua_pop(L, 1);
+    return;
+  }
+  if (!lua_istable(L, -1)) {
+    lua_pop(L, 1);
+    throw exceptions::msg()
+        << "broker.set_filter: '" << field << "' must be an array";
+  }
+  try {
+    lua_pushnil(L);
+    while (lua_next(L, -2)) {
+      f(lua_gettop(L));
+      lua_pop(L, 1);
+    }
+  } catch (...) {
+    // The key, the value and the array.
+    lua_pop(L, 3);
+    throw;
+  }
+  lua_pop(L, 1);
+}
+
+/**
+ *  The Lua broker.set_filter() function.
+ *
+ *  @param L The Lua interpreter.
+ *
+ *  @return 0.
+ */
+static int l_broker_set_filter(lua_State* L) {
+  event_filter* filter(
+      static_cast<event_filter*>(lua_touserdata(L, lua_upvalueindex(1))));
+  bool error = false;
+  try {
+    if (lua_gettop(L) == 0 || lua_isnil(L, 1))
+      filter->clear();
+    else
+      filter->set(L, 1);
+  } catch (std::exception const& e) {
+    // Lua errors do not unwind the C++ stack, the message is pushed here and
+    // the error raised once the exception is destroyed.
+    lua_pushstring(L, e.what());
+    error = true;
+  }
+  if (error)
+    return lua_error(L);
+  return 0;
+}
+
+/**
+ *  Default constructor, the filter accepts everything.
+ */
+event_filter::event_filter()
+    : _active{false}, _shard_count{1}, _shard_index{0} {}
+
+/**
+ *  Returns true if the filter has been declared by the script.
+ */
+bool event_filter::is_active() const noexcept {
+  return _active;
+}
+
+/**
+ *  Remove the filter, all the events are accepted.
+ */
+void event_filter::clear() {
+  _active = false;
+  _categories.clear();
+  _types.clear();
+  _hosts.clear();
+  _services.clear();
+}
+
+/**
+ *  Set the filter from the table at the given index of the Lua stack. On
+ *  error, the filter is left unchanged.
+ *
+ *  @param L      The Lua interpreter.
+ *  @param index  The index of the table in the stack.
+ */
+void event_filter::set(lua_State* L, int index) {
+  if (!lua_istable(L, index))
+    throw exceptions::msg() << "broker.set_filter: the filter must be a table";
+
+  std::unordered_set<unsigned short> categories;
+  std::unordered_set<uint32_t> types;
+  std::unordered_set<uint32_t> hosts;
+  std::set<std::pair<uint32_t, uint32_t>> services;
+
+  lua_pushvalue(L, index);
+  try {
+    for_each_value(L, "categories", [&](int idx) {
+      categories.insert(get_id(L, idx, "categories"));
+    });
+    for_each_value(L, "elements", [&](int idx) {
+      std::pair<uint32_t, uint32_t> p(get_id_pair(L, idx, "elements"));
+      types.insert(io::events::make_type(p.first, p.second));
+    });
+    for_each_value(L, "hosts",
+                   [&](int idx) { hosts.insert(get_id(L, idx, "hosts")); });
+    for_each_value(L, "services", [&](int idx) {
+      services.insert(get_id_pair(L, idx, "services"));
+    });
+  } catch (...) {
+    lua_pop(L, 1);
+    throw;
+  }
+  lua_pop(L, 1);
+
+  _categories = std::move(categories);
+  _types = std::move(types);
+  _hosts = std::move(hosts);
+  _services = std::move(services);
+  _active = true;
+  log_v2::lua()->info(
+      "lua: filter set with {} categories, {} elements, {} hosts and {} "
+      "services",
+      _categories.size(), _types.size(), _hosts.size(), _services.size());
+}
+
+/**
+ *  Get the mapping entries of host_id and service_id for the given type.
+ *
+ *  @param type  The event type.
+ *
+ *  @return Entries, nullptr when the event does not have such a field.
+ */
+event_filter::id_entries const& event_filter::_get_entries(uint32_t type) {
+  auto found = _entries.find(type);
+  if (found != _entries.end())
+    return found->second;
+
+  id_entries& retval = _entries[type];
+  retval.host_id = nullptr;
+  retval.service_id = nullptr;
+  io::event_info const* info(io::events::instance().get_event_info(type));
+  if (info) {
+    for (mapping::entry const* current_entry(info->get_mapping());
+         !current_entry->is_null(); ++current_entry) {
+      char const* entry_name(current_entry->get_name_v2());
+      uint32_t t(current_entry->get_type());
+      if (!entry_name ||
+          (t != mapping::source::UINT && t != mapping::source::INT))
+        continue;
+      if (strcmp(entry_name, "host_id") == 0)
+        retval.host_id = current_entry;
+      else if (strcmp(entry_name, "service_id") == 0)
+        retval.service_id = current_entry;
+    }
+  }
+  return retval;
+}
+
+/**
+ *  Get the value of an ID field of an event.
+ *
+ *  @param entry  The mapping entry of the field.
+ *  @param d      The event.
+ *
+ *  @return The ID.
+ */
+uint32_t event_filter::_get_id(mapping::entry const* entry,
+                               io::data const& d) {
+  return entry->get_type() == mapping::source::UINT
+             ? entry->get_uint(d)
+             : static_cast<uint32_t>(entry->get_int(d));
+}
+
+/**
+ *  When several interpreters run the same script, each one only handles the
+ *  events of its shard: events are dispatched on their host_id, those
+ *  without host_id are handled by the first interpreter.
+ *
+ *  @param count  The number of interpreters.
+ *  @param index  The index of this interpreter, from 0 to count - 1.
+ */
+void event_filter::set_shard(uint32_t count, uint32_t index) {
+  _shard_count = count;
+  _shard_index = index;
+}
+
+/**
+ *  Tell if an event is accepted by the filter.
+ *
+ *  @param d  The event.
+ *
+ *  @return True if the event has to be given to the script.
+ */
+bool event_filter::accepts(io::data const& d) {
+  uint32_t type(d.type());
+
+  // Events of other shards are handled by other interpreters.
+  if (_shard_count > 1) {
+    id_entries const& entries(_get_entries(type));
+    uint32_t shard(entries.host_id
+                       ? _get_id(entries.host_id, d) % _shard_count
+                       : 0);
+    if (shard != _shard_index)
+      return false;
+  }
+
+  if (!_active)
+    return true;
+
+  if ((!_categories.empty() || !_types.empty()) &&
+      _categories.find(io::events::category_of_type(type)) ==
+          _categories.end() &&
+      _types.find(type) == _types.end())
+    return false;
+
+  if (_hosts.empty() && _services.empty())
+    return true;
+
+  id_entries const& entries(_get_entries(type));
+  if (!entries.host_id)
+    return true;
+  uint32_t host_id(_get_id(entries.host_id, d));
+  if (_hosts.find(host_id) != _hosts.end())
+    return true;
+  if (!entries.service_id || _services.empty())
+    return false;
+  uint32_t service_id(_get_id(entries.service_id, d));
+  return _services.find({host_id, service_id}) != _services.end();
+}
+
+/**
+ *  Register the broker.set_filter() function. The broker table must already
+ *  exist.
+ *
+ *  @param L       The Lua interpreter.
+ *  @param filter  The filter set by the function.
+ */
+void event_filter::event_filter_reg(lua_State* L, event_filter& filter) {
+  lua_getglobal(L, "broker");
+  lua_pushlightuserdata(L, &filter);
+  lua_pushcclosure(L, l_broker_set_filter, 1);
+  lua_setfield(L, -2, "set_filter");
+  lua_pop(L, 1);
+}
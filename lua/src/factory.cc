@@ -21,6 +21,7 @@
 #include <json11.hpp>
 #include <memory>
 #include "com/centreon/broker/exceptions/msg.hh"
+#include "com/centreon/broker/logging/logging.hh"
 #include "com/centreon/broker/lua/connector.hh"
 
 using namespace com::centreon::broker;
@@ -163,9 +164,43 @@ io::endpoint* factory::new_endpoint(
       }
     }
   }
+  // Max number of events waiting for the Lua thread.
+  uint32_t max_queue_size = 0;
+  {
+    std::map<std::string, std::string>::const_iterator it{
+        cfg.params.find("max_queue_size")};
+    if (it != cfg.params.end()) {
+      try {
+        max_queue_size = std::stoul(it->second);
+      } catch (std::exception const& e) {
+        logging::error(logging::high)
+            << "lua: the max_queue_size field should contain a number. We "
+               "use the default value: no limit";
+      }
+    }
+  }
+
+  // Number of Lua interpreters running the script.
+  uint32_t vm_count = 1;
+  {
+    std::map<std::string, std::string>::const_iterator it{
+        cfg.params.find("vm_count")};
+    if (it != cfg.params.end()) {
+      try {
+        vm_count = std::stoul(it->second);
+      } catch (std::exception const& e) {
+        logging::error(logging::high)
+            << "lua: the vm_count field should contain a number. We use the "
+               "default value: 1";
+      }
+      if (vm_count == 0)
+        vm_count = 1;
+    }
+  }
+
   // Connector.
   std::unique_ptr<lua::connector> c(new lua::connector);
-  c->connect_to(filename, conf_map, cache);
+  c->connect_to(filename, conf_map, cache, max_queue_size, vm_count);
   is_acceptor = false;
   return c.release();
 }
@@ -0,0 +1,284 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#include "com/centreon/broker/lua/json_encoder.hh"
+
+#include <fmt/format.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include <iterator>
+
+#include "com/centreon/broker/exceptions/msg.hh"
+#include "com/centreon/broker/io/events.hh"
+
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::lua;
+
+/**
+ *  Get the position of the first character to escape in a string, that is
+ *  a '"', a '\' or a control character.
+ *
+ *  @param str  The string.
+ *  @param len  Its length.
+ *
+ *  @return The position of the character, len if there is none.
+ */
+static size_t find_char_to_escape(char const* str, size_t len) {
+  size_t pos = 0;
+#ifdef __SSE2__
+  __m128i const quote(_mm_set1_epi8('"'));
+  __m128i const backslash(_mm_set1_epi8('\\'));
+  __m128i const control(_mm_set1_epi8(0x1f));
+  for (; pos + 16 <= len; pos += 16) {
+    __m128i chunk(
+        _mm_loadu_si128(reinterpret_cast<__m128i const*>(str + pos)));
+    // max(c, 0x1f) == 0x1f means c <= 0x1f, as unsigned bytes.
+    __m128i found(_mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(chunk, quote),
+                     _mm_cmpeq_epi8(chunk, backslash)),
+        _mm_cmpeq_epi8(_mm_max_epu8(chunk, control), control)));
+    int mask(_mm_movemask_epi8(found));
+    if (mask)
+      return pos + __builtin_ctz(mask);
+  }
+#endif
+  for (; pos < len; ++pos) {
+    unsigned char c(str[pos]);
+    if (c == '"' || c == '\\' || c < 0x20)
+      break;
+  }
+  return pos;
+}
+
+/**
+ *  Clear the buffer, its memory is kept for the next encoding.
+ */
+void json_encoder::clear() noexcept {
+  _buffer.clear();
+}
+
+/**
+ *  Get the JSON built since the last clear().
+ *
+ *  @return The JSON.
+ */
+std::string const& json_encoder::str() const noexcept {
+  return _buffer;
+}
+
+/**
+ *  Append a character to the JSON.
+ *
+ *  @param c  The character.
+ */
+void json_encoder::append(char c) {
+  _buffer.push_back(c);
+}
+
+/**
+ *  Append raw text to the JSON.
+ *
+ *  @param str  The text.
+ *  @param len  Its length.
+ */
+void json_encoder::append(char const* str, size_t len) {
+  _buffer.append(str, len);
+}
+
+/**
+ *  Append a string to the JSON with its special characters escaped, but
+ *  without quotes.
+ *
+ *  @param str  The string.
+ *  @param len  Its length.
+ */
+void json_encoder::append_escaped(char const* str, size_t len) {
+  for (;;) {
+    size_t pos(find_char_to_escape(str, len));
+    _buffer.append(str, pos);
+    if (pos == len)
+      break;
+    unsigned char c(str[pos]);
+    switch (c) {
+      case '"':
+        _buffer.append("\\\"", 2);
+        break;
+      case '\\':
+        _buffer.append("\\\\", 2);
+        break;
+      case '\t':
+        _buffer.append("\\t", 2);
+        break;
+      case '\r':
+        _buffer.append("\\r", 2);
+        break;
+      case '\n':
+        _buffer.append("\\n", 2);
+        break;
+      case '\b':
+        _buffer.append("\\b", 2);
+        break;
+      case '\f':
+        _buffer.append("\\f", 2);
+        break;
+      default: {
+        static char const hex[] = "0123456789abcdef";
+        char u[6] = {'\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xf]};
+        _buffer.append(u, sizeof(u));
+      }
+    }
+    str += pos + 1;
+    len -= pos + 1;
+  }
+}
+
+/**
+ *  Append a quoted string to the JSON.
+ *
+ *  @param str  The string.
+ *  @param len  Its length.
+ */
+void json_encoder::append_string(char const* str, size_t len) {
+  _buffer.push_back('"');
+  append_escaped(str, len);
+  _buffer.push_back('"');
+}
+
+/**
+ *  Get the fields of an event type with their JSON keys.
+ *
+ *  @param type  The event type.
+ *
+ *  @return The fields.
+ */
+std::vector<json_encoder::field> const& json_encoder::_get_fields(
+    uint32_t type) {
+  auto found = _fields.find(type);
+  if (found != _fields.end())
+    return found->second;
+
+  io::event_info const* info(io::events::instance().get_event_info(type));
+  if (!info)
+    throw exceptions::msg() << "cannot encode object of type " << type
+                            << " to json: mapping does not exist";
+  std::vector<field> fields;
+  for (mapping::entry const* current_entry = info->get_mapping();
+       !current_entry->is_null(); ++current_entry) {
+    char const* entry_name(current_entry->get_name_v2());
+    if (!entry_name || !*entry_name)
+      continue;
+    switch (current_entry->get_type()) {
+      case mapping::source::BOOL:
+      case mapping::source::DOUBLE:
+      case mapping::source::INT:
+      case mapping::source::SHORT:
+      case mapping::source::STRING:
+      case mapping::source::TIME:
+      case mapping::source::UINT:
+        break;
+      default:  // Error in one of the mappings.
+        throw exceptions::msg()
+            << "invalid mapping for object of type '" << info->get_name()
+            << "': " << current_entry->get_type() << " is not a known type ID";
+    }
+    fields.push_back({current_entry, fmt::format(", \"{}\":", entry_name)});
+  }
+  return _fields.emplace(type, std::move(fields)).first->second;
+}
+
+/**
+ *  Append a broker event to the JSON. Its fields are given with their names
+ *  in the mapping, after the _type, category and element fields. Invalid
+ *  values (0 or -1 depending on the field) are omitted.
+ *
+ *  @param d  The event.
+ */
+void json_encoder::append_event(io::data const& d) {
+  uint32_t type(d.type());
+  std::vector<field> const& fields(_get_fields(type));
+  std::back_insert_iterator<std::string> out(_buffer);
+  fmt::format_to(out, "{{ \"_type\": {}, \"category\": {}, \"element\": {}",
+                 type, type >> 16, type & 0xffff);
+  for (field const& f : fields) {
+    mapping::entry const& e(*f.entry);
+    switch (e.get_type()) {
+      case mapping::source::BOOL:
+        _buffer.append(f.key);
+        if (e.get_bool(d))
+          _buffer.append("true", 4);
+        else
+          _buffer.append("false", 5);
+        break;
+      case mapping::source::DOUBLE:
+        _buffer.append(f.key);
+        fmt::format_to(out, "{}", e.get_double(d));
+        break;
+      case mapping::source::INT: {
+        int val(e.get_int(d));
+        if ((e.get_attribute() == mapping::entry::invalid_on_zero &&
+             val == 0) ||
+            (e.get_attribute() == mapping::entry::invalid_on_minus_one &&
+             val == -1))
+          break;
+        _buffer.append(f.key);
+        fmt::format_int str(val);
+        _buffer.append(str.data(), str.size());
+      } break;
+      case mapping::source::SHORT: {
+        _buffer.append(f.key);
+        fmt::format_int str(e.get_short(d));
+        _buffer.append(str.data(), str.size());
+      } break;
+      case mapping::source::STRING: {
+        std::string const& val(e.get_string(d));
+        if (e.get_attribute() == mapping::entry::invalid_on_zero &&
+            val.empty())
+          break;
+        _buffer.append(f.key);
+        append_string(val.data(), val.size());
+      } break;
+      case mapping::source::TIME: {
+        time_t val(e.get_time(d));
+        if ((e.get_attribute() == mapping::entry::invalid_on_zero &&
+             val == 0) ||
+            (e.get_attribute() == mapping::entry::invalid_on_minus_one &&
+             val == -1))
+          break;
+        _buffer.append(f.key);
+        fmt::format_int str(val);
+        _buffer.push_back('"');
+        _buffer.append(str.data(), str.size());
+        _buffer.push_back('"');
+      } break;
+      case mapping::source::UINT: {
+        uint32_t val(e.get_uint(d));
+        if ((e.get_attribute() == mapping::entry::invalid_on_zero &&
+             val == 0) ||
+            (e.get_attribute() == mapping::entry::invalid_on_minus_one &&
+             val == static_cast<uint32_t>(-1)))
+          break;
+        _buffer.append(f.key);
+        fmt::format_int str(val);
+        _buffer.append(str.data(), str.size());
+      } break;
+    }
+  }
+  _buffer.push_back('}');
+}
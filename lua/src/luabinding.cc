@@ -27,6 +27,7 @@
 #include "com/centreon/broker/lua/broker_log.hh"
 #include "com/centreon/broker/lua/broker_socket.hh"
 #include "com/centreon/broker/lua/broker_utils.hh"
+#include "com/centreon/broker/lua/event_filter.hh"
 
 using namespace com::centreon::broker;
 using namespace com::centreon::broker::lua;
@@ -53,6 +54,9 @@ luabinding::luabinding(std::string const& lua_script,
     : _L{nullptr},
       _filter{false},
       _flush{false},
+      _write_batch{false},
+      _batch_size{100},
+      _pending{false},
       _cache(cache),
       _total{0},
       _broker_api_version{1} {
@@ -120,16 +124,37 @@ bool luabinding::has_flush() const noexcept {
   return _flush;
 }
 
+/**
+ *  Returns true if a write_batch was configured in the Lua script.
+ */
+bool luabinding::has_write_batch() const noexcept {
+  return _write_batch;
+}
+
+/**
+ *  Restrict the events given to the script to a shard, when several
+ *  interpreters run the same script. Events of other shards still update
+ *  the cache and are acknowledged with the other ones.
+ *
+ *  @param count  The number of interpreters.
+ *  @param index  The index of this interpreter.
+ */
+void luabinding::set_shard(uint32_t count, uint32_t index) {
+  _event_filter.set_shard(count, index);
+}
+
 /**
  *  Reads the Lua script, checks its syntax and checks if
  *   - init()
  *   - write()
+ *   - write_batch()
  *   - filter()
  *   - flush()
- *  functions exist in the Lua script. The two first ones are
- *  mandatory whereas the third one is optional.
+ *  functions exist in the Lua script. init() is mandatory, write() also
+ *  unless write_batch() is defined, the other ones are optional.
  *
- *  It is also here that the broker_api_version variable is checked.
+ *  It is also here that the broker_api_version and broker_batch_size
+ *  variables are checked.
  *
  *  @param lua_script the file name of the lua script.
  */
@@ -154,9 +179,15 @@ void luabinding::_load_script(const std::string& lua_script) {
         << "lua: '" << lua_script << "' init() global function is missing";
   lua_pop(_L, 1);
 
-  // Checking for write() availability: this function is mandatory
+  // Checking for write_batch() availability: this function is optional
+  lua_getglobal(_L, "write_batch");
+  _write_batch = lua_isfunction(_L, lua_gettop(_L));
+  lua_pop(_L, 1);
+
+  // Checking for write() availability: this function is mandatory if there
+  // is no write_batch()
   lua_getglobal(_L, "write");
-  if (!lua_isfunction(_L, lua_gettop(_L)))
+  if (!_write_batch && !lua_isfunction(_L, lua_gettop(_L)))
     throw exceptions::msg()
         << "lua: '" << lua_script << "' write() global function is missing";
   lua_pop(_L, 1);
@@ -217,6 +248,25 @@ void luabinding::_load_script(const std::string& lua_script) {
 
   log_v2::lua()->info("Lua broker_api_version set to {}", _broker_api_version);
 
+  /* Checking the batch size */
+  if (_write_batch) {
+    lua_getglobal(_L, "broker_batch_size");
+    if (lua_isnumber(_L, -1)) {
+      lua_Integer size = lua_tointeger(_L, -1);
+      if (size > 0)
+        _batch_size = size;
+      else
+        log_v2::lua()->error(
+            "broker_batch_size must be a positive integer and not '{}'. "
+            "Setting it to {}",
+            size, _batch_size);
+    }
+    lua_pop(_L, 1);
+    _batch.reserve(_batch_size);
+    log_v2::lua()->info("Lua write_batch() called with at most {} events",
+                        _batch_size);
+  }
+
   // Registers the broker_log object
   broker_log::broker_log_reg(_L);
 
@@ -229,6 +279,9 @@ void luabinding::_load_script(const std::string& lua_script) {
   // Registers the broker utils
   broker_utils::broker_utils_reg(_L);
 
+  // Registers the broker.set_filter() function
+  event_filter::event_filter_reg(_L, _event_filter);
+
   // Registers the broker cache
   broker_cache::broker_cache_reg(_L, _cache, _broker_api_version);
 }
@@ -306,6 +359,17 @@ int luabinding::write(std::shared_ptr<io::data> const& data) noexcept {
   // Total to acknowledge incremented
   ++_total;
 
+  // Events rejected by the filter declared with broker.set_filter() never
+  // enter the interpreter. If no event given to the script is waiting, they
+  // can be acknowledged now.
+  if (!_event_filter.accepts(*data)) {
+    if (!_pending) {
+      retval = _total;
+      _total = 0;
+    }
+    return retval;
+  }
+
   if (has_filter()) {
     // Let's get the function to call
     lua_getglobal(_L, "filter");
@@ -333,14 +397,55 @@ int luabinding::write(std::shared_ptr<io::data> const& data) noexcept {
   if (!execute_write)
     return 0;
 
+  _pending = true;
+
+  // In batch mode, the event waits for the next write_batch() call.
+  if (_write_batch) {
+    _batch.push_back(data);
+    if (_batch.size() >= _batch_size)
+      retval = send_batch();
+    return retval;
+  }
+
   // Let's get the function to call
   lua_getglobal(_L, "write");
 
   // We add data as argument
+  _push_event(data);
+
+  if (lua_pcall(_L, 1, 1, 0) != 0) {
+    logging::error(logging::high)
+        << "lua: error running function `write'" << lua_tostring(_L, -1);
+    return 0;
+  }
+
+  if (!lua_isboolean(_L, -1)) {
+    logging::error(logging::high) << "lua: `write' must return a boolean";
+    return 0;
+  }
+  int acknowledge = lua_toboolean(_L, -1);
+  lua_pop(_L, -1);
+
+  // We have to acknowledge rejected events by the filter. It is only possible
+  // when an acknowledgement is sent by the write function.
+  if (acknowledge) {
+    retval = _total;
+    _total = 0;
+    _pending = false;
+  }
+  return retval;
+}
+
+/**
+ *  Push the event on the Lua stack, as a table or as a broker event
+ *  depending on the api version.
+ *
+ *  @param data The event to push.
+ */
+void luabinding::_push_event(std::shared_ptr<io::data> const& data) {
   switch (_broker_api_version) {
     case 1: {
-      // Let's build the table from the event as argument to write()
-
+      // Let's build the table from the event
       io::data const& d(*data);
       broker_event::create_as_table(_L, d);
     } break;
@@ -348,25 +453,55 @@ int luabinding::write(std::shared_ptr<io::data> const& data) noexcept {
       broker_event::create(_L, data);
       break;
   }
+}
+
+/**
+ *  Give the events waiting in batch mode to the write_batch() function of
+ *  the script. This is done by write() once broker_batch_size events are
+ *  waiting, and it has to be done by the caller when it has no more events
+ *  to write.
+ *
+ *  @return The number of events acknowledged.
+ */
+int32_t luabinding::send_batch() noexcept {
+  if (_batch.empty())
+    return 0;
+
+  logging::debug(logging::medium)
+      << "lua: write_batch() called with " << _batch.size() << " events";
+
+  // Let's get the function to call
+  lua_getglobal(_L, "write_batch");
+
+  // The events are given as an array.
+  lua_createtable(_L, _batch.size(), 0);
+  int idx = 1;
+  for (std::shared_ptr<io::data> const& d : _batch) {
+    _push_event(d);
+    lua_rawseti(_L, -2, idx++);
+  }
+  _batch.clear();
 
   if (lua_pcall(_L, 1, 1, 0) != 0) {
     logging::error(logging::high)
-        << "lua: error running function `write'" << lua_tostring(_L, -1);
+        << "lua: error running function `write_batch'" << lua_tostring(_L, -1);
+    lua_pop(_L, 1);
     return 0;
   }
 
   if (!lua_isboolean(_L, -1)) {
-    logging::error(logging::high) << "lua: `write' must return a boolean";
+    logging::error(logging::high) << "lua: `write_batch' must return a boolean";
+    lua_pop(_L, 1);
     return 0;
   }
-  int acknowledge = lua_toboolean(_L, -1);
-  lua_pop(_L, -1);
+  bool acknowledge = lua_toboolean(_L, -1);
+  lua_pop(_L, 1);
 
-  // We have to acknowledge rejected events by the filter. It is only possible
-  // when an acknowledgement is sent by the write function.
+  int32_t retval = 0;
   if (acknowledge) {
     retval = _total;
     _total = 0;
+    _pending = false;
   }
   return retval;
 }
@@ -385,9 +520,16 @@ lua_State* luabinding::_load_interpreter() {
   return L;
 }
 
+/**
+ *  Give the waiting events to write_batch() and then call the flush()
+ *  function of the script.
+ *
+ *  @return The number of events acknowledged.
+ */
 int32_t luabinding::flush() noexcept {
+  int32_t retval = send_batch();
   if (!_flush)
-    return 0;
+    return retval;
   // Let's get the function to call
   lua_getglobal(_L, "flush");
   if (lua_pcall(_L, 0, 1, 0) != 0) {
@@ -402,10 +544,10 @@ int32_t luabinding::flush() noexcept {
   bool acknowledge = lua_toboolean(_L, -1);
   lua_pop(_L, -1);
 
-  int32_t retval = 0;
   if (acknowledge) {
-    retval = _total;
+    retval += _total;
     _total = 0;
+    _pending = false;
   }
   return retval;
 }
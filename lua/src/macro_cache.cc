@@ -44,6 +44,27 @@ macro_cache::macro_cache(std::shared_ptr<persistent_cache> const& cache)
   }
 }
 
+/**
+ *  Copy constructor. Cached data are copied, but the copy is not bound to
+ *  the persistent cache: it is neither loaded from it nor saved to it.
+ *
+ *  @param[in] other  Object to copy.
+ */
+macro_cache::macro_cache(macro_cache const& other)
+    : _instances(other._instances),
+      _hosts(other._hosts),
+      _host_groups(other._host_groups),
+      _host_group_members(other._host_group_members),
+      _custom_vars(other._custom_vars),
+      _services(other._services),
+      _service_groups(other._service_groups),
+      _service_group_members(other._service_group_members),
+      _index_mappings(other._index_mappings),
+      _metric_mappings(other._metric_mappings),
+      _dimension_ba_events(other._dimension_ba_events),
+      _dimension_ba_bv_relation_events(other._dimension_ba_bv_relation_events),
+      _dimension_bv_events(other._dimension_bv_events) {}
+
 /**
  *  Destructor.
  */
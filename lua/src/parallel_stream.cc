@@ -0,0 +1,136 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#include "com/centreon/broker/lua/parallel_stream.hh"
+
+#include <algorithm>
+#include <ctime>
+
+#include "com/centreon/broker/exceptions/shutdown.hh"
+#include "com/centreon/broker/log_v2.hh"
+
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::lua;
+
+/**
+ *  Constructor. The first interpreter loads the persistent cache, the other
+ *  ones get a copy of its cache.
+ *
+ *  @param[in] lua_script      The Lua script to load.
+ *  @param[in] conf_params     Parameters given to the script init().
+ *  @param[in] cache           The persistent cache.
+ *  @param[in] max_queue_size  Max number of events waiting for each
+ *                             interpreter, 0 for no limit.
+ *  @param[in] count           Number of interpreters.
+ */
+parallel_stream::parallel_stream(
+    std::string const& lua_script,
+    std::map<std::string, misc::variant> const& conf_params,
+    std::shared_ptr<persistent_cache> const& cache,
+    uint32_t max_queue_size,
+    uint32_t count)
+    : io::stream("lua"), _acks(count, 0), _last_lag_warning(0) {
+  log_v2::lua()->info("lua: starting {} interpreters running '{}'", count,
+                      lua_script);
+  _streams.reserve(count);
+  _streams.emplace_back(new lua::stream(lua_script, conf_params, cache,
+                                        max_queue_size, count, 0));
+  for (uint32_t i = 1; i < count; ++i)
+    _streams.emplace_back(new lua::stream(lua_script, conf_params,
+                                          _streams[0]->get_cache(),
+                                          max_queue_size, count, i));
+}
+
+/**
+ *  Read from the connector.
+ *
+ *  @param[out] d         Cleared.
+ *  @param[in]  deadline  Timeout.
+ *
+ *  @return This method will throw.
+ */
+bool parallel_stream::read(std::shared_ptr<io::data>& d, time_t deadline) {
+  (void)deadline;
+  d.reset();
+  throw exceptions::shutdown() << "cannot read from lua generic connector";
+}
+
+/**
+ *  Get the number of events acknowledged by all the interpreters.
+ *
+ *  @return The number of events to acknowledge.
+ */
+int parallel_stream::_merge_acks() {
+  auto minmax = std::minmax_element(_acks.begin(), _acks.end());
+  int retval = *minmax.first;
+  if (retval)
+    for (int& a : _acks)
+      a -= retval;
+
+  // An interpreter whose script does not acknowledge its events holds back
+  // the acknowledgement of all the others.
+  int behind = *minmax.second - *minmax.first;
+  if (behind >= _lag_warning_events) {
+    time_t now = time(nullptr);
+    if (now >= _last_lag_warning + _lag_warning_interval) {
+      log_v2::lua()->warn(
+          "lua: interpreter {} is {} events behind the others, no event is "
+          "acknowledged until its script acknowledges them",
+          minmax.first - _acks.begin(), behind);
+      _last_lag_warning = now;
+    }
+  }
+  return retval;
+}
+
+/**
+ *  Write an event to all the interpreters.
+ *
+ *  @param[in] data Event pointer.
+ *
+ *  @return Number of events acknowledged.
+ */
+int parallel_stream::write(std::shared_ptr<io::data> const& data) {
+  for (size_t i = 0; i < _streams.size(); ++i)
+    _acks[i] += _streams[i]->write(data);
+  return _merge_acks();
+}
+
+/**
+ *  Flush all the interpreters.
+ *
+ *  @return The number of events to ack.
+ */
+int parallel_stream::flush() {
+  for (size_t i = 0; i < _streams.size(); ++i)
+    _acks[i] += _streams[i]->flush();
+  return _merge_acks();
+}
+
+/**
+ *  Get statistics of each interpreter.
+ *
+ *  @param[out] tree  The statistics.
+ */
+void parallel_stream::statistics(json11::Json::object& tree) const {
+  for (size_t i = 0; i < _streams.size(); ++i) {
+    json11::Json::object obj;
+    _streams[i]->statistics(obj);
+    tree[fmt::format("interpreter_{}", i)] = obj;
+  }
+}
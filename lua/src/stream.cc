@@ -41,20 +41,76 @@ using namespace com::centreon::broker::lua;
 /**
  *  Constructor.
  *
- *  @param[in] addr                    Address to connect to
- *  @param[in] port                    port
+ *  @param[in] lua_script      The Lua script to load.
+ *  @param[in] conf_params     Parameters given to the script init().
+ *  @param[in] cache           The persistent cache.
+ *  @param[in] max_queue_size  Max number of events waiting for the Lua
+ *                             thread, 0 for no limit.
+ *  @param[in] shard_count     Number of interpreters running the script.
+ *  @param[in] shard_index     Index of this interpreter among them.
  */
 stream::stream(std::string const& lua_script,
                std::map<std::string, misc::variant> const& conf_params,
-               std::shared_ptr<persistent_cache> const& cache)
+               std::shared_ptr<persistent_cache> const& cache,
+               uint32_t max_queue_size,
+               uint32_t shard_count,
+               uint32_t shard_index)
     : io::stream("lua"),
       _cache{cache},
+      _max_queue_size{max_queue_size},
       _acks_count{0},
+      _events_size{0},
       _stats{{}},
       _stats_it{_stats.begin()},
       _next_stat{std::chrono::system_clock::now()},
       _exit{false},
       _flush{false} {
+  _start(lua_script, conf_params, shard_count, shard_index);
+}
+
+/**
+ *  Constructor of the other interpreters of a script, their cache is a copy
+ *  of the one of the first interpreter.
+ *
+ *  @param[in] lua_script      The Lua script to load.
+ *  @param[in] conf_params     Parameters given to the script init().
+ *  @param[in] cache           The cache to copy.
+ *  @param[in] max_queue_size  Max number of events waiting for the Lua
+ *                             thread, 0 for no limit.
+ *  @param[in] shard_count     Number of interpreters running the script.
+ *  @param[in] shard_index     Index of this interpreter among them.
+ */
+stream::stream(std::string const& lua_script,
+               std::map<std::string, misc::variant> const& conf_params,
+               macro_cache const& cache,
+               uint32_t max_queue_size,
+               uint32_t shard_count,
+               uint32_t shard_index)
+    : io::stream("lua"),
+      _cache{cache},
+      _max_queue_size{max_queue_size},
+      _acks_count{0},
+      _events_size{0},
+      _stats{{}},
+      _stats_it{_stats.begin()},
+      _next_stat{std::chrono::system_clock::now()},
+      _exit{false},
+      _flush{false} {
+  _start(lua_script, conf_params, shard_count, shard_index);
+}
+
+/**
+ *  Start the stream thread and wait for the Lua interpreter to be loaded.
+ *
+ *  @param[in] lua_script   The Lua script to load.
+ *  @param[in] conf_params  Parameters given to the script init().
+ *  @param[in] shard_count  Number of interpreters running the script.
+ *  @param[in] shard_index  Index of this interpreter among them.
+ */
+void stream::_start(std::string const& lua_script,
+                    std::map<std::string, misc::variant> const& conf_params,
+                    uint32_t shard_count,
+                    uint32_t shard_index) {
   bool fail = false;
   std::string fail_msg;
   std::mutex init_m;
@@ -70,7 +126,6 @@ stream::stream(std::string const& lua_script,
    * function just increases an _acks_count to inform broker on treated events.
    */
   _thread = std::thread([&] {
-    std::unique_lock<std::mutex> lock(init_m);
     // Access to the Lua interpreter
     luabinding* lb = nullptr;
     bool has_flush = false;
@@ -78,16 +133,22 @@ stream::stream(std::string const& lua_script,
 
     try {
       lb = new luabinding(lua_script, conf_params, _cache);
+      lb->set_shard(shard_count, shard_index);
       has_flush = lb->has_flush();
     } catch (std::exception const& e) {
       fail_msg = e.what();
-      fail = true;
       _exit = true;
     }
 
-    configured = true;
-    init_cv.notify_all();
-    if (fail)
+    /* Variables of the constructor must not be used once it is informed. */
+    bool ok = lb != nullptr;
+    {
+      std::lock_guard<std::mutex> lock(init_m);
+      fail = !ok;
+      configured = true;
+      init_cv.notify_all();
+    }
+    if (!ok)
       return;
     /**
      * Events handling starts really here. */
@@ -95,22 +156,51 @@ stream::stream(std::string const& lua_script,
     /* The count of events handled each second. */
     int count = 0;
     for (;;) {
-      /* Is the flush activated and have we received a flush ? */
-      if (has_flush && _flush) {
-        log_v2::lua()->debug("stream: flush event");
-        int32_t res = lb->flush();
+      /* We wait for events, a flush or the exit. We also wake up every second
+       * to keep the statistics up to date. Then the thread queue is swapped
+       * with exposed events. */
+      {
+        std::unique_lock<std::mutex> lck(_exposed_events_m);
+        _exposed_events_cv.wait_for(lck, std::chrono::seconds(1), [this] {
+          return !_exposed_events.empty() || _flush || _exit;
+        });
+        std::swap(_exposed_events, events);
+        _events_size = events.size();
+      }
+
+      /* Writers waiting for room in the exposed queue can go on. */
+      if (_max_queue_size && !events.empty())
+        _queue_room_cv.notify_all();
+
+      /* Events are handled by batch, counters are updated once. */
+      if (!events.empty()) {
+        uint32_t acks = 0;
+        for (std::shared_ptr<io::data> const& d : events)
+          acks += lb->write(d);
+        count += events.size();
+        events.clear();
+        _events_size = 0;
+
+        /* No more events, those waiting for write_batch() are sent. */
+        if (lb->has_write_batch())
+          acks += lb->send_batch();
         log_v2::lua()->trace(
-            "stream: {} events acknowledged by the script flush", res);
-        _acks_count += res;
+            "stream: {} events acknowledged by the script write", acks);
+        _acks_count += acks;
         log_v2::lua()->debug("stream: events to ack size: {}", _acks_count);
-        _flush = false;
       }
 
-      /* If the thread queue is empty, we swap it with exposed events */
-      if (events.empty()) {
-        std::lock_guard<std::mutex> lck(_exposed_events_m);
-        std::swap(_exposed_events, events);
-        _events_size = events.size();
+      /* Have we received a flush? */
+      if (_flush) {
+        log_v2::lua()->debug("stream: flush event");
+        if (has_flush || lb->has_write_batch()) {
+          int32_t res = lb->flush();
+          log_v2::lua()->trace(
+              "stream: {} events acknowledged by the script flush", res);
+          _acks_count += res;
+          log_v2::lua()->debug("stream: events to ack size: {}", _acks_count);
+        }
+        _flush = false;
       }
 
       /* Every seconds, we store how many events have been handled. We can
@@ -125,30 +215,18 @@ stream::stream(std::string const& lua_script,
             _stats_it = _stats.begin();
 
           // We take a point at least every 1s.
-          _next_stat =
-              std::chrono::system_clock::now() + std::chrono::seconds(1);
+          _next_stat = now + std::chrono::seconds(1);
         }
       }
 
-      /* Are there events to handle? */
-      if (!events.empty()) {
-        std::shared_ptr<io::data> d = events.front();
-        events.pop_front();
-        --_events_size;
-        ++count;
-        uint32_t res = lb->write(d);
-        log_v2::lua()->trace(
-            "stream: {} events acknowledged by the script write", res);
-        _acks_count += res;
-        log_v2::lua()->debug("stream: events to ack size: {}", _acks_count);
-      } else if (_exit) {
-        /* We exit only if the events queue is empty */
-        log_v2::lua()->debug("stream: exit");
-        break;
-      } else
-        /* We did nothing, let's wait for 500ms. We don't cook an egg with our
-         * cpus. */
-        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+      /* We exit only if the events queue is empty */
+      if (_exit) {
+        std::lock_guard<std::mutex> lck(_exposed_events_m);
+        if (_exposed_events.empty()) {
+          log_v2::lua()->debug("stream: exit");
+          break;
+        }
+      }
     }
 
     // No more need of the Lua interpreter
@@ -162,11 +240,26 @@ stream::stream(std::string const& lua_script,
   }
 }
 
+/**
+ *  Get the cache of this stream. It must only be called before the first
+ *  event is written, while the stream thread does not use it.
+ *
+ *  @return The cache.
+ */
+macro_cache const& stream::get_cache() const {
+  return _cache;
+}
+
 /**
  *  Destructor.
  */
 stream::~stream() {
-  _exit = true;
+  {
+    std::lock_guard<std::mutex> lck(_exposed_events_m);
+    _exit = true;
+  }
+  _exposed_events_cv.notify_all();
+  _queue_room_cv.notify_all();
   if (_thread.joinable())
     _thread.join();
 }
@@ -186,7 +279,9 @@ bool stream::read(std::shared_ptr<io::data>& d, time_t deadline) {
 }
 
 /**
- *  Write an event.
+ *  Write an event. If the exposed queue is full, we wait for the Lua thread
+ *  to take its content. The failover thread is then blocked and the muxer
+ *  keeps the next events in its own queue.
  *
  *  @param[in] data Event pointer.
  *
@@ -195,9 +290,17 @@ bool stream::read(std::shared_ptr<io::data>& d, time_t deadline) {
 int stream::write(std::shared_ptr<io::data> const& data) {
   assert(data);
   {
-    std::lock_guard<std::mutex> lck(_exposed_events_m);
+    std::unique_lock<std::mutex> lck(_exposed_events_m);
+    if (_max_queue_size && _exposed_events.size() >= _max_queue_size) {
+      log_v2::lua()->debug("stream: queue full with {} events, waiting",
+                           _exposed_events.size());
+      _queue_room_cv.wait(lck, [this] {
+        return _exposed_events.size() < _max_queue_size || _exit;
+      });
+    }
     _exposed_events.push_back(data);
   }
+  _exposed_events_cv.notify_one();
 
   int retval = _acks_count;
   _acks_count -= retval;
@@ -218,6 +321,7 @@ int stream::flush() {
   if (!_flush) {
     log_v2::lua()->debug("stream: flush forced");
     _flush = true;
+    _exposed_events_cv.notify_one();
   }
 
   int retval = _acks_count;
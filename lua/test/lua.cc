@@ -19,6 +19,7 @@
 #include <fmt/format.h>
 #include <gtest/gtest.h>
 
+#include <array>
 #include <cstdio>
 #include <fstream>
 #include <list>
@@ -27,8 +28,11 @@
 #include "../../core/test/test_server.hh"
 #include "com/centreon/broker/config/applier/init.hh"
 #include "com/centreon/broker/exceptions/msg.hh"
+#include "com/centreon/broker/lua/json_encoder.hh"
 #include "com/centreon/broker/lua/luabinding.hh"
 #include "com/centreon/broker/lua/macro_cache.hh"
+#include "com/centreon/broker/lua/parallel_stream.hh"
+#include "com/centreon/broker/lua/stream.hh"
 #include "com/centreon/broker/misc/string.hh"
 #include "com/centreon/broker/misc/variant.hh"
 #include "com/centreon/broker/modules/loader.hh"
@@ -2062,3 +2066,319 @@ TEST_F(LuaTest, BrokerEventCache) {
   RemoveFile("/tmp/event_log");
 }
 
+
+// When a script defines write_batch()
+// Then events are given to it by arrays of broker_batch_size events and the
+// last incomplete array is given on send_batch().
+TEST_F(LuaTest, WriteBatch) {
+  modules::loader l;
+  l.load_file("./neb/10-neb.so");
+  std::map<std::string, misc::variant> conf;
+  std::string filename("/tmp/write_batch.lua");
+  CreateScript(filename,
+               "broker_api_version = 2\n"
+               "broker_batch_size = 2\n"
+               "function init(conf)\n"
+               "  broker_log:set_parameters(3, '/tmp/event_log')\n"
+               "end\n\n"
+               "function write_batch(events)\n"
+               "  broker_log:info(0, 'batch of ' .. #events)\n"
+               "  for i,e in ipairs(events) do\n"
+               "    broker_log:info(0, 'host ' .. e.host_id)\n"
+               "  end\n"
+               "  return true\n"
+               "end\n");
+  std::unique_ptr<luabinding> binding(new luabinding(filename, conf, *_cache));
+  ASSERT_TRUE(binding->has_write_batch());
+  std::array<int32_t, 3> acks;
+  for (int i = 0; i < 3; ++i) {
+    std::shared_ptr<neb::service> svc(new neb::service);
+    svc->host_id = i + 1;
+    svc->service_id = 1;
+    acks[i] = binding->write(svc);
+  }
+  ASSERT_EQ(acks[0], 0);
+  ASSERT_EQ(acks[1], 2);
+  ASSERT_EQ(acks[2], 0);
+  ASSERT_EQ(binding->send_batch(), 1);
+  ASSERT_EQ(binding->send_batch(), 0);
+
+  std::string lst(ReadFile("/tmp/event_log"));
+  size_t pos1 = lst.find("batch of 2");
+  size_t pos2 = lst.find("host 2");
+  size_t pos3 = lst.find("batch of 1");
+  size_t pos4 = lst.find("host 3");
+  ASSERT_NE(pos1, std::string::npos);
+  ASSERT_NE(pos2, std::string::npos);
+  ASSERT_NE(pos3, std::string::npos);
+  ASSERT_NE(pos4, std::string::npos);
+  ASSERT_LT(pos2, pos3);
+  ASSERT_LT(pos3, pos4);
+  RemoveFile(filename);
+  RemoveFile("/tmp/event_log");
+}
+
+// When a script declares a filter on hosts and services
+// Then rejected events are not given to write() and they are acknowledged
+// immediately when no event is waiting for an acknowledgement.
+TEST_F(LuaTest, SetFilterIds) {
+  modules::loader l;
+  l.load_file("./neb/10-neb.so");
+  std::map<std::string, misc::variant> conf;
+  std::string filename("/tmp/set_filter.lua");
+  CreateScript(filename,
+               "broker_api_version = 2\n"
+               "function init(conf)\n"
+               "  broker_log:set_parameters(3, '/tmp/event_log')\n"
+               "  broker.set_filter({ hosts = { 1 },\n"
+               "                      services = { { 2, 5 } } })\n"
+               "end\n\n"
+               "function write(d)\n"
+               "  broker_log:info(0, 'host ' .. d.host_id .. ' service ' .. "
+               "d.service_id)\n"
+               "  return d.service_id == 5\n"
+               "end\n");
+  std::unique_ptr<luabinding> binding(new luabinding(filename, conf, *_cache));
+  std::array<std::pair<uint32_t, uint32_t>, 4> ids{
+      {{1, 1}, {2, 4}, {2, 5}, {3, 1}}};
+  std::array<int32_t, 4> acks;
+  for (int i = 0; i < 4; ++i) {
+    std::shared_ptr<neb::service> svc(new neb::service);
+    svc->host_id = ids[i].first;
+    svc->service_id = ids[i].second;
+    acks[i] = binding->write(svc);
+  }
+  ASSERT_EQ(acks[0], 0);
+  ASSERT_EQ(acks[1], 0);
+  ASSERT_EQ(acks[2], 3);
+  ASSERT_EQ(acks[3], 1);
+
+  std::string lst(ReadFile("/tmp/event_log"));
+  ASSERT_NE(lst.find("host 1 service 1"), std::string::npos);
+  ASSERT_NE(lst.find("host 2 service 5"), std::string::npos);
+  ASSERT_EQ(lst.find("host 2 service 4"), std::string::npos);
+  ASSERT_EQ(lst.find("host 3 service 1"), std::string::npos);
+  RemoveFile(filename);
+  RemoveFile("/tmp/event_log");
+}
+
+// When a script declares a filter on categories and elements
+// Then only events of these types are given to write().
+TEST_F(LuaTest, SetFilterTypes) {
+  modules::loader l;
+  l.load_file("./neb/10-neb.so");
+  std::map<std::string, misc::variant> conf;
+  std::string filename("/tmp/set_filter.lua");
+  CreateScript(filename,
+               "function init(conf)\n"
+               "  broker_log:set_parameters(3, '/tmp/event_log')\n"
+               "  broker.set_filter({ categories = { 3 }, elements = { { 1, "
+               "23 } } })\n"
+               "end\n\n"
+               "function write(d)\n"
+               "  broker_log:info(0, 'element ' .. d.element)\n"
+               "  return true\n"
+               "end\n");
+  std::unique_ptr<luabinding> binding(new luabinding(filename, conf, *_cache));
+  std::shared_ptr<neb::service> svc(new neb::service);
+  svc->host_id = 1;
+  svc->service_id = 2;
+  ASSERT_EQ(binding->write(svc), 1);
+  std::shared_ptr<neb::host> hst(new neb::host);
+  hst->host_id = 1;
+  ASSERT_EQ(binding->write(hst), 1);
+
+  std::string lst(ReadFile("/tmp/event_log"));
+  ASSERT_NE(lst.find("element 23"), std::string::npos);
+  ASSERT_EQ(lst.find("element 12"), std::string::npos);
+  RemoveFile(filename);
+  RemoveFile("/tmp/event_log");
+}
+
+// When a script declares an invalid filter
+// Then an exception is thrown by the init() call.
+TEST_F(LuaTest, SetFilterError) {
+  std::map<std::string, misc::variant> conf;
+  std::string filename("/tmp/set_filter.lua");
+  CreateScript(filename,
+               "function init(conf)\n"
+               "  broker.set_filter({ hosts = 'foo' })\n"
+               "end\n\n"
+               "function write(d)\n"
+               "  return true\n"
+               "end\n");
+  ASSERT_THROW(new luabinding(filename, conf, *_cache), exceptions::msg);
+  RemoveFile(filename);
+}
+
+// When a Lua stream is configured with a max queue size
+// Then write() waits for room in the queue and all the events are finally
+// acknowledged.
+TEST_F(LuaTest, StreamMaxQueueSize) {
+  modules::loader l;
+  l.load_file("./neb/10-neb.so");
+  std::map<std::string, misc::variant> conf;
+  std::string filename("/tmp/stream_queue.lua");
+  CreateScript(filename,
+               "function init(conf)\n"
+               "end\n\n"
+               "function write(d)\n"
+               "  return true\n"
+               "end\n");
+  std::shared_ptr<persistent_cache> pcache(
+      std::make_shared<persistent_cache>("/tmp/broker_test_stream_cache"));
+  std::unique_ptr<lua::stream> s(new lua::stream(filename, conf, pcache, 10));
+  int acks = 0;
+  for (int i = 0; i < 100; ++i) {
+    std::shared_ptr<neb::service> svc(new neb::service);
+    svc->host_id = 1;
+    svc->service_id = i + 1;
+    acks += s->write(svc);
+  }
+  for (int i = 0; i < 50 && acks < 100; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    acks += s->flush();
+  }
+  ASSERT_EQ(acks, 100);
+  s.reset();
+  RemoveFile(filename);
+  RemoveFile("/tmp/broker_test_stream_cache");
+}
+
+// When an interpreter handles a shard of the events
+// Then it only gives to the script the events of its hosts, the other ones
+// being acknowledged with them.
+TEST_F(LuaTest, Shard) {
+  modules::loader l;
+  l.load_file("./neb/10-neb.so");
+  std::map<std::string, misc::variant> conf;
+  std::string filename("/tmp/shard.lua");
+  CreateScript(filename,
+               "function init(conf)\n"
+               "  broker_log:set_parameters(3, '/tmp/event_log')\n"
+               "end\n\n"
+               "function write(d)\n"
+               "  broker_log:info(0, 'host ' .. d.host_id)\n"
+               "  return true\n"
+               "end\n");
+  std::unique_ptr<luabinding> binding(new luabinding(filename, conf, *_cache));
+  binding->set_shard(2, 1);
+  int acks = 0;
+  for (uint32_t i = 1; i <= 4; ++i) {
+    std::shared_ptr<neb::service> svc(new neb::service);
+    svc->host_id = i;
+    svc->service_id = 1;
+    acks += binding->write(svc);
+  }
+  ASSERT_EQ(acks, 4);
+
+  std::string lst(ReadFile("/tmp/event_log"));
+  ASSERT_NE(lst.find("host 1"), std::string::npos);
+  ASSERT_EQ(lst.find("host 2"), std::string::npos);
+  ASSERT_NE(lst.find("host 3"), std::string::npos);
+  ASSERT_EQ(lst.find("host 4"), std::string::npos);
+  RemoveFile(filename);
+  RemoveFile("/tmp/event_log");
+}
+
+// When several interpreters run the same script
+// Then each event is given to one of them and all the events are finally
+// acknowledged.
+TEST_F(LuaTest, ParallelStream) {
+  modules::loader l;
+  l.load_file("./neb/10-neb.so");
+  std::map<std::string, misc::variant> conf;
+  std::string filename("/tmp/parallel_stream.lua");
+  CreateScript(filename,
+               "function init(conf)\n"
+               "  broker_log:set_parameters(3, '/tmp/event_log')\n"
+               "end\n\n"
+               "function write(d)\n"
+               "  broker_log:info(0, 'host ' .. d.host_id .. ';')\n"
+               "  return true\n"
+               "end\n");
+  std::shared_ptr<persistent_cache> pcache(
+      std::make_shared<persistent_cache>("/tmp/broker_test_stream_cache"));
+  std::unique_ptr<parallel_stream> s(
+      new parallel_stream(filename, conf, pcache, 0, 3));
+  int acks = 0;
+  for (int i = 1; i <= 30; ++i) {
+    std::shared_ptr<neb::service> svc(new neb::service);
+    svc->host_id = i;
+    svc->service_id = 1;
+    acks += s->write(svc);
+  }
+  for (int i = 0; i < 50 && acks < 30; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    acks += s->flush();
+  }
+  ASSERT_EQ(acks, 30);
+  s.reset();
+
+  std::string lst(ReadFile("/tmp/event_log"));
+  for (int i = 1; i <= 30; ++i) {
+    std::string str(fmt::format("host {};", i));
+    size_t pos = lst.find(str);
+    ASSERT_NE(pos, std::string::npos);
+    ASSERT_EQ(lst.find(str, pos + 1), std::string::npos);
+  }
+  RemoveFile(filename);
+  RemoveFile("/tmp/event_log");
+  RemoveFile("/tmp/broker_test_stream_cache");
+}
+
+// When strings are given to the json encoder
+// Then quotes, backslashes and control characters are escaped wherever they
+// are in the string.
+TEST_F(LuaTest, JsonEncoderEscape) {
+  json_encoder encoder;
+  std::string str("0123456789abcdef\"0123456789\\abcdef\t\x01\n");
+  encoder.append_string(str.data(), str.size());
+  ASSERT_EQ(encoder.str(),
+            "\"0123456789abcdef\\\"0123456789\\\\abcdef\\t\\u0001\\n\"");
+  encoder.clear();
+  encoder.append_string("", 0);
+  ASSERT_EQ(encoder.str(), "\"\"");
+}
+
+// When broker.json_encode_batch() is called on an array of events
+// Then we get one json per line.
+TEST_F(LuaTest, BrokerEventJsonEncodeBatch) {
+  modules::loader l;
+  l.load_file("./neb/10-neb.so");
+  std::map<std::string, misc::variant> conf;
+  std::string filename("/tmp/json_batch.lua");
+  CreateScript(filename,
+               "broker_api_version = 2\n"
+               "broker_batch_size = 2\n"
+               "function init(conf)\n"
+               "  broker_log:set_parameters(3, '/tmp/event_log')\n"
+               "end\n\n"
+               "function write_batch(events)\n"
+               "  broker_log:info(0, broker.json_encode_batch(events))\n"
+               "  broker_log:info(0, broker.json_encode_batch({ { a = 1 }, "
+               "'b\"' }))\n"
+               "  return true\n"
+               "end\n");
+  std::unique_ptr<luabinding> binding(new luabinding(filename, conf, *_cache));
+  for (int i = 1; i <= 2; ++i) {
+    std::shared_ptr<neb::service> svc(new neb::service);
+    svc->host_id = i;
+    svc->service_id = 3;
+    svc->output = "out\"put";
+    binding->write(svc);
+  }
+  std::string lst(ReadFile("/tmp/event_log"));
+  size_t pos1 = lst.find("\"host_id\":1,");
+  size_t pos2 = lst.find("}\n{ \"_type\": 65559");
+  size_t pos3 = lst.find("\"host_id\":2,");
+  ASSERT_NE(pos1, std::string::npos);
+  ASSERT_NE(pos2, std::string::npos);
+  ASSERT_NE(pos3, std::string::npos);
+  ASSERT_LT(pos1, pos2);
+  ASSERT_LT(pos2, pos3);
+  ASSERT_NE(lst.find("\"output\":\"out\\\"put\""), std::string::npos);
+  ASSERT_NE(lst.find("{\"a\":1}\n\"b\\\"\"\n"), std::string::npos);
+  RemoveFile(filename);
+  RemoveFile("/tmp/event_log");
+}
@@ -0,0 +1,203 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+/*
+ *  Benchmark of the service status events generated by the NEB callbacks.
+ *
+ *  Service statuses are filled like in callback_service_status() and paced
+ *  at a fixed rate (100k events/s by default). A consumer thread releases
+ *  them as the broker would. Each event is either allocated or taken from an
+ *  object pool, and the cost per event of the producer (acquisition and
+ *  fill, pacing excluded) is reported for both.
+ *
+ *  Usage: bench_neb_service_status [events] [events per second]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "com/centreon/broker/misc/mpmc_queue.hh"
+#include "com/centreon/broker/misc/object_pool.hh"
+#include "com/centreon/broker/misc/string.hh"
+#include "com/centreon/broker/neb/service_status.hh"
+
+using namespace com::centreon::broker;
+
+namespace {
+/**
+ *  Strings returned by the engine service getters.
+ */
+struct service {
+  std::string check_command{"check_centreon_ping!3!200,20%"};
+  std::string check_period{"24x7"};
+  std::string event_handler{"restart_service"};
+  std::string plugin_output{
+      "OK - 127.0.0.1 rta 0.042ms lost 0% | rta=0.042ms;200;400;0;"};
+  std::string long_plugin_output{"Packets: 3 sent, 3 received"};
+  std::string perf_data{
+      "rta=0.042ms;200.000;400.000;0; pl=0%;20;50;0;100 "
+      "rtmax=0.060ms;;;; rtmin=0.034ms;;;;"};
+  std::string hostname{"central-host-0042"};
+  std::string description{"Ping"};
+};
+
+/**
+ *  Fill a service status as callback_service_status() does.
+ *
+ *  @param[out] ss  The event.
+ *  @param[in]  s   The service.
+ *  @param[in]  i   Index of the event.
+ */
+void fill(neb::service_status& ss, service const& s, uint32_t i) {
+  ss.acknowledged = false;
+  ss.acknowledgement_type = 0;
+  ss.active_checks_enabled = true;
+  if (!s.check_command.empty())
+    misc::string::assign_utf8(ss.check_command, s.check_command);
+  ss.check_interval = 5;
+  if (!s.check_period.empty())
+    ss.check_period = s.check_period;
+  ss.check_type = 0;
+  ss.current_check_attempt = 1;
+  ss.current_state = i % 4;
+  ss.downtime_depth = 0;
+  if (!s.event_handler.empty())
+    misc::string::assign_utf8(ss.event_handler, s.event_handler);
+  ss.event_handler_enabled = true;
+  ss.execution_time = 0.1;
+  ss.flap_detection_enabled = true;
+  ss.has_been_checked = true;
+  ss.is_flapping = false;
+  ss.last_check = i;
+  ss.last_hard_state = 0;
+  ss.last_hard_state_change = i;
+  ss.last_notification = 0;
+  ss.notification_number = 0;
+  ss.last_state_change = i;
+  ss.last_time_critical = 0;
+  ss.last_time_ok = i;
+  ss.last_time_unknown = 0;
+  ss.last_time_warning = 0;
+  ss.last_update = time(nullptr);
+  ss.latency = 0.2;
+  ss.max_check_attempts = 3;
+  ss.next_check = i + 300;
+  ss.next_notification = 0;
+  ss.no_more_notifications = false;
+  ss.notifications_enabled = true;
+  ss.obsess_over = false;
+  if (!s.plugin_output.empty()) {
+    misc::string::assign_utf8(ss.output, s.plugin_output);
+    ss.output.append("\n");
+  }
+  if (!s.long_plugin_output.empty())
+    misc::string::append_utf8(ss.output, s.long_plugin_output);
+  ss.passive_checks_enabled = true;
+  ss.percent_state_change = 0;
+  if (!s.perf_data.empty())
+    misc::string::assign_utf8(ss.perf_data, s.perf_data);
+  ss.retry_interval = 1;
+  misc::string::assign_utf8(ss.host_name, s.hostname);
+  misc::string::assign_utf8(ss.service_description, s.description);
+  ss.host_id = 42;
+  ss.service_id = i + 1;
+  ss.should_be_scheduled = true;
+  ss.state_type = 1;
+}
+
+/**
+ *  Replay service statuses at a fixed rate.
+ *
+ *  @param[in] name     Name of the run.
+ *  @param[in] count    Number of events.
+ *  @param[in] rate     Events per second.
+ *  @param[in] acquire  Function returning a new event.
+ */
+void run(char const* name,
+         uint32_t count,
+         uint32_t rate,
+         std::function<std::shared_ptr<neb::service_status>()> acquire) {
+  service const s;
+  misc::mpmc_queue<std::shared_ptr<neb::service_status>> q(4096);
+  std::thread consumer([&q, count]() {
+    std::shared_ptr<neb::service_status> ss;
+    for (uint32_t i = 0; i < count;) {
+      if (q.try_pop(ss)) {
+        ss.reset();
+        ++i;
+      } else
+        std::this_thread::yield();
+    }
+  });
+
+  std::chrono::nanoseconds period(std::chrono::seconds(1));
+  period /= rate;
+  std::chrono::nanoseconds spent(0);
+  std::chrono::steady_clock::time_point start(
+      std::chrono::steady_clock::now());
+  for (uint32_t i = 0; i < count; ++i) {
+    std::chrono::steady_clock::time_point due(start + i * period);
+    while (std::chrono::steady_clock::now() < due)
+      ;
+    std::chrono::steady_clock::time_point begin(
+        std::chrono::steady_clock::now());
+    std::shared_ptr<neb::service_status> ss(acquire());
+    fill(*ss, s, i);
+    spent += std::chrono::steady_clock::now() - begin;
+    while (!q.try_push(ss))
+      std::this_thread::yield();
+  }
+  consumer.join();
+  std::chrono::duration<double> elapsed(std::chrono::steady_clock::now() -
+                                        start);
+
+  std::printf("%-10s %u events in %.2fs (%.0f events/s), %.0f ns/event\n",
+              name, count, elapsed.count(), count / elapsed.count(),
+              static_cast<double>(spent.count()) / count);
+}
+}  // namespace
+
+/**
+ *  Benchmark entry point.
+ *
+ *  @param[in] argc  Argument count.
+ *  @param[in] argv  Optional event count and rate.
+ *
+ *  @return EXIT_SUCCESS on success.
+ */
+int main(int argc, char* argv[]) {
+  uint32_t count(argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000);
+  uint32_t rate(argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 100000);
+  if (!count || !rate) {
+    std::fprintf(stderr, "usage: %s [events] [events per second]\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  run("allocated", count, rate, []() {
+    return std::shared_ptr<neb::service_status>(new neb::service_status);
+  });
+  misc::object_pool<neb::service_status> pool;
+  run("pooled", count, rate, [&pool]() { return pool.acquire(); });
+  return EXIT_SUCCESS;
+}
@@ -24,7 +24,7 @@
 #include <string>
 #include <utility>
 #include "com/centreon/broker/logging/backend.hh"
-#include "com/centreon/broker/multiplexing/publisher.hh"
+#include "com/centreon/broker/multiplexing/async_publisher.hh"
 #include "com/centreon/broker/namespace.hh"
 #include "com/centreon/broker/neb/callback.hh"
 
@@ -68,7 +68,7 @@ enum data_element {
 extern std::string gl_configuration_file;
 
 // Sender object.
-extern multiplexing::publisher gl_publisher;
+extern multiplexing::async_publisher gl_publisher;
 
 // Registered callbacks.
 extern std::list<std::shared_ptr<neb::callback> > gl_registered_callbacks;
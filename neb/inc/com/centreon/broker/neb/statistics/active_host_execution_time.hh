@@ -39,7 +39,9 @@ class active_host_execution_time : public plugin {
   ~active_host_execution_time();
   active_host_execution_time& operator=(
       active_host_execution_time const& right);
-  void run(std::string& output, std::string& perfdata);
+  void run(std::string& output,
+           std::string& perfdata,
+           aggregate const& stats);
 };
 }  // namespace statistics
 }  // namespace neb
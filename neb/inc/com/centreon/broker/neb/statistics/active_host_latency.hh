@@ -38,7 +38,9 @@ class active_host_latency : public plugin {
   active_host_latency(active_host_latency const& right);
   ~active_host_latency();
   active_host_latency& operator=(active_host_latency const& right);
-  void run(std::string& output, std::string& perfdata);
+  void run(std::string& output,
+           std::string& perfdata,
+           aggregate const& stats);
 };
 }  // namespace statistics
 }  // namespace neb
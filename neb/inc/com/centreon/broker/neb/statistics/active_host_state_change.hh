@@ -38,7 +38,9 @@ class active_host_state_change : public plugin {
   active_host_state_change(active_host_state_change const& right);
   ~active_host_state_change();
   active_host_state_change& operator=(active_host_state_change const& right);
-  void run(std::string& output, std::string& perfdata);
+  void run(std::string& output,
+           std::string& perfdata,
+           aggregate const& stats);
 };
 }  // namespace statistics
 }  // namespace neb
@@ -38,7 +38,9 @@ class active_hosts_last : public plugin {
   active_hosts_last(active_hosts_last const& right);
   ~active_hosts_last();
   active_hosts_last& operator=(active_hosts_last const& right);
-  void run(std::string& output, std::string& perfdata);
+  void run(std::string& output,
+           std::string& perfdata,
+           aggregate const& stats);
 };
 }  // namespace statistics
 }  // namespace neb
@@ -39,7 +39,9 @@ class active_service_execution_time : public plugin {
   ~active_service_execution_time();
   active_service_execution_time& operator=(
       active_service_execution_time const& right);
-  void run(std::string& output, std::string& perfdata);
+  void run(std::string& output,
+           std::string& perfdata,
+           aggregate const& stats);
 };
 }  // namespace statistics
 }  // namespace neb
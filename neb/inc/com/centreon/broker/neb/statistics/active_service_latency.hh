@@ -38,7 +38,9 @@ class active_service_latency : public plugin {
   active_service_latency(active_service_latency const& right);
   ~active_service_latency();
   active_service_latency& operator=(active_service_latency const& right);
-  void run(std::string& output, std::string& perfdata);
+  void run(std::string& output,
+           std::string& perfdata,
+           aggregate const& stats);
 };
 }  // namespace statistics
 }  // namespace neb
@@ -39,7 +39,9 @@ class active_service_state_change : public plugin {
   ~active_service_state_change();
   active_service_state_change& operator=(
       active_service_state_change const& right);
-  void run(std::string& output, std::string& perfdata);
+  void run(std::string& output,
+           std::string& perfdata,
+           aggregate const& stats);
 };
 }  // namespace statistics
 }  // namespace neb
@@ -38,7 +38,9 @@ class active_services_last : public plugin {
   active_services_last(active_services_last const& right);
   ~active_services_last();
   active_services_last& operator=(active_services_last const& right);
-  void run(std::string& output, std::string& perfdata);
+  void run(std::string& output,
+           std::string& perfdata,
+           aggregate const& stats);
 };
 }  // namespace statistics
 }  // namespace neb
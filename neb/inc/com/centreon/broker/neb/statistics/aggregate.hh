@@ -0,0 +1,79 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#ifndef CCB_NEB_STATISTICS_AGGREGATE_HH
+#define CCB_NEB_STATISTICS_AGGREGATE_HH
+
+#include <ctime>
+#include "com/centreon/broker/namespace.hh"
+#include "com/centreon/broker/neb/statistics/compute_value.hh"
+
+CCB_BEGIN()
+
+namespace neb {
+namespace statistics {
+/**
+ *  @class aggregate aggregate.hh
+ * "com/centreon/broker/neb/statistics/aggregate.hh"
+ *  @brief Host and service values used by the statistics plugins.
+ *
+ *  The generator computes them once per run, with a single pass over the
+ *  hosts and a single pass over the services of the engine, then all the
+ *  plugins build their output from them.
+ */
+class aggregate {
+ public:
+  /**
+   *  Values computed on the hosts or on the services.
+   */
+  struct checkables {
+    checkables();
+
+    uint32_t total;
+    // Count of objects per current state.
+    uint32_t states[4];
+    uint32_t checked;
+    uint32_t actively_checked;
+    uint32_t flapping;
+    uint32_t scheduled;
+    compute_value<double> active_execution_time;
+    compute_value<double> active_latency;
+    compute_value<double> passive_latency;
+    compute_value<double> active_state_change;
+    compute_value<double> passive_state_change;
+    compute_value<double> state_change;
+    // Count of objects checked during the last 1, 5, 15 and 60 minutes.
+    uint32_t active_last[4];
+    uint32_t passive_last[4];
+  };
+
+  checkables hosts;
+  checkables services;
+
+  aggregate() = default;
+  aggregate(aggregate const&) = delete;
+  aggregate& operator=(aggregate const&) = delete;
+  ~aggregate() = default;
+  void compute(time_t now);
+};
+}  // namespace statistics
+}  // namespace neb
+
+CCB_END()
+
+#endif  // !CCB_NEB_STATISTICS_AGGREGATE_HH
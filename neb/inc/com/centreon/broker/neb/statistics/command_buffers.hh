@@ -38,7 +38,9 @@ class command_buffers : public plugin {
   command_buffers(command_buffers const& right);
   ~command_buffers();
   command_buffers& operator=(command_buffers const& right);
-  void run(std::string& output, std::string& perfdata);
+  void run(std::string& output,
+           std::string& perfdata,
+           aggregate const& stats);
 };
 }  // namespace statistics
 }  // namespace neb
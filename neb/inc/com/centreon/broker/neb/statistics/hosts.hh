@@ -37,7 +37,9 @@ class hosts : public plugin {
   hosts(hosts const& right);
   ~hosts();
   hosts& operator=(hosts const& right);
-  void run(std::string& output, std::string& perfdata);
+  void run(std::string& output,
+           std::string& perfdata,
+           aggregate const& stats);
 };
 }  // namespace statistics
 }  // namespace neb
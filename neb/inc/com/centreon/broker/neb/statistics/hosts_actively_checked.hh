@@ -38,7 +38,9 @@ class hosts_actively_checked : public plugin {
   hosts_actively_checked(hosts_actively_checked const& right);
   ~hosts_actively_checked();
   hosts_actively_checked& operator=(hosts_actively_checked const& right);
-  void run(std::string& output, std::string& perfdata);
+  void run(std::string& output,
+           std::string& perfdata,
+           aggregate const& stats);
 };
 }  // namespace statistics
 }  // namespace neb
@@ -38,7 +38,9 @@ class hosts_checked : public plugin {
   hosts_checked(hosts_checked const& right);
   ~hosts_checked();
   hosts_checked& operator=(hosts_checked const& right);
-  void run(std::string& output, std::string& perfdata);
+  void run(std::string& output,
+           std::string& perfdata,
+           aggregate const& stats);
 };
 }  // namespace statistics
 }  // namespace neb
@@ -38,7 +38,9 @@ class hosts_flapping : public plugin {
   hosts_flapping(hosts_flapping const& right);
   ~hosts_flapping();
   hosts_flapping& operator=(hosts_flapping const& right);
-  void run(std::string& output, std::string& perfdata);
+  void run(std::string& output,
+           std::string& perfdata,
+           aggregate const& stats);
 };
 }  // namespace statistics
 }  // namespace neb
@@ -38,7 +38,9 @@ class hosts_scheduled : public plugin {
   hosts_scheduled(hosts_scheduled const& right);
   ~hosts_scheduled();
   hosts_scheduled& operator=(hosts_scheduled const& right);
-  void run(std::string& output, std::string& perfdata);
+  void run(std::string& output,
+           std::string& perfdata,
+           aggregate const& stats);
 };
 }  // namespace statistics
 }  // namespace neb
@@ -38,7 +38,9 @@ class passive_host_latency : public plugin {
   passive_host_latency(passive_host_latency const& right);
   ~passive_host_latency();
   passive_host_latency& operator=(passive_host_latency const& right);
-  void run(std::string& output, std::string& perfdata);
+  void run(std::string& output,
+           std::string& perfdata,
+           aggregate const& stats);
 };
 }  // namespace statistics
 }  // namespace neb
@@ -38,7 +38,9 @@ class passive_host_state_change : public plugin {
   passive_host_state_change(passive_host_state_change const& right);
   ~passive_host_state_change();
   passive_host_state_change& operator=(passive_host_state_change const& right);
-  void run(std::string& output, std::string& perfdata);
+  void run(std::string& output,
+           std::string& perfdata,
+           aggregate const& stats);
 };
 }  // namespace statistics
 }  // namespace neb
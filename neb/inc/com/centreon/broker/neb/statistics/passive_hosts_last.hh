@@ -38,7 +38,9 @@ class passive_hosts_last : public plugin {
   passive_hosts_last(passive_hosts_last const& right);
   ~passive_hosts_last();
   passive_hosts_last& operator=(passive_hosts_last const& right);
-  void run(std::string& output, std::string& perfdata);
+  void run(std::string& output,
+           std::string& perfdata,
+           aggregate const& stats);
 };
 }  // namespace statistics
 }  // namespace neb
@@ -38,7 +38,9 @@ class passive_service_latency : public plugin {
   passive_service_latency(passive_service_latency const& right);
   ~passive_service_latency();
   passive_service_latency& operator=(passive_service_latency const& right);
-  void run(std::string& output, std::string& perfdata);
+  void run(std::string& output,
+           std::string& perfdata,
+           aggregate const& stats);
 };
 }  // namespace statistics
 }  // namespace neb
@@ -39,7 +39,9 @@ class passive_service_state_change : public plugin {
   ~passive_service_state_change();
   passive_service_state_change& operator=(
       passive_service_state_change const& right);
-  void run(std::string& output, std::string& perfdata);
+  void run(std::string& output,
+           std::string& perfdata,
+           aggregate const& stats);
 };
 }  // namespace statistics
 }  // namespace neb
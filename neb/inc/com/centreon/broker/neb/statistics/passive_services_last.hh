@@ -38,7 +38,9 @@ class passive_services_last : public plugin {
   passive_services_last(passive_services_last const& right);
   ~passive_services_last();
   passive_services_last& operator=(passive_services_last const& right);
-  void run(std::string& output, std::string& perfdata);
+  void run(std::string& output,
+           std::string& perfdata,
+           aggregate const& stats);
 };
 }  // namespace statistics
 }  // namespace neb
@@ -21,6 +21,7 @@
 
 #include <string>
 #include "com/centreon/broker/namespace.hh"
+#include "com/centreon/broker/neb/statistics/aggregate.hh"
 
 CCB_BEGIN()
 
@@ -37,7 +38,9 @@ class plugin {
   virtual ~plugin();
   plugin& operator=(plugin const& right);
   virtual std::string const& name() const throw();
-  virtual void run(std::string& output, std::string& perfdata) = 0;
+  virtual void run(std::string& output,
+                   std::string& perfdata,
+                   aggregate const& stats) = 0;
 
  protected:
   std::string _name;
@@ -37,7 +37,9 @@ class services : public plugin {
   services(services const& right);
   ~services();
   services& operator=(services const& right);
-  void run(std::string& output, std::string& perfdata);
+  void run(std::string& output,
+           std::string& perfdata,
+           aggregate const& stats);
 };
 }  // namespace statistics
 }  // namespace neb
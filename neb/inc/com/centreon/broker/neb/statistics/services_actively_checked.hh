@@ -38,7 +38,9 @@ class services_actively_checked : public plugin {
   services_actively_checked(services_actively_checked const& right);
   ~services_actively_checked();
   services_actively_checked& operator=(services_actively_checked const& right);
-  void run(std::string& output, std::string& perfdata);
+  void run(std::string& output,
+           std::string& perfdata,
+           aggregate const& stats);
 };
 }  // namespace statistics
 }  // namespace neb
@@ -38,7 +38,9 @@ class services_checked : public plugin {
   services_checked(services_checked const& right);
   ~services_checked();
   services_checked& operator=(services_checked const& right);
-  void run(std::string& output, std::string& perfdata);
+  void run(std::string& output,
+           std::string& perfdata,
+           aggregate const& stats);
 };
 }  // namespace statistics
 }  // namespace neb
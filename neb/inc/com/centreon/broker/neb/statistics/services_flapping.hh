@@ -38,7 +38,9 @@ class services_flapping : public plugin {
   services_flapping(services_flapping const& right);
   ~services_flapping();
   services_flapping& operator=(services_flapping const& right);
-  void run(std::string& output, std::string& perfdata);
+  void run(std::string& output,
+           std::string& perfdata,
+           aggregate const& stats);
 };
 }  // namespace statistics
 }  // namespace neb
@@ -38,7 +38,9 @@ class services_scheduled : public plugin {
   services_scheduled(services_scheduled const& right);
   ~services_scheduled();
   services_scheduled& operator=(services_scheduled const& right);
-  void run(std::string& output, std::string& perfdata);
+  void run(std::string& output,
+           std::string& perfdata,
+           aggregate const& stats);
 };
 }  // namespace statistics
 }  // namespace neb
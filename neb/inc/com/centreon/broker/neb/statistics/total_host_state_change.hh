@@ -38,7 +38,9 @@ class total_host_state_change : public plugin {
   total_host_state_change(total_host_state_change const& right);
   ~total_host_state_change();
   total_host_state_change& operator=(total_host_state_change const& right);
-  void run(std::string& output, std::string& perfdata);
+  void run(std::string& output,
+           std::string& perfdata,
+           aggregate const& stats);
 };
 }  // namespace statistics
 }  // namespace neb
@@ -38,7 +38,9 @@ class total_hosts : public plugin {
   total_hosts(total_hosts const& right);
   ~total_hosts();
   total_hosts& operator=(total_hosts const& right);
-  void run(std::string& output, std::string& perfdata);
+  void run(std::string& output,
+           std::string& perfdata,
+           aggregate const& stats);
 };
 }  // namespace statistics
 }  // namespace neb
@@ -39,7 +39,9 @@ class total_service_state_change : public plugin {
   ~total_service_state_change();
   total_service_state_change& operator=(
       total_service_state_change const& right);
-  void run(std::string& output, std::string& perfdata);
+  void run(std::string& output,
+           std::string& perfdata,
+           aggregate const& stats);
 };
 }  // namespace statistics
 }  // namespace neb
@@ -38,7 +38,9 @@ class total_services : public plugin {
   total_services(total_services const& right);
   ~total_services();
   total_services& operator=(total_services const& right);
-  void run(std::string& output, std::string& perfdata);
+  void run(std::string& output,
+           std::string& perfdata,
+           aggregate const& stats);
 };
 }  // namespace statistics
 }  // namespace neb
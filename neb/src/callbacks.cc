@@ -31,6 +31,7 @@
 #include "com/centreon/broker/config/state.hh"
 #include "com/centreon/broker/exceptions/msg.hh"
 #include "com/centreon/broker/logging/logging.hh"
+#include "com/centreon/broker/misc/object_pool.hh"
 #include "com/centreon/broker/misc/string.hh"
 #include "com/centreon/broker/neb/callback.hh"
 #include "com/centreon/broker/neb/events.hh"
@@ -114,6 +115,14 @@ extern "C" {
 char const* get_program_version();
 }
 
+// Pools of the events generated on each check, their objects and the
+// memory of their strings are reused from one check to another.
+static misc::object_pool<neb::host_check> gl_host_check_pool;
+static misc::object_pool<neb::host_status> gl_host_status_pool;
+static misc::object_pool<neb::log_entry> gl_log_entry_pool;
+static misc::object_pool<neb::service_check> gl_service_check_pool;
+static misc::object_pool<neb::service_status> gl_service_status_pool;
+
 // Statistics generator.
 static neb::statistics::generator gl_generator;
 
@@ -736,7 +745,7 @@ int neb::callback_event_handler(int callback_type, void* data) {
  */
 int neb::callback_external_command(int callback_type, void* data) {
   // Log message.
-  logging::debug(logging::low) << "callbacks: external command data";
+  LOGGING_DEBUG(logging::low) << "callbacks: external command data";
   (void)callback_type;
 
   nebstruct_external_command_data* necd(
@@ -1260,7 +1269,7 @@ int neb::callback_host_check(int callback_type, void* data) {
   try {
     // In/Out variables.
     nebstruct_host_check_data const* hcdata;
-    std::shared_ptr<neb::host_check> host_check(new neb::host_check);
+    std::shared_ptr<neb::host_check> host_check(gl_host_check_pool.acquire());
 
     // Fill output var.
     hcdata = static_cast<nebstruct_host_check_data*>(data);
@@ -1268,8 +1277,7 @@ int neb::callback_host_check(int callback_type, void* data) {
     if (hcdata->command_line) {
       host_check->active_checks_enabled = h->get_checks_enabled();
       host_check->check_type = hcdata->check_type;
-      host_check->command_line =
-          misc::string::check_string_utf8(hcdata->command_line);
+      misc::string::assign_utf8(host_check->command_line, hcdata->command_line);
       if (!hcdata->host_name)
         throw(exceptions::msg() << "unnamed host");
       host_check->host_id = engine::get_host_id(hcdata->host_name);
@@ -1312,7 +1320,8 @@ int neb::callback_host_status(int callback_type, void* data) {
   try {
     // In/Out variables.
     engine::host const* h;
-    std::shared_ptr<neb::host_status> host_status(new neb::host_status);
+    std::shared_ptr<neb::host_status> host_status(
+        gl_host_status_pool.acquire());
 
     // Fill output var.
     h = static_cast<engine::host*>(
@@ -1321,8 +1330,8 @@ int neb::callback_host_status(int callback_type, void* data) {
     host_status->acknowledgement_type = h->get_acknowledgement_type();
     host_status->active_checks_enabled = h->get_checks_enabled();
     if (!h->get_check_command().empty())
-      host_status->check_command =
-          misc::string::check_string_utf8(h->get_check_command());
+      misc::string::assign_utf8(host_status->check_command,
+                                h->get_check_command());
     host_status->check_interval = h->get_check_interval();
     if (!h->get_check_period().empty())
       host_status->check_period = h->get_check_period();
@@ -1333,8 +1342,8 @@ int neb::callback_host_status(int callback_type, void* data) {
                                    : 4);  // Pending state.
     host_status->downtime_depth = h->get_scheduled_downtime_depth();
     if (!h->get_event_handler().empty())
-      host_status->event_handler =
-          misc::string::check_string_utf8(h->get_event_handler());
+      misc::string::assign_utf8(host_status->event_handler,
+                                h->get_event_handler());
     host_status->event_handler_enabled = h->get_event_handler_enabled();
     host_status->execution_time = h->get_execution_time();
     host_status->flap_detection_enabled = h->get_flap_detection_enabled();
@@ -1366,18 +1375,16 @@ int neb::callback_host_status(int callback_type, void* data) {
     host_status->notifications_enabled = h->get_notifications_enabled();
     host_status->obsess_over = h->get_obsess_over();
     if (!h->get_plugin_output().empty()) {
-      host_status->output =
-          misc::string::check_string_utf8(h->get_plugin_output());
+      misc::string::assign_utf8(host_status->output, h->get_plugin_output());
       host_status->output.append("\n");
     }
     if (!h->get_long_plugin_output().empty())
-      host_status->output.append(
-          misc::string::check_string_utf8(h->get_long_plugin_output()));
+      misc::string::append_utf8(host_status->output,
+                                h->get_long_plugin_output());
     host_status->passive_checks_enabled = h->get_accept_passive_checks();
     host_status->percent_state_change = h->get_percent_state_change();
     if (!h->get_perf_data().empty())
-      host_status->perf_data =
-          misc::string::check_string_utf8(h->get_perf_data());
+      misc::string::assign_utf8(host_status->perf_data, h->get_perf_data());
     host_status->retry_interval = h->get_retry_interval();
     host_status->should_be_scheduled = h->get_should_be_scheduled();
     host_status->state_type =
@@ -1431,14 +1438,14 @@ int neb::callback_log(int callback_type, void* data) {
   try {
     // In/Out variables.
     nebstruct_log_data const* log_data;
-    std::shared_ptr<neb::log_entry> le(new neb::log_entry);
+    std::shared_ptr<neb::log_entry> le(gl_log_entry_pool.acquire());
 
     // Fill output var.
     log_data = static_cast<nebstruct_log_data*>(data);
     le->c_time = log_data->entry_time;
     le->poller_name = config::applier::state::instance().poller_name();
     if (log_data->data) {
-      le->output = misc::string::check_string_utf8(log_data->data);
+      misc::string::assign_utf8(le->output, log_data->data);
       set_log_data(*le, le->output.c_str());
     }
 
@@ -1466,7 +1473,7 @@ int neb::callback_log(int callback_type, void* data) {
  */
 int neb::callback_module(int callback_type, void* data) {
   // Log message.
-  logging::debug(logging::low) << "callbacks: generating module event";
+  LOGGING_DEBUG(logging::low) << "callbacks: generating module event";
   (void)callback_type;
 
   try {
@@ -1507,7 +1514,7 @@ int neb::callback_module(int callback_type, void* data) {
  */
 int neb::callback_process(int callback_type, void* data) {
   // Log message.
-  logging::debug(logging::low) << "callbacks: process event callback";
+  LOGGING_DEBUG(logging::low) << "callbacks: process event callback";
   (void)callback_type;
 
   try {
@@ -1548,6 +1555,19 @@ int neb::callback_process(int callback_type, void* data) {
         config::applier::state::instance().apply(conf);
         gl_generator.set(conf);
 
+        // From now on, events are published by a broker thread.
+        if (conf.publisher_async()) {
+          multiplexing::async_publisher::overflow_policy policy(
+              multiplexing::async_publisher::block);
+          multiplexing::async_publisher::parse_policy(
+              conf.publisher_overflow_policy(), policy);
+          std::string spill_file(conf.publisher_spill_file());
+          if (spill_file.empty())
+            spill_file = config::applier::state::instance().cache_dir() +
+                         ".publisher";
+          gl_publisher.start(conf.publisher_queue_size(), policy, spill_file);
+        }
+
         // Set variables.
         statistics_interval = gl_generator.interval();
       } catch (exceptions::msg const& e) {
@@ -1934,7 +1954,8 @@ int neb::callback_service_check(int callback_type, void* data) {
   try {
     // In/Out variables.
     nebstruct_service_check_data const* scdata;
-    std::shared_ptr<neb::service_check> service_check(new neb::service_check);
+    std::shared_ptr<neb::service_check> service_check(
+        gl_service_check_pool.acquire());
 
     // Fill output var.
     scdata = static_cast<nebstruct_service_check_data*>(data);
@@ -1942,8 +1963,8 @@ int neb::callback_service_check(int callback_type, void* data) {
     if (scdata->command_line) {
       service_check->active_checks_enabled = s->get_checks_enabled();
       service_check->check_type = scdata->check_type;
-      service_check->command_line =
-          misc::string::check_string_utf8(scdata->command_line);
+      misc::string::assign_utf8(service_check->command_line,
+                                scdata->command_line);
       if (!scdata->host_id)
         throw exceptions::msg() << "host without id";
       if (!scdata->service_id)
@@ -1988,7 +2009,7 @@ int neb::callback_service_status(int callback_type, void* data) {
   try {
     // In/Out variables.
     std::shared_ptr<neb::service_status> service_status(
-        new neb::service_status);
+        gl_service_status_pool.acquire());
 
     // Fill output var.
     engine::service const* s{static_cast<engine::service*>(
@@ -1997,8 +2018,8 @@ int neb::callback_service_status(int callback_type, void* data) {
     service_status->acknowledgement_type = s->get_acknowledgement_type();
     service_status->active_checks_enabled = s->get_checks_enabled();
     if (!s->get_check_command().empty())
-      service_status->check_command =
-          misc::string::check_string_utf8(s->get_check_command());
+      misc::string::assign_utf8(service_status->check_command,
+                                s->get_check_command());
     service_status->check_interval = s->get_check_interval();
     if (!s->get_check_period().empty())
       service_status->check_period = s->get_check_period();
@@ -2009,8 +2030,8 @@ int neb::callback_service_status(int callback_type, void* data) {
                                    : 4);  // Pending state.
     service_status->downtime_depth = s->get_scheduled_downtime_depth();
     if (!s->get_event_handler().empty())
-      service_status->event_handler =
-          misc::string::check_string_utf8(s->get_event_handler());
+      misc::string::assign_utf8(service_status->event_handler,
+                                s->get_event_handler());
     service_status->event_handler_enabled = s->get_event_handler_enabled();
     service_status->execution_time = s->get_execution_time();
     service_status->flap_detection_enabled = s->get_flap_detection_enabled();
@@ -2035,28 +2056,25 @@ int neb::callback_service_status(int callback_type, void* data) {
     service_status->notifications_enabled = s->get_notifications_enabled();
     service_status->obsess_over = s->get_obsess_over();
     if (!s->get_plugin_output().empty()) {
-      service_status->output =
-          misc::string::check_string_utf8(s->get_plugin_output());
+      misc::string::assign_utf8(service_status->output, s->get_plugin_output());
       service_status->output.append("\n");
     }
     if (!s->get_long_plugin_output().empty())
-      service_status->output.append(
-          misc::string::check_string_utf8(s->get_long_plugin_output()));
+      misc::string::append_utf8(service_status->output,
+                                s->get_long_plugin_output());
 
     service_status->passive_checks_enabled = s->get_accept_passive_checks();
     service_status->percent_state_change = s->get_percent_state_change();
     if (!s->get_perf_data().empty())
-      service_status->perf_data =
-          misc::string::check_string_utf8(s->get_perf_data());
+      misc::string::assign_utf8(service_status->perf_data, s->get_perf_data());
     service_status->retry_interval = s->get_retry_interval();
     if (s->get_hostname().empty())
       throw exceptions::msg() << "unnamed host";
     if (s->get_description().empty())
       throw exceptions::msg() << "unnamed service";
-    service_status->host_name =
-        misc::string::check_string_utf8(s->get_hostname());
-    service_status->service_description =
-        misc::string::check_string_utf8(s->get_description());
+    misc::string::assign_utf8(service_status->host_name, s->get_hostname());
+    misc::string::assign_utf8(service_status->service_description,
+                              s->get_description());
     {
       std::pair<uint64_t, uint64_t> p{engine::get_host_and_service_id(
           s->get_hostname(), s->get_description())};
@@ -68,6 +68,9 @@ int nebmodule_deinit(int flags, int reason) {
     // Unregister callbacks.
     neb::unregister_callbacks();
 
+    // Publish the events still queued.
+    neb::gl_publisher.stop();
+
     // Unload singletons.
     com::centreon::broker::config::applier::deinit();
   }
@@ -170,6 +173,7 @@ int nebmodule_init(int flags, char const* args, void* handle) {
           s.loggers());
 
       std::string err;
+      log_v2::instance().set_async(s);
       if (!log_v2::instance().load("/etc/centreon-broker/log-config.json", s.broker_name(), err))
         logging::error(logging::low) << err;
 
@@ -65,14 +65,12 @@ active_host_latency& active_host_latency::operator=(
  *
  *  @param[out] output   The output return by the plugin.
  *  @param[out] perfdata The perf data return by the plugin.
+ *  @param[in]  stats    The host and service values.
  */
-void active_host_latency::run(std::string& output, std::string& perfdata) {
-  compute_value<double> cv;
-  for (host_map::const_iterator it{com::centreon::engine::host::hosts.begin()},
-       end{com::centreon::engine::host::hosts.end()};
-       it != end; ++it)
-    if (it->second->get_check_type() == checkable::check_active)
-      cv << it->second->get_latency();
+void active_host_latency::run(std::string& output,
+                              std::string& perfdata,
+                              aggregate const& stats) {
+  compute_value<double> const& cv(stats.hosts.active_latency);
 
   if (cv.size()) {
     // Output.
@@ -67,14 +67,12 @@ active_service_latency& active_service_latency::operator=(
  *
  *  @param[out] output   The output return by the plugin.
  *  @param[out] perfdata The perf data return by the plugin.
+ *  @param[in]  stats    The host and service values.
  */
-void active_service_latency::run(std::string& output, std::string& perfdata) {
-  compute_value<double> cv;
-  for (service_map::const_iterator it{service::services.begin()},
-       end{service::services.end()};
-       it != end; ++it)
-    if (it->second->get_check_type() == checkable::check_active)
-      cv << it->second->get_latency();
+void active_service_latency::run(std::string& output,
+                                 std::string& perfdata,
+                                 aggregate const& stats) {
+  compute_value<double> const& cv(stats.services.active_latency);
 
   if (cv.size()) {
     // Output.
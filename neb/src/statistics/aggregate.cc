@@ -0,0 +1,117 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#include "com/centreon/broker/neb/statistics/aggregate.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/host.hh"
+#include "com/centreon/engine/service.hh"
+
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::neb::statistics;
+using namespace com::centreon::engine;
+
+/**
+ *  Add a checked object to the counters of the last 1, 5, 15 and 60
+ *  minutes.
+ *
+ *  @param[out] last  The counters.
+ *  @param[in]  diff  Seconds elapsed since the last check.
+ */
+static void add_last_check(uint32_t (&last)[4], time_t diff) {
+  if (diff <= 60 * 60) {
+    ++last[3];
+    if (diff <= 15 * 60) {
+      ++last[2];
+      if (diff <= 5 * 60) {
+        ++last[1];
+        if (diff <= 1 * 60)
+          ++last[0];
+      }
+    }
+  }
+}
+
+/**
+ *  Compute the values of a map of hosts or services in one pass.
+ *
+ *  @param[in]  objects  The engine objects.
+ *  @param[in]  now      The current time.
+ *  @param[out] c        The values.
+ */
+template <typename T>
+static void compute_checkables(T const& objects,
+                               time_t now,
+                               aggregate::checkables& c) {
+  c = aggregate::checkables();
+  c.total = objects.size();
+  for (typename T::const_iterator it{objects.begin()}, end{objects.end()};
+       it != end; ++it) {
+    auto const& obj(*it->second);
+    uint32_t state(obj.get_current_state());
+    if (state < 4)
+      ++c.states[state];
+    if (obj.get_has_been_checked())
+      ++c.checked;
+    if (obj.get_checks_enabled())
+      ++c.actively_checked;
+    if (obj.get_is_flapping())
+      ++c.flapping;
+    if (obj.get_should_be_scheduled())
+      ++c.scheduled;
+
+    double state_change(obj.get_percent_state_change());
+    c.state_change << state_change;
+    switch (obj.get_check_type()) {
+      case checkable::check_active:
+        c.active_execution_time << obj.get_execution_time();
+        c.active_latency << obj.get_latency();
+        c.active_state_change << state_change;
+        add_last_check(c.active_last, now - obj.get_last_check());
+        break;
+      case checkable::check_passive:
+        c.passive_latency << obj.get_latency();
+        c.passive_state_change << state_change;
+        add_last_check(c.passive_last, now - obj.get_last_check());
+        break;
+    }
+  }
+}
+
+/**
+ *  Default constructor, all the values are empty.
+ */
+aggregate::checkables::checkables()
+    : total{0},
+      states{0, 0, 0, 0},
+      checked{0},
+      actively_checked{0},
+      flapping{0},
+      scheduled{0},
+      active_last{0, 0, 0, 0},
+      passive_last{0, 0, 0, 0} {}
+
+/**
+ *  Compute the values of the engine hosts and services. This must be called
+ *  from the engine thread.
+ *
+ *  @param[in] now  The current time.
+ */
+void aggregate::compute(time_t now) {
+  compute_checkables(host::hosts, now, hosts);
+  compute_checkables(service::services, now, services);
+}
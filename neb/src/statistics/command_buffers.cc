@@ -62,9 +62,11 @@ command_buffers& command_buffers::operator=(command_buffers const& right) {
  *
  *  @param[out] output   The output return by the plugin.
  *  @param[out] perfdata The perf data return by the plugin.
+ *  @param[in]  stats    The host and service values.
  */
 void command_buffers::run(std::string& output __attribute__((unused)),
-                          std::string& perfdata __attribute__((unused))) {
+                          std::string& perfdata __attribute__((unused)),
+                          aggregate const& stats __attribute__((unused))) {
   // XXX
   // uint32_t high(0);
   // uint32_t total(::external_command_buffer_slots);
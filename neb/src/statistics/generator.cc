@@ -220,7 +220,14 @@ void generator::remove(uint64_t host_id, uint64_t service_id) {
  *  Execute all plugins.
  */
 void generator::run() {
+  if (_registers.empty())
+    return;
+
+  // Host and service values are computed once for all the plugins.
   time_t now(time(nullptr));
+  aggregate stats;
+  stats.compute(now);
+
   for (std::map<std::pair<uint64_t, uint64_t>,
                 std::shared_ptr<plugin> >::const_iterator
            it(_registers.begin()),
@@ -237,7 +244,7 @@ void generator::run() {
     try {
       std::string output;
       std::string perfdata;
-      it->second->run(output, perfdata);
+      it->second->run(output, perfdata, stats);
       ss->output = output;
       ss->perf_data = perfdata;
     } catch (std::exception const& e) {
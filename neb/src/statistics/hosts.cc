@@ -61,14 +61,13 @@ hosts& hosts::operator=(hosts const& right) {
  *
  *  @param[out] output   The output return by the plugin.
  *  @param[out] perfdata The perf data return by the plugin.
+ *  @param[in]  stats    The host and service values.
  */
-void hosts::run(std::string& output, std::string& perfdata) {
-  // Count hosts up / down / unreachable.
-  uint32_t total[3] = {0, 0, 0};
-  for (host_map::const_iterator it{com::centreon::engine::host::hosts.begin()},
-       end{com::centreon::engine::host::hosts.end()};
-       it != end; ++it)
-    ++total[it->second->get_current_state()];
+void hosts::run(std::string& output,
+                std::string& perfdata,
+                aggregate const& stats) {
+  // Count hosts per state.
+  uint32_t const* total(stats.hosts.states);
 
   uint32_t not_up{total[com::centreon::engine::host::state_down] +
                       total[com::centreon::engine::host::state_unreachable]};
@@ -64,15 +64,12 @@ hosts_actively_checked& hosts_actively_checked::operator=(
  *
  *  @param[out] output   The output return by the plugin.
  *  @param[out] perfdata The perf data return by the plugin.
+ *  @param[in]  stats    The host and service values.
  */
-void hosts_actively_checked::run(std::string& output, std::string& perfdata) {
-  // Count hosts active checked.
-  uint32_t total{0};
-  for (host_map::const_iterator it{com::centreon::engine::host::hosts.begin()},
-       end{com::centreon::engine::host::hosts.end()};
-       it != end; ++it)
-    if (it->second->get_checks_enabled())
-      ++total;
+void hosts_actively_checked::run(std::string& output,
+                                 std::string& perfdata,
+                                 aggregate const& stats) {
+  uint32_t total{stats.hosts.actively_checked};
 
   // Output.
   std::ostringstream oss;
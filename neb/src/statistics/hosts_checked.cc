@@ -60,15 +60,12 @@ hosts_checked& hosts_checked::operator=(hosts_checked const& right) {
  *
  *  @param[out] output   The output return by the plugin.
  *  @param[out] perfdata The perf data return by the plugin.
+ *  @param[in]  stats    The host and service values.
  */
-void hosts_checked::run(std::string& output, std::string& perfdata) {
-  // Count hosts checked.
-  uint32_t total{0};
-  for (host_map::const_iterator it{com::centreon::engine::host::hosts.begin()},
-       end{com::centreon::engine::host::hosts.end()};
-       it != end; ++it)
-    if (it->second->get_has_been_checked())
-      ++total;
+void hosts_checked::run(std::string& output,
+                        std::string& perfdata,
+                        aggregate const& stats) {
+  uint32_t total{stats.hosts.checked};
 
   // Output.
   std::ostringstream oss;
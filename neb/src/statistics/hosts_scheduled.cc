@@ -61,15 +61,12 @@ hosts_scheduled& hosts_scheduled::operator=(hosts_scheduled const& right) {
  *
  *  @param[out] output   The output return by the plugin.
  *  @param[out] perfdata The perf data return by the plugin.
+ *  @param[in]  stats    The host and service values.
  */
-void hosts_scheduled::run(std::string& output, std::string& perfdata) {
-  // Count hosts scheduled.
-  uint32_t total(0);
-  for (host_map::const_iterator it{com::centreon::engine::host::hosts.begin()},
-       end{com::centreon::engine::host::hosts.end()};
-       it != end; ++it)
-    if (it->second->get_should_be_scheduled())
-      ++total;
+void hosts_scheduled::run(std::string& output,
+                          std::string& perfdata,
+                          aggregate const& stats) {
+  uint32_t total{stats.hosts.scheduled};
 
   // Output.
   std::ostringstream oss;
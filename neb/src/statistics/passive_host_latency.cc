@@ -65,13 +65,12 @@ passive_host_latency& passive_host_latency::operator=(
  *
  *  @param[out] output   The output return by the plugin.
  *  @param[out] perfdata The perf data return by the plugin.
+ *  @param[in]  stats    The host and service values.
  */
-void passive_host_latency::run(std::string& output, std::string& perfdata) {
-  compute_value<double> cv;
-  for (host_map::const_iterator it{host::hosts.begin()}, end{host::hosts.end()};
-       it != end; ++it)
-    if (it->second->get_check_type() == checkable::check_passive)
-      cv << it->second->get_latency();
+void passive_host_latency::run(std::string& output,
+                               std::string& perfdata,
+                               aggregate const& stats) {
+  compute_value<double> const& cv(stats.hosts.passive_latency);
 
   if (cv.size()) {
     // Output.
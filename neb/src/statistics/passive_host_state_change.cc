@@ -67,14 +67,12 @@ passive_host_state_change& passive_host_state_change::operator=(
  *
  *  @param[out] output   The output return by the plugin.
  *  @param[out] perfdata The perf data return by the plugin.
+ *  @param[in]  stats    The host and service values.
  */
 void passive_host_state_change::run(std::string& output,
-                                    std::string& perfdata) {
-  compute_value<double> cv;
-  for (host_map::const_iterator it{host::hosts.begin()}, end{host::hosts.end()};
-       it != end; ++it)
-    if (it->second->get_check_type() == checkable::check_passive)
-      cv << it->second->get_percent_state_change();
+                                    std::string& perfdata,
+                                    aggregate const& stats) {
+  compute_value<double> const& cv(stats.hosts.passive_state_change);
 
   if (cv.size()) {
     // Output.
@@ -63,30 +63,15 @@ passive_hosts_last& passive_hosts_last::operator=(
  *
  *  @param[out] output   The output return by the plugin.
  *  @param[out] perfdata The perf data return by the plugin.
+ *  @param[in]  stats    The host and service values.
  */
-void passive_hosts_last::run(std::string& output, std::string& perfdata) {
-  uint32_t last_checked_1{0};
-  uint32_t last_checked_5{0};
-  uint32_t last_checked_15{0};
-  uint32_t last_checked_60{0};
-  time_t now{time(nullptr)};
-  for (host_map::const_iterator it{host::hosts.begin()}, end{host::hosts.end()};
-       it != end; ++it) {
-    if (it->second->get_check_type() == checkable::check_passive) {
-      int diff(now - it->second->get_last_check());
-      if (diff <= 60 * 60) {
-        ++last_checked_60;
-        if (diff <= 15 * 60) {
-          ++last_checked_15;
-          if (diff <= 5 * 60) {
-            ++last_checked_5;
-            if (diff <= 1 * 60)
-              ++last_checked_1;
-          }
-        }
-      }
-    }
-  }
+void passive_hosts_last::run(std::string& output,
+                             std::string& perfdata,
+                             aggregate const& stats) {
+  uint32_t last_checked_1{stats.hosts.passive_last[0]};
+  uint32_t last_checked_5{stats.hosts.passive_last[1]};
+  uint32_t last_checked_15{stats.hosts.passive_last[2]};
+  uint32_t last_checked_60{stats.hosts.passive_last[3]};
 
   // Output.
   std::ostringstream oss;
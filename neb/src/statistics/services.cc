@@ -61,15 +61,13 @@ services& services::operator=(services const& right) {
  *
  *  @param[out] output   The output return by the plugin.
  *  @param[out] perfdata The perf data return by the plugin.
+ *  @param[in]  stats    The host and service values.
  */
-void services::run(std::string& output, std::string& perfdata) {
-  // Count services ok / warning / unknown / critical.
-  uint32_t total[4] = {0, 0, 0, 0};
-  for (service_map::const_iterator
-           it{com::centreon::engine::service::services.begin()},
-       end{com::centreon::engine::service::services.end()};
-       it != end; ++it)
-    ++total[it->second->get_current_state()];
+void services::run(std::string& output,
+                   std::string& perfdata,
+                   aggregate const& stats) {
+  // Count services per state.
+  uint32_t const* total(stats.services.states);
 
   uint32_t not_ok{total[com::centreon::engine::service::state_warning] +
                       total[com::centreon::engine::service::state_critical] +
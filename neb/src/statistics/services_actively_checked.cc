@@ -64,17 +64,12 @@ services_actively_checked& services_actively_checked::operator=(
  *
  *  @param[out] output   The output return by the plugin.
  *  @param[out] perfdata The perf data return by the plugin.
+ *  @param[in]  stats    The host and service values.
  */
 void services_actively_checked::run(std::string& output,
-                                    std::string& perfdata) {
-  // Count services active checked.
-  uint32_t total{0};
-  for (service_map::const_iterator
-           it{com::centreon::engine::service::services.begin()},
-       end{com::centreon::engine::service::services.end()};
-       it != end; ++it)
-    if (it->second->get_checks_enabled())
-      ++total;
+                                    std::string& perfdata,
+                                    aggregate const& stats) {
+  uint32_t total{stats.services.actively_checked};
 
   // Output.
   std::ostringstream oss;
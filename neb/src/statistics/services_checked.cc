@@ -61,16 +61,12 @@ services_checked& services_checked::operator=(services_checked const& right) {
  *
  *  @param[out] output   The output return by the plugin.
  *  @param[out] perfdata The perf data return by the plugin.
+ *  @param[in]  stats    The host and service values.
  */
-void services_checked::run(std::string& output, std::string& perfdata) {
-  // Count services checked.
-  uint32_t total{0};
-  for (service_map::const_iterator
-           it{com::centreon::engine::service::services.begin()},
-       end{com::centreon::engine::service::services.end()};
-       it != end; ++it)
-    if (it->second->get_has_been_checked())
-      ++total;
+void services_checked::run(std::string& output,
+                           std::string& perfdata,
+                           aggregate const& stats) {
+  uint32_t total{stats.services.checked};
 
   // Output.
   std::ostringstream oss;
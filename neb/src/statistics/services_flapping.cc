@@ -62,16 +62,12 @@ services_flapping& services_flapping::operator=(
  *
  *  @param[out] output   The output return by the plugin.
  *  @param[out] perfdata The perf data return by the plugin.
+ *  @param[in]  stats    The host and service values.
  */
-void services_flapping::run(std::string& output, std::string& perfdata) {
-  // Count services are flapping.
-  uint32_t total{0};
-  for (service_map::const_iterator
-           it{com::centreon::engine::service::services.begin()},
-       end{com::centreon::engine::service::services.end()};
-       it != end; ++it)
-    if (it->second->get_is_flapping())
-      ++total;
+void services_flapping::run(std::string& output,
+                            std::string& perfdata,
+                            aggregate const& stats) {
+  uint32_t total{stats.services.flapping};
 
   // Output.
   std::ostringstream oss;
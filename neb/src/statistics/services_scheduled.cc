@@ -61,16 +61,12 @@ services_scheduled& services_scheduled::operator=(
  *
  *  @param[out] output   The output return by the plugin.
  *  @param[out] perfdata The perf data return by the plugin.
+ *  @param[in]  stats    The host and service values.
  */
-void services_scheduled::run(std::string& output, std::string& perfdata) {
-  // Count services scheduled.
-  uint32_t total{0};
-  for (service_map::const_iterator
-           it{com::centreon::engine::service::services.begin()},
-       end{com::centreon::engine::service::services.end()};
-       it != end; ++it)
-    if (it->second->get_should_be_scheduled())
-      ++total;
+void services_scheduled::run(std::string& output,
+                             std::string& perfdata,
+                             aggregate const& stats) {
+  uint32_t total{stats.services.scheduled};
 
   // Output.
   std::ostringstream oss;
@@ -66,16 +66,13 @@ total_host_state_change& total_host_state_change::operator=(
  *
  *  @param[out] output   The output return by the plugin.
  *  @param[out] perfdata The perf data return by the plugin.
+ *  @param[in]  stats    The host and service values.
  */
-void total_host_state_change::run(std::string& output, std::string& perfdata) {
-  if (!com::centreon::engine::host::hosts.empty()) {
-    compute_value<double> cv;
-    for (host_map::const_iterator
-             it{com::centreon::engine::host::hosts.begin()},
-         end{com::centreon::engine::host::hosts.end()};
-         it != end; ++it)
-      cv << it->second->get_percent_state_change();
-
+void total_host_state_change::run(std::string& output,
+                                  std::string& perfdata,
+                                  aggregate const& stats) {
+  compute_value<double> const& cv(stats.hosts.state_change);
+  if (cv.size()) {
     // Output.
     std::ostringstream oss;
     oss << "Engine " << config::applier::state::instance().poller_name()
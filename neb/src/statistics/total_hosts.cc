@@ -60,10 +60,13 @@ total_hosts& total_hosts::operator=(total_hosts const& right) {
  *
  *  @param[out] output   The output return by the plugin.
  *  @param[out] perfdata The perf data return by the plugin.
+ *  @param[in]  stats    The host and service values.
  */
-void total_hosts::run(std::string& output, std::string& perfdata) {
+void total_hosts::run(std::string& output,
+                      std::string& perfdata,
+                      aggregate const& stats) {
   // Count hosts.
-  uint32_t total(com::centreon::engine::host::hosts.size());
+  uint32_t total{stats.hosts.total};
 
   // Output.
   std::ostringstream oss;
@@ -60,10 +60,13 @@ total_services& total_services::operator=(total_services const& right) {
  *
  *  @param[out] output   The output return by the plugin.
  *  @param[out] perfdata The perf data return by the plugin.
+ *  @param[in]  stats    The host and service values.
  */
-void total_services::run(std::string& output, std::string& perfdata) {
+void total_services::run(std::string& output,
+                         std::string& perfdata,
+                         aggregate const& stats) {
   // Count services.
-  size_t total{com::centreon::engine::service::services.size()};
+  uint32_t total{stats.services.total};
 
   // Output.
   std::ostringstream oss;
@@ -20,6 +20,9 @@
 #include <gtest/gtest.h>
 #include <cmath>
 #include <cstdlib>
+#include <thread>
+#include "com/centreon/broker/misc/mpmc_queue.hh"
+#include "com/centreon/broker/misc/object_pool.hh"
 #include "randomize.hh"
 
 using namespace com::centreon::broker;
@@ -136,3 +139,132 @@ TEST_F(ServiceStatus, DefaultCtor) {
   ASSERT_FALSE(!ss.service_description.empty());
   ASSERT_FALSE((ss.service_id != 0));
 }
+
+/**
+ *  Check that a service_status given back to a pool is reset.
+ */
+TEST_F(ServiceStatus, PoolReset) {
+  misc::object_pool<neb::service_status> pool;
+  neb::service_status* first;
+  {
+    std::shared_ptr<neb::service_status> ss(pool.acquire());
+    first = ss.get();
+    randomize(*ss);
+  }
+
+  std::shared_ptr<neb::service_status> ss(pool.acquire());
+  ASSERT_EQ(ss.get(), first);
+  neb::service_status blank;
+  for (mapping::entry const* e(neb::service_status::entries); !e->is_null();
+       ++e) {
+    switch (e->get_type()) {
+      case mapping::source::BOOL:
+        ASSERT_EQ(e->get_bool(*ss), e->get_bool(blank));
+        break;
+      case mapping::source::DOUBLE:
+        ASSERT_EQ(e->get_double(*ss), e->get_double(blank));
+        break;
+      case mapping::source::INT:
+        ASSERT_EQ(e->get_int(*ss), e->get_int(blank));
+        break;
+      case mapping::source::SHORT:
+        ASSERT_EQ(e->get_short(*ss), e->get_short(blank));
+        break;
+      case mapping::source::STRING:
+        ASSERT_EQ(e->get_string(*ss), e->get_string(blank));
+        break;
+      case mapping::source::TIME:
+        ASSERT_EQ(e->get_time(*ss), e->get_time(blank));
+        break;
+      case mapping::source::UINT:
+        ASSERT_EQ(e->get_uint(*ss), e->get_uint(blank));
+        break;
+    }
+  }
+}
+
+/**
+ *  Fill a service_status the way callback_service_status() does.
+ *
+ *  @param[out] ss  The event.
+ *  @param[in]  i   Index of the event in the replay.
+ */
+static void fill_service_status(neb::service_status& ss, uint32_t i) {
+  static std::string const check_command("check_centreon_ping!3!200,20%");
+  static std::string const check_period("24x7");
+  static std::string const event_handler("restart_service");
+  static std::string const output(
+      "OK - 127.0.0.1 rta 0.042ms lost 0% | rta=0.042ms;200;400;0;");
+  static std::string const long_output("Packets: 3 sent, 3 received");
+  static std::string const perf_data(
+      "rta=0.042ms;200.000;400.000;0; pl=0%;20;50;0;100 "
+      "rtmax=0.060ms;;;; rtmin=0.034ms;;;;");
+  static std::string const host_name("central-host-0042");
+  static std::string const description("Ping");
+
+  ss.acknowledged = false;
+  ss.active_checks_enabled = true;
+  ss.check_command = check_command;
+  ss.check_interval = 5;
+  ss.check_period = check_period;
+  ss.check_type = 0;
+  ss.current_check_attempt = 1;
+  ss.current_state = i % 4;
+  ss.downtime_depth = 0;
+  ss.event_handler = event_handler;
+  ss.event_handler_enabled = true;
+  ss.execution_time = 0.1;
+  ss.flap_detection_enabled = true;
+  ss.has_been_checked = true;
+  ss.is_flapping = false;
+  ss.last_check = i;
+  ss.last_hard_state = 0;
+  ss.last_update = i;
+  ss.latency = 0.2;
+  ss.max_check_attempts = 3;
+  ss.next_check = i + 300;
+  ss.output = output;
+  ss.output.append("\n");
+  ss.output.append(long_output);
+  ss.passive_checks_enabled = true;
+  ss.percent_state_change = 0;
+  ss.perf_data = perf_data;
+  ss.retry_interval = 1;
+  ss.host_name = host_name;
+  ss.service_description = description;
+  ss.host_id = 42;
+  ss.service_id = i + 1;
+  ss.should_be_scheduled = true;
+  ss.state_type = 1;
+}
+
+/**
+ *  Replay pooled service statuses, events are released by another thread
+ *  as they would be by the broker. Only the events in flight are allocated.
+ */
+TEST_F(ServiceStatus, PooledReplay) {
+  constexpr uint32_t count = 100000;
+  misc::object_pool<neb::service_status> pool;
+  misc::mpmc_queue<std::shared_ptr<neb::service_status>> q(4096);
+  std::thread consumer([&q, count]() {
+    std::shared_ptr<neb::service_status> ss;
+    for (uint32_t i = 0; i < count;) {
+      if (q.try_pop(ss)) {
+        ss.reset();
+        ++i;
+      } else
+        std::this_thread::yield();
+    }
+  });
+
+  for (uint32_t i = 0; i < count; ++i) {
+    std::shared_ptr<neb::service_status> ss(pool.acquire());
+    fill_service_status(*ss, i);
+    while (!q.try_push(ss))
+      std::this_thread::yield();
+  }
+  consumer.join();
+
+  ASSERT_LE(pool.allocated(), 4096u + 2u);
+  ASSERT_EQ(pool.available(), pool.allocated());
+}
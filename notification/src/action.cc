@@ -270,7 +270,7 @@ void action::process_action(
 void action::_spawn_notification_attempts(
     state& st,
     std::vector<std::pair<time_t, action> >& spawned_actions) const {
-  logging::debug(logging::low)
+  LOGGING_DEBUG(logging::low)
       << "notification: spawning notification action for node ("
       << _id.get_host_id() << ", " << _id.get_service_id() << ")";
 
@@ -311,20 +311,20 @@ void action::_process_notification(
     state& st,
     node_cache& cache,
     std::vector<std::pair<time_t, action> >& spawned_actions) const {
-  logging::debug(logging::low)
+  LOGGING_DEBUG(logging::low)
       << "notification: processing action for rule " << _notification_rule_id
       << " of node (" << _id.get_host_id() << ", " << _id.get_service_id()
       << ")";
 
   // Check action viability.
-  logging::debug(logging::low)
+  LOGGING_DEBUG(logging::low)
       << "notification: checking action viability for node ("
       << _id.get_host_id() << ", " << _id.get_service_id() << ")";
 
   // Check the node's existence.
   node::ptr n(st.get_node_by_id(_id));
   if (!n) {
-    logging::debug(logging::low)
+    LOGGING_DEBUG(logging::low)
         << "notification: node (" << _id.get_host_id() << ", "
         << _id.get_service_id()
         << ") was not declared, notification attempt is not viable";
@@ -380,7 +380,7 @@ void action::_process_notification(
 
   // Check the existence of correlated parent.
   if (n->has_parent() && !method->should_be_notified_when_correlated()) {
-    logging::debug(logging::low)
+    LOGGING_DEBUG(logging::low)
         << "notification: node (" << _id.get_host_id() << ", "
         << _id.get_service_id()
         << ") has parent issue, notification attempt is not viable";
@@ -390,7 +390,7 @@ void action::_process_notification(
   // Check if the state is valid.
   if (!method->should_be_notified_for(n->get_hard_state(),
                                       n->get_node_id().is_service())) {
-    logging::debug(logging::low)
+    LOGGING_DEBUG(logging::low)
         << "notification: node (" << _id.get_host_id() << ", "
         << _id.get_service_id() << ") should not be notified for state "
         << static_cast<int>(n->get_hard_state()) << " according to method "
@@ -400,7 +400,7 @@ void action::_process_notification(
 
   // Check if the notification type is valid.
   if (!method->should_be_notified_for(_act)) {
-    logging::debug(logging::low)
+    LOGGING_DEBUG(logging::low)
         << "notification: node (" << _id.get_host_id() << ", "
         << _id.get_service_id() << ") should not be notified for action type "
         << static_cast<int>(_act) << " according to method "
@@ -411,7 +411,7 @@ void action::_process_notification(
   // See if the timeperiod is valid.
   time_t now = ::time(NULL);
   if (tp && !tp->is_valid(now)) {
-    logging::debug(logging::low)
+    LOGGING_DEBUG(logging::low)
         << "notification: notification attempt on node (" << _id.get_host_id()
         << ", " << _id.get_service_id()
         << ") is not in a valid timeperiod, "
@@ -426,7 +426,7 @@ void action::_process_notification(
 
   // See if the node is in downtime.
   if (_act == notification_attempt && cache.node_in_downtime(_id) == true) {
-    logging::debug(logging::low)
+    LOGGING_DEBUG(logging::low)
         << "notification: node (" << _id.get_host_id() << ", "
         << _id.get_service_id()
         << ") is in downtime, notification won't be sent";
@@ -435,7 +435,7 @@ void action::_process_notification(
 
   // See if the node has been acknowledged.
   if (_act == notification_attempt && cache.node_acknowledged(_id) == true) {
-    logging::debug(logging::low)
+    LOGGING_DEBUG(logging::low)
         << "notification: node (" << _id.get_host_id() << ", "
         << _id.get_service_id()
         << ") is acknowledged, notification won't be sent";
@@ -58,7 +58,7 @@ void notification_method_loader::load(mysql* ms,
       nm->set_types(res.value_as_str(5));
       nm->set_start(res.value_as_u32(6));
       nm->set_end(res.value_as_u32(7));
-      logging::debug(logging::low)
+      LOGGING_DEBUG(logging::low)
           << "notification: new method " << res.value_as_u32(0) << " ('"
           << nm->get_name() << "')";
       output->add_notification_method(res.value_as_u32(0), nm);
@@ -55,7 +55,7 @@ void notification_rule_loader::load(mysql* ms,
       rule->set_timeperiod_id(res.value_as_u32(2));
       rule->set_contact_id(res.value_as_u32(3));
       rule->set_node_id(node_id(res.value_as_u32(4), res.value_as_u32(5)));
-      logging::debug(logging::low)
+      LOGGING_DEBUG(logging::low)
           << "notification: new rule " << rule->get_id() << " affecting node ("
           << rule->get_node_id().get_host_id() << ", "
           << rule->get_node_id().get_service_id() << ") using method "
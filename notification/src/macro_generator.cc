@@ -77,7 +77,7 @@ void macro_generator::generate(macro_container& container,
 
   for (macro_container::iterator it(container.begin()), end(container.end());
        it != end; ++it) {
-    logging::debug(logging::low)
+    LOGGING_DEBUG(logging::low)
         << "notification: searching macro " << it.key();
     if (_get_global_macros(it.key(), st, it.value()))
       continue;
@@ -83,7 +83,7 @@ void node_cache::starting() {
   if (_cache.get() == NULL)
     return;
 
-  logging::debug(logging::low)
+  LOGGING_DEBUG(logging::low)
       << "notification: loading the node cache " << _cache->get_cache_file();
 
   std::shared_ptr<io::data> data;
@@ -102,7 +102,7 @@ void node_cache::starting() {
     return;
   }
 
-  logging::debug(logging::low)
+  LOGGING_DEBUG(logging::low)
       << "notification: finished loading the node cache "
       << _cache->get_cache_file() << " succesfully";
 }
@@ -115,7 +115,7 @@ void node_cache::stopping() {
   if (_cache.get() == NULL)
     return;
 
-  logging::debug(logging::low)
+  LOGGING_DEBUG(logging::low)
       << "notification: writing the node cache " << _cache->get_cache_file();
 
   // Lock the mutex;
@@ -126,7 +126,7 @@ void node_cache::stopping() {
     _cache->transaction();
     // Sache into the cache.
     _save_cache();
-    logging::debug(logging::low)
+    LOGGING_DEBUG(logging::low)
         << "notification: finished writing the node cache "
         << _cache->get_cache_file() << " succesfully";
   } catch (std::exception const& e) {
@@ -137,8 +137,8 @@ void node_cache::stopping() {
     return;
   }
 
-  logging::debug(logging::low) << "notification: commiting the node cache '"
-                               << _cache->get_cache_file() << "'";
+  LOGGING_DEBUG(logging::low) << "notification: commiting the node cache '"
+                              << _cache->get_cache_file() << "'";
 
   try {
     _cache->commit();
@@ -148,8 +148,8 @@ void node_cache::stopping() {
         << _cache->get_cache_file() << "': " << e.what();
   }
 
-  logging::debug(logging::low) << "notification: commited the node cache '"
-                               << _cache->get_cache_file() << "' succesfully";
+  LOGGING_DEBUG(logging::low) << "notification: commited the node cache '"
+                              << _cache->get_cache_file() << "' succesfully";
 }
 
 /**
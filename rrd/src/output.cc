@@ -30,6 +30,7 @@
 #include "com/centreon/broker/logging/logging.hh"
 #include "com/centreon/broker/rrd/exceptions/open.hh"
 #include "com/centreon/broker/rrd/exceptions/update.hh"
+#include "com/centreon/broker/stats/stages.hh"
 #include "com/centreon/broker/storage/events.hh"
 #include "com/centreon/broker/storage/internal.hh"
 #include "com/centreon/broker/storage/perfdata.hh"
@@ -233,7 +234,10 @@ int output<T>::write(std::shared_ptr<io::data> const& d) {
                   e->value_type, oss.str());
               break;
           }
-          _backend.update(e->ctime, oss.str());
+          {
+            stats::stage_timer timer(stats::stage_rrd_update);
+            _backend.update(e->ctime, oss.str());
+          }
         } else
           // Cache value.
           it->second.push_back(d);
@@ -272,7 +276,10 @@ int output<T>::write(std::shared_ptr<io::data> const& d) {
             value = "0";
           else
             value = "";
-          _backend.update(e->ctime, value);
+          {
+            stats::stage_timer timer(stats::stage_rrd_update);
+            _backend.update(e->ctime, value);
+          }
         } else
           // Cache value.
           it->second.push_back(d);
@@ -23,6 +23,7 @@
 #include <json11.hpp>
 #include <mutex>
 #include <string>
+#include <vector>
 #include "com/centreon/broker/namespace.hh"
 
 CCB_BEGIN()
@@ -43,7 +44,8 @@ class builder {
   builder(builder const& right);
   ~builder() throw();
   builder& operator=(builder const& right);
-  void build();
+  void build(std::vector<std::string> const& subtrees =
+                 std::vector<std::string>());
   std::string const& data() const noexcept;
   json11::Json const& root() const noexcept;
 
@@ -31,6 +31,14 @@ namespace stats {
 // Forward declaration.
 class config;
 
+/**
+ *  A stats FIFO, with the subtrees written in it (all when empty).
+ */
+struct fifo_config {
+  std::string path;
+  std::vector<std::string> subtrees;
+};
+
 /**
  *  @class parser parser.hh "com/centreon/broker/stats/parser.hh"
  *  @brief Parse a <stats> node.
@@ -46,6 +54,7 @@ class parser {
   parser& operator=(parser const& right) = delete;
 
   void parse(std::vector<std::string>& cfg, std::string const& content);
+  void parse(std::vector<fifo_config>& cfg, std::string const& content);
 };
 }  // namespace stats
 
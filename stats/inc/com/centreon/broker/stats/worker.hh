@@ -23,6 +23,7 @@
 #include <atomic>
 #include <string>
 #include <thread>
+#include <vector>
 
 namespace com {
 namespace centreon {
@@ -39,6 +40,7 @@ class worker {
   std::string _buffer;
   int _fd;
   std::string _fifo;
+  std::vector<std::string> _subtrees;
 
   std::thread _thread;
   std::atomic_bool _exit;
@@ -53,7 +55,9 @@ class worker {
   worker(worker const& right) = delete;
   worker& operator=(worker const& right) = delete;
 
-  void run(std::string const& fifo_file);
+  void run(std::string const& fifo_file,
+           std::vector<std::string> const& subtrees =
+               std::vector<std::string>());
 };
 }  // namespace stats
 }  // namespace broker
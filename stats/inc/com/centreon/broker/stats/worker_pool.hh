@@ -22,6 +22,7 @@
 
 #include <string>
 #include <thread>
+#include <vector>
 #include "com/centreon/broker/stats/worker.hh"
 
 namespace com {
@@ -40,7 +41,9 @@ class worker_pool {
  public:
   worker_pool();
 
-  void add_worker(std::string const& fifo);
+  void add_worker(std::string const& fifo,
+                  std::vector<std::string> const& subtrees =
+                      std::vector<std::string>());
   void cleanup();
 
  private:
@@ -32,6 +32,7 @@
 #include "com/centreon/broker/multiplexing/muxer.hh"
 #include "com/centreon/broker/mysql_manager.hh"
 #include "com/centreon/broker/stats/helper.hh"
+#include "com/centreon/broker/stats/registry.hh"
 
 using namespace com::centreon::broker;
 using namespace com::centreon::broker::stats;
@@ -79,29 +80,59 @@ builder& builder::operator=(builder const& right) {
 /**
  *  Get and build statistics.
  *
- *  @param[in,out] srz  The serializer to use to serialize data.
+ *  Endpoints statistics are read from the stats registry, they are never
+ *  gathered from the endpoints themselves.
+ *
+ *  @param[in] subtrees  Paths of the wanted subtrees, everything is built
+ *                       when empty. Registry subtrees can be cut at any
+ *                       depth, other entries only at the top level.
  */
-void builder::build() {
+void builder::build(std::vector<std::string> const& subtrees) {
   // Cleanup.
   _data.clear();
+
+  // A top level entry is wanted if a subtree is in it.
+  auto wanted = [&subtrees](std::string const& name) -> bool {
+    if (subtrees.empty())
+      return true;
+    for (std::string const& s : subtrees)
+      if (s.compare(0, name.size(), name) == 0 &&
+          (s.size() == name.size() || s[name.size()] == '/'))
+        return true;
+    return false;
+  };
+
   json11::Json::object object;
-  stats::get_generic_stats(object);
+  {
+    json11::Json::object generic_object;
+    stats::get_generic_stats(generic_object);
+    for (auto& p : generic_object)
+      if (wanted(p.first))
+        object[p.first] = p.second;
+  }
 
-  json11::Json::object mysql_object;
-  stats::get_mysql_stats(mysql_object);
-  object["mysql manager"] = mysql_object;
+  if (wanted("mysql manager")) {
+    json11::Json::object mysql_object;
+    stats::get_mysql_stats(mysql_object);
+    object["mysql manager"] = mysql_object;
+  }
+
+  if (wanted("stages")) {
+    json11::Json::object stages_object;
+    stats::get_stage_stats(stages_object);
+    object["stages"] = stages_object;
+  }
 
   std::vector<json11::Json::object> modules_objects;
   stats::get_loaded_module_stats(modules_objects);
   for (auto& obj : modules_objects) {
-    object["module" + obj["name"].string_value()] = obj;
+    std::string name("module" + obj["name"].string_value());
+    if (wanted(name))
+      object[name] = obj;
   }
 
-  std::vector<json11::Json::object> endpoint_objects;
-  stats::get_endpoint_stats(endpoint_objects);
-  for (auto& obj : endpoint_objects) {
-    object["endpoint " + obj["name"].string_value()] = obj;
-  }
+  for (auto& p : stats::registry::instance().snapshot(subtrees))
+    object[p.first] = p.second;
 
   _root = object;
   std::string buffer;
@@ -66,18 +66,18 @@ void broker_module_init(void const* arg) {
     if (it != base_cfg.params().end()) {
       try {
         // Parse configuration.
-        std::vector<std::string> stats_cfg;
+        std::vector<stats::fifo_config> stats_cfg;
         {
           stats::parser p;
           p.parse(stats_cfg, it->second);
         }
 
         // File configured, load stats engine.
-        for (std::vector<std::string>::const_iterator
+        for (std::vector<stats::fifo_config>::const_iterator
                  it = stats_cfg.begin(),
                  end = stats_cfg.end();
              it != end; ++it) {
-          pool.add_worker(*it);
+          pool.add_worker(it->path, it->subtrees);
         }
         loaded = true;
       } catch (std::exception const& e) {
@@ -41,25 +41,43 @@ parser::~parser() throw() {}
  *  @param[in]  content XML content.
  */
 void parser::parse(std::vector<std::string>& cfg, std::string const& content) {
+  std::vector<fifo_config> fifos;
+  parse(fifos, content);
+  for (fifo_config const& f : fifos)
+    cfg.push_back(f.path);
+}
+
+/**
+ *  Parse a json buffer. Each FIFO may be given a "subtrees" array, to only
+ *  write these subtrees of the statistics in it.
+ *
+ *  @param[out] cfg      Parsed FIFOs.
+ *  @param[in]  content  Json content.
+ */
+void parser::parse(std::vector<fifo_config>& cfg, std::string const& content) {
   std::string err;
   auto json_fifo = [&cfg](Json const& js) -> void {
-    if (js.is_string() && !js.string_value().empty())
-      cfg.push_back(js.string_value());
+    Json const& path{js["json_fifo"]};
+    if (path.is_string() && !path.string_value().empty()) {
+      fifo_config f;
+      f.path = path.string_value();
+      for (Json const& s : js["subtrees"].array_items())
+        if (s.is_string())
+          f.subtrees.push_back(s.string_value());
+      cfg.push_back(f);
+    }
   };
 
   Json const& js{Json::parse(content, err)};
   if (!err.empty())
     throw(exceptions::msg() << "stats: invalid json file");
 
-  if (js.is_object()) {
-    Json const& field{js["json_fifo"]};
-    json_fifo(field);
-  } else if (js.is_array()) {
+  if (js.is_object())
+    json_fifo(js);
+  else if (js.is_array()) {
     for (auto it = js.array_items().begin(), end = js.array_items().end();
-         it != end; ++it) {
-      Json const& field{(*it)["json_fifo"]};
-      json_fifo(field);
-    }
+         it != end; ++it)
+      json_fifo(*it);
   }
 
   return;
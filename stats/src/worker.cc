@@ -58,14 +58,16 @@ worker::~worker() noexcept {
  *  Run the statistics thread.
  *
  *  @param[in] fifo_file Path to the FIFO file.
- *  @param[in] type     The type of this FIFO.
+ *  @param[in] subtrees  Subtrees written in the FIFO, all when empty.
  */
-void worker::run(std::string const& fifo_file) {
+void worker::run(std::string const& fifo_file,
+                 std::vector<std::string> const& subtrees) {
   // Close FD.
   _close();
 
   // Set FIFO file.
   _fifo = fifo_file;
+  _subtrees = subtrees;
 
   // Set exit flag.
   _exit = false;
@@ -149,7 +151,7 @@ void worker::_run() {
           if (_buffer.empty()) {
             // Generate statistics.
             builder stats_builder;
-            stats_builder.build();
+            stats_builder.build(_subtrees);
             _buffer = stats_builder.data();
           }
 
@@ -31,7 +31,8 @@ using namespace com::centreon::broker::stats;
 
 worker_pool::worker_pool() {}
 
-void worker_pool::add_worker(std::string const& fifo) {
+void worker_pool::add_worker(std::string const& fifo,
+                             std::vector<std::string> const& subtrees) {
   // Does file exist and is a FIFO ?
   struct stat s;
   std::string fifo_path = fifo;
@@ -54,7 +55,7 @@ void worker_pool::add_worker(std::string const& fifo) {
 
   // Create thread.
   _workers_fifo.push_back(std::make_shared<stats::worker>());
-  _workers_fifo.back()->run(fifo_path);
+  _workers_fifo.back()->run(fifo_path, subtrees);
 }
 
 void worker_pool::cleanup() {
@@ -40,6 +40,7 @@
 #include "com/centreon/broker/misc/string.hh"
 #include "com/centreon/broker/multiplexing/engine.hh"
 #include "com/centreon/broker/stats/builder.hh"
+#include "com/centreon/broker/stats/registry.hh"
 
 using namespace com::centreon::broker;
 
@@ -296,6 +297,42 @@ TEST_F(StatsTest, Parser) {
   ASSERT_THROW(parser.parse(result, "ds{ahsjklhdasjhdaskjh"), exceptions::msg);
 }
 
+TEST_F(StatsTest, ParserSubtrees) {
+  stats::parser parser;
+  std::vector<stats::fifo_config> result;
+
+  parser.parse(result,
+               "[{ \"json_fifo\":\"/tmp/test.txt\" },"
+               " { \"json_fifo\":\"/tmp/test2.txt\","
+               " \"subtrees\": [\"stages\", \"endpoint sql/state\"] }]");
+  ASSERT_EQ(result.size(), 2u);
+  ASSERT_EQ(result[0].path, "/tmp/test.txt");
+  ASSERT_TRUE(result[0].subtrees.empty());
+  ASSERT_EQ(result[1].path, "/tmp/test2.txt");
+  ASSERT_EQ(result[1].subtrees,
+            std::vector<std::string>({"stages", "endpoint sql/state"}));
+}
+
+TEST_F(StatsTest, BuilderSubtrees) {
+  stats::group g;
+  g.add<stats::text>("state")->set("connected");
+  g.add<stats::counter>("events")->add(4);
+  g.publish("endpoint BuilderSubtrees");
+
+  stats::builder build;
+  build.build({"pid", "endpoint BuilderSubtrees/state"});
+
+  std::string err;
+  json11::Json const& result{json11::Json::parse(build.data(), err)};
+
+  ASSERT_TRUE(err.empty());
+  ASSERT_EQ(result.object_items().size(), 2u);
+  ASSERT_EQ(result["pid"].number_value(), getpid());
+  ASSERT_EQ(result["endpoint BuilderSubtrees"]["state"].string_value(),
+            "connected");
+  ASSERT_TRUE(result["endpoint BuilderSubtrees"]["events"].is_null());
+}
+
 TEST_F(StatsTest, Worker) {
   std::unique_ptr<stats::worker> work(new stats::worker);
 
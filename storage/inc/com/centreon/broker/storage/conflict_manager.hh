@@ -27,6 +27,7 @@
 #include <thread>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "com/centreon/broker/io/events.hh"
 #include "com/centreon/broker/io/stream.hh"
@@ -197,6 +198,19 @@ class conflict_manager {
   std::deque<std::pair<bool*, std::string>> _cv_queue;
   std::deque<std::pair<bool*, std::string>> _log_queue;
 
+  /* The last real time status received for each host/service, written to the
+   * 'hosts'/'services' tables just before the commit of the main loop, that
+   * is when the loop timeout or _max_pending_queries is reached. A status
+   * received while an older one is still waiting replaces it, so each row is
+   * updated once. The vectors keep the pointers to the booleans of all the
+   * received events, they are acknowledged when the last one is written. */
+  std::unordered_map<uint64_t,
+                     std::pair<std::shared_ptr<io::data>, std::vector<bool*>>>
+      _host_statuses;
+  std::unordered_map<std::pair<uint64_t, uint64_t>,
+                     std::pair<std::shared_ptr<io::data>, std::vector<bool*>>>
+      _service_statuses;
+
   timestamp _oldest_timestamp;
   std::unordered_map<uint32_t, stored_timestamp> _stored_timestamps;
 
@@ -314,6 +328,7 @@ class conflict_manager {
   void _insert_perfdatas();
   void _update_customvariables();
   void _insert_logs();
+  void _update_statuses();
   void __exit();
 
  public:
@@ -526,6 +526,8 @@ void conflict_manager::_callback() {
           }
         }
         log_v2::sql()->debug("{} new events to treat", count);
+        /* Time to send the last statuses to database */
+        _update_statuses();
         /* Here, just before looping, we commit. */
         _finish_actions();
         if (_fifo.get_pending_elements() == 0)
@@ -939,6 +939,9 @@ void conflict_manager::_process_host(
                          actions::comments | actions::service_dependencies);
   neb::host& h = *static_cast<neb::host*>(d.get());
 
+  // The waiting statuses are older than this host.
+  _update_statuses();
+
   // Log message.
   log_v2::sql()->debug(
       "SQL: processing host event (poller: {}, id: {}, name: {})", h.poller_id,
@@ -1067,29 +1070,19 @@ void conflict_manager::_process_host_status(
         "processing host status event (id: {}, last check: {}, state ({}, {}))",
         hs.host_id, hs.last_check, hs.current_state, hs.state_type);
 
-    // Prepare queries.
-    if (!_host_status_update.prepared()) {
-      query_preparator::event_unique unique;
-      unique.insert("host_id");
-      query_preparator qp(neb::host_status::static_type(), unique);
-      _host_status_update = qp.prepare_update(_mysql);
-    }
-
-    // Processing.
-    _host_status_update << hs;
-    int32_t conn =
-        _mysql.choose_connection_by_instance(_cache_host_instance[hs.host_id]);
-    _mysql.run_statement(_host_status_update,
-                         database::mysql_error::store_host_status, true, conn);
-    _add_action(conn, actions::hosts);
-  } else
+    // Processing: the status is written by _update_statuses().
+    auto& status = _host_statuses[hs.host_id];
+    status.first = d;
+    status.second.push_back(std::get<2>(t));
+  } else {
     // Do nothing.
     log_v2::sql()->info(
         "SQL: not processing host status event (id: {}, check type: {}, last "
         "check: {}, next check: {}, now: {}, state: ({}, {}))",
         hs.host_id, hs.check_type, hs.last_check, hs.next_check, now,
         hs.current_state, hs.state_type);
-  *std::get<2>(t) = true;
+    *std::get<2>(t) = true;
+  }
 }
 
 /**
@@ -1116,6 +1109,9 @@ void conflict_manager::_process_instance(
       "SQL: processing poller event (id: {}, name: {}, running: {})",
       i.poller_id, i.name, i.is_running ? "yes" : "no");
 
+  // Statuses waiting for the hosts/services of this poller come first.
+  _update_statuses();
+
   // Clean tables.
   _clean_tables(i.poller_id);
 
@@ -1566,6 +1562,9 @@ void conflict_manager::_process_service(
                          actions::downtimes | actions::host_dependencies |
                          actions::service_dependencies);
 
+  // The waiting statuses are older than this service.
+  _update_statuses();
+
   // Processed object.
   neb::service const& s(*static_cast<neb::service const*>(d.get()));
   if (_cache_host_instance[s.host_id]) {
@@ -1643,24 +1642,11 @@ void conflict_manager::_process_service_status(
         ss.host_id, ss.service_id, ss.last_check, ss.current_state,
         ss.state_type);
 
-    // Prepare queries.
-    if (!_service_status_update.prepared()) {
-      query_preparator::event_unique unique;
-      unique.insert("host_id");
-      unique.insert("service_id");
-      query_preparator qp(neb::service_status::static_type(), unique);
-      _service_status_update = qp.prepare_update(_mysql);
-    }
-
-    // Processing.
-    _service_status_update << ss;
-    int32_t conn =
-        _mysql.choose_connection_by_instance(_cache_host_instance[ss.host_id]);
-    _mysql.run_statement(_service_status_update,
-                         database::mysql_error::store_service_status, false,
-                         conn);
-    _add_action(conn, actions::hosts);
-  } else
+    // Processing: the status is written by _update_statuses().
+    auto& status = _service_statuses[{ss.host_id, ss.service_id}];
+    status.first = d;
+    status.second.push_back(std::get<2>(t));
+  } else {
     // Do nothing.
     log_v2::sql()->info(
         "SQL: not processing service status event (host: {}, service: {}, "
@@ -1668,7 +1654,8 @@ void conflict_manager::_process_service_status(
         "{}))",
         ss.host_id, ss.service_id, ss.check_type, ss.last_check, ss.next_check,
         now, ss.current_state, ss.state_type);
-  *std::get<2>(t) = true;
+    *std::get<2>(t) = true;
+  }
 }
 
 /**
@@ -1769,3 +1756,71 @@ void conflict_manager::_insert_logs() {
     _log_queue.pop_front();
   }
 }
+
+/**
+ * @brief Write the real time statuses of hosts and services received since
+ * the last call. For each host/service, only the last status is written, the
+ * events it replaces are acknowledged with it.
+ *
+ * When we exit the function, the status maps are empty.
+ */
+void conflict_manager::_update_statuses() {
+  if (!_host_statuses.empty()) {
+    // Prepare queries.
+    if (!_host_status_update.prepared()) {
+      query_preparator::event_unique unique;
+      unique.insert("host_id");
+      query_preparator qp(neb::host_status::static_type(), unique);
+      _host_status_update = qp.prepare_update(_mysql);
+    }
+
+    size_t count = 0;
+    for (auto& p : _host_statuses) {
+      neb::host_status const& hs(
+          *static_cast<neb::host_status const*>(p.second.first.get()));
+      _host_status_update << hs;
+      int32_t conn = _mysql.choose_connection_by_instance(
+          _cache_host_instance[hs.host_id]);
+      _mysql.run_statement(_host_status_update,
+                           database::mysql_error::store_host_status, true,
+                           conn);
+      _add_action(conn, actions::hosts);
+      for (bool* ack : p.second.second)
+        *ack = true;
+      count += p.second.second.size();
+    }
+    log_v2::sql()->debug("{} host statuses updated from {} events",
+                         _host_statuses.size(), count);
+    _host_statuses.clear();
+  }
+
+  if (!_service_statuses.empty()) {
+    // Prepare queries.
+    if (!_service_status_update.prepared()) {
+      query_preparator::event_unique unique;
+      unique.insert("host_id");
+      unique.insert("service_id");
+      query_preparator qp(neb::service_status::static_type(), unique);
+      _service_status_update = qp.prepare_update(_mysql);
+    }
+
+    size_t count = 0;
+    for (auto& p : _service_statuses) {
+      neb::service_status const& ss(
+          *static_cast<neb::service_status const*>(p.second.first.get()));
+      _service_status_update << ss;
+      int32_t conn = _mysql.choose_connection_by_instance(
+          _cache_host_instance[ss.host_id]);
+      _mysql.run_statement(_service_status_update,
+                           database::mysql_error::store_service_status, false,
+                           conn);
+      _add_action(conn, actions::hosts);
+      for (bool* ack : p.second.second)
+        *ack = true;
+      count += p.second.second.size();
+    }
+    log_v2::sql()->debug("{} service statuses updated from {} events",
+                         _service_statuses.size(), count);
+    _service_statuses.clear();
+  }
+}
@@ -303,7 +303,7 @@ void parser::parse_perfdata(const char* str, std::list<perfdata>& pd) {
     p.max(extract_double(const_cast<const char**>(&tmp)));
 
     // Log new perfdata.
-    logging::debug(logging::low)
+    LOGGING_DEBUG(logging::low)
         << "storage: got new perfdata (name=" << p.name()
         << ", value=" << p.value() << ", unit=" << p.unit()
         << ", warning=" << p.warning() << ", critical=" << p.critical()
@@ -269,8 +269,8 @@ void tcp_connection::start_reading() {
 
 void tcp_connection::handle_read(const asio::error_code& ec,
                                  size_t read_bytes) {
-  log_v2::tcp()->trace("Incoming data: {} bytes: {}", read_bytes,
-                       debug_buf(&_read_buffer[0], read_bytes));
+  LOG_V2_TRACE(log_v2::tcp(), "Incoming data: {} bytes: {}", read_bytes,
+               debug_buf(&_read_buffer[0], read_bytes));
   if (read_bytes > 0) {
     std::lock_guard<std::mutex> lock(_read_queue_m);
     _read_queue.emplace(_read_buffer.begin(),